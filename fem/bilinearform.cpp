@@ -15,6 +15,10 @@
 #include "../general/device.hpp"
 #include <cmath>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -122,19 +126,16 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    switch (assembly)
    {
       case AssemblyLevel::FULL:
-         // ext = new FABilinearFormExtension(this);
-         // Use the original BilinearForm implementation for now
+         ext = new FABilinearFormExtension(this);
          break;
       case AssemblyLevel::ELEMENT:
-         mfem_error("Element assembly not supported yet... stay tuned!");
-         // ext = new EABilinearFormExtension(this);
+         ext = new EABilinearFormExtension(this);
          break;
       case AssemblyLevel::PARTIAL:
          ext = new PABilinearFormExtension(this);
          break;
       case AssemblyLevel::NONE:
-         mfem_error("Matrix-free action not supported yet... stay tuned!");
-         // ext = new MFBilinearFormExtension(this);
+         ext = new MFBilinearFormExtension(this);
          break;
       default:
          mfem_error("Unknown assembly level");
@@ -144,7 +145,7 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
-   if (assembly != AssemblyLevel::FULL)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       static_cond = NULL;
       MFEM_WARNING("Static condensation not supported for this assembly level");
@@ -169,7 +170,7 @@ void BilinearForm::EnableHybridization(FiniteElementSpace *constr_space,
                                        const Array<int> &ess_tdof_list)
 {
    delete hybridization;
-   if (assembly != AssemblyLevel::FULL)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       delete constr_integ;
       hybridization = NULL;
@@ -373,7 +374,8 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
-   if (ext)
+   if (ext && (assembly != AssemblyLevel::FULL ||
+               static_cast<FABilinearFormExtension*>(ext)->SupportsForm()))
    {
       ext->Assemble();
       return;
@@ -397,7 +399,20 @@ void BilinearForm::Assemble(int skip_zeros)
    }
 #endif
 
-   if (dbfi.Size())
+   bool threaded = false;
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   threaded = !element_matrices && Device::Allows(Backend::OMP_MASK);
+   for (int k = 0; k < dbfi.Size(); k++)
+   {
+      threaded = threaded && dbfi[k]->IsThreadSafe();
+   }
+#endif
+
+   if (dbfi.Size() && threaded)
+   {
+      AssembleDomainThreaded(skip_zeros);
+   }
+   else if (dbfi.Size())
    {
       for (int i = 0; i < fes -> GetNE(); i++)
       {
@@ -573,6 +588,79 @@ void BilinearForm::Assemble(int skip_zeros)
 #endif
 }
 
+void BilinearForm::AssembleDomainThreaded(int skip_zeros)
+{
+   // Every thread uses its own transformation, see
+   // FiniteElementSpace::GetElementTransformation(int,
+   // IsoparametricTransformation *).
+   for (int k = 0; k < dbfi.Size(); k++)
+   {
+      MFEM_VERIFY(dbfi[k]->IsThreadSafe(),
+                  "domain integrator #" << k << " is not thread-safe");
+   }
+   if (dbfi.Size() == 0) { return; }
+   if (mat == NULL) { AllocMat(); }
+   const int NE = fes->GetNE();
+#ifdef MFEM_USE_OPENMP
+   const int block_size = 64*omp_get_max_threads();
+#else
+   const int block_size = 64;
+#endif
+   Array<DenseMatrix *> elmats(std::min(block_size, NE));
+   for (int k = 0; k < elmats.Size(); k++) { elmats[k] = new DenseMatrix; }
+   GridFunction *nodes = fes->GetMesh()->GetNodes();
+   if (nodes) { nodes->HostRead(); }
+
+   for (int b = 0; b < NE; b += block_size)
+   {
+      const int nb = std::min(block_size, NE - b);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel
+#endif
+      {
+         IsoparametricTransformation eltrans;
+         DenseMatrix elmat_k;
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(dynamic,4)
+#endif
+         for (int k = 0; k < nb; k++)
+         {
+            const int i = b + k;
+            const FiniteElement &fe = *fes->GetFE(i);
+            DenseMatrix &elmat = *elmats[k];
+            fes->GetElementTransformation(i, &eltrans);
+            dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+            for (int j = 1; j < dbfi.Size(); j++)
+            {
+               dbfi[j]->AssembleElementMatrix(fe, eltrans, elmat_k);
+               elmat += elmat_k;
+            }
+         }
+      }
+
+      // Add the element matrices of the block in element order
+      for (int k = 0; k < nb; k++)
+      {
+         const int i = b + k;
+         fes->GetElementVDofs(i, vdofs);
+         if (static_cond)
+         {
+            static_cond->AssembleMatrix(i, *elmats[k]);
+         }
+         else
+         {
+            mat->AddSubMatrix(vdofs, vdofs, *elmats[k], skip_zeros);
+            if (hybridization)
+            {
+               hybridization->AssembleMatrix(i, *elmats[k]);
+            }
+         }
+      }
+   }
+
+   for (int k = 0; k < elmats.Size(); k++) { delete elmats[k]; }
+}
+
 void BilinearForm::ConformingAssemble()
 {
    // Do not remove zero entries to preserve the symmetric structure of the
@@ -612,13 +700,13 @@ void BilinearForm::AssembleDiagonal(Vector &diag) const
 {
    if (ext)
    {
-      MFEM_ASSERT(diag.Size() == fes->GetNConformingDofs(),
+      MFEM_ASSERT(diag.Size() == fes->GetConformingVSize(),
                   "Vector for holding diagonal has wrong size!");
       const SparseMatrix *P = fes->GetConformingProlongation();
       if (P)
       {
          MFEM_WARNING("Partial assembly diagonal may be incorrect with AMR!");
-         Vector local_diag(P->Height());
+         Vector local_diag(fes->GetVSize());
          ext->AssembleDiagonal(local_diag);
          P->MultTranspose(local_diag, diag);
       }
@@ -640,7 +728,9 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
 {
    const SparseMatrix *P = fes->GetConformingProlongation();
 
-   if (ext)
+   // With AssemblyLevel::FULL, the extension assembles 'mat' which is then
+   // handled exactly as in the legacy full assembly below.
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
       return;
@@ -708,7 +798,7 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
 void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                     OperatorHandle &A)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
       return;
@@ -751,7 +841,7 @@ void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
 void BilinearForm::RecoverFEMSolution(const Vector &X,
                                       const Vector &b, Vector &x)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->RecoverFEMSolution(X, b, x);
       return;
@@ -926,18 +1016,13 @@ void BilinearForm::EliminateVDofs(const Array<int> &vdofs,
       mat_e = new SparseMatrix(height);
    }
 
+   Array<int> rc(vdofs.Size());
    for (int i = 0; i < vdofs.Size(); i++)
    {
       int vdof = vdofs[i];
-      if ( vdof >= 0 )
-      {
-         mat -> EliminateRowCol (vdof, *mat_e, dpolicy);
-      }
-      else
-      {
-         mat -> EliminateRowCol (-1-vdof, *mat_e, dpolicy);
-      }
+      rc[i] = (vdof >= 0) ? vdof : -1-vdof;
    }
+   mat -> EliminateRowCols (rc, *mat_e, dpolicy);
 }
 
 void BilinearForm::EliminateEssentialBCFromDofs(
@@ -48,6 +48,8 @@ enum class AssemblyLevel
     BLFIntegrators. */
 class BilinearForm : public Matrix
 {
+   friend class FABilinearFormExtension;
+
 protected:
    /// Sparse matrix to be associated with the form. Owned.
    SparseMatrix *mat;
@@ -150,7 +152,13 @@ public:
    int Size() const { return height; }
 
    /// Set the desired assembly level. The default is AssemblyLevel::FULL.
-   /** This method must be called before assembly. */
+   /** This method must be called before assembly. Without a call to this
+       method, the form is fully assembled element by element, which supports
+       all integrator types, static condensation and hybridization. Explicitly
+       requesting AssemblyLevel::FULL selects the FABilinearFormExtension,
+       which assembles the domain integrators directly into a CSR matrix, for
+       the forms it supports, see FABilinearFormExtension::SupportsForm(). The
+       other forms use the element-by-element assembly. */
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
    /** Enable the use of static condensation. For details see the description
@@ -229,6 +237,10 @@ public:
    /// Matrix vector multiplication.
    virtual void Mult(const Vector &x, Vector &y) const { mat->Mult(x, y); }
 
+   /// Matrix multiplication with all vectors of @a X, see Operator::MultMulti.
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const
+   { mat->MultMulti(X, Y); }
+
    void FullMult(const Vector &x, Vector &y) const
    { mat->Mult(x, y); mat_e->AddMult(x, y); }
 
@@ -317,8 +329,20 @@ public:
    }
 
    /// Assembles the form i.e. sums over all domain/bdr integrators.
+   /** When MFEM is built with MFEM_USE_OPENMP and MFEM_THREAD_SAFE, and an
+       OpenMP backend is enabled in the Device, the element matrices of the
+       domain integrators are computed by multiple threads, provided that all
+       of them are thread-safe, see BilinearFormIntegrator::IsThreadSafe().
+       The matrices are added to the matrix in element order, so the result
+       does not depend on the number of threads. */
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Add the element matrices of the domain integrators to the
+       matrix, computing them for blocks of elements with OpenMP threads. */
+   /** This is the threaded part of Assemble(). All domain integrators must be
+       thread-safe. The result is the same as with the serial assembly. */
+   void AssembleDomainThreaded(int skip_zeros = 1);
+
    /** @brief Assemble the diagonal of the bilinear form into diag
 
        For adaptively refined meshes, this returns P^T d_e, where d_e is the
@@ -14,6 +14,7 @@
 
 #include "../general/forall.hpp"
 #include "bilinearform.hpp"
+#include <algorithm>
 
 namespace mfem
 {
@@ -38,7 +39,8 @@ const Operator *BilinearFormExtension::GetRestriction() const
 // Data and methods for partially-assembled bilinear forms
 PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    : BilinearFormExtension(form),
-     trialFes(a->FESpace()), testFes(a->FESpace())
+     trialFes(a->FESpace()), testFes(a->FESpace()),
+     int_face_restrict_lex(NULL), bdr_face_restrict_lex(NULL)
 {
    elem_restrict_lex = trialFes->GetElementRestriction(
                           ElementDofOrdering::LEXICOGRAPHIC);
@@ -58,10 +60,50 @@ void PABilinearFormExtension::Assemble()
    {
       integrators[i]->AssemblePA(*a->FESpace());
    }
+
+   Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
+   if (intFaceIntegrators.Size() > 0)
+   {
+      int_face_restrict_lex =
+         trialFes->GetFaceRestriction(FaceType::Interior);
+      int_face_X.SetSize(int_face_restrict_lex->Height(),
+                         Device::GetMemoryType());
+      int_face_Y.SetSize(int_face_restrict_lex->Height(),
+                         Device::GetMemoryType());
+      int_face_Y.UseDevice(true);
+      for (int i = 0; i < intFaceIntegrators.Size(); ++i)
+      {
+         intFaceIntegrators[i]->AssemblePAInteriorFaces(*a->FESpace());
+      }
+   }
+
+   Array<BilinearFormIntegrator*> &bdrFaceIntegrators = *a->GetBFBFI();
+   if (bdrFaceIntegrators.Size() > 0)
+   {
+      Array<Array<int>*> &markers = *a->GetBFBFI_Marker();
+      for (int i = 0; i < markers.Size(); ++i)
+      {
+         MFEM_VERIFY(markers[i] == NULL, "boundary markers are not supported "
+                     "by the partially assembled face integrators");
+      }
+      bdr_face_restrict_lex =
+         trialFes->GetFaceRestriction(FaceType::Boundary);
+      bdr_face_X.SetSize(bdr_face_restrict_lex->Height(),
+                         Device::GetMemoryType());
+      bdr_face_Y.SetSize(bdr_face_restrict_lex->Height(),
+                         Device::GetMemoryType());
+      bdr_face_Y.UseDevice(true);
+      for (int i = 0; i < bdrFaceIntegrators.Size(); ++i)
+      {
+         bdrFaceIntegrators[i]->AssemblePABoundaryFaces(*a->FESpace());
+      }
+   }
 }
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
 {
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "AssembleDiagonal does not support face integrators");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -72,7 +114,11 @@ void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
       {
          integrators[i]->AssembleDiagonalPA(localY);
       }
-      elem_restrict_lex->MultTranspose(localY, y);
+      // The diagonal entries are not affected by the sign changes of the dofs
+      const ElementRestriction *restE =
+         dynamic_cast<const ElementRestriction*>(elem_restrict_lex);
+      if (restE) { restE->MultTransposeUnsigned(localY, y); }
+      else { elem_restrict_lex->MultTranspose(localY, y); }
    }
    else
    {
@@ -98,6 +144,9 @@ void PABilinearFormExtension::Update()
       localX.SetSize(elem_restrict_lex->Height());
       localY.SetSize(elem_restrict_lex->Height());
    }
+   // the face restrictions are recreated by Assemble()
+   int_face_restrict_lex = NULL;
+   bdr_face_restrict_lex = NULL;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -146,6 +195,44 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          integrators[i]->AddMultPA(x, y);
       }
    }
+   AddMultFaces(x, y, false);
+}
+
+void PABilinearFormExtension::MultMulti(const MultiVector &X,
+                                        MultiVector &Y) const
+{
+   MFEM_VERIFY(X.NumVectors() == Y.NumVectors(),
+               "incompatible number of vectors");
+   if (!elem_restrict_lex)
+   {
+      Operator::MultMulti(X, Y);
+      return;
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   const int k = X.NumVectors();
+   localXs.SetSize(localX.Size(), k);
+   localYs.SetSize(localY.Size(), k);
+   Vector x, y, lx, ly;
+   for (int j = 0; j < k; j++)
+   {
+      X.GetVector(j, x);
+      localXs.GetVector(j, lx);
+      elem_restrict_lex->Mult(x, lx);
+   }
+   localYs = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultPAMulti(k, localXs, localYs);
+   }
+   for (int j = 0; j < k; j++)
+   {
+      X.GetVector(j, x);
+      Y.GetVector(j, y);
+      localYs.GetVector(j, ly);
+      elem_restrict_lex->MultTranspose(ly, y);
+      AddMultFaces(x, y, false);
+   }
 }
 
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
@@ -171,6 +258,247 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
          integrators[i]->AddMultTransposePA(x, y);
       }
    }
+   AddMultFaces(x, y, true);
+}
+
+void PABilinearFormExtension::AddMultFaces(const Vector &x, Vector &y,
+                                           const bool transpose) const
+{
+   const FaceType types[2] = { FaceType::Interior, FaceType::Boundary };
+   for (const FaceType type : types)
+   {
+      const bool interior = (type == FaceType::Interior);
+      const L2FaceRestriction *face_restrict =
+         interior ? int_face_restrict_lex : bdr_face_restrict_lex;
+      if (face_restrict == NULL) { continue; }
+      Array<BilinearFormIntegrator*> &integrators =
+         interior ? *a->GetFBFI() : *a->GetBFBFI();
+      Vector &faceX = interior ? int_face_X : bdr_face_X;
+      Vector &faceY = interior ? int_face_Y : bdr_face_Y;
+      face_restrict->Mult(x, faceX);
+      faceY = 0.0;
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         if (transpose) { integrators[i]->AddMultTransposePA(faceX, faceY); }
+         else { integrators[i]->AddMultPA(faceX, faceY); }
+      }
+      face_restrict->AddMultTranspose(faceY, y);
+   }
+}
+
+
+// Data and methods for element-assembled bilinear forms
+EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
+   : PABilinearFormExtension(form),
+     ne(trialFes->GetNE()),
+     elemDofs(ne > 0 ? trialFes->GetFE(0)->GetDof() : 0)
+{
+   MFEM_VERIFY(ne == 0 || elem_restrict_lex,
+               "element assembly requires an ElementRestriction");
+}
+
+void EABilinearFormExtension::Assemble()
+{
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "face integrators are not supported by AssemblyLevel::ELEMENT");
+   ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
+   ea_data.UseDevice(true);
+   ea_data = 0.0;
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleEA(*a->FESpace(), ea_data);
+   }
+}
+
+void EABilinearFormExtension::AssembleDiagonal(Vector &y) const
+{
+   const int NDOFS = elemDofs;
+   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   auto D = Reshape(localY.Write(), NDOFS, ne);
+   MFEM_FORALL(glob_j, ne*NDOFS,
+   {
+      const int e = glob_j/NDOFS;
+      const int j = glob_j%NDOFS;
+      D(j, e) = A(j, j, e);
+   });
+   const ElementRestriction *restE =
+      dynamic_cast<const ElementRestriction*>(elem_restrict_lex);
+   if (restE) { restE->MultTransposeUnsigned(localY, y); }
+   else { elem_restrict_lex->MultTranspose(localY, y); }
+}
+
+void EABilinearFormExtension::Update()
+{
+   PABilinearFormExtension::Update();
+   ne = trialFes->GetNE();
+   elemDofs = ne > 0 ? trialFes->GetFE(0)->GetDof() : 0;
+   ea_data.Destroy();
+}
+
+void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   elem_restrict_lex->Mult(x, localX);
+   // Batched dense matrix-vector product: the element matrices are stored
+   // column-major, so accumulate one column at a time to keep the inner loop
+   // contiguous.
+   const int NDOFS = elemDofs;
+   auto X = Reshape(localX.Read(), NDOFS, ne);
+   auto Y = Reshape(localY.Write(), NDOFS, ne);
+   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   MFEM_FORALL(e, ne,
+   {
+      for (int i = 0; i < NDOFS; i++) { Y(i, e) = 0.0; }
+      for (int j = 0; j < NDOFS; j++)
+      {
+         const double xj = X(j, e);
+         for (int i = 0; i < NDOFS; i++)
+         {
+            Y(i, e) += A(i, j, e) * xj;
+         }
+      }
+   });
+   elem_restrict_lex->MultTranspose(localY, y);
+}
+
+void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   elem_restrict_lex->Mult(x, localX);
+   const int NDOFS = elemDofs;
+   auto X = Reshape(localX.Read(), NDOFS, ne);
+   auto Y = Reshape(localY.Write(), NDOFS, ne);
+   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   MFEM_FORALL(glob_j, ne*NDOFS,
+   {
+      const int e = glob_j/NDOFS;
+      const int j = glob_j%NDOFS;
+      double res = 0.0;
+      for (int i = 0; i < NDOFS; i++)
+      {
+         res += A(i, j, e) * X(i, e);
+      }
+      Y(j, e) = res;
+   });
+   elem_restrict_lex->MultTranspose(localY, y);
+}
+
+
+// Data and methods for fully-assembled bilinear forms
+FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
+   : EABilinearFormExtension(form) { }
+
+bool FABilinearFormExtension::SupportsForm() const
+{
+   return (a->bbfi.Size() == 0 && a->fbfi.Size() == 0 &&
+           a->bfbfi.Size() == 0 && !a->static_cond && !a->hybridization &&
+           a->FESpace()->GetVDim() == 1 &&
+           (ne == 0 ||
+            dynamic_cast<const ElementRestriction*>(elem_restrict_lex)));
+}
+
+void FABilinearFormExtension::Assemble()
+{
+   MFEM_VERIFY(SupportsForm(), "the form is not supported by "
+               "FABilinearFormExtension, see SupportsForm()");
+
+   EABilinearFormExtension::Assemble();
+
+   const int height = a->FESpace()->GetVSize();
+   const ElementRestriction *restE =
+      static_cast<const ElementRestriction*>(elem_restrict_lex);
+   if (a->mat == NULL || !a->mat->Finalized())
+   {
+      delete a->mat;
+      // Compute the sparsity pattern once, the column indices are written
+      // below together with the entries.
+      Array<int> I;
+      const int nnz = ne > 0 ? restE->FillI(I) : 0;
+      int *i = new int[height+1];
+      if (ne > 0) { I.HostRead(); I.CopyTo(i); }
+      else { std::fill(i, i + height+1, 0); }
+      a->mat = new SparseMatrix(i, new int[nnz], new double[nnz],
+                                height, height);
+   }
+   if (ne > 0) { restE->FillJAndData(ea_data, *a->mat); }
+
+   // The eliminated part of the matrix is recomputed from the new entries.
+   delete a->mat_e;
+   a->mat_e = NULL;
+}
+
+void FABilinearFormExtension::AssembleDiagonal(Vector &diag) const
+{
+   a->mat->GetDiag(diag);
+}
+
+void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   a->mat->Mult(x, y);
+}
+
+void FABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   a->mat->MultTranspose(x, y);
+}
+
+void FABilinearFormExtension::MultMulti(const MultiVector &X,
+                                        MultiVector &Y) const
+{
+   a->mat->MultMulti(X, Y);
+}
+
+
+// Data and methods for matrix-free bilinear forms
+MFBilinearFormExtension::MFBilinearFormExtension(BilinearForm *form)
+   : PABilinearFormExtension(form)
+{
+   MFEM_VERIFY(trialFes->GetNE() == 0 || elem_restrict_lex,
+               "matrix-free action requires an ElementRestriction");
+}
+
+void MFBilinearFormExtension::Assemble()
+{
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "face integrators are not supported by AssemblyLevel::NONE");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleMF(*a->FESpace());
+   }
+}
+
+void MFBilinearFormExtension::AssembleDiagonal(Vector &diag) const
+{
+   MFEM_ABORT("AssembleDiagonal is not supported by the matrix-free action!");
+}
+
+void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   elem_restrict_lex->Mult(x, localX);
+   localY = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultMF(localX, localY);
+   }
+   elem_restrict_lex->MultTranspose(localY, y);
+}
+
+void MFBilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   elem_restrict_lex->Mult(x, localX);
+   localY = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultTransposeMF(localX, localY);
+   }
+   elem_restrict_lex->MultTranspose(localY, y);
 }
 
 } // namespace mfem
@@ -55,46 +55,6 @@ public:
    virtual void Update() = 0;
 };
 
-/// Data and methods for fully-assembled bilinear forms
-class FABilinearFormExtension : public BilinearFormExtension
-{
-public:
-   FABilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
-
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
-   void FormLinearSystem(const Array<int> &ess_tdof_list,
-                         Vector &x, Vector &b,
-                         OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~FABilinearFormExtension() {}
-};
-
-/// Data and methods for element-assembled bilinear forms
-class EABilinearFormExtension : public BilinearFormExtension
-{
-public:
-   EABilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
-
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
-   void FormLinearSystem(const Array<int> &ess_tdof_list,
-                         Vector &x, Vector &b,
-                         OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~EABilinearFormExtension() {}
-};
-
 /// Data and methods for partially-assembled bilinear forms
 class PABilinearFormExtension : public BilinearFormExtension
 {
@@ -102,6 +62,13 @@ protected:
    const FiniteElementSpace *trialFes, *testFes; // Not owned
    mutable Vector localX, localY;
    const Operator *elem_restrict_lex; // Not owned
+   const L2FaceRestriction *int_face_restrict_lex; // Not owned
+   const L2FaceRestriction *bdr_face_restrict_lex; // Not owned
+   mutable Vector int_face_X, int_face_Y, bdr_face_X, bdr_face_Y;
+   mutable MultiVector localXs, localYs;
+
+   /// Add the action of the interior and boundary face integrators to y.
+   void AddMultFaces(const Vector &x, Vector &y, const bool transpose) const;
 
 public:
    PABilinearFormExtension(BilinearForm*);
@@ -117,26 +84,92 @@ public:
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
+
+   /** @brief Apply the operator to all vectors of @a X. The E-vectors of all
+       the vectors are processed together by the domain integrators, see
+       BilinearFormIntegrator::AddMultPAMulti(). */
+   void MultMulti(const MultiVector &X, MultiVector &Y) const;
+};
+
+/// Data and methods for element-assembled bilinear forms
+/** The element matrices of all domain integrators are computed with the same
+    DofToQuad and GeometricFactors data used by PABilinearFormExtension and are
+    stored in one contiguous batched array of size ndofs x ndofs x ne, with the
+    element degrees of freedom in lexicographic order. The action is a batched
+    dense matrix-vector product applied to the E-vectors produced by the
+    ElementRestriction. */
+class EABilinearFormExtension : public PABilinearFormExtension
+{
+protected:
+   int ne;
+   int elemDofs;
+   Vector ea_data;
+
+public:
+   EABilinearFormExtension(BilinearForm *form);
+
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void MultMulti(const MultiVector &X, MultiVector &Y) const
+   { Operator::MultMulti(X, Y); }
+   void Update();
+
+   /// Return the batched element matrices, see AssembleEA().
+   /** The entry (i,j) of the matrix of element e is stored at index
+       i + ndofs*(j + ndofs*e). */
+   const Vector &GetElementMatrices() const { return ea_data; }
+};
+
+/// Data and methods for fully-assembled bilinear forms
+/** The element matrices are computed as in EABilinearFormExtension and are
+    then assembled in parallel directly into the finalized CSR matrix of the
+    BilinearForm, see BilinearForm::SpMat(). The sparsity pattern is computed
+    only once from the ElementRestriction and it is reused when the form is
+    reassembled, e.g. after BilinearForm::Update() without a mesh change. Since
+    the result is a regular SparseMatrix, the methods BilinearForm::
+    FormSystemMatrix(), ParBilinearForm::ParallelAssemble(), etc. use it exactly
+    as in the legacy (element-by-element) full assembly. */
+class FABilinearFormExtension : public EABilinearFormExtension
+{
+public:
+   FABilinearFormExtension(BilinearForm *form);
+
+   /** @brief Return true if the form can be assembled by this class, i.e. it
+       has only domain integrators, a scalar space with an ElementRestriction,
+       and neither static condensation nor hybridization. */
+   /** Otherwise BilinearForm::Assemble() uses the legacy full assembly. */
+   bool SupportsForm() const;
+
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void MultMulti(const MultiVector &X, MultiVector &Y) const;
 };
 
 /// Data and methods for matrix-free bilinear forms
-class MFBilinearFormExtension : public BilinearFormExtension
+/** Only the mesh nodes, as an E-vector, and the coefficient values are stored
+    by the domain integrators, see BilinearFormIntegrator::AssembleMF(). The
+    geometric factors are recomputed at the quadrature points every time the
+    action is applied, trading extra flops for a much smaller memory footprint
+    than PABilinearFormExtension, which stores dim*(dim+1)/2 doubles per point
+    for diffusion. */
+class MFBilinearFormExtension : public PABilinearFormExtension
 {
 public:
-   MFBilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
+   MFBilinearFormExtension(BilinearForm *form);
 
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
-   void FormLinearSystem(const Array<int> &ess_tdof_list,
-                         Vector &x, Vector &b,
-                         OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~MFBilinearFormExtension() {}
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void MultMulti(const MultiVector &X, MultiVector &Y) const
+   { Operator::MultMulti(X, Y); }
 };
 
 }
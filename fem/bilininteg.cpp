@@ -12,6 +12,7 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -26,6 +27,18 @@ void BilinearFormIntegrator::AssemblePA(const FiniteElementSpace&)
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AssemblePAInteriorFaces(const FiniteElementSpace&)
+{
+   MFEM_ABORT("BilinearFormIntegrator::AssemblePAInteriorFaces (...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssemblePABoundaryFaces(const FiniteElementSpace&)
+{
+   MFEM_ABORT("BilinearFormIntegrator::AssemblePABoundaryFaces (...)\n"
+              "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleDiagonalPA(Vector &) const
 {
    MFEM_ABORT("BilinearFormIntegrator::AssembleDiagonalPA (...)\n"
@@ -44,6 +57,85 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAMulti(const int nv, const Vector &x,
+                                            Vector &y) const
+{
+   const int nx = x.Size() / nv, ny = y.Size() / nv;
+   MFEM_VERIFY(nx*nv == x.Size() && ny*nv == y.Size(), "incompatible sizes");
+   Vector xv, yv;
+   for (int v = 0; v < nv; v++)
+   {
+      xv.MakeRef(const_cast<Vector&>(x), v*nx, nx);
+      yv.MakeRef(y, v*ny, ny);
+      AddMultPA(xv, yv);
+   }
+}
+
+template <typename S, typename T>
+static void ConvertPrecision(const int n, const S *x, T *y)
+{
+   MFEM_FORALL(i, n, y[i] = static_cast<T>(x[i]););
+}
+
+void BilinearFormIntegrator::ToSinglePrecision(const Vector &x,
+                                               Array<float> &y)
+{
+   y.SetSize(x.Size(), Device::GetMemoryType());
+   ConvertPrecision(x.Size(), x.Read(), y.Write());
+}
+
+void BilinearFormIntegrator::ToSinglePrecision(const Array<double> &x,
+                                               Array<float> &y)
+{
+   y.SetSize(x.Size(), Device::GetMemoryType());
+   ConvertPrecision(x.Size(), x.Read(), y.Write());
+}
+
+void BilinearFormIntegrator::ToDoublePrecision(const Array<float> &x,
+                                               Vector &y)
+{
+   y.SetSize(x.Size(), Device::GetMemoryType());
+   ConvertPrecision(x.Size(), x.Read(), y.Write());
+}
+
+void BilinearFormIntegrator::AssembleEA(const FiniteElementSpace&, Vector&)
+{
+   MFEM_ABORT("BilinearFormIntegrator::AssembleEA (...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace&)
+{
+   MFEM_ABORT("BilinearFormIntegrator::AssembleMF (...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultMF(const Vector &, Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultMF (...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposeMF(const Vector &, Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultTransposeMF (...)\n"
+              "   is not implemented for this class.");
+}
+
+const DofToQuad &BilinearFormIntegrator::GetMFNodes(
+   const FiniteElementSpace &fes, const IntegrationRule &ir, Vector &enodes)
+{
+   Mesh *mesh = fes.GetMesh();
+   mesh->EnsureNodes();
+   const GridFunction *nodes = mesh->GetNodes();
+   const FiniteElementSpace *nfes = nodes->FESpace();
+   const Operator *restr =
+      nfes->GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   enodes.SetSize(restr->Height(), Device::GetMemoryType());
+   restr->Mult(*nodes, enodes);
+   return nfes->GetFE(0)->GetDofToQuad(ir, DofToQuad::TENSOR);
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
@@ -939,7 +1031,13 @@ void VectorMassIntegrator::AssembleElementMatrix
    double norm;
 
    // If vdim is not set, set it to the space dimension
+#ifdef MFEM_THREAD_SAFE
+   const int vdim = (this->vdim == -1) ? spaceDim : this->vdim;
+   Vector shape, vec;
+   DenseMatrix partelmat, mcoeff;
+#else
    vdim = (vdim == -1) ? spaceDim : vdim;
+#endif
 
    elmat.SetSize(nd*vdim);
    shape.SetSize(nd);
@@ -1021,7 +1119,13 @@ void VectorMassIntegrator::AssembleElementMatrix2(
    double norm;
 
    // If vdim is not set, set it to the space dimension
+#ifdef MFEM_THREAD_SAFE
+   const int vdim = (this->vdim == -1) ? Trans.GetSpaceDim() : this->vdim;
+   Vector shape, te_shape, vec;
+   DenseMatrix partelmat, mcoeff;
+#else
    vdim = (vdim == -1) ? Trans.GetSpaceDim() : vdim;
+#endif
 
    elmat.SetSize(te_nd*vdim, tr_nd*vdim);
    shape.SetSize(tr_nd);
@@ -26,6 +26,13 @@ protected:
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
       : NonlinearFormIntegrator(ir) { }
 
+   /// Copy @a x into the single precision array @a y, on the device.
+   static void ToSinglePrecision(const Vector &x, Array<float> &y);
+   static void ToSinglePrecision(const Array<double> &x, Array<float> &y);
+
+   /// Copy the single precision array @a x into @a y, on the device.
+   static void ToDoublePrecision(const Array<float> &x, Vector &y);
+
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
    // actions.
@@ -34,16 +41,32 @@ public:
    // AssemblePA() can be given as a QuadratureSpace, e.g. using a new method:
    // SetQuadratureSpace().
 
-   // TODO: the methods for the various assembly levels make sense even in the
+   // TODO: the methods for the other assembly levels make sense even in the
    // base class NonlinearFormIntegrator, except that not all assembly levels
    // make sense for the action of the nonlinear operator (but they all make
    // sense for its Jacobian).
 
+   /** @brief Return true if AssembleElementMatrix() can be called
+       concurrently for different elements, see BilinearForm::Assemble(). */
+   /** This requires the integrator to use local work arrays when
+       MFEM_THREAD_SAFE is defined and its coefficients to be thread-safe, see
+       Coefficient::IsThreadSafe(). */
+   virtual bool IsThreadSafe() const { return false; }
+
    /// Method defining partial assembly.
    /** The result of the partial assembly is stored internally so that it can be
        used later in the methods AddMultPA() and AddMultTransposePA(). */
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   /// Method defining partial assembly on the interior faces.
+   /** The result is used by AddMultPA() and AddMultTransposePA(), which then
+       act on face E-vectors, see L2FaceRestriction. */
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   /// Method defining partial assembly on the boundary faces.
+   /** See AssemblePAInteriorFaces(). */
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
    /// Assemble diagonal and add it to Vector @a diag.
    virtual void AssembleDiagonalPA(Vector &diag) const;
 
@@ -65,6 +88,39 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on @a nv vectors.
+   /** The E-vectors @a x and @a y contain @a nv E-vectors each, stored one
+       after the other as in MultiVector. The default implementation calls
+       AddMultPA() for each of them; derived classes can override it to read
+       the partial assembly data once for all the vectors. */
+   virtual void AddMultPAMulti(const int nv, const Vector &x, Vector &y) const;
+
+   /// Method defining element assembly.
+   /** The element matrices are added to the batched array @a emat, which has
+       to be of size ndofs x ndofs x ne, where ndofs is the number of degrees
+       of freedom of one element (in lexicographic order) and ne is the number
+       of elements. The row index corresponds to the test and the column index
+       to the trial degrees of freedom. */
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
+   /// Method defining matrix-free assembly.
+   /** Only the data needed to recompute the action on-the-fly is stored, e.g.
+       the mesh nodes as an E-vector, so that the geometric factors and the
+       coefficient are evaluated at the quadrature points in AddMultMF(). */
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   /// Method for matrix-free action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
+       the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+
+   /// Method for matrix-free transposed action, see AddMultMF().
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -168,6 +224,14 @@ public:
    { return 0.0; }
 
    virtual ~BilinearFormIntegrator() { }
+
+protected:
+   /** @brief Setup helper for matrix-free kernels: compute the mesh nodes of
+       @a fes as a lexicographic E-vector in @a enodes and return the tensor
+       basis of the nodes evaluated at the points of @a ir. */
+   static const DofToQuad &GetMFNodes(const FiniteElementSpace &fes,
+                                      const IntegrationRule &ir,
+                                      Vector &enodes);
 };
 
 class TransposeIntegrator : public BilinearFormIntegrator
@@ -197,6 +261,21 @@ public:
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
 
+   virtual void AssemblePA(const FiniteElementSpace &fes)
+   { bfi->AssemblePA(fes); }
+
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes)
+   { bfi->AssemblePAInteriorFaces(fes); }
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes)
+   { bfi->AssemblePABoundaryFaces(fes); }
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const
+   { bfi->AddMultTransposePA(x, y); }
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const
+   { bfi->AddMultPA(x, y); }
+
    virtual ~TransposeIntegrator() { if (own_bfi) { delete bfi; } }
 };
 
@@ -1681,18 +1760,45 @@ private:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
+   bool single_precision;
+   Array<float> pa_data_sp, B_sp, G_sp, Bt_sp, Gt_sp;
+
+   // MF extension
+   const DofToQuad *maps_nodes;   ///< Not owned
+   const IntegrationRule *mf_ir;  ///< Not owned
+   Vector mf_nodes, mf_coeff;
 
 public:
    /// Construct a diffusion integrator with coefficient Q = 1
-   DiffusionIntegrator() { Q = NULL; MQ = NULL; maps = NULL; geom = NULL; }
+   DiffusionIntegrator()
+   {
+      Q = NULL; MQ = NULL; maps = maps_nodes = NULL; geom = NULL;
+      single_precision = false;
+   }
 
    /// Construct a diffusion integrator with a scalar coefficient q
    DiffusionIntegrator(Coefficient &q)
-      : Q(&q) { MQ = NULL; maps = NULL; geom = NULL; }
+      : Q(&q)
+   {
+      MQ = NULL; maps = maps_nodes = NULL; geom = NULL;
+      single_precision = false;
+   }
 
    /// Construct a diffusion integrator with a matrix coefficient q
    DiffusionIntegrator(MatrixCoefficient &q)
-      : MQ(&q) { Q = NULL; maps = NULL; geom = NULL; }
+      : MQ(&q)
+   {
+      Q = NULL; maps = maps_nodes = NULL; geom = NULL;
+      single_precision = false;
+   }
+
+   /** @brief Store the partial assembly data and the basis matrices in single
+       precision and apply the operator in single precision arithmetic. */
+   /** This halves the memory traffic of AddMultPA(), while the input and output
+       E-vectors are still double precision. It is meant for preconditioners,
+       e.g. inside an IterativeRefinementSolver, and it must be called before
+       AssemblePA(). */
+   void SetSinglePrecisionPA(bool sp = true) { single_precision = sp; }
 
    /** Given a particular Finite Element
        computes the element stiffness matrix elmat. */
@@ -1706,6 +1812,9 @@ public:
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
 
+   virtual bool IsThreadSafe() const
+   { return (!Q || Q->IsThreadSafe()) && (!MQ || MQ->IsThreadSafe()); }
+
    /// Perform the local action of the BilinearFormIntegrator
    virtual void AssembleElementVector(const FiniteElement &el,
                                       ElementTransformation &Tr,
@@ -1726,6 +1835,18 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPAMulti(const int nv, const Vector &x,
+                               Vector &y) const;
+
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 };
@@ -1743,14 +1864,29 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   bool single_precision;
+   Array<float> pa_data_sp, B_sp, Bt_sp;
+
+   // MF extension
+   const DofToQuad *maps_nodes;   ///< Not owned
+   const IntegrationRule *mf_ir;  ///< Not owned
+   Vector mf_nodes, mf_coeff;
 
 public:
    MassIntegrator(const IntegrationRule *ir = NULL)
-      : BilinearFormIntegrator(ir) { Q = NULL; maps = NULL; geom = NULL; }
+      : BilinearFormIntegrator(ir)
+   {
+      Q = NULL; maps = maps_nodes = NULL; geom = NULL;
+      single_precision = false;
+   }
 
    /// Construct a mass integrator with coefficient q
    MassIntegrator(Coefficient &q, const IntegrationRule *ir = NULL)
-      : BilinearFormIntegrator(ir), Q(&q) { maps = NULL; geom = NULL; }
+      : BilinearFormIntegrator(ir), Q(&q)
+   { maps = maps_nodes = NULL; geom = NULL; single_precision = false; }
+
+   /// Use single precision partial assembly, see DiffusionIntegrator.
+   void SetSinglePrecisionPA(bool sp = true) { single_precision = sp; }
 
    /** Given a particular Finite Element
        computes the element mass matrix elmat. */
@@ -1762,12 +1898,26 @@ public:
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
 
+   virtual bool IsThreadSafe() const { return !Q || Q->IsThreadSafe(); }
+
    virtual void AssemblePA(const FiniteElementSpace&);
 
    virtual void AssembleDiagonalPA(Vector &diag) const;
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPAMulti(const int nv, const Vector &x,
+                               Vector &y) const;
+
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -1833,9 +1983,11 @@ class VectorMassIntegrator: public BilinearFormIntegrator
 {
 private:
    int vdim;
+#ifndef MFEM_THREAD_SAFE
    Vector shape, te_shape, vec;
    DenseMatrix partelmat;
    DenseMatrix mcoeff;
+#endif
    int Q_order;
 
 protected:
@@ -1873,6 +2025,12 @@ public:
                                        const FiniteElement &test_fe,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+
+   virtual bool IsThreadSafe() const
+   {
+      return (!Q || Q->IsThreadSafe()) && (!VQ || VQ->IsThreadSafe()) &&
+             (!MQ || MQ->IsThreadSafe());
+   }
 };
 
 
@@ -1992,15 +2150,25 @@ private:
    DenseMatrix vshape, projcurl;
 #endif
 
+   // PA extension
+   const DofToQuad *mapsC;        ///< Not owned. Closed 1D basis.
+   const DofToQuad *mapsO;        ///< Not owned. Open 1D basis.
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 protected:
    Coefficient *Q;
    MatrixCoefficient *MQ;
 
 public:
-   CurlCurlIntegrator() { Q = NULL; MQ = NULL; }
+   CurlCurlIntegrator() : mapsC(NULL), mapsO(NULL), geom(NULL)
+   { Q = NULL; MQ = NULL; }
    /// Construct a bilinear form integrator for Nedelec elements
-   CurlCurlIntegrator(Coefficient &q) : Q(&q) { MQ = NULL; }
-   CurlCurlIntegrator(MatrixCoefficient &m) : MQ(&m) { Q = NULL; }
+   CurlCurlIntegrator(Coefficient &q)
+      : mapsC(NULL), mapsO(NULL), geom(NULL), Q(&q) { MQ = NULL; }
+   CurlCurlIntegrator(MatrixCoefficient &m)
+      : mapsC(NULL), mapsO(NULL), geom(NULL), MQ(&m) { Q = NULL; }
 
    /* Given a particular Finite Element, compute the
       element curl-curl matrix elmat */
@@ -2016,6 +2184,12 @@ public:
    virtual double ComputeFluxEnergy(const FiniteElement &fluxelem,
                                     ElementTransformation &Trans,
                                     Vector &flux, Vector *d_energy = NULL);
+
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalPA(Vector &diag) const;
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
 };
 
 /** Integrator for (curl u, curl v) for FE spaces defined by 'dim' copies of a
@@ -2050,7 +2224,7 @@ class VectorFEMassIntegrator: public BilinearFormIntegrator
 {
 private:
    void Init(Coefficient *q, VectorCoefficient *vq, MatrixCoefficient *mq)
-   { Q = q; VQ = vq; MQ = mq; }
+   { Q = q; VQ = vq; MQ = mq; mapsC = mapsO = NULL; geom = NULL; }
 
 #ifndef MFEM_THREAD_SAFE
    Vector shape;
@@ -2060,6 +2234,14 @@ private:
    DenseMatrix trial_vshape;
 #endif
 
+   // PA extension
+   const DofToQuad *mapsC;        ///< Not owned. Closed 1D basis.
+   const DofToQuad *mapsO;        ///< Not owned. Open 1D basis.
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   bool hdiv; ///< Raviart-Thomas (true) or Nedelec (false) elements
+   Vector pa_data;
+
 protected:
    Coefficient *Q;
    VectorCoefficient *VQ;
@@ -2081,6 +2263,12 @@ public:
                                        const FiniteElement &test_fe,
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
+
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalPA(Vector &diag) const;
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
 };
 
 /** Integrator for (Q div u, p) where u=(v1,...,vn) and all vi are in the same
@@ -2119,13 +2307,27 @@ private:
    Vector divshape;
 #endif
 
+   // PA extension
+   const DofToQuad *mapsC;        ///< Not owned. Closed 1D basis.
+   const DofToQuad *mapsO;        ///< Not owned. Open 1D basis.
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 public:
-   DivDivIntegrator() { Q = NULL; }
-   DivDivIntegrator(Coefficient &q) : Q(&q) { }
+   DivDivIntegrator() : Q(NULL), mapsC(NULL), mapsO(NULL), geom(NULL) { }
+   DivDivIntegrator(Coefficient &q)
+      : Q(&q), mapsC(NULL), mapsO(NULL), geom(NULL) { }
 
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
                                       DenseMatrix &elmat);
+
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalPA(Vector &diag) const;
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
 };
 
 /** Integrator for
@@ -2145,9 +2347,16 @@ private:
    DenseMatrix gshape;
    DenseMatrix pelmat;
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, vdim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 public:
-   VectorDiffusionIntegrator() { Q = NULL; }
-   VectorDiffusionIntegrator(Coefficient &q) { Q = &q; }
+   VectorDiffusionIntegrator() { Q = NULL; maps = NULL; geom = NULL; }
+   VectorDiffusionIntegrator(Coefficient &q)
+   { Q = &q; maps = NULL; geom = NULL; }
 
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -2155,6 +2364,12 @@ public:
    virtual void AssembleElementVector(const FiniteElement &el,
                                       ElementTransformation &Tr,
                                       const Vector &elfun, Vector &elvect);
+
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalPA(Vector &diag) const;
+
+   virtual void AddMultPA(const Vector&, Vector&) const;
 };
 
 /** Integrator for the linear elasticity form:
@@ -2175,18 +2390,36 @@ private:
    Vector divshape;
 #endif
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 public:
    ElasticityIntegrator(Coefficient &l, Coefficient &m)
-   { lambda = &l; mu = &m; }
+   { lambda = &l; mu = &m; maps = NULL; geom = NULL; }
    /** With this constructor lambda = q_l * m and mu = q_m * m;
        if dim * q_l + 2 * q_m = 0 then trace(sigma) = 0. */
    ElasticityIntegrator(Coefficient &m, double q_l, double q_m)
-   { lambda = NULL; mu = &m; q_lambda = q_l; q_mu = q_m; }
+   {
+      lambda = NULL; mu = &m; q_lambda = q_l; q_mu = q_m;
+      maps = NULL; geom = NULL;
+   }
 
    virtual void AssembleElementMatrix(const FiniteElement &,
                                       ElementTransformation &,
                                       DenseMatrix &);
 
+   /** The partial assembly data at each quadrature point consists of the
+       inverse Jacobian (dim x dim) followed by lambda and mu, both scaled by
+       the quadrature weight and det(J). */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalPA(Vector &diag) const;
+
+   virtual void AddMultPA(const Vector&, Vector&) const;
+
    /** Compute the stress corresponding to the local displacement @a u and
        interpolate it at the nodes of the given @a fluxelem. Only the symmetric
        part of the stress is stored, so that the size of @a flux is equal to
@@ -2233,6 +2466,13 @@ protected:
 private:
    Vector shape1, shape2;
 
+   // PA extension
+   DofToQuad maps;      ///< 1D basis at the 1D face quadrature points
+   int dim, nf, nsides, dofs1D, quad1D;
+   Vector pa_data;
+
+   void SetupPA(const FiniteElementSpace &fes, FaceType type);
+
 public:
    /// Construct integrator with rho = 1.
    DGTraceIntegrator(VectorCoefficient &_u, double a, double b)
@@ -2247,6 +2487,14 @@ public:
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
+
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 };
 
 /** Integrator for the DG form:
@@ -2272,6 +2520,13 @@ protected:
    Vector shape1, shape2, dshape1dn, dshape2dn, nor, nh, ni;
    DenseMatrix jmat, dshape1, dshape2, mq, adjJ;
 
+   // PA extension
+   DofToQuad maps;      ///< 1D basis at the 1D face quadrature points
+   int dim, nf, nsides, dofs1D, quad1D;
+   Vector pa_data;
+
+   void SetupPA(const FiniteElementSpace &fes, FaceType type);
+
 public:
    DGDiffusionIntegrator(const double s, const double k)
       : Q(NULL), MQ(NULL), sigma(s), kappa(k) { }
@@ -2284,6 +2539,14 @@ public:
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
+
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 };
 
 /** Integrator for the DG elasticity form, for the formulations see:
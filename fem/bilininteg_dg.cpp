@@ -0,0 +1,654 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA DG Face Integrators
+//
+// The face E-vectors are produced by L2FaceRestriction: for every face side
+// they contain the trace of the element on the face and its reference normal
+// derivative at the face dofs, with layout (face dof, component, side, face).
+// The face dofs are ordered lexicographically in the reference coordinates of
+// the face, so that both sides of an interior face share the same face dofs.
+
+// Compute the 1D basis (and its derivatives) at the 1D face quadrature points.
+static void PADGFaceMaps(const FiniteElement &fe, const IntegrationRule &ir,
+                         const int dim, DofToQuad &maps)
+{
+   const TensorBasisElement *tfe = dynamic_cast<const TensorBasisElement*>(&fe);
+   MFEM_VERIFY(tfe, "only tensor-product elements are supported");
+   const Poly_1D::Basis &basis1d = tfe->GetBasis1D();
+   const int D1D = fe.GetOrder() + 1;
+   const int NQ = ir.GetNPoints();
+   const int Q1D = (dim == 2) ? NQ : static_cast<int>(sqrt(NQ) + 0.5);
+   MFEM_VERIFY(Q1D*((dim == 2) ? 1 : Q1D) == NQ,
+               "only tensor-product face rules are supported");
+   MFEM_VERIFY(D1D <= MAX_D1D && Q1D <= MAX_Q1D, "order is too high");
+
+   Vector val(D1D), der(D1D);
+   maps.FE = &fe;
+   maps.IntRule = &ir;
+   maps.mode = DofToQuad::TENSOR;
+   maps.ndof = D1D;
+   maps.nqpt = Q1D;
+   maps.B.SetSize(Q1D*D1D, Device::GetMemoryType());
+   maps.Bt.SetSize(D1D*Q1D, Device::GetMemoryType());
+   maps.G.SetSize(Q1D*D1D, Device::GetMemoryType());
+   maps.Gt.SetSize(D1D*Q1D, Device::GetMemoryType());
+   auto B = maps.B.HostWrite();
+   auto Bt = maps.Bt.HostWrite();
+   auto G = maps.G.HostWrite();
+   auto Gt = maps.Gt.HostWrite();
+   for (int q = 0; q < Q1D; q++)
+   {
+      // the first Q1D points of the face rule have distinct x coordinates
+      basis1d.Eval(ir.IntPoint(q).x, val, der);
+      for (int d = 0; d < D1D; d++)
+      {
+         B[q + Q1D*d] = Bt[d + D1D*q] = val(d);
+         G[q + Q1D*d] = Gt[d + D1D*q] = der(d);
+      }
+   }
+}
+
+// PA DG Trace Apply 2D kernel
+static void PADGTraceApply2D(const int NF,
+                             const int NS,
+                             const bool transpose,
+                             const int D1D,
+                             const int Q1D,
+                             const Array<double> &b,
+                             const Vector &_op,
+                             const Vector &_x,
+                             Vector &_y)
+{
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, NS, NF);
+   auto x = Reshape(_x.Read(), D1D, 2, NS, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, 2, NS, NF);
+   MFEM_FORALL(f, NF,
+   {
+      double u[2][MAX_Q1D];
+      for (int s = 0; s < NS; s++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            u[s][q] = 0.0;
+            for (int k = 0; k < D1D; k++)
+            {
+               u[s][q] += B(q,k) * x(k,0,s,f);
+            }
+         }
+      }
+      for (int q = 0; q < Q1D; q++)
+      {
+         const double w1 = op(q,0,f);
+         if (NS == 1)
+         {
+            u[0][q] *= w1;
+            continue;
+         }
+         const double w2 = op(q,1,f);
+         const double u0 = u[0][q];
+         const double u1 = u[1][q];
+         u[0][q] = transpose ? w1*(u0 - u1) : w1*u0 - w2*u1;
+         u[1][q] = transpose ? w2*(u1 - u0) : w2*u1 - w1*u0;
+      }
+      for (int s = 0; s < NS; s++)
+      {
+         for (int k = 0; k < D1D; k++)
+         {
+            double r = 0.0;
+            for (int q = 0; q < Q1D; q++)
+            {
+               r += B(q,k) * u[s][q];
+            }
+            y(k,0,s,f) += r;
+         }
+      }
+   });
+}
+
+// PA DG Trace Apply 3D kernel
+static void PADGTraceApply3D(const int NF,
+                             const int NS,
+                             const bool transpose,
+                             const int D1D,
+                             const int Q1D,
+                             const Array<double> &b,
+                             const Vector &_op,
+                             const Vector &_x,
+                             Vector &_y)
+{
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, NS, NF);
+   auto x = Reshape(_x.Read(), D1D, D1D, 2, NS, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, 2, NS, NF);
+   MFEM_FORALL(f, NF,
+   {
+      double u[2][MAX_Q1D][MAX_Q1D];
+      double t[MAX_Q1D][MAX_D1D];
+      for (int s = 0; s < NS; s++)
+      {
+         for (int ky = 0; ky < D1D; ky++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               t[qx][ky] = 0.0;
+               for (int kx = 0; kx < D1D; kx++)
+               {
+                  t[qx][ky] += B(qx,kx) * x(kx,ky,0,s,f);
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               u[s][qy][qx] = 0.0;
+               for (int ky = 0; ky < D1D; ky++)
+               {
+                  u[s][qy][qx] += B(qy,ky) * t[qx][ky];
+               }
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; qy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            const double w1 = op(qx,qy,0,f);
+            if (NS == 1)
+            {
+               u[0][qy][qx] *= w1;
+               continue;
+            }
+            const double w2 = op(qx,qy,1,f);
+            const double u0 = u[0][qy][qx];
+            const double u1 = u[1][qy][qx];
+            u[0][qy][qx] = transpose ? w1*(u0 - u1) : w1*u0 - w2*u1;
+            u[1][qy][qx] = transpose ? w2*(u1 - u0) : w2*u1 - w1*u0;
+         }
+      }
+      for (int s = 0; s < NS; s++)
+      {
+         for (int ky = 0; ky < D1D; ky++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               t[qx][ky] = 0.0;
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  t[qx][ky] += B(qy,ky) * u[s][qy][qx];
+               }
+            }
+         }
+         for (int ky = 0; ky < D1D; ky++)
+         {
+            for (int kx = 0; kx < D1D; kx++)
+            {
+               double r = 0.0;
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  r += B(qx,kx) * t[qx][ky];
+               }
+               y(kx,ky,0,s,f) += r;
+            }
+         }
+      }
+   });
+}
+
+static void PADGTraceApply(const int dim,
+                           const int NF,
+                           const int NS,
+                           const bool transpose,
+                           const DofToQuad &maps,
+                           const Vector &op,
+                           const Vector &x,
+                           Vector &y)
+{
+   if (NF == 0) { return; }
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   if (dim == 2)
+   {
+      return PADGTraceApply2D(NF, NS, transpose, D1D, Q1D, maps.B, op, x, y);
+   }
+   if (dim == 3)
+   {
+      return PADGTraceApply3D(NF, NS, transpose, D1D, Q1D, maps.B, op, x, y);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DGTraceIntegrator::SetupPA(const FiniteElementSpace &fes, FaceType type)
+{
+   const Array<int> &faces = fes.GetFaceRestriction(type)->GetFaces();
+   nf = faces.Size();
+   nsides = (type == FaceType::Interior) ? 2 : 1;
+   if (nf == 0) { return; }
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleFaceMatrix(), assuming that the mesh and the
+      // space use the same order on all elements
+      FaceElementTransformations *T =
+         mesh->GetFaceElementTransformations(faces[0]);
+      const int order = T->Elem1->OrderW() + 2*el.GetOrder();
+      ir = &IntRules.Get(T->FaceGeom, order);
+   }
+   PADGFaceMaps(el, *ir, dim, maps);
+   dofs1D = maps.ndof;
+   quad1D = maps.nqpt;
+
+   // Store w1 = W*(a+b) and, on interior faces, w2 = W*(b-a) where
+   // a = rho*alpha*(u.n)/2 and b = rho*beta*|u.n|, see AssembleFaceMatrix().
+   const int NQ = ir->GetNPoints();
+   pa_data.SetSize(NQ*nsides*nf, Device::GetMemoryType());
+   auto op = Reshape(pa_data.HostWrite(), NQ, nsides, nf);
+   Vector vu(dim), nor(dim);
+   for (int f = 0; f < nf; f++)
+   {
+      FaceElementTransformations &T =
+         *mesh->GetFaceElementTransformations(faces[f]);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         IntegrationPoint eip1, eip2;
+         T.Loc1.Transform(ip, eip1);
+         T.Face->SetIntPoint(&ip);
+         T.Elem1->SetIntPoint(&eip1);
+         u->Eval(vu, *T.Elem1, eip1);
+         CalcOrtho(T.Face->Jacobian(), nor);
+         const double un = vu * nor;
+         double a = 0.5 * alpha * un;
+         double b = beta * fabs(un);
+         if (rho)
+         {
+            double rho_p;
+            if (un >= 0.0 && nsides == 2)
+            {
+               T.Loc2.Transform(ip, eip2);
+               T.Elem2->SetIntPoint(&eip2);
+               rho_p = rho->Eval(*T.Elem2, eip2);
+            }
+            else
+            {
+               rho_p = rho->Eval(*T.Elem1, eip1);
+            }
+            a *= rho_p;
+            b *= rho_p;
+         }
+         op(q,0,f) = ip.weight * (a + b);
+         if (nsides == 2) { op(q,1,f) = ip.weight * (b - a); }
+      }
+   }
+}
+
+void DGTraceIntegrator::AssemblePAInteriorFaces(const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGTraceIntegrator::AssemblePABoundaryFaces(const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+void DGTraceIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   PADGTraceApply(dim, nf, nsides, false, maps, pa_data, x, y);
+}
+
+void DGTraceIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
+{
+   PADGTraceApply(dim, nf, nsides, true, maps, pa_data, x, y);
+}
+
+// PA DG Diffusion Integrator
+//
+// With the gradient g of a side expressed in the (face, normal line)
+// coordinates of the E-vector, the flux term of AssembleFaceMatrix() at a
+// quadrature point is F = sum_s c_s.g_s, where c_s is stored in the pa_data.
+// The jump term uses the stored coefficient wq = kappa {h^{-1} Q}.
+
+// PA DG Diffusion Apply 2D kernel
+static void PADGDiffusionApply2D(const int NF,
+                                 const int NS,
+                                 const bool transpose,
+                                 const double sigma,
+                                 const int D1D,
+                                 const int Q1D,
+                                 const Array<double> &b,
+                                 const Array<double> &g,
+                                 const Vector &_op,
+                                 const Vector &_x,
+                                 Vector &_y)
+{
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, 2*NS + 1, NF);
+   auto x = Reshape(_x.Read(), D1D, 2, NS, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, 2, NS, NF);
+   MFEM_FORALL(f, NF,
+   {
+      double u[2][MAX_Q1D];
+      double du[2][2][MAX_Q1D];
+      for (int s = 0; s < NS; s++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            u[s][q] = du[s][0][q] = du[s][1][q] = 0.0;
+            for (int k = 0; k < D1D; k++)
+            {
+               u[s][q] += B(q,k) * x(k,0,s,f);
+               du[s][0][q] += G(q,k) * x(k,0,s,f);
+               du[s][1][q] += B(q,k) * x(k,1,s,f);
+            }
+         }
+      }
+      for (int q = 0; q < Q1D; q++)
+      {
+         double F = 0.0;
+         for (int s = 0; s < NS; s++)
+         {
+            F += op(q,2*s,f) * du[s][0][q] + op(q,2*s+1,f) * du[s][1][q];
+         }
+         const double jmp = (NS == 2) ? u[0][q] - u[1][q] : u[0][q];
+         const double wq = op(q,2*NS,f);
+         const double val = (transpose ? sigma*F : -F) + wq*jmp;
+         const double dc = transpose ? -jmp : sigma*jmp;
+         for (int s = 0; s < NS; s++)
+         {
+            u[s][q] = (s == 0) ? val : -val;
+            du[s][0][q] = dc * op(q,2*s,f);
+            du[s][1][q] = dc * op(q,2*s+1,f);
+         }
+      }
+      for (int s = 0; s < NS; s++)
+      {
+         for (int k = 0; k < D1D; k++)
+         {
+            double r = 0.0, t = 0.0;
+            for (int q = 0; q < Q1D; q++)
+            {
+               r += B(q,k) * u[s][q] + G(q,k) * du[s][0][q];
+               t += B(q,k) * du[s][1][q];
+            }
+            y(k,0,s,f) += r;
+            y(k,1,s,f) += t;
+         }
+      }
+   });
+}
+
+// PA DG Diffusion Apply 3D kernel
+static void PADGDiffusionApply3D(const int NF,
+                                 const int NS,
+                                 const bool transpose,
+                                 const double sigma,
+                                 const int D1D,
+                                 const int Q1D,
+                                 const Array<double> &b,
+                                 const Array<double> &g,
+                                 const Vector &_op,
+                                 const Vector &_x,
+                                 Vector &_y)
+{
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 3*NS + 1, NF);
+   auto x = Reshape(_x.Read(), D1D, D1D, 2, NS, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, 2, NS, NF);
+   MFEM_FORALL(f, NF,
+   {
+      double u[2][MAX_Q1D][MAX_Q1D];
+      double du[2][3][MAX_Q1D][MAX_Q1D];
+      double Bv[MAX_Q1D][MAX_D1D], Gv[MAX_Q1D][MAX_D1D], Bw[MAX_Q1D][MAX_D1D];
+      for (int s = 0; s < NS; s++)
+      {
+         for (int ky = 0; ky < D1D; ky++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               Bv[qx][ky] = Gv[qx][ky] = Bw[qx][ky] = 0.0;
+               for (int kx = 0; kx < D1D; kx++)
+               {
+                  Bv[qx][ky] += B(qx,kx) * x(kx,ky,0,s,f);
+                  Gv[qx][ky] += G(qx,kx) * x(kx,ky,0,s,f);
+                  Bw[qx][ky] += B(qx,kx) * x(kx,ky,1,s,f);
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               double uq = 0.0, d0 = 0.0, d1 = 0.0, d2 = 0.0;
+               for (int ky = 0; ky < D1D; ky++)
+               {
+                  uq += B(qy,ky) * Bv[qx][ky];
+                  d0 += B(qy,ky) * Gv[qx][ky];
+                  d1 += G(qy,ky) * Bv[qx][ky];
+                  d2 += B(qy,ky) * Bw[qx][ky];
+               }
+               u[s][qy][qx] = uq;
+               du[s][0][qy][qx] = d0;
+               du[s][1][qy][qx] = d1;
+               du[s][2][qy][qx] = d2;
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; qy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            double F = 0.0;
+            for (int s = 0; s < NS; s++)
+            {
+               for (int c = 0; c < 3; c++)
+               {
+                  F += op(qx,qy,3*s+c,f) * du[s][c][qy][qx];
+               }
+            }
+            const double jmp = (NS == 2) ?
+                               u[0][qy][qx] - u[1][qy][qx] : u[0][qy][qx];
+            const double wq = op(qx,qy,3*NS,f);
+            const double val = (transpose ? sigma*F : -F) + wq*jmp;
+            const double dc = transpose ? -jmp : sigma*jmp;
+            for (int s = 0; s < NS; s++)
+            {
+               u[s][qy][qx] = (s == 0) ? val : -val;
+               for (int c = 0; c < 3; c++)
+               {
+                  du[s][c][qy][qx] = dc * op(qx,qy,3*s+c,f);
+               }
+            }
+         }
+      }
+      for (int s = 0; s < NS; s++)
+      {
+         // Bv, Gv and Bw are reused for the contractions in y
+         for (int ky = 0; ky < D1D; ky++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               double a = 0.0, b = 0.0, c = 0.0;
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  a += B(qy,ky) * u[s][qy][qx] + G(qy,ky) * du[s][1][qy][qx];
+                  b += B(qy,ky) * du[s][0][qy][qx];
+                  c += B(qy,ky) * du[s][2][qy][qx];
+               }
+               Bv[qx][ky] = a;
+               Gv[qx][ky] = b;
+               Bw[qx][ky] = c;
+            }
+         }
+         for (int ky = 0; ky < D1D; ky++)
+         {
+            for (int kx = 0; kx < D1D; kx++)
+            {
+               double r = 0.0, t = 0.0;
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  r += B(qx,kx) * Bv[qx][ky] + G(qx,kx) * Gv[qx][ky];
+                  t += B(qx,kx) * Bw[qx][ky];
+               }
+               y(kx,ky,0,s,f) += r;
+               y(kx,ky,1,s,f) += t;
+            }
+         }
+      }
+   });
+}
+
+static void PADGDiffusionApply(const int dim,
+                               const int NF,
+                               const int NS,
+                               const bool transpose,
+                               const double sigma,
+                               const DofToQuad &maps,
+                               const Vector &op,
+                               const Vector &x,
+                               Vector &y)
+{
+   if (NF == 0) { return; }
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   if (dim == 2)
+   {
+      return PADGDiffusionApply2D(NF, NS, transpose, sigma, D1D, Q1D,
+                                  maps.B, maps.G, op, x, y);
+   }
+   if (dim == 3)
+   {
+      return PADGDiffusionApply3D(NF, NS, transpose, sigma, D1D, Q1D,
+                                  maps.B, maps.G, op, x, y);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DGDiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
+                                    FaceType type)
+{
+   MFEM_VERIFY(MQ == NULL, "PA: only scalar coefficients are supported");
+   const Array<int> &faces = fes.GetFaceRestriction(type)->GetFaces();
+   nf = faces.Size();
+   nsides = (type == FaceType::Interior) ? 2 : 1;
+   if (nf == 0) { return; }
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleFaceMatrix()
+      const Geometry::Type face_geom = mesh->GetFaceBaseGeometry(faces[0]);
+      ir = &IntRules.Get(face_geom, 2*el.GetOrder());
+   }
+   PADGFaceMaps(el, *ir, dim, maps);
+   dofs1D = maps.ndof;
+   quad1D = maps.nqpt;
+
+   const int NQ = ir->GetNPoints();
+   const int nc = nsides*dim + 1;
+   pa_data.SetSize(NQ*nc*nf, Device::GetMemoryType());
+   auto op = Reshape(pa_data.HostWrite(), NQ, nc, nf);
+   Vector nor(dim), c(dim);
+   DenseMatrix M(dim), JM(dim), JMinv(dim);
+   for (int f = 0; f < nf; f++)
+   {
+      FaceElementTransformations &T =
+         *mesh->GetFaceElementTransformations(faces[f]);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         T.Face->SetIntPoint(&ip);
+         CalcOrtho(T.Face->Jacobian(), nor);
+         double wq = 0.0;
+         for (int s = 0; s < nsides; s++)
+         {
+            IntegrationPointTransformation &loc = (s == 0) ? T.Loc1 : T.Loc2;
+            ElementTransformation &Te = (s == 0) ? *T.Elem1 : *T.Elem2;
+            IntegrationPoint eip;
+            loc.Transform(ip, eip);
+            Te.SetIntPoint(&eip);
+            double w = ip.weight;
+            if (nsides == 2) { w /= 2; }
+            if (Q) { w *= Q->Eval(Te, eip); }
+            wq += w / Te.Weight() * (nor * nor);
+
+            // M is the Jacobian of the map from the (face, normal line)
+            // coordinates to the reference coordinates of the element: its
+            // first columns come from the face-to-element map and the last one
+            // is the reference direction normal to the face, pointing inward.
+            loc.Transf.SetIntPoint(&ip);
+            const DenseMatrix &locJ = loc.Transf.Jacobian();
+            const double ecoord[3] = { eip.x, eip.y, eip.z };
+            M = 0.0;
+            for (int d = 0; d < dim; d++)
+            {
+               double row = 0.0;
+               for (int j = 0; j < dim-1; j++)
+               {
+                  M(d,j) = locJ(d,j);
+                  row += fabs(locJ(d,j));
+               }
+               if (row < 1e-12) { M(d,dim-1) = (ecoord[d] < 0.5) ? 1.0 : -1.0; }
+            }
+            Mult(Te.Jacobian(), M, JM);
+            CalcInverse(JM, JMinv);
+            JMinv.Mult(nor, c);
+            for (int d = 0; d < dim; d++)
+            {
+               op(q,s*dim+d,f) = w * c(d);
+            }
+         }
+         op(q,nsides*dim,f) = kappa * wq;
+      }
+   }
+}
+
+void DGDiffusionIntegrator::AssemblePAInteriorFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGDiffusionIntegrator::AssemblePABoundaryFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+void DGDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   PADGDiffusionApply(dim, nf, nsides, false, sigma, maps, pa_data, x, y);
+}
+
+void DGDiffusionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
+{
+   PADGDiffusionApply(dim, nf, nsides, true, sigma, maps, pa_data, x, y);
+}
+
+} // namespace mfem
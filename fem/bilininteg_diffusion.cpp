@@ -227,19 +227,19 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalBatched(*fes.GetMesh(), *ir, coeff);
    }
    PADiffusionSetup(dim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J, coeff,
                     pa_data);
+   if (single_precision)
+   {
+      ToSinglePrecision(pa_data, pa_data_sp);
+      ToSinglePrecision(maps->B, B_sp);
+      ToSinglePrecision(maps->G, G_sp);
+      ToSinglePrecision(maps->Bt, Bt_sp);
+      ToSinglePrecision(maps->Gt, Gt_sp);
+      pa_data.Destroy();
+   }
 }
 
 
@@ -660,6 +660,14 @@ static void PADiffusionAssembleDiagonal(const int dim,
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag) const
 {
+   if (single_precision)
+   {
+      Vector pa_data_dp;
+      ToDoublePrecision(pa_data_sp, pa_data_dp);
+      PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
+                                  maps->B, maps->G, pa_data_dp, diag);
+      return;
+   }
    PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
                                maps->B, maps->G, pa_data, diag);
 }
@@ -766,17 +774,19 @@ static void OccaPADiffusionApply3D(const int D1D,
 #endif // MFEM_USE_OCCA
 
 // PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double,
+         typename PA_T = Vector>
 static void PADiffusionApply2D(const int NE,
-                               const Array<double> &b_,
-                               const Array<double> &g_,
-                               const Array<double> &bt_,
-                               const Array<double> &gt_,
-                               const Vector &d_,
+                               const Array<T> &b_,
+                               const Array<T> &g_,
+                               const Array<T> &bt_,
+                               const Array<T> &gt_,
+                               const PA_T &d_,
                                const Vector &x_,
                                Vector &y_,
                                const int d1d = 0,
-                               const int q1d = 0)
+                               const int q1d = 0,
+                               const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -787,17 +797,20 @@ static void PADiffusionApply2D(const int NE,
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto Gt = Reshape(gt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   auto X = Reshape(x_.Read(), D1D, D1D, NE*nv);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE*nv);
+   MFEM_FORALL(ev, NE*nv,
    {
+      // All the vectors of an element reuse its data
+      const int e = ev / nv;
+      const int xe = e + (ev % nv)*NE;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
 
-      double grad[max_Q1D][max_Q1D][2];
+      T grad[max_Q1D][max_Q1D][2];
       for (int qy = 0; qy < Q1D; ++qy)
       {
          for (int qx = 0; qx < Q1D; ++qx)
@@ -808,7 +821,7 @@ static void PADiffusionApply2D(const int NE,
       }
       for (int dy = 0; dy < D1D; ++dy)
       {
-         double gradX[max_Q1D][2];
+         T gradX[max_Q1D][2];
          for (int qx = 0; qx < Q1D; ++qx)
          {
             gradX[qx][0] = 0.0;
@@ -816,7 +829,7 @@ static void PADiffusionApply2D(const int NE,
          }
          for (int dx = 0; dx < D1D; ++dx)
          {
-            const double s = X(dx,dy,e);
+            const T s = X(dx,dy,xe);
             for (int qx = 0; qx < Q1D; ++qx)
             {
                gradX[qx][0] += s * B(qx,dx);
@@ -825,8 +838,8 @@ static void PADiffusionApply2D(const int NE,
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            const double wy  = B(qy,dy);
-            const double wDy = G(qy,dy);
+            const T wy  = B(qy,dy);
+            const T wDy = G(qy,dy);
             for (int qx = 0; qx < Q1D; ++qx)
             {
                grad[qy][qx][0] += gradX[qx][1] * wy;
@@ -841,12 +854,12 @@ static void PADiffusionApply2D(const int NE,
          {
             const int q = qx + qy * Q1D;
 
-            const double O11 = D(q,0,e);
-            const double O12 = D(q,1,e);
-            const double O22 = D(q,2,e);
+            const T O11 = D(q,0,e);
+            const T O12 = D(q,1,e);
+            const T O22 = D(q,2,e);
 
-            const double gradX = grad[qy][qx][0];
-            const double gradY = grad[qy][qx][1];
+            const T gradX = grad[qy][qx][0];
+            const T gradY = grad[qy][qx][1];
 
             grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
             grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
@@ -854,7 +867,7 @@ static void PADiffusionApply2D(const int NE,
       }
       for (int qy = 0; qy < Q1D; ++qy)
       {
-         double gradX[max_D1D][2];
+         T gradX[max_D1D][2];
          for (int dx = 0; dx < D1D; ++dx)
          {
             gradX[dx][0] = 0;
@@ -862,23 +875,23 @@ static void PADiffusionApply2D(const int NE,
          }
          for (int qx = 0; qx < Q1D; ++qx)
          {
-            const double gX = grad[qy][qx][0];
-            const double gY = grad[qy][qx][1];
+            const T gX = grad[qy][qx][0];
+            const T gY = grad[qy][qx][1];
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double wx  = Bt(dx,qx);
-               const double wDx = Gt(dx,qx);
+               const T wx  = Bt(dx,qx);
+               const T wDx = Gt(dx,qx);
                gradX[dx][0] += gX * wDx;
                gradX[dx][1] += gY * wx;
             }
          }
          for (int dy = 0; dy < D1D; ++dy)
          {
-            const double wy  = Bt(dy,qy);
-            const double wDy = Gt(dy,qy);
+            const T wy  = Bt(dy,qy);
+            const T wDy = Gt(dy,qy);
             for (int dx = 0; dx < D1D; ++dx)
             {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               Y(dx,dy,xe) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
             }
          }
       }
@@ -1044,16 +1057,18 @@ static void SmemPADiffusionApply2D(const int NE,
 }
 
 // PA Diffusion Apply 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double,
+         typename PA_T = Vector>
 static void PADiffusionApply3D(const int NE,
-                               const Array<double> &b,
-                               const Array<double> &g,
-                               const Array<double> &bt,
-                               const Array<double> &gt,
-                               const Vector &d_,
+                               const Array<T> &b,
+                               const Array<T> &g,
+                               const Array<T> &bt,
+                               const Array<T> &gt,
+                               const PA_T &d_,
                                const Vector &x_,
                                Vector &y_,
-                               int d1d = 0, int q1d = 0)
+                               int d1d = 0, int q1d = 0,
+                               const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1064,15 +1079,18 @@ static void PADiffusionApply3D(const int NE,
    auto Bt = Reshape(bt.Read(), D1D, Q1D);
    auto Gt = Reshape(gt.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE*nv);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE*nv);
+   MFEM_FORALL(ev, NE*nv,
    {
+      // All the vectors of an element reuse its data
+      const int e = ev / nv;
+      const int xe = e + (ev % nv)*NE;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double grad[max_Q1D][max_Q1D][max_Q1D][3];
+      T grad[max_Q1D][max_Q1D][max_Q1D][3];
       for (int qz = 0; qz < Q1D; ++qz)
       {
          for (int qy = 0; qy < Q1D; ++qy)
@@ -1087,7 +1105,7 @@ static void PADiffusionApply3D(const int NE,
       }
       for (int dz = 0; dz < D1D; ++dz)
       {
-         double gradXY[max_Q1D][max_Q1D][3];
+         T gradXY[max_Q1D][max_Q1D][3];
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
@@ -1099,7 +1117,7 @@ static void PADiffusionApply3D(const int NE,
          }
          for (int dy = 0; dy < D1D; ++dy)
          {
-            double gradX[max_Q1D][2];
+            T gradX[max_Q1D][2];
             for (int qx = 0; qx < Q1D; ++qx)
             {
                gradX[qx][0] = 0.0;
@@ -1107,7 +1125,7 @@ static void PADiffusionApply3D(const int NE,
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double s = X(dx,dy,dz,e);
+               const T s = X(dx,dy,dz,xe);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   gradX[qx][0] += s * B(qx,dx);
@@ -1116,12 +1134,12 @@ static void PADiffusionApply3D(const int NE,
             }
             for (int qy = 0; qy < Q1D; ++qy)
             {
-               const double wy  = B(qy,dy);
-               const double wDy = G(qy,dy);
+               const T wy  = B(qy,dy);
+               const T wDy = G(qy,dy);
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  const double wx  = gradX[qx][0];
-                  const double wDx = gradX[qx][1];
+                  const T wx  = gradX[qx][0];
+                  const T wDx = gradX[qx][1];
                   gradXY[qy][qx][0] += wDx * wy;
                   gradXY[qy][qx][1] += wx  * wDy;
                   gradXY[qy][qx][2] += wx  * wy;
@@ -1130,8 +1148,8 @@ static void PADiffusionApply3D(const int NE,
          }
          for (int qz = 0; qz < Q1D; ++qz)
          {
-            const double wz  = B(qz,dz);
-            const double wDz = G(qz,dz);
+            const T wz  = B(qz,dz);
+            const T wDz = G(qz,dz);
             for (int qy = 0; qy < Q1D; ++qy)
             {
                for (int qx = 0; qx < Q1D; ++qx)
@@ -1151,15 +1169,15 @@ static void PADiffusionApply3D(const int NE,
             for (int qx = 0; qx < Q1D; ++qx)
             {
                const int q = qx + (qy + qz * Q1D) * Q1D;
-               const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O13 = D(q,2,e);
-               const double O22 = D(q,3,e);
-               const double O23 = D(q,4,e);
-               const double O33 = D(q,5,e);
-               const double gradX = grad[qz][qy][qx][0];
-               const double gradY = grad[qz][qy][qx][1];
-               const double gradZ = grad[qz][qy][qx][2];
+               const T O11 = D(q,0,e);
+               const T O12 = D(q,1,e);
+               const T O13 = D(q,2,e);
+               const T O22 = D(q,3,e);
+               const T O23 = D(q,4,e);
+               const T O33 = D(q,5,e);
+               const T gradX = grad[qz][qy][qx][0];
+               const T gradY = grad[qz][qy][qx][1];
+               const T gradZ = grad[qz][qy][qx][2];
                grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
                grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
                grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
@@ -1168,7 +1186,7 @@ static void PADiffusionApply3D(const int NE,
       }
       for (int qz = 0; qz < Q1D; ++qz)
       {
-         double gradXY[max_D1D][max_D1D][3];
+         T gradXY[max_D1D][max_D1D][3];
          for (int dy = 0; dy < D1D; ++dy)
          {
             for (int dx = 0; dx < D1D; ++dx)
@@ -1180,7 +1198,7 @@ static void PADiffusionApply3D(const int NE,
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            double gradX[max_D1D][3];
+            T gradX[max_D1D][3];
             for (int dx = 0; dx < D1D; ++dx)
             {
                gradX[dx][0] = 0;
@@ -1189,13 +1207,13 @@ static void PADiffusionApply3D(const int NE,
             }
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               const double gX = grad[qz][qy][qx][0];
-               const double gY = grad[qz][qy][qx][1];
-               const double gZ = grad[qz][qy][qx][2];
+               const T gX = grad[qz][qy][qx][0];
+               const T gY = grad[qz][qy][qx][1];
+               const T gZ = grad[qz][qy][qx][2];
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  const double wx  = Bt(dx,qx);
-                  const double wDx = Gt(dx,qx);
+                  const T wx  = Bt(dx,qx);
+                  const T wDx = Gt(dx,qx);
                   gradX[dx][0] += gX * wDx;
                   gradX[dx][1] += gY * wx;
                   gradX[dx][2] += gZ * wx;
@@ -1203,8 +1221,8 @@ static void PADiffusionApply3D(const int NE,
             }
             for (int dy = 0; dy < D1D; ++dy)
             {
-               const double wy  = Bt(dy,qy);
-               const double wDy = Gt(dy,qy);
+               const T wy  = Bt(dy,qy);
+               const T wDy = Gt(dy,qy);
                for (int dx = 0; dx < D1D; ++dx)
                {
                   gradXY[dy][dx][0] += gradX[dx][0] * wy;
@@ -1215,13 +1233,13 @@ static void PADiffusionApply3D(const int NE,
          }
          for (int dz = 0; dz < D1D; ++dz)
          {
-            const double wz  = Bt(dz,qz);
-            const double wDz = Gt(dz,qz);
+            const T wz  = Bt(dz,qz);
+            const T wDz = Gt(dz,qz);
             for (int dy = 0; dy < D1D; ++dy)
             {
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  Y(dx,dy,dz,e) +=
+                  Y(dx,dy,dz,xe) +=
                      ((gradXY[dy][dx][0] * wz) +
                       (gradXY[dy][dx][1] * wz) +
                       (gradXY[dy][dx][2] * wDz));
@@ -1533,12 +1551,1315 @@ static void PADiffusionApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// Apply the generic kernels to NV vectors, in double or single precision
+template <typename T, typename PA_T>
+static void PADiffusionApplyMulti(const int dim,
+                                  const int D1D,
+                                  const int Q1D,
+                                  const int NE,
+                                  const int NV,
+                                  const Array<T> &B,
+                                  const Array<T> &G,
+                                  const Array<T> &Bt,
+                                  const Array<T> &Gt,
+                                  const PA_T &D,
+                                  const Vector &X,
+                                  Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADiffusionApply2D<2,2>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x33: return PADiffusionApply2D<3,3>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x44: return PADiffusionApply2D<4,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x55: return PADiffusionApply2D<5,5>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x66: return PADiffusionApply2D<6,6>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         default:
+            return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D,NV);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PADiffusionApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x34: return PADiffusionApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x45: return PADiffusionApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x56: return PADiffusionApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         default:
+            return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D,NV);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (single_precision)
+   {
+      PADiffusionApplyMulti(dim, dofs1D, quad1D, ne, 1,
+                            B_sp, G_sp, Bt_sp, Gt_sp, pa_data_sp, x, y);
+      return;
+   }
    PADiffusionApply(dim, dofs1D, quad1D, ne,
                     maps->B, maps->G, maps->Bt, maps->Gt,
                     pa_data, x, y);
 }
 
+void DiffusionIntegrator::AddMultPAMulti(const int nv, const Vector &x,
+                                         Vector &y) const
+{
+   if (single_precision)
+   {
+      PADiffusionApplyMulti(dim, dofs1D, quad1D, ne, nv,
+                            B_sp, G_sp, Bt_sp, Gt_sp, pa_data_sp, x, y);
+      return;
+   }
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca())
+   {
+      BilinearFormIntegrator::AddMultPAMulti(nv, x, y);
+      return;
+   }
+#endif // MFEM_USE_OCCA
+   PADiffusionApplyMulti(dim, dofs1D, quad1D, ne, nv,
+                         maps->B, maps->G, maps->Bt, maps->Gt, pa_data, x, y);
+}
+
+// EA Diffusion Assemble 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EADiffusionAssemble2D(const int NE,
+                                  const Array<double> &b_,
+                                  const Array<double> &g_,
+                                  const Vector &d_,
+                                  Vector &m_,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, 3, NE);
+   auto M = Reshape(m_.ReadWrite(), D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int i1 = 0; i1 < D1D; ++i1)
+      {
+         for (int j1 = 0; j1 < D1D; ++j1)
+         {
+            // contract in x; DX[a][b] couples the derivative in direction a
+            // of the test function with direction b of the trial function
+            double DX[2][2][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gg = 0.0, gb = 0.0, bg = 0.0, bb = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double bi = B(qx,i1), gi = G(qx,i1);
+                  const double bj = B(qx,j1), gj = G(qx,j1);
+                  gg += gi * gj * D(qx,qy,0,e);
+                  gb += gi * bj * D(qx,qy,1,e);
+                  bg += bi * gj * D(qx,qy,1,e);
+                  bb += bi * bj * D(qx,qy,2,e);
+               }
+               DX[0][0][qy] = gg;
+               DX[0][1][qy] = gb;
+               DX[1][0][qy] = bg;
+               DX[1][1][qy] = bb;
+            }
+            // contract in y
+            for (int i2 = 0; i2 < D1D; ++i2)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  double val = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double bi = B(qy,i2), gi = G(qy,i2);
+                     const double bj = B(qy,j2), gj = G(qy,j2);
+                     val += bi * bj * DX[0][0][qy];
+                     val += bi * gj * DX[0][1][qy];
+                     val += gi * bj * DX[1][0][qy];
+                     val += gi * gj * DX[1][1][qy];
+                  }
+                  M(i1,i2,j1,j2,e) += val;
+               }
+            }
+         }
+      }
+   });
+}
+
+// EA Diffusion Assemble 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EADiffusionAssemble3D(const int NE,
+                                  const Array<double> &b_,
+                                  const Array<double> &g_,
+                                  const Vector &d_,
+                                  Vector &m_,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, 6, NE);
+   auto M = Reshape(m_.ReadWrite(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // symmetric storage index of the (a,b) entry of the 3x3 matrix D
+      const int sym[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+      for (int i1 = 0; i1 < D1D; ++i1)
+      {
+         for (int j1 = 0; j1 < D1D; ++j1)
+         {
+            // contract in x; the x-factor of the derivative in direction a is
+            // G for a == 0 and B otherwise (same for the y- and z-factors)
+            double DX[3][3][max_Q1D][max_Q1D];
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  double val[3][3];
+                  for (int a = 0; a < 3; ++a)
+                  {
+                     for (int b = 0; b < 3; ++b) { val[a][b] = 0.0; }
+                  }
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double bi = B(qx,i1), gi = G(qx,i1);
+                     const double bj = B(qx,j1), gj = G(qx,j1);
+                     for (int a = 0; a < 3; ++a)
+                     {
+                        const double wi = (a == 0) ? gi : bi;
+                        for (int b = 0; b < 3; ++b)
+                        {
+                           const double wj = (b == 0) ? gj : bj;
+                           val[a][b] += wi * wj * D(qx,qy,qz,sym[a][b],e);
+                        }
+                     }
+                  }
+                  for (int a = 0; a < 3; ++a)
+                  {
+                     for (int b = 0; b < 3; ++b) { DX[a][b][qz][qy] = val[a][b]; }
+                  }
+               }
+            }
+            for (int i2 = 0; i2 < D1D; ++i2)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  // contract in y
+                  double DXY[3][3][max_Q1D];
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     double val[3][3];
+                     for (int a = 0; a < 3; ++a)
+                     {
+                        for (int b = 0; b < 3; ++b) { val[a][b] = 0.0; }
+                     }
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        const double bi = B(qy,i2), gi = G(qy,i2);
+                        const double bj = B(qy,j2), gj = G(qy,j2);
+                        for (int a = 0; a < 3; ++a)
+                        {
+                           const double wi = (a == 1) ? gi : bi;
+                           for (int b = 0; b < 3; ++b)
+                           {
+                              const double wj = (b == 1) ? gj : bj;
+                              val[a][b] += wi * wj * DX[a][b][qz][qy];
+                           }
+                        }
+                     }
+                     for (int a = 0; a < 3; ++a)
+                     {
+                        for (int b = 0; b < 3; ++b) { DXY[a][b][qz] = val[a][b]; }
+                     }
+                  }
+                  // contract in z
+                  for (int i3 = 0; i3 < D1D; ++i3)
+                  {
+                     for (int j3 = 0; j3 < D1D; ++j3)
+                     {
+                        double val = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const double bi = B(qz,i3), gi = G(qz,i3);
+                           const double bj = B(qz,j3), gj = G(qz,j3);
+                           for (int a = 0; a < 3; ++a)
+                           {
+                              const double wi = (a == 2) ? gi : bi;
+                              for (int b = 0; b < 3; ++b)
+                              {
+                                 const double wj = (b == 2) ? gj : bj;
+                                 val += wi * wj * DXY[a][b][qz];
+                              }
+                           }
+                        }
+                        M(i1,i2,i3,j1,j2,j3,e) += val;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void EADiffusionAssemble(const int dim,
+                                const int D1D,
+                                const int Q1D,
+                                const int NE,
+                                const Array<double> &B,
+                                const Array<double> &G,
+                                const Vector &D,
+                                Vector &M)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x22: return EADiffusionAssemble2D<2,2>(NE,B,G,D,M);
+         case 0x33: return EADiffusionAssemble2D<3,3>(NE,B,G,D,M);
+         case 0x44: return EADiffusionAssemble2D<4,4>(NE,B,G,D,M);
+         case 0x55: return EADiffusionAssemble2D<5,5>(NE,B,G,D,M);
+         case 0x66: return EADiffusionAssemble2D<6,6>(NE,B,G,D,M);
+         default:   return EADiffusionAssemble2D(NE,B,G,D,M,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: return EADiffusionAssemble3D<2,3>(NE,B,G,D,M);
+         case 0x34: return EADiffusionAssemble3D<3,4>(NE,B,G,D,M);
+         case 0x45: return EADiffusionAssemble3D<4,5>(NE,B,G,D,M);
+         default:   return EADiffusionAssemble3D(NE,B,G,D,M,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DiffusionIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                     Vector &emat)
+{
+   if (fes.GetNE() == 0) { return; }
+   // The element matrices are computed from double precision data
+   const bool sp = single_precision;
+   single_precision = false;
+   AssemblePA(fes);
+   single_precision = sp;
+   EADiffusionAssemble(dim, dofs1D, quad1D, ne, maps->B, maps->G, pa_data,
+                       emat);
+}
+
+// MF Diffusion Apply 2D kernel. The geometric factors are recomputed at the
+// quadrature points from the mesh nodes E-vector XN, with tensor basis BN and
+// GN, instead of being read from stored quadrature data.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionApply2D(const int NE,
+                               const int ND1D,
+                               const Array<double> &b_,
+                               const Array<double> &g_,
+                               const Array<double> &bt_,
+                               const Array<double> &gt_,
+                               const Array<double> &bn_,
+                               const Array<double> &gn_,
+                               const Array<double> &w_,
+                               const Vector &c_,
+                               const Vector &xn_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto BN = Reshape(bn_.Read(), Q1D, ND1D);
+   auto GN = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, NE);
+   auto XN = Reshape(xn_.Read(), ND1D, ND1D, 2, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // Reference gradient of the solution and of the mesh nodes: jac[..][c][d]
+      // is the derivative of the c-th physical coordinate in direction d.
+      double grad[max_Q1D][max_Q1D][2];
+      double jac[max_Q1D][max_Q1D][2][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] = 0.0;
+            grad[qy][qx][1] = 0.0;
+            for (int c = 0; c < 2; ++c)
+            {
+               jac[qy][qx][c][0] = 0.0;
+               jac[qy][qx][c][1] = 0.0;
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X(dx,dy,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][0] += gradX[qx][1] * wy;
+               grad[qy][qx][1] += gradX[qx][0] * wDy;
+            }
+         }
+      }
+      for (int dy = 0; dy < ND1D; ++dy)
+      {
+         double jacX[max_Q1D][2][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               jacX[qx][c][0] = 0.0;
+               jacX[qx][c][1] = 0.0;
+            }
+         }
+         for (int dx = 0; dx < ND1D; ++dx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               const double s = XN(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  jacX[qx][c][0] += s * BN(qx,dx);
+                  jacX[qx][c][1] += s * GN(qx,dx);
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = BN(qy,dy);
+            const double wDy = GN(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  jac[qy][qx][c][0] += jacX[qx][c][1] * wy;
+                  jac[qy][qx][c][1] += jacX[qx][c][0] * wDy;
+               }
+            }
+         }
+      }
+      // Apply W C det(J) J^{-1} J^{-T} at each quadrature point
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double J11 = jac[qy][qx][0][0];
+            const double J21 = jac[qy][qx][1][0];
+            const double J12 = jac[qy][qx][0][1];
+            const double J22 = jac[qy][qx][1][1];
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            const double c_detJ = W(qx,qy) * coeff / ((J11*J22)-(J21*J12));
+            const double O11 =  c_detJ * (J12*J12 + J22*J22);
+            const double O12 = -c_detJ * (J12*J11 + J22*J21);
+            const double O22 =  c_detJ * (J11*J11 + J21*J21);
+
+            const double gradX = grad[qy][qx][0];
+            const double gradY = grad[qy][qx][1];
+
+            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[max_D1D][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0;
+            gradX[dx][1] = 0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double gX = grad[qy][qx][0];
+            const double gY = grad[qy][qx][1];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = Bt(dx,qx);
+               const double wDx = Gt(dx,qx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+            }
+         }
+      }
+   });
+}
+
+// MF Diffusion Apply 3D kernel, see MFDiffusionApply2D.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionApply3D(const int NE,
+                               const int ND1D,
+                               const Array<double> &b_,
+                               const Array<double> &g_,
+                               const Array<double> &bt_,
+                               const Array<double> &gt_,
+                               const Array<double> &bn_,
+                               const Array<double> &gn_,
+                               const Array<double> &w_,
+                               const Vector &c_,
+                               const Vector &xn_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto BN = Reshape(bn_.Read(), Q1D, ND1D);
+   auto GN = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, Q1D, NE);
+   auto XN = Reshape(xn_.Read(), ND1D, ND1D, ND1D, 3, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double grad[max_Q1D][max_Q1D][max_Q1D][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] = 0.0;
+               grad[qz][qy][qx][1] = 0.0;
+               grad[qz][qy][qx][2] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double gradXY[max_Q1D][max_Q1D][3];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradXY[qy][qx][0] = 0.0;
+               gradXY[qy][qx][1] = 0.0;
+               gradXY[qy][qx][2] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,dz,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double wx  = gradX[qx][0];
+                  const double wDx = gradX[qx][1];
+                  gradXY[qy][qx][0] += wDx * wy;
+                  gradXY[qy][qx][1] += wx  * wDy;
+                  gradXY[qy][qx][2] += wx  * wy;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = B(qz,dz);
+            const double wDz = G(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+               }
+            }
+         }
+      }
+      // Recompute the Jacobian one quadrature plane at a time: first contract
+      // the nodes in z, then in y, and finally in x at each point.
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double XZ[3][2][MAX_D1D][MAX_D1D];
+         for (int c = 0; c < 3; ++c)
+         {
+            for (int dy = 0; dy < ND1D; ++dy)
+            {
+               for (int dx = 0; dx < ND1D; ++dx)
+               {
+                  double u = 0.0, v = 0.0;
+                  for (int dz = 0; dz < ND1D; ++dz)
+                  {
+                     const double s = XN(dx,dy,dz,c,e);
+                     u += s * BN(qz,dz);
+                     v += s * GN(qz,dz);
+                  }
+                  XZ[c][0][dy][dx] = u;
+                  XZ[c][1][dy][dx] = v;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            // XYZ[c][d]: partial contraction for the derivative in direction d
+            double XYZ[3][3][MAX_D1D];
+            for (int c = 0; c < 3; ++c)
+            {
+               for (int dx = 0; dx < ND1D; ++dx)
+               {
+                  double u = 0.0, v = 0.0, w = 0.0;
+                  for (int dy = 0; dy < ND1D; ++dy)
+                  {
+                     u += BN(qy,dy) * XZ[c][0][dy][dx];
+                     v += GN(qy,dy) * XZ[c][0][dy][dx];
+                     w += BN(qy,dy) * XZ[c][1][dy][dx];
+                  }
+                  XYZ[c][0][dx] = u;
+                  XYZ[c][1][dx] = v;
+                  XYZ[c][2][dx] = w;
+               }
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double J[3][3];
+               for (int c = 0; c < 3; ++c)
+               {
+                  double u = 0.0, v = 0.0, w = 0.0;
+                  for (int dx = 0; dx < ND1D; ++dx)
+                  {
+                     u += GN(qx,dx) * XYZ[c][0][dx];
+                     v += BN(qx,dx) * XYZ[c][1][dx];
+                     w += BN(qx,dx) * XYZ[c][2][dx];
+                  }
+                  J[c][0] = u;
+                  J[c][1] = v;
+                  J[c][2] = w;
+               }
+               const double J11 = J[0][0], J12 = J[0][1], J13 = J[0][2];
+               const double J21 = J[1][0], J22 = J[1][1], J23 = J[1][2];
+               const double J31 = J[2][0], J32 = J[2][1], J33 = J[2][2];
+               const double detJ = J11 * (J22 * J33 - J32 * J23) -
+               /* */               J21 * (J12 * J33 - J32 * J13) +
+               /* */               J31 * (J12 * J23 - J22 * J13);
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               const double c_detJ = W(qx,qy,qz) * coeff / detJ;
+               // adj(J)
+               const double A11 = (J22 * J33) - (J23 * J32);
+               const double A12 = (J32 * J13) - (J12 * J33);
+               const double A13 = (J12 * J23) - (J22 * J13);
+               const double A21 = (J31 * J23) - (J21 * J33);
+               const double A22 = (J11 * J33) - (J13 * J31);
+               const double A23 = (J21 * J13) - (J11 * J23);
+               const double A31 = (J21 * J32) - (J31 * J22);
+               const double A32 = (J31 * J12) - (J11 * J32);
+               const double A33 = (J11 * J22) - (J12 * J21);
+               // detJ J^{-1} J^{-T} = (1/detJ) adj(J) adj(J)^T
+               const double O11 = c_detJ * (A11*A11 + A12*A12 + A13*A13);
+               const double O12 = c_detJ * (A11*A21 + A12*A22 + A13*A23);
+               const double O13 = c_detJ * (A11*A31 + A12*A32 + A13*A33);
+               const double O22 = c_detJ * (A21*A21 + A22*A22 + A23*A23);
+               const double O23 = c_detJ * (A21*A31 + A22*A32 + A23*A33);
+               const double O33 = c_detJ * (A31*A31 + A32*A32 + A33*A33);
+               const double gradX = grad[qz][qy][qx][0];
+               const double gradY = grad[qz][qy][qx][1];
+               const double gradZ = grad[qz][qy][qx][2];
+               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double gradXY[max_D1D][max_D1D][3];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] = 0;
+               gradXY[dy][dx][1] = 0;
+               gradXY[dy][dx][2] = 0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][3];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0;
+               gradX[dx][1] = 0;
+               gradX[dx][2] = 0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qz][qy][qx][0];
+               const double gY = grad[qz][qy][qx][1];
+               const double gZ = grad[qz][qy][qx][2];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+                  gradX[dx][2] += gZ * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,dz,e) +=
+                     ((gradXY[dy][dx][0] * wz) +
+                      (gradXY[dy][dx][1] * wz) +
+                      (gradXY[dy][dx][2] * wDz));
+               }
+            }
+         }
+      }
+   });
+}
+
+static void MFDiffusionApply(const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int ND1D,
+                             const int NE,
+                             const DofToQuad &maps,
+                             const DofToQuad &maps_nodes,
+                             const Array<double> &W,
+                             const Vector &C,
+                             const Vector &XN,
+                             const Vector &X,
+                             Vector &Y)
+{
+   const Array<double> &B = maps.B, &G = maps.G;
+   const Array<double> &Bt = maps.Bt, &Gt = maps.Gt;
+   const Array<double> &BN = maps_nodes.B, &GN = maps_nodes.G;
+   if (dim == 2)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x22:
+            return MFDiffusionApply2D<2,2>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         case 0x33:
+            return MFDiffusionApply2D<3,3>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         case 0x44:
+            return MFDiffusionApply2D<4,4>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         case 0x55:
+            return MFDiffusionApply2D<5,5>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         default:
+            return MFDiffusionApply2D(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y,
+                                      D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23:
+            return MFDiffusionApply3D<2,3>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         case 0x34:
+            return MFDiffusionApply3D<3,4>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         case 0x45:
+            return MFDiffusionApply3D<4,5>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         case 0x56:
+            return MFDiffusionApply3D<5,6>(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y);
+         default:
+            return MFDiffusionApply3D(NE,ND1D,B,G,Bt,Gt,BN,GN,W,C,XN,X,Y,
+                                      D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DiffusionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   mf_ir = IntRule ? IntRule : &GetRule(el, el);
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "dim = " << dim << " is not supported");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "surface meshes are not "
+               "supported");
+   maps = &el.GetDofToQuad(*mf_ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   maps_nodes = &GetMFNodes(fes, *mf_ir, mf_nodes);
+   if (Q == nullptr)
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = cQ->constant;
+   }
+   else
+   {
+      // General coefficients cannot be evaluated inside the kernels, so their
+      // values are stored: one double per point instead of the symmetric
+      // dim x dim matrix stored by partial assembly.
+      Q->EvalBatched(*fes.GetMesh(), *mf_ir, mf_coeff);
+   }
+}
+
+void DiffusionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   MFDiffusionApply(dim, dofs1D, quad1D, maps_nodes->ndof, ne, *maps,
+                    *maps_nodes, mf_ir->GetWeights(), mf_coeff, mf_nodes, x, y);
+}
+
+// PA Vector Diffusion Integrator
+
+void VectorDiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleElementMatrix()
+      ElementTransformation &T = *mesh->GetElementTransformation(0);
+      const int order = 2 * T.OrderGrad(&el);
+      ir = (el.Space() == FunctionSpace::rQk) ?
+           &RefinedIntRules.Get(el.GetGeomType(), order) :
+           &IntRules.Get(el.GetGeomType(), order);
+   }
+   const int nq = ir->GetNPoints();
+   dim = mesh->Dimension();
+   vdim = fes.GetVDim();
+   MFEM_VERIFY(dim == 2 || dim == 3, "dim = " << dim << " is not supported");
+   const int symmDims = (dim * (dim + 1)) / 2;
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
+   Vector coeff;
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q->EvalBatched(*fes.GetMesh(), *ir, coeff);
+   }
+   // The quadrature data is the same as for the scalar DiffusionIntegrator
+   PADiffusionSetup(dim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J, coeff,
+                    pa_data);
+}
+
+void VectorDiffusionIntegrator::AssembleDiagonalPA(Vector &diag) const
+{
+   if (ne == 0) { return; }
+   // All the components share the diagonal of the scalar diffusion operator
+   const int ND = (dim == 2) ? dofs1D*dofs1D : dofs1D*dofs1D*dofs1D;
+   const int VDIM = vdim;
+   Vector sdiag(ND*ne, Device::GetMemoryType());
+   sdiag.UseDevice(true);
+   sdiag = 0.0;
+   PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
+                               maps->B, maps->G, pa_data, sdiag);
+   auto S = Reshape(sdiag.Read(), ND, ne);
+   auto Y = Reshape(diag.ReadWrite(), ND, VDIM, ne);
+   MFEM_FORALL(i, ND*ne,
+   {
+      const int d = i % ND;
+      const int e = i / ND;
+      for (int c = 0; c < VDIM; ++c)
+      {
+         Y(d,c,e) += S(d,e);
+      }
+   });
+}
+
+// PA Vector Diffusion Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAVectorDiffusionApply2D(const int NE,
+                                     const int VDIM,
+                                     const Array<double> &b_,
+                                     const Array<double> &g_,
+                                     const Array<double> &bt_,
+                                     const Array<double> &gt_,
+                                     const Vector &d_,
+                                     const Vector &x_,
+                                     Vector &y_,
+                                     const int d1d = 0,
+                                     const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, VDIM, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double grad[max_Q1D][max_Q1D][2];
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][0] = 0.0;
+               grad[qy][qx][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + qy * Q1D;
+               const double O11 = D(q,0,e);
+               const double O12 = D(q,1,e);
+               const double O22 = D(q,2,e);
+               const double gradX = grad[qy][qx][0];
+               const double gradY = grad[qy][qx][1];
+               grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+               grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][0];
+               const double gY = grad[qy][qx][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Vector Diffusion Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAVectorDiffusionApply3D(const int NE,
+                                     const int VDIM,
+                                     const Array<double> &b_,
+                                     const Array<double> &g_,
+                                     const Array<double> &bt_,
+                                     const Array<double> &gt_,
+                                     const Vector &d_,
+                                     const Vector &x_,
+                                     Vector &y_,
+                                     const int d1d = 0,
+                                     const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, VDIM, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double grad[max_Q1D][max_Q1D][max_Q1D][3];
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] = 0.0;
+                  grad[qz][qy][qx][1] = 0.0;
+                  grad[qz][qy][qx][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const int q = qx + (qy + qz * Q1D) * Q1D;
+                  const double O11 = D(q,0,e);
+                  const double O12 = D(q,1,e);
+                  const double O13 = D(q,2,e);
+                  const double O22 = D(q,3,e);
+                  const double O23 = D(q,4,e);
+                  const double O33 = D(q,5,e);
+                  const double gradX = grad[qz][qy][qx][0];
+                  const double gradY = grad[qz][qy][qx][1];
+                  const double gradZ = grad[qz][qy][qx][2];
+                  grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+                  grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+                  grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0.0;
+                  gradXY[dy][dx][1] = 0.0;
+                  gradXY[dy][dx][2] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0.0;
+                  gradX[dx][1] = 0.0;
+                  gradX[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][0];
+                  const double gY = grad[qz][qy][qx][1];
+                  const double gZ = grad[qz][qy][qx][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,c,e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PAVectorDiffusionApply(const int dim,
+                                   const int D1D,
+                                   const int Q1D,
+                                   const int NE,
+                                   const int VDIM,
+                                   const Array<double> &B,
+                                   const Array<double> &G,
+                                   const Array<double> &Bt,
+                                   const Array<double> &Gt,
+                                   const Vector &D,
+                                   const Vector &X,
+                                   Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return PAVectorDiffusionApply2D<2,2>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         case 0x33:
+            return PAVectorDiffusionApply2D<3,3>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         case 0x44:
+            return PAVectorDiffusionApply2D<4,4>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         case 0x55:
+            return PAVectorDiffusionApply2D<5,5>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         default:
+            return PAVectorDiffusionApply2D(NE,VDIM,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23:
+            return PAVectorDiffusionApply3D<2,3>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         case 0x34:
+            return PAVectorDiffusionApply3D<3,4>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         case 0x45:
+            return PAVectorDiffusionApply3D<4,5>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         case 0x56:
+            return PAVectorDiffusionApply3D<5,6>(NE,VDIM,B,G,Bt,Gt,D,X,Y);
+         default:
+            return PAVectorDiffusionApply3D(NE,VDIM,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void VectorDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   PAVectorDiffusionApply(dim, dofs1D, quad1D, ne, vdim,
+                          maps->B, maps->G, maps->Bt, maps->Gt,
+                          pa_data, x, y);
+}
+
 } // namespace mfem
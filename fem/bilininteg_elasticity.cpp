@@ -0,0 +1,825 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Elasticity Integrator
+
+// Evaluate the coefficient Q at the points of ir in all the elements of fes,
+// storing a single value when Q is a ConstantCoefficient.
+static void PAElasticityCoefficient(Coefficient &Q,
+                                    const FiniteElementSpace &fes,
+                                    const IntegrationRule &ir,
+                                    Vector &coeff)
+{
+   if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+      return;
+   }
+   Q.EvalBatched(*fes.GetMesh(), ir, coeff);
+}
+
+// PA Elasticity Assemble 2D kernel
+static void PAElasticitySetup2D(const int Q1D,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &l,
+                                const Vector &m,
+                                Vector &d)
+{
+   const int NQ = Q1D*Q1D;
+   const bool const_l = l.Size() == 1;
+   const bool const_m = m.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 2, 2, NE);
+   auto L = const_l ? Reshape(l.Read(), 1, 1) : Reshape(l.Read(), NQ, NE);
+   auto M = const_m ? Reshape(m.Read(), 1, 1) : Reshape(m.Read(), NQ, NE);
+   auto D = Reshape(d.Write(), NQ, 6, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double detJ = (J11*J22)-(J21*J12);
+         const double id = 1.0 / detJ;
+         // J^{-1}, stored column-major
+         D(q,0,e) =  id * J22;
+         D(q,1,e) = -id * J21;
+         D(q,2,e) = -id * J12;
+         D(q,3,e) =  id * J11;
+         D(q,4,e) = W[q] * detJ * (const_l ? L(0,0) : L(q,e));
+         D(q,5,e) = W[q] * detJ * (const_m ? M(0,0) : M(q,e));
+      }
+   });
+}
+
+// PA Elasticity Assemble 3D kernel
+static void PAElasticitySetup3D(const int Q1D,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &l,
+                                const Vector &m,
+                                Vector &d)
+{
+   const int NQ = Q1D*Q1D*Q1D;
+   const bool const_l = l.Size() == 1;
+   const bool const_m = m.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto L = const_l ? Reshape(l.Read(), 1, 1) : Reshape(l.Read(), NQ, NE);
+   auto M = const_m ? Reshape(m.Read(), 1, 1) : Reshape(m.Read(), NQ, NE);
+   auto D = Reshape(d.Write(), NQ, 11, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J31 = J(q,2,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double J32 = J(q,2,1,e);
+         const double J13 = J(q,0,2,e);
+         const double J23 = J(q,1,2,e);
+         const double J33 = J(q,2,2,e);
+         const double detJ = J11 * (J22 * J33 - J32 * J23) -
+         /* */               J21 * (J12 * J33 - J32 * J13) +
+         /* */               J31 * (J12 * J23 - J22 * J13);
+         const double id = 1.0 / detJ;
+         // J^{-1} = adj(J) / det(J), stored column-major
+         D(q,0,e) = id * ((J22 * J33) - (J23 * J32)); // 1,1
+         D(q,1,e) = id * ((J31 * J23) - (J21 * J33)); // 2,1
+         D(q,2,e) = id * ((J21 * J32) - (J31 * J22)); // 3,1
+         D(q,3,e) = id * ((J32 * J13) - (J12 * J33)); // 1,2
+         D(q,4,e) = id * ((J11 * J33) - (J13 * J31)); // 2,2
+         D(q,5,e) = id * ((J31 * J12) - (J11 * J32)); // 3,2
+         D(q,6,e) = id * ((J12 * J23) - (J22 * J13)); // 1,3
+         D(q,7,e) = id * ((J21 * J13) - (J11 * J23)); // 2,3
+         D(q,8,e) = id * ((J11 * J22) - (J12 * J21)); // 3,3
+         D(q,9,e) = W[q] * detJ * (const_l ? L(0,0) : L(q,e));
+         D(q,10,e) = W[q] * detJ * (const_m ? M(0,0) : M(q,e));
+      }
+   });
+}
+
+static void PAElasticitySetup(const int dim,
+                              const int Q1D,
+                              const int NE,
+                              const Array<double> &W,
+                              const Vector &J,
+                              const Vector &L,
+                              const Vector &M,
+                              Vector &D)
+{
+   if (dim == 2) { return PAElasticitySetup2D(Q1D, NE, W, J, L, M, D); }
+   if (dim == 3) { return PAElasticitySetup3D(Q1D, NE, W, J, L, M, D); }
+   MFEM_ABORT("dim = " << dim << " is not supported in PAElasticitySetup");
+}
+
+void ElasticityIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleElementMatrix()
+      ElementTransformation &T = *mesh->GetElementTransformation(0);
+      ir = &IntRules.Get(el.GetGeomType(), 2 * T.OrderGrad(&el));
+   }
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "dim = " << dim << " is not supported");
+   MFEM_VERIFY(fes.GetVDim() == dim, "the vector dimension of the space must "
+               "be equal to the mesh dimension");
+   const int nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   Vector lcoeff, mcoeff;
+   PAElasticityCoefficient(*mu, fes, *ir, mcoeff);
+   if (lambda)
+   {
+      PAElasticityCoefficient(*lambda, fes, *ir, lcoeff);
+   }
+   else
+   {
+      lcoeff = mcoeff;
+      lcoeff *= q_lambda;
+      mcoeff *= q_mu;
+   }
+   pa_data.SetSize((dim*dim + 2) * nq * ne, Device::GetMemoryType());
+   PAElasticitySetup(dim, quad1D, ne, ir->GetWeights(), geom->J,
+                     lcoeff, mcoeff, pa_data);
+}
+
+
+// PA Elasticity Diagonal 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D, 6, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int c = 0; c < 2; ++c)
+      {
+         // for the c-th component, the diagonal is gradphi^T O gradphi with
+         // O = (lambda + mu) J^{-1} e_c e_c^T J^{-T} + mu J^{-1} J^{-T}
+         double QD0[MQ1][MD1];
+         double QD1[MQ1][MD1];
+         double QD2[MQ1][MD1];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               QD0[qx][dy] = 0.0;
+               QD1[qx][dy] = 0.0;
+               QD2[qx][dy] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const int q = qx + qy * Q1D;
+                  const double I11 = D(q,0,e), I21 = D(q,1,e);
+                  const double I12 = D(q,2,e), I22 = D(q,3,e);
+                  const double L = D(q,4,e), M = D(q,5,e);
+                  const double Ic1 = c == 0 ? I11 : I12;
+                  const double Ic2 = c == 0 ? I21 : I22;
+                  const double O11 = (L+M)*Ic1*Ic1 + M*(I11*I11 + I12*I12);
+                  const double O12 = (L+M)*Ic1*Ic2 + M*(I11*I21 + I12*I22);
+                  const double O22 = (L+M)*Ic2*Ic2 + M*(I21*I21 + I22*I22);
+                  QD0[qx][dy] += B(qy, dy) * B(qy, dy) * O11;
+                  QD1[qx][dy] += B(qy, dy) * G(qy, dy) * O12;
+                  QD2[qx][dy] += G(qy, dy) * G(qy, dy) * O22;
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  Y(dx,dy,c,e) += G(qx, dx) * G(qx, dx) * QD0[qx][dy];
+                  Y(dx,dy,c,e) += G(qx, dx) * B(qx, dx) * QD1[qx][dy];
+                  Y(dx,dy,c,e) += B(qx, dx) * G(qx, dx) * QD1[qx][dy];
+                  Y(dx,dy,c,e) += B(qx, dx) * B(qx, dx) * QD2[qx][dy];
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Diagonal 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D*Q1D, 11, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               // first tensor contraction, along z direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        QQD[qx][qy][dz] = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const int q = qx + (qy + qz * Q1D) * Q1D;
+                           // O_ij = (lambda + mu) Jinv_ic Jinv_jc
+                           //      + mu sum_k Jinv_ik Jinv_jk
+                           double O = (D(q,9,e) + D(q,10,e)) *
+                                      D(q,i+DIM*c,e) * D(q,j+DIM*c,e);
+                           for (int k = 0; k < DIM; ++k)
+                           {
+                              O += D(q,10,e) * D(q,i+DIM*k,e) * D(q,j+DIM*k,e);
+                           }
+                           const double Bz = B(qz,dz);
+                           const double Gz = G(qz,dz);
+                           const double L = i==2 ? Gz : Bz;
+                           const double R = j==2 ? Gz : Bz;
+                           QQD[qx][qy][dz] += L * O * R;
+                        }
+                     }
+                  }
+               }
+               // second tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        QDD[qx][dy][dz] = 0.0;
+                        for (int qy = 0; qy < Q1D; ++qy)
+                        {
+                           const double By = B(qy,dy);
+                           const double Gy = G(qy,dy);
+                           const double L = i==1 ? Gy : By;
+                           const double R = j==1 ? Gy : By;
+                           QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
+                        }
+                     }
+                  }
+               }
+               // third tensor contraction, along x direction
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        for (int qx = 0; qx < Q1D; ++qx)
+                        {
+                           const double Bx = B(qx,dx);
+                           const double Gx = G(qx,dx);
+                           const double L = i==0 ? Gx : Bx;
+                           const double R = j==0 ? Gx : Bx;
+                           Y(dx,dy,dz,c,e) += L * QDD[qx][dy][dz] * R;
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PAElasticityAssembleDiagonal(const int dim,
+                                         const int D1D,
+                                         const int Q1D,
+                                         const int NE,
+                                         const Array<double> &B,
+                                         const Array<double> &G,
+                                         const Vector &D,
+                                         Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityDiagonal2D<2,2>(NE,B,G,D,Y);
+         case 0x33: return PAElasticityDiagonal2D<3,3>(NE,B,G,D,Y);
+         case 0x44: return PAElasticityDiagonal2D<4,4>(NE,B,G,D,Y);
+         case 0x55: return PAElasticityDiagonal2D<5,5>(NE,B,G,D,Y);
+         default: return PAElasticityDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAElasticityDiagonal3D<2,3>(NE,B,G,D,Y);
+         case 0x34: return PAElasticityDiagonal3D<3,4>(NE,B,G,D,Y);
+         case 0x45: return PAElasticityDiagonal3D<4,5>(NE,B,G,D,Y);
+         case 0x56: return PAElasticityDiagonal3D<5,6>(NE,B,G,D,Y);
+         default: return PAElasticityDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void ElasticityIntegrator::AssembleDiagonalPA(Vector &diag) const
+{
+   if (ne == 0) { return; }
+   PAElasticityAssembleDiagonal(dim, dofs1D, quad1D, ne,
+                                maps->B, maps->G, pa_data, diag);
+}
+
+
+// PA Elasticity Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityApply2D(const int NE,
+                                const Array<double> &b_,
+                                const Array<double> &g_,
+                                const Array<double> &bt_,
+                                const Array<double> &gt_,
+                                const Vector &d_,
+                                const Vector &x_,
+                                Vector &y_,
+                                const int d1d = 0,
+                                const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, 6, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, 2, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // grad[qy][qx][c][d]: derivative of the c-th component in the reference
+      // direction d
+      double grad[max_Q1D][max_Q1D][2][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               grad[qy][qx][c][0] = 0.0;
+               grad[qy][qx][c][1] = 0.0;
+            }
+         }
+      }
+      for (int c = 0; c < 2; ++c)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][c][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][c][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+      }
+      // Compute the stress sigma = lambda div(u) I + mu (grad(u) + grad(u)^T)
+      // and map it back to the reference element: sigma J^{-T}
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double Jinv[2][2];
+            Jinv[0][0] = D(q,0,e);
+            Jinv[1][0] = D(q,1,e);
+            Jinv[0][1] = D(q,2,e);
+            Jinv[1][1] = D(q,3,e);
+            const double L = D(q,4,e);
+            const double M = D(q,5,e);
+            double gradu[2][2];
+            for (int c = 0; c < 2; ++c)
+            {
+               for (int j = 0; j < 2; ++j)
+               {
+                  gradu[c][j] = grad[qy][qx][c][0] * Jinv[0][j] +
+                                grad[qy][qx][c][1] * Jinv[1][j];
+               }
+            }
+            const double div = gradu[0][0] + gradu[1][1];
+            double sigma[2][2];
+            for (int c = 0; c < 2; ++c)
+            {
+               for (int j = 0; j < 2; ++j)
+               {
+                  sigma[c][j] = M * (gradu[c][j] + gradu[j][c]);
+               }
+               sigma[c][c] += L * div;
+            }
+            for (int c = 0; c < 2; ++c)
+            {
+               for (int k = 0; k < 2; ++k)
+               {
+                  grad[qy][qx][c][k] = sigma[c][0] * Jinv[k][0] +
+                                       sigma[c][1] * Jinv[k][1];
+               }
+            }
+         }
+      }
+      for (int c = 0; c < 2; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][c][0];
+               const double gY = grad[qy][qx][c][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityApply3D(const int NE,
+                                const Array<double> &b_,
+                                const Array<double> &g_,
+                                const Array<double> &bt_,
+                                const Array<double> &gt_,
+                                const Vector &d_,
+                                const Vector &x_,
+                                Vector &y_,
+                                const int d1d = 0,
+                                const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 11, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, 3, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double grad[max_Q1D][max_Q1D][max_Q1D][3][3];
+      for (int c = 0; c < 3; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][c][0] = 0.0;
+                  grad[qz][qy][qx][c][1] = 0.0;
+                  grad[qz][qy][qx][c][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][c][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][c][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][c][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+      }
+      // Compute the stress sigma = lambda div(u) I + mu (grad(u) + grad(u)^T)
+      // and map it back to the reference element: sigma J^{-T}
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double Jinv[3][3];
+               for (int j = 0; j < 3; ++j)
+               {
+                  for (int k = 0; k < 3; ++k)
+                  {
+                     Jinv[k][j] = D(q,k+3*j,e);
+                  }
+               }
+               const double L = D(q,9,e);
+               const double M = D(q,10,e);
+               double gradu[3][3];
+               for (int c = 0; c < 3; ++c)
+               {
+                  for (int j = 0; j < 3; ++j)
+                  {
+                     gradu[c][j] = grad[qz][qy][qx][c][0] * Jinv[0][j] +
+                                   grad[qz][qy][qx][c][1] * Jinv[1][j] +
+                                   grad[qz][qy][qx][c][2] * Jinv[2][j];
+                  }
+               }
+               const double div = gradu[0][0] + gradu[1][1] + gradu[2][2];
+               double sigma[3][3];
+               for (int c = 0; c < 3; ++c)
+               {
+                  for (int j = 0; j < 3; ++j)
+                  {
+                     sigma[c][j] = M * (gradu[c][j] + gradu[j][c]);
+                  }
+                  sigma[c][c] += L * div;
+               }
+               for (int c = 0; c < 3; ++c)
+               {
+                  for (int k = 0; k < 3; ++k)
+                  {
+                     grad[qz][qy][qx][c][k] = sigma[c][0] * Jinv[k][0] +
+                                              sigma[c][1] * Jinv[k][1] +
+                                              sigma[c][2] * Jinv[k][2];
+                  }
+               }
+            }
+         }
+      }
+      for (int c = 0; c < 3; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0.0;
+                  gradXY[dy][dx][1] = 0.0;
+                  gradXY[dy][dx][2] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0.0;
+                  gradX[dx][1] = 0.0;
+                  gradX[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][c][0];
+                  const double gY = grad[qz][qy][qx][c][1];
+                  const double gZ = grad[qz][qy][qx][c][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,c,e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PAElasticityApply(const int dim,
+                              const int D1D,
+                              const int Q1D,
+                              const int NE,
+                              const Array<double> &B,
+                              const Array<double> &G,
+                              const Array<double> &Bt,
+                              const Array<double> &Gt,
+                              const Vector &D,
+                              const Vector &X,
+                              Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityApply2D<2,2>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x33: return PAElasticityApply2D<3,3>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x44: return PAElasticityApply2D<4,4>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x55: return PAElasticityApply2D<5,5>(NE,B,G,Bt,Gt,D,X,Y);
+         default:   return PAElasticityApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAElasticityApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x34: return PAElasticityApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x45: return PAElasticityApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y);
+         case 0x56: return PAElasticityApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y);
+         default:   return PAElasticityApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void ElasticityIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   PAElasticityApply(dim, dofs1D, quad1D, ne,
+                     maps->B, maps->G, maps->Bt, maps->Gt,
+                     pa_data, x, y);
+}
+
+} // namespace mfem
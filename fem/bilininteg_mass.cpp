@@ -51,16 +51,7 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalBatched(*fes.GetMesh(), *ir, coeff);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -112,6 +103,13 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       });
    }
+   if (single_precision)
+   {
+      ToSinglePrecision(pa_data, pa_data_sp);
+      ToSinglePrecision(maps->B, B_sp);
+      ToSinglePrecision(maps->Bt, Bt_sp);
+      pa_data.Destroy();
+   }
 }
 
 
@@ -422,6 +420,14 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag) const
 {
+   if (single_precision)
+   {
+      Vector pa_data_dp;
+      ToDoublePrecision(pa_data_sp, pa_data_dp);
+      PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data_dp,
+                             diag);
+      return;
+   }
    PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
 }
 
@@ -518,15 +524,17 @@ static void OccaPAMassApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double,
+         typename PA_T = Vector>
 static void PAMassApply2D(const int NE,
-                          const Array<double> &b_,
-                          const Array<double> &bt_,
-                          const Vector &d_,
+                          const Array<T> &b_,
+                          const Array<T> &bt_,
+                          const PA_T &d_,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
-                          const int q1d = 0)
+                          const int q1d = 0,
+                          const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -535,16 +543,19 @@ static void PAMassApply2D(const int NE,
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   auto X = Reshape(x_.Read(), D1D, D1D, NE*nv);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE*nv);
+   MFEM_FORALL(ev, NE*nv,
    {
+      // All the vectors of an element reuse its data
+      const int e = ev / nv;
+      const int xe = e + (ev % nv)*NE;
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xy[max_Q1D][max_Q1D];
+      T sol_xy[max_Q1D][max_Q1D];
       for (int qy = 0; qy < Q1D; ++qy)
       {
          for (int qx = 0; qx < Q1D; ++qx)
@@ -554,14 +565,14 @@ static void PAMassApply2D(const int NE,
       }
       for (int dy = 0; dy < D1D; ++dy)
       {
-         double sol_x[max_Q1D];
+         T sol_x[max_Q1D];
          for (int qy = 0; qy < Q1D; ++qy)
          {
             sol_x[qy] = 0.0;
          }
          for (int dx = 0; dx < D1D; ++dx)
          {
-            const double s = X(dx,dy,e);
+            const T s = X(dx,dy,xe);
             for (int qx = 0; qx < Q1D; ++qx)
             {
                sol_x[qx] += B(qx,dx)* s;
@@ -569,7 +580,7 @@ static void PAMassApply2D(const int NE,
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            const double d2q = B(qy,dy);
+            const T d2q = B(qy,dy);
             for (int qx = 0; qx < Q1D; ++qx)
             {
                sol_xy[qy][qx] += d2q * sol_x[qx];
@@ -585,14 +596,14 @@ static void PAMassApply2D(const int NE,
       }
       for (int qy = 0; qy < Q1D; ++qy)
       {
-         double sol_x[max_D1D];
+         T sol_x[max_D1D];
          for (int dx = 0; dx < D1D; ++dx)
          {
             sol_x[dx] = 0.0;
          }
          for (int qx = 0; qx < Q1D; ++qx)
          {
-            const double s = sol_xy[qy][qx];
+            const T s = sol_xy[qy][qx];
             for (int dx = 0; dx < D1D; ++dx)
             {
                sol_x[dx] += Bt(dx,qx) * s;
@@ -600,10 +611,10 @@ static void PAMassApply2D(const int NE,
          }
          for (int dy = 0; dy < D1D; ++dy)
          {
-            const double q2d = Bt(dy,qy);
+            const T q2d = Bt(dy,qy);
             for (int dx = 0; dx < D1D; ++dx)
             {
-               Y(dx,dy,e) += q2d * sol_x[dx];
+               Y(dx,dy,xe) += q2d * sol_x[dx];
             }
          }
       }
@@ -732,15 +743,17 @@ static void SmemPAMassApply2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename T = double,
+         typename PA_T = Vector>
 static void PAMassApply3D(const int NE,
-                          const Array<double> &b_,
-                          const Array<double> &bt_,
-                          const Vector &d_,
+                          const Array<T> &b_,
+                          const Array<T> &bt_,
+                          const PA_T &d_,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
-                          const int q1d = 0)
+                          const int q1d = 0,
+                          const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -749,15 +762,18 @@ static void PAMassApply3D(const int NE,
    auto B = Reshape(b_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE*nv);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE*nv);
+   MFEM_FORALL(ev, NE*nv,
    {
+      // All the vectors of an element reuse its data
+      const int e = ev / nv;
+      const int xe = e + (ev % nv)*NE;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
+      T sol_xyz[max_Q1D][max_Q1D][max_Q1D];
       for (int qz = 0; qz < Q1D; ++qz)
       {
          for (int qy = 0; qy < Q1D; ++qy)
@@ -770,7 +786,7 @@ static void PAMassApply3D(const int NE,
       }
       for (int dz = 0; dz < D1D; ++dz)
       {
-         double sol_xy[max_Q1D][max_Q1D];
+         T sol_xy[max_Q1D][max_Q1D];
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
@@ -780,14 +796,14 @@ static void PAMassApply3D(const int NE,
          }
          for (int dy = 0; dy < D1D; ++dy)
          {
-            double sol_x[max_Q1D];
+            T sol_x[max_Q1D];
             for (int qx = 0; qx < Q1D; ++qx)
             {
                sol_x[qx] = 0;
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double s = X(dx,dy,dz,e);
+               const T s = X(dx,dy,dz,xe);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   sol_x[qx] += B(qx,dx) * s;
@@ -795,7 +811,7 @@ static void PAMassApply3D(const int NE,
             }
             for (int qy = 0; qy < Q1D; ++qy)
             {
-               const double wy = B(qy,dy);
+               const T wy = B(qy,dy);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   sol_xy[qy][qx] += wy * sol_x[qx];
@@ -804,7 +820,7 @@ static void PAMassApply3D(const int NE,
          }
          for (int qz = 0; qz < Q1D; ++qz)
          {
-            const double wz = B(qz,dz);
+            const T wz = B(qz,dz);
             for (int qy = 0; qy < Q1D; ++qy)
             {
                for (int qx = 0; qx < Q1D; ++qx)
@@ -826,7 +842,7 @@ static void PAMassApply3D(const int NE,
       }
       for (int qz = 0; qz < Q1D; ++qz)
       {
-         double sol_xy[max_D1D][max_D1D];
+         T sol_xy[max_D1D][max_D1D];
          for (int dy = 0; dy < D1D; ++dy)
          {
             for (int dx = 0; dx < D1D; ++dx)
@@ -836,14 +852,14 @@ static void PAMassApply3D(const int NE,
          }
          for (int qy = 0; qy < Q1D; ++qy)
          {
-            double sol_x[max_D1D];
+            T sol_x[max_D1D];
             for (int dx = 0; dx < D1D; ++dx)
             {
                sol_x[dx] = 0;
             }
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               const double s = sol_xyz[qz][qy][qx];
+               const T s = sol_xyz[qz][qy][qx];
                for (int dx = 0; dx < D1D; ++dx)
                {
                   sol_x[dx] += Bt(dx,qx) * s;
@@ -851,7 +867,7 @@ static void PAMassApply3D(const int NE,
             }
             for (int dy = 0; dy < D1D; ++dy)
             {
-               const double wy = Bt(dy,qy);
+               const T wy = Bt(dy,qy);
                for (int dx = 0; dx < D1D; ++dx)
                {
                   sol_xy[dy][dx] += wy * sol_x[dx];
@@ -860,12 +876,12 @@ static void PAMassApply3D(const int NE,
          }
          for (int dz = 0; dz < D1D; ++dz)
          {
-            const double wz = Bt(dz,qz);
+            const T wz = Bt(dz,qz);
             for (int dy = 0; dy < D1D; ++dy)
             {
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
+                  Y(dx,dy,dz,xe) += wz * sol_xy[dy][dx];
                }
             }
          }
@@ -1098,9 +1114,699 @@ static void PAMassApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// Apply the generic kernels to NV vectors, in double or single precision
+template <typename T, typename PA_T>
+static void PAMassApplyMulti(const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int NE,
+                             const int NV,
+                             const Array<T> &B,
+                             const Array<T> &Bt,
+                             const PA_T &D,
+                             const Vector &X,
+                             Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x22: return PAMassApply2D<2,2>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x33: return PAMassApply2D<3,3>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x44: return PAMassApply2D<4,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x55: return PAMassApply2D<5,5>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x66: return PAMassApply2D<6,6>(NE,B,Bt,D,X,Y,0,0,NV);
+         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D,NV);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: return PAMassApply3D<2,3>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x34: return PAMassApply3D<3,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x45: return PAMassApply3D<4,5>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x56: return PAMassApply3D<5,6>(NE,B,Bt,D,X,Y,0,0,NV);
+         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D,NV);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (single_precision)
+   {
+      PAMassApplyMulti(dim, dofs1D, quad1D, ne, 1, B_sp, Bt_sp, pa_data_sp,
+                       x, y);
+      return;
+   }
    PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
 }
 
+void MassIntegrator::AddMultPAMulti(const int nv, const Vector &x,
+                                    Vector &y) const
+{
+   if (single_precision)
+   {
+      PAMassApplyMulti(dim, dofs1D, quad1D, ne, nv, B_sp, Bt_sp, pa_data_sp,
+                       x, y);
+      return;
+   }
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca())
+   {
+      BilinearFormIntegrator::AddMultPAMulti(nv, x, y);
+      return;
+   }
+#endif // MFEM_USE_OCCA
+   PAMassApplyMulti(dim, dofs1D, quad1D, ne, nv, maps->B, maps->Bt, pa_data,
+                    x, y);
+}
+
+// EA Mass Assemble 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAMassAssemble2D(const int NE,
+                             const Array<double> &b_,
+                             const Vector &d_,
+                             Vector &m_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
+   auto M = Reshape(m_.ReadWrite(), D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int i1 = 0; i1 < D1D; ++i1)
+      {
+         for (int j1 = 0; j1 < D1D; ++j1)
+         {
+            // contract in x: sum_qx B(qx,i1) B(qx,j1) D(qx,qy)
+            double DX[max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double val = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  val += B(qx,i1) * B(qx,j1) * D(qx,qy,e);
+               }
+               DX[qy] = val;
+            }
+            // contract in y
+            for (int i2 = 0; i2 < D1D; ++i2)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  double val = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     val += B(qy,i2) * B(qy,j2) * DX[qy];
+                  }
+                  M(i1,i2,j1,j2,e) += val;
+               }
+            }
+         }
+      }
+   });
+}
+
+// EA Mass Assemble 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAMassAssemble3D(const int NE,
+                             const Array<double> &b_,
+                             const Vector &d_,
+                             Vector &m_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
+   auto M = Reshape(m_.ReadWrite(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int i1 = 0; i1 < D1D; ++i1)
+      {
+         for (int j1 = 0; j1 < D1D; ++j1)
+         {
+            // contract in x
+            double DX[max_Q1D][max_Q1D];
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  double val = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     val += B(qx,i1) * B(qx,j1) * D(qx,qy,qz,e);
+                  }
+                  DX[qz][qy] = val;
+               }
+            }
+            for (int i2 = 0; i2 < D1D; ++i2)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  // contract in y
+                  double DXY[max_Q1D];
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     double val = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        val += B(qy,i2) * B(qy,j2) * DX[qz][qy];
+                     }
+                     DXY[qz] = val;
+                  }
+                  // contract in z
+                  for (int i3 = 0; i3 < D1D; ++i3)
+                  {
+                     for (int j3 = 0; j3 < D1D; ++j3)
+                     {
+                        double val = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           val += B(qz,i3) * B(qz,j3) * DXY[qz];
+                        }
+                        M(i1,i2,i3,j1,j2,j3,e) += val;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void EAMassAssemble(const int dim,
+                           const int D1D,
+                           const int Q1D,
+                           const int NE,
+                           const Array<double> &B,
+                           const Vector &D,
+                           Vector &M)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x22: return EAMassAssemble2D<2,2>(NE,B,D,M);
+         case 0x33: return EAMassAssemble2D<3,3>(NE,B,D,M);
+         case 0x44: return EAMassAssemble2D<4,4>(NE,B,D,M);
+         case 0x55: return EAMassAssemble2D<5,5>(NE,B,D,M);
+         case 0x66: return EAMassAssemble2D<6,6>(NE,B,D,M);
+         default:   return EAMassAssemble2D(NE,B,D,M,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: return EAMassAssemble3D<2,3>(NE,B,D,M);
+         case 0x34: return EAMassAssemble3D<3,4>(NE,B,D,M);
+         case 0x45: return EAMassAssemble3D<4,5>(NE,B,D,M);
+         case 0x56: return EAMassAssemble3D<5,6>(NE,B,D,M);
+         default:   return EAMassAssemble3D(NE,B,D,M,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void MassIntegrator::AssembleEA(const FiniteElementSpace &fes, Vector &emat)
+{
+   if (fes.GetNE() == 0) { return; }
+   // The element matrices are computed from double precision data
+   const bool sp = single_precision;
+   single_precision = false;
+   AssemblePA(fes);
+   single_precision = sp;
+   EAMassAssemble(dim, dofs1D, quad1D, ne, maps->B, pa_data, emat);
+}
+
+// MF Mass Apply 2D kernel. The Jacobian determinant is recomputed at the
+// quadrature points from the mesh nodes E-vector XN, with tensor basis BN and
+// GN, instead of being read from stored quadrature data.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassApply2D(const int NE,
+                          const int ND1D,
+                          const Array<double> &b_,
+                          const Array<double> &bt_,
+                          const Array<double> &bn_,
+                          const Array<double> &gn_,
+                          const Array<double> &w_,
+                          const Vector &c_,
+                          const Vector &xn_,
+                          const Vector &x_,
+                          Vector &y_,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto BN = Reshape(bn_.Read(), Q1D, ND1D);
+   auto GN = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, NE);
+   auto XN = Reshape(xn_.Read(), ND1D, ND1D, 2, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double sol_xy[max_Q1D][max_Q1D];
+      double jac[max_Q1D][max_Q1D][2][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            sol_xy[qy][qx] = 0.0;
+            for (int c = 0; c < 2; ++c)
+            {
+               jac[qy][qx][c][0] = 0.0;
+               jac[qy][qx][c][1] = 0.0;
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double sol_x[max_Q1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            sol_x[qy] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X(dx,dy,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] += B(qx,dx)* s;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double d2q = B(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] += d2q * sol_x[qx];
+            }
+         }
+      }
+      for (int dy = 0; dy < ND1D; ++dy)
+      {
+         double jacX[max_Q1D][2][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               jacX[qx][c][0] = 0.0;
+               jacX[qx][c][1] = 0.0;
+            }
+         }
+         for (int dx = 0; dx < ND1D; ++dx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               const double s = XN(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  jacX[qx][c][0] += s * BN(qx,dx);
+                  jacX[qx][c][1] += s * GN(qx,dx);
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = BN(qy,dy);
+            const double wDy = GN(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  jac[qy][qx][c][0] += jacX[qx][c][1] * wy;
+                  jac[qy][qx][c][1] += jacX[qx][c][0] * wDy;
+               }
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double J11 = jac[qy][qx][0][0];
+            const double J21 = jac[qy][qx][1][0];
+            const double J12 = jac[qy][qx][0][1];
+            const double J22 = jac[qy][qx][1][1];
+            const double detJ = (J11*J22)-(J21*J12);
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            sol_xy[qy][qx] *= W(qx,qy) * coeff * detJ;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double sol_x[max_D1D];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            sol_x[dx] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double s = sol_xy[qy][qx];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] += Bt(dx,qx) * s;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double q2d = Bt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,e) += q2d * sol_x[dx];
+            }
+         }
+      }
+   });
+}
+
+// MF Mass Apply 3D kernel, see MFMassApply2D.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassApply3D(const int NE,
+                          const int ND1D,
+                          const Array<double> &b_,
+                          const Array<double> &bt_,
+                          const Array<double> &bn_,
+                          const Array<double> &gn_,
+                          const Array<double> &w_,
+                          const Vector &c_,
+                          const Vector &xn_,
+                          const Vector &x_,
+                          Vector &y_,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto BN = Reshape(bn_.Read(), Q1D, ND1D);
+   auto GN = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, Q1D, NE);
+   auto XN = Reshape(xn_.Read(), ND1D, ND1D, ND1D, 3, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xyz[qz][qy][qx] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double sol_xy[max_Q1D][max_Q1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] = 0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,dz,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += B(qx,dx) * s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] += wy * sol_x[qx];
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz = B(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+               }
+            }
+         }
+      }
+      // Recompute the Jacobian one quadrature plane at a time: first contract
+      // the nodes in z, then in y, and finally in x at each point.
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double XZ[3][2][MAX_D1D][MAX_D1D];
+         for (int c = 0; c < 3; ++c)
+         {
+            for (int dy = 0; dy < ND1D; ++dy)
+            {
+               for (int dx = 0; dx < ND1D; ++dx)
+               {
+                  double u = 0.0, v = 0.0;
+                  for (int dz = 0; dz < ND1D; ++dz)
+                  {
+                     const double s = XN(dx,dy,dz,c,e);
+                     u += s * BN(qz,dz);
+                     v += s * GN(qz,dz);
+                  }
+                  XZ[c][0][dy][dx] = u;
+                  XZ[c][1][dy][dx] = v;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double XYZ[3][3][MAX_D1D];
+            for (int c = 0; c < 3; ++c)
+            {
+               for (int dx = 0; dx < ND1D; ++dx)
+               {
+                  double u = 0.0, v = 0.0, w = 0.0;
+                  for (int dy = 0; dy < ND1D; ++dy)
+                  {
+                     u += BN(qy,dy) * XZ[c][0][dy][dx];
+                     v += GN(qy,dy) * XZ[c][0][dy][dx];
+                     w += BN(qy,dy) * XZ[c][1][dy][dx];
+                  }
+                  XYZ[c][0][dx] = u;
+                  XYZ[c][1][dx] = v;
+                  XYZ[c][2][dx] = w;
+               }
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double J[3][3];
+               for (int c = 0; c < 3; ++c)
+               {
+                  double u = 0.0, v = 0.0, w = 0.0;
+                  for (int dx = 0; dx < ND1D; ++dx)
+                  {
+                     u += GN(qx,dx) * XYZ[c][0][dx];
+                     v += BN(qx,dx) * XYZ[c][1][dx];
+                     w += BN(qx,dx) * XYZ[c][2][dx];
+                  }
+                  J[c][0] = u;
+                  J[c][1] = v;
+                  J[c][2] = w;
+               }
+               const double detJ =
+                  J[0][0] * (J[1][1] * J[2][2] - J[2][1] * J[1][2]) -
+                  J[1][0] * (J[0][1] * J[2][2] - J[2][1] * J[0][2]) +
+                  J[2][0] * (J[0][1] * J[1][2] - J[1][1] * J[0][2]);
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               sol_xyz[qz][qy][qx] *= W(qx,qy,qz) * coeff * detJ;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double sol_xy[max_D1D][max_D1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_xy[dy][dx] = 0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = sol_xyz[qz][qy][qx];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] += wy * sol_x[dx];
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz = Bt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+static void MFMassApply(const int dim,
+                        const int D1D,
+                        const int Q1D,
+                        const int ND1D,
+                        const int NE,
+                        const DofToQuad &maps,
+                        const DofToQuad &maps_nodes,
+                        const Array<double> &W,
+                        const Vector &C,
+                        const Vector &XN,
+                        const Vector &X,
+                        Vector &Y)
+{
+   const Array<double> &B = maps.B, &Bt = maps.Bt;
+   const Array<double> &BN = maps_nodes.B, &GN = maps_nodes.G;
+   if (dim == 2)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x22: return MFMassApply2D<2,2>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         case 0x33: return MFMassApply2D<3,3>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         case 0x44: return MFMassApply2D<4,4>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         case 0x55: return MFMassApply2D<5,5>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         default:
+            return MFMassApply2D(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: return MFMassApply3D<2,3>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         case 0x34: return MFMassApply3D<3,4>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         case 0x45: return MFMassApply3D<4,5>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         case 0x56: return MFMassApply3D<5,6>(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y);
+         default:
+            return MFMassApply3D(NE,ND1D,B,Bt,BN,GN,W,C,XN,X,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void MassIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   mf_ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "dim = " << dim << " is not supported");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "surface meshes are not "
+               "supported");
+   nq = mf_ir->GetNPoints();
+   maps = &el.GetDofToQuad(*mf_ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   maps_nodes = &GetMFNodes(fes, *mf_ir, mf_nodes);
+   if (Q == nullptr)
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q->EvalBatched(*fes.GetMesh(), *mf_ir, mf_coeff);
+   }
+}
+
+void MassIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   MFMassApply(dim, dofs1D, quad1D, maps_nodes->ndof, ne, *maps, *maps_nodes,
+               mf_ir->GetWeights(), mf_coeff, mf_nodes, x, y);
+}
+
 } // namespace mfem
@@ -0,0 +1,1220 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA H(curl) and H(div) Integrators
+//
+// The Nedelec (ND) and Raviart-Thomas (RT) hexahedral elements are described
+// by VectorTensorFiniteElement: component c of a basis function is a product of
+// 1D functions from the closed basis (D1D dofs) and the open basis (D1D-1 dofs).
+// For ND elements the open basis is used in direction c and the closed basis in
+// the other directions; for RT elements it is the other way around. The
+// E-vector stores the dofs of the x, y and z components one after the other,
+// each block in lexicographic order.
+
+// Return true if the closed 1D basis is used in direction d by component c.
+MFEM_HOST_DEVICE static inline bool IsClosed(const bool hdiv,
+                                             const int c, const int d)
+{
+   return (c == d) == hdiv;
+}
+
+// Index of the entry (i,j) of a symmetric 3x3 matrix stored as 11, 21, 31,
+// 22, 32, 33.
+MFEM_HOST_DEVICE static inline int SymmIndex3D(const int i, const int j)
+{
+   const int r = (i > j) ? i : j;
+   const int s = (i > j) ? j : i;
+   return (s == 0) ? r : ((s == 1) ? 2 + r : 5);
+}
+
+// Evaluate the scalar coefficient Q (1 when NULL) at the points of ir in all
+// the elements of fes, storing a single value when Q is constant.
+static void PAHcurlHdivCoefficient(Coefficient *Q,
+                                   const FiniteElementSpace &fes,
+                                   const IntegrationRule &ir,
+                                   Vector &coeff)
+{
+   if (Q == NULL)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+      return;
+   }
+   if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+      return;
+   }
+   Q->EvalBatched(*fes.GetMesh(), ir, coeff);
+}
+
+// PA H(curl)/H(div) Assemble 3D kernel
+// Stores the symmetric matrix W Q det(J) J^{-1} J^{-T} when 'covariant' is
+// true (ND mass) and W Q J^T J / det(J) otherwise (RT mass, ND curl-curl).
+static void PAHcurlHdivSetup3D(const int Q1D,
+                               const int NE,
+                               const bool covariant,
+                               const Array<double> &w,
+                               const Vector &j,
+                               const Vector &c,
+                               Vector &op)
+{
+   const int NQ = Q1D*Q1D*Q1D;
+   const bool const_c = c.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
+   auto D = Reshape(op.Write(), NQ, 6, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J31 = J(q,2,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double J32 = J(q,2,1,e);
+         const double J13 = J(q,0,2,e);
+         const double J23 = J(q,1,2,e);
+         const double J33 = J(q,2,2,e);
+         const double detJ = J11 * (J22 * J33 - J32 * J23) -
+         /* */               J21 * (J12 * J33 - J32 * J13) +
+         /* */               J31 * (J12 * J23 - J22 * J13);
+         const double coeff = const_c ? C(0,0) : C(q,e);
+         const double c_detJ = W[q] * coeff / detJ;
+         if (covariant)
+         {
+            // adj(J)
+            const double A11 = (J22 * J33) - (J23 * J32);
+            const double A12 = (J32 * J13) - (J12 * J33);
+            const double A13 = (J12 * J23) - (J22 * J13);
+            const double A21 = (J31 * J23) - (J21 * J33);
+            const double A22 = (J11 * J33) - (J13 * J31);
+            const double A23 = (J21 * J13) - (J11 * J23);
+            const double A31 = (J21 * J32) - (J31 * J22);
+            const double A32 = (J31 * J12) - (J11 * J32);
+            const double A33 = (J11 * J22) - (J12 * J21);
+            // detJ J^{-1} J^{-T} = (1/detJ) adj(J) adj(J)^T
+            D(q,0,e) = c_detJ * (A11*A11 + A12*A12 + A13*A13); // 1,1
+            D(q,1,e) = c_detJ * (A11*A21 + A12*A22 + A13*A23); // 2,1
+            D(q,2,e) = c_detJ * (A11*A31 + A12*A32 + A13*A33); // 3,1
+            D(q,3,e) = c_detJ * (A21*A21 + A22*A22 + A23*A23); // 2,2
+            D(q,4,e) = c_detJ * (A21*A31 + A22*A32 + A23*A33); // 3,2
+            D(q,5,e) = c_detJ * (A31*A31 + A32*A32 + A33*A33); // 3,3
+         }
+         else
+         {
+            // (1/detJ) J^T J
+            D(q,0,e) = c_detJ * (J11*J11 + J21*J21 + J31*J31); // 1,1
+            D(q,1,e) = c_detJ * (J11*J12 + J21*J22 + J31*J32); // 2,1
+            D(q,2,e) = c_detJ * (J11*J13 + J21*J23 + J31*J33); // 3,1
+            D(q,3,e) = c_detJ * (J12*J12 + J22*J22 + J32*J32); // 2,2
+            D(q,4,e) = c_detJ * (J12*J13 + J22*J23 + J32*J33); // 3,2
+            D(q,5,e) = c_detJ * (J13*J13 + J23*J23 + J33*J33); // 3,3
+         }
+      }
+   });
+}
+
+// PA H(div) DivDiv Assemble 3D kernel: stores W Q / det(J).
+static void PAHdivDivSetup3D(const int Q1D,
+                             const int NE,
+                             const Array<double> &w,
+                             const Vector &j,
+                             const Vector &c,
+                             Vector &op)
+{
+   const int NQ = Q1D*Q1D*Q1D;
+   const bool const_c = c.Size() == 1;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
+   auto D = Reshape(op.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J31 = J(q,2,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double J32 = J(q,2,1,e);
+         const double J13 = J(q,0,2,e);
+         const double J23 = J(q,1,2,e);
+         const double J33 = J(q,2,2,e);
+         const double detJ = J11 * (J22 * J33 - J32 * J23) -
+         /* */               J21 * (J12 * J33 - J32 * J13) +
+         /* */               J31 * (J12 * J23 - J22 * J13);
+         const double coeff = const_c ? C(0,0) : C(q,e);
+         D(q,e) = W[q] * coeff / detJ;
+      }
+   });
+}
+
+// PA H(curl)/H(div) Mass Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAHcurlHdivMassApply3D(const int NE,
+                                   const bool hdiv,
+                                   const Array<double> &bc_,
+                                   const Array<double> &bo_,
+                                   const Vector &op_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = 3 * (hdiv ? D1D*(D1D-1)*(D1D-1) : (D1D-1)*D1D*D1D);
+   auto Bc = Reshape(bc_.Read(), Q1D, D1D);
+   auto Bo = Reshape(bo_.Read(), Q1D, D1D-1);
+   auto op = Reshape(op_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto X = Reshape(x_.Read(), ND, NE);
+   auto Y = Reshape(y_.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double mass[max_Q1D][max_Q1D][max_Q1D][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 3; ++c)
+               {
+                  mass[qz][qy][qx][c] = 0.0;
+               }
+            }
+         }
+      }
+
+      int osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const bool cx = IsClosed(hdiv, c, 0);
+         const bool cy = IsClosed(hdiv, c, 1);
+         const bool cz = IsClosed(hdiv, c, 2);
+         const int D1Dx = cx ? D1D : D1D - 1;
+         const int D1Dy = cy ? D1D : D1D - 1;
+         const int D1Dz = cz ? D1D : D1D - 1;
+         const auto &Bx = cx ? Bc : Bo;
+         const auto &By = cy ? Bc : Bo;
+         const auto &Bz = cz ? Bc : Bo;
+
+         for (int dz = 0; dz < D1Dz; ++dz)
+         {
+            double massXY[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  massXY[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               double massX[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  massX[qx] = 0.0;
+               }
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  const double t = X(dx + (dy + dz * D1Dy) * D1Dx + osc, e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     massX[qx] += t * Bx(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = By(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     massXY[qy][qx] += massX[qx] * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = Bz(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     mass[qz][qy][qx][c] += massXY[qy][qx] * wz;
+                  }
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+
+      // apply the quadrature point operator
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const double O11 = op(q,0,e);
+               const double O12 = op(q,1,e);
+               const double O13 = op(q,2,e);
+               const double O22 = op(q,3,e);
+               const double O23 = op(q,4,e);
+               const double O33 = op(q,5,e);
+               const double massX = mass[qz][qy][qx][0];
+               const double massY = mass[qz][qy][qx][1];
+               const double massZ = mass[qz][qy][qx][2];
+               mass[qz][qy][qx][0] = (O11*massX)+(O12*massY)+(O13*massZ);
+               mass[qz][qy][qx][1] = (O12*massX)+(O22*massY)+(O23*massZ);
+               mass[qz][qy][qx][2] = (O13*massX)+(O23*massY)+(O33*massZ);
+            }
+         }
+      }
+
+      osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const bool cx = IsClosed(hdiv, c, 0);
+         const bool cy = IsClosed(hdiv, c, 1);
+         const bool cz = IsClosed(hdiv, c, 2);
+         const int D1Dx = cx ? D1D : D1D - 1;
+         const int D1Dy = cy ? D1D : D1D - 1;
+         const int D1Dz = cz ? D1D : D1D - 1;
+         const auto &Bx = cx ? Bc : Bo;
+         const auto &By = cy ? Bc : Bo;
+         const auto &Bz = cz ? Bc : Bo;
+
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double massXY[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  massXY[dy][dx] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double massX[max_D1D];
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  massX[dx] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double t = mass[qz][qy][qx][c];
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     massX[dx] += t * Bx(qx,dx);
+                  }
+               }
+               for (int dy = 0; dy < D1Dy; ++dy)
+               {
+                  const double wy = By(qy,dy);
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     massXY[dy][dx] += massX[dx] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1Dz; ++dz)
+            {
+               const double wz = Bz(qz,dz);
+               for (int dy = 0; dy < D1Dy; ++dy)
+               {
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     Y(dx + (dy + dz * D1Dy) * D1Dx + osc, e) +=
+                        massXY[dy][dx] * wz;
+                  }
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+   });
+}
+
+// PA H(curl)/H(div) Mass Diagonal 3D kernel
+static void PAHcurlHdivMassDiagonal3D(const int D1D,
+                                      const int Q1D,
+                                      const int NE,
+                                      const bool hdiv,
+                                      const Array<double> &bc_,
+                                      const Array<double> &bo_,
+                                      const Vector &op_,
+                                      Vector &diag_)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = 3 * (hdiv ? D1D*(D1D-1)*(D1D-1) : (D1D-1)*D1D*D1D);
+   auto Bc = Reshape(bc_.Read(), Q1D, D1D);
+   auto Bo = Reshape(bo_.Read(), Q1D, D1D-1);
+   auto op = Reshape(op_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto Y = Reshape(diag_.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_Q1D = MAX_Q1D;
+      int osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const bool cx = IsClosed(hdiv, c, 0);
+         const bool cy = IsClosed(hdiv, c, 1);
+         const bool cz = IsClosed(hdiv, c, 2);
+         const int D1Dx = cx ? D1D : D1D - 1;
+         const int D1Dy = cy ? D1D : D1D - 1;
+         const int D1Dz = cz ? D1D : D1D - 1;
+         const auto &Bx = cx ? Bc : Bo;
+         const auto &By = cy ? Bc : Bo;
+         const auto &Bz = cz ? Bc : Bo;
+         const int occ = SymmIndex3D(c, c);
+
+         for (int dz = 0; dz < D1Dz; ++dz)
+         {
+            double QZ[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QZ[qy][qx] = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     const int q = qx + (qy + qz * Q1D) * Q1D;
+                     QZ[qy][qx] += op(q,occ,e) * Bz(qz,dz) * Bz(qz,dz);
+                  }
+               }
+            }
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               double QY[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QY[qx] = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     QY[qx] += QZ[qy][qx] * By(qy,dy) * By(qy,dy);
+                  }
+               }
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  double val = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     val += QY[qx] * Bx(qx,dx) * Bx(qx,dx);
+                  }
+                  Y(dx + (dy + dz * D1Dy) * D1Dx + osc, e) += val;
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+   });
+}
+
+// PA H(curl) CurlCurl Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAHcurlCurlApply3D(const int NE,
+                               const Array<double> &bc_,
+                               const Array<double> &gc_,
+                               const Array<double> &bo_,
+                               const Array<double> &go_,
+                               const Vector &op_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = 3 * (D1D-1)*D1D*D1D;
+   auto Bc = Reshape(bc_.Read(), Q1D, D1D);
+   auto Gc = Reshape(gc_.Read(), Q1D, D1D);
+   auto Bo = Reshape(bo_.Read(), Q1D, D1D-1);
+   auto Go = Reshape(go_.Read(), Q1D, D1D-1);
+   auto op = Reshape(op_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto X = Reshape(x_.Read(), ND, NE);
+   auto Y = Reshape(y_.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double curl[max_Q1D][max_Q1D][max_Q1D][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 3; ++c)
+               {
+                  curl[qz][qy][qx][c] = 0.0;
+               }
+            }
+         }
+      }
+
+      // the reference curl of u_c e_c is the cross product grad(u_c) x e_c
+      int osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const bool cx = IsClosed(false, c, 0);
+         const bool cy = IsClosed(false, c, 1);
+         const bool cz = IsClosed(false, c, 2);
+         const int D1Dx = cx ? D1D : D1D - 1;
+         const int D1Dy = cy ? D1D : D1D - 1;
+         const int D1Dz = cz ? D1D : D1D - 1;
+         const auto &Bx = cx ? Bc : Bo;
+         const auto &By = cy ? Bc : Bo;
+         const auto &Bz = cz ? Bc : Bo;
+         const auto &Gx = cx ? Gc : Go;
+         const auto &Gy = cy ? Gc : Go;
+         const auto &Gz = cz ? Gc : Go;
+
+         for (int dz = 0; dz < D1Dz; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  const double s = X(dx + (dy + dz * D1Dy) * D1Dx + osc, e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * Bx(qx,dx);
+                     gradX[qx][1] += s * Gx(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = By(qy,dy);
+                  const double wDy = Gy(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradXY[qy][qx][0] += gradX[qx][1] * wy;
+                     gradXY[qy][qx][1] += gradX[qx][0] * wDy;
+                     gradXY[qy][qx][2] += gradX[qx][0] * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = Bz(qz,dz);
+               const double wDz = Gz(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double gX = gradXY[qy][qx][0] * wz;
+                     const double gY = gradXY[qy][qx][1] * wz;
+                     const double gZ = gradXY[qy][qx][2] * wDz;
+                     if (c == 0)
+                     {
+                        curl[qz][qy][qx][1] += gZ;
+                        curl[qz][qy][qx][2] -= gY;
+                     }
+                     else if (c == 1)
+                     {
+                        curl[qz][qy][qx][0] -= gZ;
+                        curl[qz][qy][qx][2] += gX;
+                     }
+                     else
+                     {
+                        curl[qz][qy][qx][0] += gY;
+                        curl[qz][qy][qx][1] -= gX;
+                     }
+                  }
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+
+      // apply the quadrature point operator
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const double O11 = op(q,0,e);
+               const double O12 = op(q,1,e);
+               const double O13 = op(q,2,e);
+               const double O22 = op(q,3,e);
+               const double O23 = op(q,4,e);
+               const double O33 = op(q,5,e);
+               const double c1 = curl[qz][qy][qx][0];
+               const double c2 = curl[qz][qy][qx][1];
+               const double c3 = curl[qz][qy][qx][2];
+               curl[qz][qy][qx][0] = (O11*c1)+(O12*c2)+(O13*c3);
+               curl[qz][qy][qx][1] = (O12*c1)+(O22*c2)+(O23*c3);
+               curl[qz][qy][qx][2] = (O13*c1)+(O23*c2)+(O33*c3);
+            }
+         }
+      }
+
+      osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const bool cx = IsClosed(false, c, 0);
+         const bool cy = IsClosed(false, c, 1);
+         const bool cz = IsClosed(false, c, 2);
+         const int D1Dx = cx ? D1D : D1D - 1;
+         const int D1Dy = cy ? D1D : D1D - 1;
+         const int D1Dz = cz ? D1D : D1D - 1;
+         const auto &Bx = cx ? Bc : Bo;
+         const auto &By = cy ? Bc : Bo;
+         const auto &Bz = cz ? Bc : Bo;
+         const auto &Gx = cx ? Gc : Go;
+         const auto &Gy = cy ? Gc : Go;
+         const auto &Gz = cz ? Gc : Go;
+
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0.0;
+                  gradXY[dy][dx][1] = 0.0;
+                  gradXY[dy][dx][2] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  gradX[dx][0] = 0.0;
+                  gradX[dx][1] = 0.0;
+                  gradX[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  // transpose of the cross product with e_c
+                  const double c1 = curl[qz][qy][qx][0];
+                  const double c2 = curl[qz][qy][qx][1];
+                  const double c3 = curl[qz][qy][qx][2];
+                  const double gX = (c == 1) ? c3 : ((c == 2) ? -c2 : 0.0);
+                  const double gY = (c == 0) ? -c3 : ((c == 2) ? c1 : 0.0);
+                  const double gZ = (c == 0) ? c2 : ((c == 1) ? -c1 : 0.0);
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     const double wx  = Bx(qx,dx);
+                     const double wDx = Gx(qx,dx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1Dy; ++dy)
+               {
+                  const double wy  = By(qy,dy);
+                  const double wDy = Gy(qy,dy);
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1Dz; ++dz)
+            {
+               const double wz  = Bz(qz,dz);
+               const double wDz = Gz(qz,dz);
+               for (int dy = 0; dy < D1Dy; ++dy)
+               {
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     Y(dx + (dy + dz * D1Dy) * D1Dx + osc, e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+   });
+}
+
+// PA H(curl) CurlCurl Diagonal 3D kernel
+static void PAHcurlCurlDiagonal3D(const int D1D,
+                                  const int Q1D,
+                                  const int NE,
+                                  const Array<double> &bc_,
+                                  const Array<double> &gc_,
+                                  const Array<double> &bo_,
+                                  const Array<double> &go_,
+                                  const Vector &op_,
+                                  Vector &diag_)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = 3 * (D1D-1)*D1D*D1D;
+   auto Bc = Reshape(bc_.Read(), Q1D, D1D);
+   auto Gc = Reshape(gc_.Read(), Q1D, D1D);
+   auto Bo = Reshape(bo_.Read(), Q1D, D1D-1);
+   auto Go = Reshape(go_.Read(), Q1D, D1D-1);
+   auto op = Reshape(op_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto Y = Reshape(diag_.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_Q1D = MAX_Q1D;
+      int osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const bool cx = IsClosed(false, c, 0);
+         const bool cy = IsClosed(false, c, 1);
+         const bool cz = IsClosed(false, c, 2);
+         const int D1Dx = cx ? D1D : D1D - 1;
+         const int D1Dy = cy ? D1D : D1D - 1;
+         const int D1Dz = cz ? D1D : D1D - 1;
+         const auto &Bx = cx ? Bc : Bo;
+         const auto &By = cy ? Bc : Bo;
+         const auto &Bz = cz ? Bc : Bo;
+         const auto &Gx = cx ? Gc : Go;
+         const auto &Gy = cy ? Gc : Go;
+         const auto &Gz = cz ? Gc : Go;
+         // The curl of u e_c is s1 d(u)/d(x_a) e_b + s2 d(u)/d(x_b) e_a, where
+         // (a,b) are the other two directions, so that its D-norm is
+         //   D_bb (u_a)^2 + D_aa (u_b)^2 + 2 s1 s2 D_ab u_a u_b,
+         // with s1 s2 = -1 and u_a = d(u)/d(x_a).
+         const int a = (c == 0) ? 1 : 0;
+         const int b = (c == 2) ? 1 : 2;
+         const int obb = SymmIndex3D(b, b);
+         const int oaa = SymmIndex3D(a, a);
+         const int oab = SymmIndex3D(a, b);
+
+         for (int dz = 0; dz < D1Dz; ++dz)
+         {
+            // the three terms of the D-norm
+            double QZ[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QZ[qy][qx][0] = QZ[qy][qx][1] = QZ[qy][qx][2] = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     const int q = qx + (qy + qz * Q1D) * Q1D;
+                     const double fa = (a == 2) ? Gz(qz,dz) : Bz(qz,dz);
+                     const double fb = (b == 2) ? Gz(qz,dz) : Bz(qz,dz);
+                     QZ[qy][qx][0] += op(q,obb,e) * fa * fa;
+                     QZ[qy][qx][1] += op(q,oaa,e) * fb * fb;
+                     QZ[qy][qx][2] -= 2.0 * op(q,oab,e) * fa * fb;
+                  }
+               }
+            }
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               double QY[max_Q1D][3];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QY[qx][0] = QY[qx][1] = QY[qx][2] = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double fa = (a == 1) ? Gy(qy,dy) : By(qy,dy);
+                     const double fb = (b == 1) ? Gy(qy,dy) : By(qy,dy);
+                     QY[qx][0] += QZ[qy][qx][0] * fa * fa;
+                     QY[qx][1] += QZ[qy][qx][1] * fb * fb;
+                     QY[qx][2] += QZ[qy][qx][2] * fa * fb;
+                  }
+               }
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  double val = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double fa = (a == 0) ? Gx(qx,dx) : Bx(qx,dx);
+                     const double fb = (b == 0) ? Gx(qx,dx) : Bx(qx,dx);
+                     val += (QY[qx][0] * fa * fa) + (QY[qx][1] * fb * fb) +
+                            (QY[qx][2] * fa * fb);
+                  }
+                  Y(dx + (dy + dz * D1Dy) * D1Dx + osc, e) += val;
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+   });
+}
+
+// PA H(div) DivDiv Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAHdivDivApply3D(const int NE,
+                             const Array<double> &gc_,
+                             const Array<double> &bo_,
+                             const Vector &op_,
+                             const Vector &x_,
+                             Vector &y_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = 3 * D1D*(D1D-1)*(D1D-1);
+   auto Gc = Reshape(gc_.Read(), Q1D, D1D);
+   auto Bo = Reshape(bo_.Read(), Q1D, D1D-1);
+   auto op = Reshape(op_.Read(), Q1D*Q1D*Q1D, NE);
+   auto X = Reshape(x_.Read(), ND, NE);
+   auto Y = Reshape(y_.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double div[max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               div[qz][qy][qx] = 0.0;
+            }
+         }
+      }
+
+      // the reference divergence of u_c e_c is d(u_c)/d(x_c)
+      int osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const int D1Dx = (c == 0) ? D1D : D1D - 1;
+         const int D1Dy = (c == 1) ? D1D : D1D - 1;
+         const int D1Dz = (c == 2) ? D1D : D1D - 1;
+         const auto &Fx = (c == 0) ? Gc : Bo;
+         const auto &Fy = (c == 1) ? Gc : Bo;
+         const auto &Fz = (c == 2) ? Gc : Bo;
+
+         for (int dz = 0; dz < D1Dz; ++dz)
+         {
+            double divXY[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  divXY[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               double divX[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  divX[qx] = 0.0;
+               }
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  const double t = X(dx + (dy + dz * D1Dy) * D1Dx + osc, e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     divX[qx] += t * Fx(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = Fy(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     divXY[qy][qx] += divX[qx] * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = Fz(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     div[qz][qy][qx] += divXY[qy][qx] * wz;
+                  }
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+
+      // apply the quadrature point operator
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               div[qz][qy][qx] *= op(qx + (qy + qz * Q1D) * Q1D, e);
+            }
+         }
+      }
+
+      osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const int D1Dx = (c == 0) ? D1D : D1D - 1;
+         const int D1Dy = (c == 1) ? D1D : D1D - 1;
+         const int D1Dz = (c == 2) ? D1D : D1D - 1;
+         const auto &Fx = (c == 0) ? Gc : Bo;
+         const auto &Fy = (c == 1) ? Gc : Bo;
+         const auto &Fz = (c == 2) ? Gc : Bo;
+
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double divXY[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  divXY[dy][dx] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double divX[max_D1D];
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  divX[dx] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double t = div[qz][qy][qx];
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     divX[dx] += t * Fx(qx,dx);
+                  }
+               }
+               for (int dy = 0; dy < D1Dy; ++dy)
+               {
+                  const double wy = Fy(qy,dy);
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     divXY[dy][dx] += divX[dx] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1Dz; ++dz)
+            {
+               const double wz = Fz(qz,dz);
+               for (int dy = 0; dy < D1Dy; ++dy)
+               {
+                  for (int dx = 0; dx < D1Dx; ++dx)
+                  {
+                     Y(dx + (dy + dz * D1Dy) * D1Dx + osc, e) +=
+                        divXY[dy][dx] * wz;
+                  }
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+   });
+}
+
+// PA H(div) DivDiv Diagonal 3D kernel
+static void PAHdivDivDiagonal3D(const int D1D,
+                                const int Q1D,
+                                const int NE,
+                                const Array<double> &gc_,
+                                const Array<double> &bo_,
+                                const Vector &op_,
+                                Vector &diag_)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = 3 * D1D*(D1D-1)*(D1D-1);
+   auto Gc = Reshape(gc_.Read(), Q1D, D1D);
+   auto Bo = Reshape(bo_.Read(), Q1D, D1D-1);
+   auto op = Reshape(op_.Read(), Q1D*Q1D*Q1D, NE);
+   auto Y = Reshape(diag_.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_Q1D = MAX_Q1D;
+      int osc = 0;
+      for (int c = 0; c < 3; ++c)  // loop over x, y, z components
+      {
+         const int D1Dx = (c == 0) ? D1D : D1D - 1;
+         const int D1Dy = (c == 1) ? D1D : D1D - 1;
+         const int D1Dz = (c == 2) ? D1D : D1D - 1;
+         const auto &Fx = (c == 0) ? Gc : Bo;
+         const auto &Fy = (c == 1) ? Gc : Bo;
+         const auto &Fz = (c == 2) ? Gc : Bo;
+
+         for (int dz = 0; dz < D1Dz; ++dz)
+         {
+            double QZ[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QZ[qy][qx] = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     const int q = qx + (qy + qz * Q1D) * Q1D;
+                     QZ[qy][qx] += op(q,e) * Fz(qz,dz) * Fz(qz,dz);
+                  }
+               }
+            }
+            for (int dy = 0; dy < D1Dy; ++dy)
+            {
+               double QY[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QY[qx] = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     QY[qx] += QZ[qy][qx] * Fy(qy,dy) * Fy(qy,dy);
+                  }
+               }
+               for (int dx = 0; dx < D1Dx; ++dx)
+               {
+                  double val = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     val += QY[qx] * Fx(qx,dx) * Fx(qx,dx);
+                  }
+                  Y(dx + (dy + dz * D1Dy) * D1Dx + osc, e) += val;
+               }
+            }
+         }
+         osc += D1Dx * D1Dy * D1Dz;
+      }
+   });
+}
+
+// Return the VectorTensorFiniteElement used by fes, verifying that partial
+// assembly is supported for it.
+static const VectorTensorFiniteElement &GetVectorTensorFE(
+   const FiniteElementSpace &fes, const int map_type)
+{
+   const VectorTensorFiniteElement *el =
+      dynamic_cast<const VectorTensorFiniteElement*>(fes.GetFE(0));
+   MFEM_VERIFY(el != NULL && el->GetDim() == 3 &&
+               fes.GetMesh()->SpaceDimension() == 3,
+               "PA is only supported for ND and RT elements on hexahedra");
+   MFEM_VERIFY(map_type < 0 || el->GetMapType() == map_type,
+               "PA: unsupported element type");
+   return *el;
+}
+
+void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   MFEM_VERIFY(VQ == NULL && MQ == NULL,
+               "PA: only scalar coefficients are supported");
+   const VectorTensorFiniteElement &el = GetVectorTensorFE(fes, -1);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleElementMatrix()
+      ElementTransformation &T = *mesh->GetElementTransformation(0);
+      const int order = T.OrderW() + 2 * el.GetOrder();
+      ir = &IntRules.Get(el.GetGeomType(), order);
+   }
+   dim = mesh->Dimension();
+   hdiv = (el.GetMapType() == FiniteElement::H_DIV);
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   mapsC = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   mapsO = &el.GetDofToQuadOpen(*ir, DofToQuad::TENSOR);
+   dofs1D = mapsC->ndof;
+   quad1D = mapsC->nqpt;
+   pa_data.SetSize(6 * ir->GetNPoints() * ne, Device::GetMemoryType());
+   Vector coeff;
+   PAHcurlHdivCoefficient(Q, fes, *ir, coeff);
+   PAHcurlHdivSetup3D(quad1D, ne, !hdiv, ir->GetWeights(), geom->J, coeff,
+                      pa_data);
+}
+
+void VectorFEMassIntegrator::AssembleDiagonalPA(Vector &diag) const
+{
+   if (ne == 0) { return; }
+   PAHcurlHdivMassDiagonal3D(dofs1D, quad1D, ne, hdiv, mapsC->B, mapsO->B,
+                             pa_data, diag);
+}
+
+void VectorFEMassIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const Array<double> &Bc = mapsC->B;
+   const Array<double> &Bo = mapsO->B;
+   switch ((dofs1D << 4 ) | quad1D)
+   {
+      case 0x23:
+         return PAHcurlHdivMassApply3D<2,3>(ne,hdiv,Bc,Bo,pa_data,x,y);
+      case 0x34:
+         return PAHcurlHdivMassApply3D<3,4>(ne,hdiv,Bc,Bo,pa_data,x,y);
+      case 0x45:
+         return PAHcurlHdivMassApply3D<4,5>(ne,hdiv,Bc,Bo,pa_data,x,y);
+      case 0x56:
+         return PAHcurlHdivMassApply3D<5,6>(ne,hdiv,Bc,Bo,pa_data,x,y);
+      default:
+         return PAHcurlHdivMassApply3D(ne,hdiv,Bc,Bo,pa_data,x,y,
+                                       dofs1D,quad1D);
+   }
+}
+
+void CurlCurlIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   MFEM_VERIFY(MQ == NULL, "PA: only scalar coefficients are supported");
+   const VectorTensorFiniteElement &el =
+      GetVectorTensorFE(fes, FiniteElement::H_CURL);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleElementMatrix()
+      ir = &IntRules.Get(el.GetGeomType(), 2 * el.GetOrder());
+   }
+   dim = mesh->Dimension();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   mapsC = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   mapsO = &el.GetDofToQuadOpen(*ir, DofToQuad::TENSOR);
+   dofs1D = mapsC->ndof;
+   quad1D = mapsC->nqpt;
+   pa_data.SetSize(6 * ir->GetNPoints() * ne, Device::GetMemoryType());
+   Vector coeff;
+   PAHcurlHdivCoefficient(Q, fes, *ir, coeff);
+   // The reference curl is mapped with the contravariant Piola transformation
+   PAHcurlHdivSetup3D(quad1D, ne, false, ir->GetWeights(), geom->J, coeff,
+                      pa_data);
+}
+
+void CurlCurlIntegrator::AssembleDiagonalPA(Vector &diag) const
+{
+   if (ne == 0) { return; }
+   PAHcurlCurlDiagonal3D(dofs1D, quad1D, ne, mapsC->B, mapsC->G,
+                         mapsO->B, mapsO->G, pa_data, diag);
+}
+
+void CurlCurlIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const Array<double> &Bc = mapsC->B;
+   const Array<double> &Gc = mapsC->G;
+   const Array<double> &Bo = mapsO->B;
+   const Array<double> &Go = mapsO->G;
+   switch ((dofs1D << 4 ) | quad1D)
+   {
+      case 0x22: return PAHcurlCurlApply3D<2,2>(ne,Bc,Gc,Bo,Go,pa_data,x,y);
+      case 0x33: return PAHcurlCurlApply3D<3,3>(ne,Bc,Gc,Bo,Go,pa_data,x,y);
+      case 0x44: return PAHcurlCurlApply3D<4,4>(ne,Bc,Gc,Bo,Go,pa_data,x,y);
+      case 0x55: return PAHcurlCurlApply3D<5,5>(ne,Bc,Gc,Bo,Go,pa_data,x,y);
+      default:   return PAHcurlCurlApply3D(ne,Bc,Gc,Bo,Go,pa_data,x,y,
+                                              dofs1D,quad1D);
+   }
+}
+
+void DivDivIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const VectorTensorFiniteElement &el =
+      GetVectorTensorFE(fes, FiniteElement::H_DIV);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleElementMatrix()
+      ir = &IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() - 2);
+   }
+   dim = mesh->Dimension();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   mapsC = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   mapsO = &el.GetDofToQuadOpen(*ir, DofToQuad::TENSOR);
+   dofs1D = mapsC->ndof;
+   quad1D = mapsC->nqpt;
+   pa_data.SetSize(ir->GetNPoints() * ne, Device::GetMemoryType());
+   Vector coeff;
+   PAHcurlHdivCoefficient(Q, fes, *ir, coeff);
+   PAHdivDivSetup3D(quad1D, ne, ir->GetWeights(), geom->J, coeff, pa_data);
+}
+
+void DivDivIntegrator::AssembleDiagonalPA(Vector &diag) const
+{
+   if (ne == 0) { return; }
+   PAHdivDivDiagonal3D(dofs1D, quad1D, ne, mapsC->G, mapsO->B, pa_data, diag);
+}
+
+void DivDivIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const Array<double> &Gc = mapsC->G;
+   const Array<double> &Bo = mapsO->B;
+   switch ((dofs1D << 4 ) | quad1D)
+   {
+      case 0x21: return PAHdivDivApply3D<2,1>(ne,Gc,Bo,pa_data,x,y);
+      case 0x32: return PAHdivDivApply3D<3,2>(ne,Gc,Bo,pa_data,x,y);
+      case 0x43: return PAHdivDivApply3D<4,3>(ne,Gc,Bo,pa_data,x,y);
+      case 0x54: return PAHdivDivApply3D<5,4>(ne,Gc,Bo,pa_data,x,y);
+      default:   return PAHdivDivApply3D(ne,Gc,Bo,pa_data,x,y,dofs1D,quad1D);
+   }
+}
+
+} // namespace mfem
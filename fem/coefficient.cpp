@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +22,42 @@ namespace mfem
 
 using namespace std;
 
+void Coefficient::EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                              Vector &qcoeff)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq * ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   for (int e = 0; e < ne; ++e)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; ++q)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,e) = Eval(T, ip);
+      }
+   }
+}
+
+// The batched evaluations based on the QuadratureInterpolator require the same
+// conditions as the GeometricFactors of the mesh.
+static bool BatchedEvalSupported(const Mesh &mesh)
+{
+   const int dim = mesh.Dimension();
+   return mesh.GetNE() > 0 && dim > 1 && dim == mesh.SpaceDimension() &&
+          mesh.NURBSext == NULL && mesh.GetNumGeometries(dim) == 1;
+}
+
+void ConstantCoefficient::EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                                      Vector &qcoeff)
+{
+   qcoeff.SetSize(ir.GetNPoints() * mesh.GetNE(), Device::GetMemoryType());
+   qcoeff.UseDevice(true);
+   qcoeff = constant;
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -28,6 +65,25 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                                     Vector &qcoeff)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   Vector elem_values(NE);
+   for (int e = 0; e < NE; e++)
+   {
+      elem_values(e) = constants(mesh.GetAttribute(e)-1);
+   }
+   qcoeff.SetSize(NQ * NE, Device::GetMemoryType());
+   auto V = elem_values.Read();
+   auto C = Reshape(qcoeff.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++) { C(q,e) = V[e]; }
+   });
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +102,83 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                                      Vector &qcoeff)
+{
+   if (!BatchedEvalSupported(mesh))
+   {
+      Coefficient::EvalBatched(mesh, ir, qcoeff);
+      return;
+   }
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   const int sdim = mesh.SpaceDimension();
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(ir, GeometricFactors::COORDINATES);
+   auto X = Reshape(geom->X.HostRead(), nq, sdim, ne);
+   qcoeff.SetSize(nq * ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   Vector x(sdim);
+   for (int e = 0; e < ne; ++e)
+   {
+      for (int q = 0; q < nq; ++q)
+      {
+         for (int d = 0; d < sdim; d++) { x(d) = X(q,d,e); }
+         C(q,e) = Function ? (*Function)(x) : (*TDFunction)(x, GetTime());
+      }
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T.ElementNo, ip, Component);
 }
 
+void GridFunctionCoefficient::EvalBatched(Mesh &mesh,
+                                          const IntegrationRule &ir,
+                                          Vector &qcoeff)
+{
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   const int dim = mesh.Dimension();
+   const int vdim = fes.GetVDim();
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   const FiniteElement *fe = NE > 0 ? fes.GetFE(0) : NULL;
+   const bool supported =
+      fes.GetMesh() == &mesh && BatchedEvalSupported(mesh) &&
+      fe->GetRangeType() == FiniteElement::SCALAR &&
+      (vdim == 1 || vdim == dim) &&
+      fe->GetDof() <= (dim == 2 ? QuadratureInterpolator::MAX_ND2D :
+                       QuadratureInterpolator::MAX_ND3D) &&
+      NQ <= (dim == 2 ? QuadratureInterpolator::MAX_NQ2D :
+             QuadratureInterpolator::MAX_NQ3D);
+   if (!supported)
+   {
+      Coefficient::EvalBatched(mesh, ir, qcoeff);
+      return;
+   }
+   const Operator *R = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(R->Height(), Device::GetMemoryType());
+   R->Mult(*GridF, e_vec);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   Vector q_val(NQ * vdim * NE, Device::GetMemoryType()), empty;
+   qi->Mult(e_vec, QuadratureInterpolator::VALUES, q_val, empty, empty);
+   if (vdim == 1)
+   {
+      qcoeff.Swap(q_val);
+      return;
+   }
+   const int VDIM = vdim, comp = Component - 1;
+   qcoeff.SetSize(NQ * NE, Device::GetMemoryType());
+   auto V = Reshape(q_val.Read(), NQ, VDIM, NE);
+   auto C = Reshape(qcoeff.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++) { C(q,e) = V(q,comp,e); }
+   });
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
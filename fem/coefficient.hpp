@@ -59,6 +59,25 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at the points @a ir of all elements of
+       @a mesh, where all elements use the same IntegrationRule. */
+   /** The Vector @a qcoeff is resized to nq x ne, i.e. it has the layout of a
+       QuadratureFunction: the values in element e are stored at the offset
+       e*nq, in the order of the points of @a ir.
+
+       The default implementation calls Eval() at every point. Derived classes
+       may override it with batched evaluations that do not use the element
+       transformations. */
+   virtual void EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                            Vector &qcoeff);
+
+   /** @brief Return true if Eval() can be called concurrently by several
+       threads, each with its own ElementTransformation. */
+   /** This requires Eval() to modify no data of the coefficient. The threaded
+       assembly of the forms is used only with coefficients that return true,
+       see BilinearFormIntegrator::IsThreadSafe(). */
+   virtual bool IsThreadSafe() const { return false; }
+
    virtual ~Coefficient() { }
 };
 
@@ -76,6 +95,12 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   virtual bool IsThreadSafe() const { return true; }
+
+   /// Fill @a qcoeff with the constant on the device.
+   virtual void EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                            Vector &qcoeff);
 };
 
 /// class for piecewise constant coefficient
@@ -110,6 +135,13 @@ public:
    /// Evaluate the coefficient function
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   virtual bool IsThreadSafe() const { return true; }
+
+   /** Only the element attributes are read on the host, the values are
+       expanded to the quadrature points on the device. */
+   virtual void EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                            Vector &qcoeff);
 };
 
 
@@ -156,6 +188,15 @@ public:
    /// Evaluate coefficient
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /// The C-function must be safe to call concurrently.
+   virtual bool IsThreadSafe() const { return true; }
+
+   /** The physical coordinates of the points are computed at once, see
+       GeometricFactors::COORDINATES, and the function is called at every
+       point without any ElementTransformation. */
+   virtual void EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                            Vector &qcoeff);
 };
 
 class GridFunction;
@@ -179,6 +220,11 @@ public:
 
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** The GridFunction is interpolated at the points with the
+       QuadratureInterpolator of its FiniteElementSpace. */
+   virtual void EvalBatched(Mesh &mesh, const IntegrationRule &ir,
+                            Vector &qcoeff);
 };
 
 class TransformedCoefficient : public Coefficient
@@ -315,6 +361,9 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /// See Coefficient::IsThreadSafe().
+   virtual bool IsThreadSafe() const { return false; }
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -328,6 +377,11 @@ public:
    using VectorCoefficient::Eval;
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip) { V = vec; }
+
+   virtual bool IsThreadSafe() const { return true; }
+
+   /// Return a reference to the constant vector in this class.
+   const Vector &GetVec() const { return vec; }
 };
 
 class VectorFunctionCoefficient : public VectorCoefficient
@@ -361,6 +415,10 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** The C-function must be safe to call concurrently. Eval() sets the time
+       of the scalar Coefficient, if any. */
+   virtual bool IsThreadSafe() const { return !Q; }
+
    virtual ~VectorFunctionCoefficient() { }
 };
 
@@ -569,6 +627,9 @@ public:
    virtual void Eval(DenseMatrix &K, ElementTransformation &T,
                      const IntegrationPoint &ip) = 0;
 
+   /// See Coefficient::IsThreadSafe().
+   virtual bool IsThreadSafe() const { return false; }
+
    virtual ~MatrixCoefficient() { }
 };
 
@@ -582,6 +643,8 @@ public:
    using MatrixCoefficient::Eval;
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationPoint &ip) { M = mat; }
+
+   virtual bool IsThreadSafe() const { return true; }
 };
 
 class MatrixFunctionCoefficient : public MatrixCoefficient
@@ -626,6 +689,10 @@ public:
    virtual void Eval(DenseMatrix &K, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** The C-function must be safe to call concurrently. Eval() sets the time
+       of the scalar Coefficient, if any. */
+   virtual bool IsThreadSafe() const { return !Q; }
+
    virtual ~MatrixFunctionCoefficient() { }
 };
 
@@ -108,6 +108,7 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    pad_digits_cycle = pad_digits_rank = pad_digits_default;
    format = SERIAL_FORMAT; // use serial mesh format
    compression = false;
+   binary = false;
    error = NO_ERROR;
 }
 
@@ -163,10 +164,10 @@ void DataCollection::SetFormat(int fmt)
 
 void DataCollection::SetCompression(bool comp)
 {
-   compression = comp;
-#ifdef MFEM_USE_GZSTREAM
-   MFEM_ASSERT(!compression, "GZStream not enabled in MFEM build.");
+#ifndef MFEM_USE_GZSTREAM
+   MFEM_VERIFY(!comp, "GZStream not enabled in MFEM build.");
 #endif
+   compression = comp;
 }
 
 void DataCollection::SetPrefixPath(const std::string& prefix)
@@ -234,10 +235,15 @@ void DataCollection::SaveMesh()
    const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
    if (pmesh && format == PARALLEL_FORMAT)
    {
-      pmesh->ParPrint(mesh_file);
+      pmesh->ParPrint(mesh_file, binary);
    }
    else
 #endif
+   if (binary)
+   {
+      mesh->PrintBinary(mesh_file);
+   }
+   else
    {
       mesh->Print(mesh_file);
    }
@@ -280,7 +286,14 @@ void DataCollection::SaveOneField(const FieldMapIterator &it)
    ofgzstream field_file(GetFieldFileName(it->first).c_str(), mode);
 
    field_file.precision(precision);
-   (it->second)->Save(field_file);
+   if (binary)
+   {
+      (it->second)->SaveBinary(field_file);
+   }
+   else
+   {
+      (it->second)->Save(field_file);
+   }
    if (!field_file)
    {
       error = WRITE_ERROR;
@@ -745,6 +758,7 @@ ParaViewDataCollection::ParaViewDataCollection(const std::string&
    myrank = 0;
    nprocs = 1;
    levels_of_detail = 1;
+   data_format = VTKFormat::ASCII;
 
 #ifdef MFEM_USE_MPI
    lcomm = MPI_COMM_SELF;
@@ -858,7 +872,9 @@ void ParaViewDataCollection::Save()
    {
       std::string fname = GenerateCollectionPath()+"/"+GenerateVTUPath()+"/"
                           +GenerateVTUFileName();
-      std::fstream out; out.open(fname.c_str(), std::ios::out);
+      // every rank writes its own piece
+      std::fstream out;
+      out.open(fname.c_str(), std::ios::out | std::ios::binary);
       SaveDataVTU(out,levels_of_detail);
       out.close();
    }
@@ -894,8 +910,7 @@ void ParaViewDataCollection::Save()
       {
          out << "<PDataArray type=\"Float64\" Name=\"" << it->first;
          int vec_dim=it->second->VectorDim();
-         out<<"\" NumberOfComponents=\""<< vec_dim <<"\" format=\"ascii\" />" <<
-            std::endl;
+         out<<"\" NumberOfComponents=\""<< vec_dim <<"\" />" << std::endl;
       }
       out << "</PPointData>" << std::endl ;
 
@@ -925,91 +940,85 @@ void ParaViewDataCollection::Save()
 
 void ParaViewDataCollection::SaveDataVTU(std::ostream &out, int ref)
 {
-   out << "<VTKFile type=\"UnstructuredGrid\" ";
-   out << " version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
-   out << "<UnstructuredGrid>" << std::endl;
-   mesh->PrintVTU(out,ref);
-
-   // dump out the grid functions as point data
-   out << "<PointData >" << std::endl;
-   // save the grid functions
-   // iterate over all grid functions
-   for (FieldMapIterator it=field_map.begin(); it!=field_map.end(); ++it)
-   {
-      SaveGFieldVTU(out,ref,it);
-   }
-   // iterate over all quadrature functions
-   // if the Quadrature functions are dumped as cell data
-   // the cycle should be moved before the grid functions
-   // and the PrintVTU CellData section should be open in the mesh dump
-   for (QFieldMapIterator it=q_field_map.begin(); it!=q_field_map.end(); ++it)
+   // with compression, use zlib at the same level as the gzstream outputs
+   const VTKFormat fmt = compression ? VTKFormat::BINARY : data_format;
+   VTKDataWriter writer(out, fmt, compression ? 6 : 0);
+   writer.BeginFile("UnstructuredGrid");
+   // the appended format needs a second pass to write the data
+   do
    {
-      // save the quadrature functions
-      // this one is not implemented yet
-      SaveQFieldVTU(out,ref,it);
+      mesh->PrintVTU(writer,ref);
+
+      std::ostream &markup = writer.Markup();
+      // dump out the grid functions as point data
+      markup << "<PointData >\n";
+      // save the grid functions
+      // iterate over all grid functions
+      for (FieldMapIterator it=field_map.begin(); it!=field_map.end(); ++it)
+      {
+         SaveGFieldVTU(writer,ref,it);
+      }
+      // iterate over all quadrature functions
+      // if the Quadrature functions are dumped as cell data
+      // the cycle should be moved before the grid functions
+      // and the PrintVTU CellData section should be open in the mesh dump
+      for (QFieldMapIterator it=q_field_map.begin(); it!=q_field_map.end();
+           ++it)
+      {
+         // save the quadrature functions
+         // this one is not implemented yet
+         SaveQFieldVTU(writer,ref,it);
+      }
+      markup << "</PointData>\n";
+      // close the mesh
+      markup << "</Piece>\n"; // close the piece open in the PrintVTU method
    }
-   out << "</PointData>" << std::endl;
-   // close the mesh
-   out << "</Piece>" << std::endl; // close the piece open in the PrintVTU method
-   out << "</UnstructuredGrid>" << std::endl;
-   out << "</VTKFile>" << std::endl;
+   while (writer.NextPass());
+   writer.EndFile();
 }
 
-void ParaViewDataCollection::SaveQFieldVTU(std::ostream &out, int ref,
+void ParaViewDataCollection::SaveQFieldVTU(VTKDataWriter &writer, int ref,
                                            const QFieldMapIterator& it )
 {
+   if (!writer.WritesData()) { return; }
    MFEM_WARNING("SaveQFieldVTU is wotk in progress - field name:"<<it->second);
 }
 
-void ParaViewDataCollection::SaveGFieldVTU(std::ostream &out, int ref_,
+void ParaViewDataCollection::SaveGFieldVTU(VTKDataWriter &writer, int ref_,
                                            const FieldMapIterator& it)
 {
    RefinedGeometry *RefG;
    Vector val;
    DenseMatrix vval, pmat;
    int vec_dim = it->second->VectorDim();
-   if (vec_dim == 1)
+
+   std::size_t np = 0;
+   for (int i = 0; i < mesh->GetNE(); i++)
    {
-      // scalar data
-      out << "<DataArray type=\"Float64\" Name=\"" << it->first;
-      out << "\" NumberOfComponents=\"1\" format=\"ascii\" >" << std::endl;
-      for (int i = 0; i < mesh->GetNE(); i++)
+      RefG = GlobGeometryRefiner.Refine(
+                mesh->GetElementBaseGeometry(i), ref_, 1);
+      np += RefG->RefPts.GetNPoints();
+   }
+
+   writer.BeginArray<double>(it->first.c_str(), vec_dim, vec_dim*np);
+   for (int i = 0; writer.WritesData() && i < mesh->GetNE(); i++)
+   {
+      RefG = GlobGeometryRefiner.Refine(
+                mesh->GetElementBaseGeometry(i), ref_, 1);
+      if (vec_dim == 1)
       {
-         RefG = GlobGeometryRefiner.Refine(
-                   mesh->GetElementBaseGeometry(i), ref_, 1);
+         // scalar data
          it->second->GetValues(i, RefG->RefPts, val, pmat);
-         for (int j = 0; j < val.Size(); j++)
-         {
-            out << val(j) << '\n';
-         }
+         writer.Write(val.GetData(), val.Size());
       }
-
-   }
-   else
-   {
-      // vector data
-      out << "<DataArray type=\"Float64\" Name=\"" << it->first;
-      out << "\" NumberOfComponents=\"" << vec_dim << "\" format=\"ascii\" >" <<
-          std::endl;
-      for (int i = 0; i < mesh->GetNE(); i++)
+      else
       {
-         RefG = GlobGeometryRefiner.Refine(
-                   mesh->GetElementBaseGeometry(i), ref_, 1);
-
+         // vector data, stored point by point in the columns of vval
          it->second->GetVectorValues(i, RefG->RefPts, vval, pmat);
-
-         for (int jj = 0; jj < vval.Width(); jj++)
-         {
-            for (int ii = 0; ii < vval.Height(); ii++)
-            {
-               out << vval(ii, jj) << ' ';
-            }
-            out << std::endl;
-         }
+         writer.Write(vval.Data(), vval.Height()*vval.Width());
       }
    }
-   out << "</DataArray>" << std::endl;
-   out.flush();
+   writer.EndArray();
 }
 
 int ParaViewDataCollection::create_directory(const std::string &dir_name)
@@ -1041,6 +1050,7 @@ ParaViewDataCollection::ParaViewDataCollection(const std::string&
    MPI_Comm_rank(lcomm, &myrank);
    MPI_Comm_size(lcomm, &nprocs);
    levels_of_detail = 1;
+   data_format = VTKFormat::ASCII;
 
    std::string dpath = GenerateCollectionPath();
    std::string pvdname = dpath+"/"+GeneratePVDFileName();
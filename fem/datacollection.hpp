@@ -207,6 +207,8 @@ protected:
    /// Output mesh format: see the #Format enumeration
    int format;
    bool compression;
+   /// Write the mesh and fields in MFEM's binary format, see SetBinary()
+   bool binary;
 
    /// Should the collection delete its mesh and fields
    bool own_data;
@@ -351,6 +353,14 @@ public:
    /// Set the flag for use of gz compressed files
    void SetCompression(bool comp);
 
+   /// Set the flag for writing the mesh and fields in binary format.
+   /** The mesh is written with Mesh::PrintBinary() (ParMesh::ParPrint() with
+       PARALLEL_FORMAT) and the fields with GridFunction::SaveBinary(). The
+       files are read back with the same constructors as the ascii files, e.g.
+       by VisItDataCollection::Load(). Quadrature fields are written in
+       ascii. */
+   void SetBinary(bool bin) { binary = bin; }
+
    /// Set the path where the DataCollection will be saved.
    void SetPrefixPath(const std::string &prefix);
 
@@ -479,12 +489,15 @@ private:
    int myrank;
    int nprocs;
    int levels_of_detail;
+   VTKFormat data_format;
    std::fstream pvd_stream;
 
 protected:
    void SaveDataVTU(std::ostream &out, int ref);
-   void SaveGFieldVTU(std::ostream& out, int ref_, const FieldMapIterator& it);
-   void SaveQFieldVTU(std::ostream &out, int ref, const QFieldMapIterator& it);
+   void SaveGFieldVTU(VTKDataWriter &writer, int ref_,
+                      const FieldMapIterator& it);
+   void SaveQFieldVTU(VTKDataWriter &writer, int ref,
+                      const QFieldMapIterator& it);
 
    std::string  GenerateCollectionPath();
    std::string  GenerateVTUFileName();
@@ -526,6 +539,13 @@ public:
    /// levels_of_detail_
    void SetLevelsOfDetail(int levels_of_detail_);
 
+   /// Set the format of the data arrays in the .vtu files, see VTKFormat.
+   /** The default is VTKFormat::ASCII. The VTKFormat::APPENDED format writes
+       raw binary data and is the fastest to write and read. If compression is
+       enabled with SetCompression(), the data is written zlib-compressed in
+       the VTKFormat::BINARY format, regardless of this setting. */
+   void SetDataFormat(VTKFormat fmt) { data_format = fmt; }
+
    /// Save the collection - the directory name is constructed based on the
    /// cycle value
    virtual void Save() override;
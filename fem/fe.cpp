@@ -7177,6 +7177,79 @@ PositiveTensorFiniteElement::PositiveTensorFiniteElement(
      TensorBasisElement(dims, p, BasisType::Positive, dmtype) { }
 
 
+VectorTensorFiniteElement::VectorTensorFiniteElement(const int dims,
+                                                     const int d,
+                                                     const int p,
+                                                     const int cbtype,
+                                                     const int obtype,
+                                                     const int M)
+   : VectorFiniteElement(dims, TensorBasisElement::GetTensorProductGeometry(dims),
+                         d, p, M, FunctionSpace::Qk),
+     cbasis1d(poly1d.GetBasis(p, VerifyClosed(cbtype))),
+     obasis1d(poly1d.GetBasis(p - 1, VerifyOpen(obtype))),
+     dof_map(d)
+{ }
+
+const DofToQuad &VectorTensorFiniteElement::GetDofToQuad(
+   const IntegrationRule &ir, DofToQuad::Mode mode) const
+{
+   return GetTensorDofToQuad(cbasis1d, Order + 1, ir, mode, dof2quad_array);
+}
+
+const DofToQuad &VectorTensorFiniteElement::GetDofToQuadOpen(
+   const IntegrationRule &ir, DofToQuad::Mode mode) const
+{
+   return GetTensorDofToQuad(obasis1d, Order, ir, mode, dof2quad_array_open);
+}
+
+const DofToQuad &VectorTensorFiniteElement::GetTensorDofToQuad(
+   const Poly_1D::Basis &basis, const int ndof, const IntegrationRule &ir,
+   DofToQuad::Mode mode, Array<DofToQuad*> &dof2quad) const
+{
+   MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
+
+   for (int i = 0; i < dof2quad.Size(); i++)
+   {
+      const DofToQuad &d2q = *dof2quad[i];
+      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
+   }
+
+   DofToQuad *d2q = new DofToQuad;
+   const int nqpt = (int)floor(pow(ir.GetNPoints(), 1.0/Dim) + 0.5);
+   d2q->FE = this;
+   d2q->IntRule = &ir;
+   d2q->mode = mode;
+   d2q->ndof = ndof;
+   d2q->nqpt = nqpt;
+   d2q->B.SetSize(nqpt*ndof);
+   d2q->Bt.SetSize(ndof*nqpt);
+   d2q->G.SetSize(nqpt*ndof);
+   d2q->Gt.SetSize(ndof*nqpt);
+   Vector val(ndof), grad(ndof);
+   for (int i = 0; i < nqpt; i++)
+   {
+      // The first 'nqpt' points in 'ir' have the same x-coordinates as those
+      // of the 1D rule.
+      basis.Eval(ir.IntPoint(i).x, val, grad);
+      for (int j = 0; j < ndof; j++)
+      {
+         d2q->B[i+nqpt*j] = d2q->Bt[j+ndof*i] = val(j);
+         d2q->G[i+nqpt*j] = d2q->Gt[j+ndof*i] = grad(j);
+      }
+   }
+   dof2quad.Append(d2q);
+   return *d2q;
+}
+
+VectorTensorFiniteElement::~VectorTensorFiniteElement()
+{
+   for (int i = 0; i < dof2quad_array_open.Size(); i++)
+   {
+      delete dof2quad_array_open[i];
+   }
+}
+
+
 H1_SegmentElement::H1_SegmentElement(const int p, const int btype)
    : NodalTensorFiniteElement(1, p, VerifyClosed(btype), H1_DOF_MAP)
 {
@@ -10094,11 +10167,9 @@ const double RT_HexahedronElement::nk[18] =
 RT_HexahedronElement::RT_HexahedronElement(const int p,
                                            const int cb_type,
                                            const int ob_type)
-   : VectorFiniteElement(3, Geometry::CUBE, 3*(p + 1)*(p + 1)*(p + 2), p + 1,
-                         H_DIV, FunctionSpace::Qk),
-     cbasis1d(poly1d.GetBasis(p + 1, VerifyClosed(cb_type))),
-     obasis1d(poly1d.GetBasis(p, VerifyOpen(ob_type))),
-     dof_map(Dof), dof2nk(Dof)
+   : VectorTensorFiniteElement(3, 3*(p + 1)*(p + 1)*(p + 2), p + 1, cb_type,
+                               ob_type, H_DIV),
+     dof2nk(Dof)
 {
    const double *cp = poly1d.ClosedPoints(p + 1, cb_type);
    const double *op = poly1d.OpenPoints(p, ob_type);
@@ -10743,11 +10814,9 @@ const double ND_HexahedronElement::tk[18] =
 
 ND_HexahedronElement::ND_HexahedronElement(const int p,
                                            const int cb_type, const int ob_type)
-   : VectorFiniteElement(3, Geometry::CUBE, 3*p*(p + 1)*(p + 1), p,
-                         H_CURL, FunctionSpace::Qk),
-     cbasis1d(poly1d.GetBasis(p, VerifyClosed(cb_type))),
-     obasis1d(poly1d.GetBasis(p - 1, VerifyOpen(ob_type))),
-     dof_map(Dof), dof2tk(Dof)
+   : VectorTensorFiniteElement(3, 3*p*(p + 1)*(p + 1), p, cb_type, ob_type,
+                               H_CURL),
+     dof2tk(Dof)
 {
    const double *cp = poly1d.ClosedPoints(p, cb_type);
    const double *op = poly1d.OpenPoints(p - 1, ob_type);
@@ -146,8 +146,8 @@ public:
           dimensions using 1D number of quadrature points and degrees of
           freedom. */
       /** When representing a vector-valued FiniteElement, two DofToQuad objects
-          are used to describe the "closed" and "open" 1D basis functions
-          (TODO). */
+          are used to describe the "closed" and "open" 1D basis functions,
+          see VectorTensorFiniteElement. */
       TENSOR
    };
 
@@ -1882,6 +1882,50 @@ public:
    }
 };
 
+/** @brief Base class for vector finite elements on tensor-product geometries
+    whose basis functions are products of "closed" and "open" 1D bases, e.g.
+    ND_HexahedronElement and RT_HexahedronElement. */
+/** The closed 1D basis has degree Order and the open 1D basis has degree
+    Order-1. */
+class VectorTensorFiniteElement : public VectorFiniteElement
+{
+protected:
+   Poly_1D::Basis &cbasis1d, &obasis1d;
+   /** @brief Map from the lexicographic ordering of the dofs, component by
+       component, to their native ordering. A negative entry -1-k indicates
+       that the native basis function k has the opposite sign. */
+   Array<int> dof_map;
+
+private:
+   /// Container for the DofToQuad objects of the open 1D basis.
+   mutable Array<DofToQuad*> dof2quad_array_open;
+
+   const DofToQuad &GetTensorDofToQuad(const Poly_1D::Basis &basis,
+                                       const int ndof,
+                                       const IntegrationRule &ir,
+                                       DofToQuad::Mode mode,
+                                       Array<DofToQuad*> &dof2quad) const;
+
+public:
+   VectorTensorFiniteElement(const int dims, const int d, const int p,
+                             const int cbtype, const int obtype, const int M);
+
+   /// See #dof_map.
+   const Array<int> &GetDofMap() const { return dof_map; }
+
+   /** @brief Return the DofToQuad object of the closed 1D basis. Only the
+       DofToQuad::TENSOR mode is supported. */
+   virtual const DofToQuad &GetDofToQuad(const IntegrationRule &ir,
+                                         DofToQuad::Mode mode) const;
+
+   /** @brief Return the DofToQuad object of the open 1D basis. Only the
+       DofToQuad::TENSOR mode is supported. */
+   const DofToQuad &GetDofToQuadOpen(const IntegrationRule &ir,
+                                     DofToQuad::Mode mode) const;
+
+   virtual ~VectorTensorFiniteElement();
+};
+
 class H1_SegmentElement : public NodalTensorFiniteElement
 {
 private:
@@ -2424,16 +2468,15 @@ public:
 };
 
 
-class RT_HexahedronElement : public VectorFiniteElement
+class RT_HexahedronElement : public VectorTensorFiniteElement
 {
    static const double nk[18];
 
-   Poly_1D::Basis &cbasis1d, &obasis1d;
 #ifndef MFEM_THREAD_SAFE
    mutable Vector shape_cx, shape_ox, shape_cy, shape_oy, shape_cz, shape_oz;
    mutable Vector dshape_cx, dshape_cy, dshape_cz;
 #endif
-   Array<int> dof_map, dof2nk;
+   Array<int> dof2nk;
 
 public:
    RT_HexahedronElement(const int p,
@@ -2578,16 +2621,15 @@ public:
 };
 
 
-class ND_HexahedronElement : public VectorFiniteElement
+class ND_HexahedronElement : public VectorTensorFiniteElement
 {
    static const double tk[18];
 
-   Poly_1D::Basis &cbasis1d, &obasis1d;
 #ifndef MFEM_THREAD_SAFE
    mutable Vector shape_cx, shape_ox, shape_cy, shape_oy, shape_cz, shape_oz;
    mutable Vector dshape_cx, dshape_cy, dshape_cz;
 #endif
-   Array<int> dof_map, dof2tk;
+   Array<int> dof2tk;
 
 public:
    ND_HexahedronElement(const int p,
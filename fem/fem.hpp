@@ -23,10 +23,12 @@
 #include "nonlininteg.hpp"
 #include "bilininteg.hpp"
 #include "fespace.hpp"
+#include "fespacehierarchy.hpp"
 #include "gridfunc.hpp"
 #include "linearform.hpp"
 #include "nonlinearform.hpp"
 #include "bilinearform.hpp"
+#include "multigrid.hpp"
 #include "hybridization.hpp"
 #include "datacollection.hpp"
 #include "estimators.hpp"
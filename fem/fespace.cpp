@@ -855,6 +855,17 @@ const Operator *FiniteElementSpace::GetElementRestriction(
    return L2E_nat.Ptr();
 }
 
+const L2FaceRestriction *FiniteElementSpace::GetFaceRestriction(
+   FaceType type) const
+{
+   OperatorHandle &L2F = (type == FaceType::Interior) ? L2F_int : L2F_bdr;
+   if (L2F.Ptr() == NULL)
+   {
+      L2F.Reset(new L2FaceRestriction(*this, type));
+   }
+   return static_cast<const L2FaceRestriction*>(L2F.Ptr());
+}
+
 const QuadratureInterpolator *FiniteElementSpace::GetQuadratureInterpolator(
    const IntegrationRule &ir) const
 {
@@ -1078,6 +1089,59 @@ void FiniteElementSpace::RefinementOperator
    }
 }
 
+void FiniteElementSpace::RefinementOperator
+::MultTranspose(const Vector &x, Vector &y) const
+{
+   Mesh* mesh = fespace->GetMesh();
+   const CoarseFineTransformations &rtrans = mesh->GetRefinementTransforms();
+
+   Array<int> dofs, old_dofs, old_vdofs;
+
+   Array<char> processed(fespace->GetVSize());
+   processed = 0;
+
+   int vdim = fespace->GetVDim();
+   int old_ndofs = width / vdim;
+
+   y = 0.0;
+   const double *xd = x.HostRead();
+   double *yd = y.HostReadWrite();
+   for (int k = 0; k < mesh->GetNE(); k++)
+   {
+      const Embedding &emb = rtrans.embeddings[k];
+      const Geometry::Type geom = mesh->GetElementBaseGeometry(k);
+      const DenseMatrix &lP = localP[geom](emb.matrix);
+
+      fespace->GetElementDofs(k, dofs);
+      old_elem_dof->GetRow(emb.parent, old_dofs);
+
+      for (int vd = 0; vd < vdim; vd++)
+      {
+         old_dofs.Copy(old_vdofs);
+         fespace->DofsToVDofs(vd, old_vdofs, old_ndofs);
+
+         for (int i = 0; i < dofs.Size(); i++)
+         {
+            double rsign, osign;
+            int r = fespace->DofToVDof(dofs[i], vd);
+            r = DecodeDof(r, rsign);
+
+            // every fine dof contributes once, as it is set once in Mult()
+            if (!processed[r])
+            {
+               const double value = xd[r] * rsign;
+               for (int j = 0; j < old_vdofs.Size(); j++)
+               {
+                  int o = DecodeDof(old_vdofs[j], osign);
+                  yd[o] += value * lP(i, j) * osign;
+               }
+               processed[r] = 1;
+            }
+         }
+      }
+   }
+}
+
 FiniteElementSpace::DerefinementOperator::DerefinementOperator(
    const FiniteElementSpace *f_fes, const FiniteElementSpace *c_fes,
    BilinearFormIntegrator *mass_integ)
@@ -1892,6 +1956,8 @@ void FiniteElementSpace::Destroy()
    Th.Clear();
    L2E_nat.Clear();
    L2E_lex.Clear();
+   L2F_int.Clear();
+   L2F_bdr.Clear();
    for (int i = 0; i < E2Q_array.Size(); i++)
    {
       delete E2Q_array[i];
@@ -2128,6 +2194,16 @@ void FiniteElementSpace::Save(std::ostream &out) const
 }
 
 FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input)
+{
+   string header;
+   input >> std::ws;
+   getline(input, header);  // 'FiniteElementSpace'
+   filter_dos(header);
+   return Load(m, input, header);
+}
+
+FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input,
+                                                  const std::string &header)
 {
    string buff;
    int fes_format = 0, ord;
@@ -2135,11 +2211,8 @@ FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input)
 
    Destroy();
 
-   input >> std::ws;
-   getline(input, buff);  // 'FiniteElementSpace'
-   filter_dos(buff);
-   if (buff == "FiniteElementSpace") { fes_format = 90; /* v0.9 */ }
-   else if (buff == "MFEM FiniteElementSpace v1.0") { fes_format = 100; }
+   if (header == "FiniteElementSpace") { fes_format = 90; /* v0.9 */ }
+   else if (header == "MFEM FiniteElementSpace v1.0") { fes_format = 100; }
    else { MFEM_ABORT("input stream is not a FiniteElementSpace!"); }
    getline(input, buff, ' '); // 'FiniteElementCollection:'
    input >> std::ws;
@@ -2404,6 +2477,109 @@ const Operator &GridTransfer::MakeTrueOperator(
 }
 
 
+PRefinementTransferOperator::PRefinementTransferOperator(
+   const FiniteElementSpace &lFESpace_, const FiniteElementSpace &hFESpace_)
+   : Operator(hFESpace_.GetVSize(), lFESpace_.GetVSize()),
+     lFESpace(lFESpace_), hFESpace(hFESpace_)
+{
+   MFEM_VERIFY(lFESpace.GetMesh() == hFESpace.GetMesh(),
+               "the FE spaces must be defined on the same mesh");
+   MFEM_VERIFY(lFESpace.GetVDim() == hFESpace.GetVDim(),
+               "incompatible coarse and fine FE spaces");
+
+   IsoparametricTransformation isotr;
+   Mesh::GeometryList elem_geoms(*hFESpace.GetMesh());
+   for (int i = 0; i < elem_geoms.Size(); i++)
+   {
+      const Geometry::Type geom = elem_geoms[i];
+      const FiniteElement *h_fe =
+         hFESpace.FEColl()->FiniteElementForGeometry(geom);
+      const FiniteElement *l_fe =
+         lFESpace.FEColl()->FiniteElementForGeometry(geom);
+      isotr.SetIdentityTransformation(geom);
+      localP[geom].SetSize(h_fe->GetDof(), l_fe->GetDof());
+      h_fe->GetTransferMatrix(*l_fe, isotr, localP[geom]);
+   }
+}
+
+void PRefinementTransferOperator::Mult(const Vector &x, Vector &y) const
+{
+   Mesh *mesh = hFESpace.GetMesh();
+   Array<int> l_vdofs, h_vdofs;
+   const int vdim = hFESpace.GetVDim();
+
+   const double *xd = x.HostRead();
+   double *yd = y.HostWrite();
+   for (int k = 0; k < mesh->GetNE(); k++)
+   {
+      const DenseMatrix &lP = localP[mesh->GetElementBaseGeometry(k)];
+      const int l_nd = lP.Width(), h_nd = lP.Height();
+      lFESpace.GetElementVDofs(k, l_vdofs);
+      hFESpace.GetElementVDofs(k, h_vdofs);
+
+      for (int vd = 0; vd < vdim; vd++)
+      {
+         for (int i = 0; i < h_nd; i++)
+         {
+            double rsign, osign;
+            const int h_vdof = h_vdofs[i + vd*h_nd];
+            const int r = FiniteElementSpace::DecodeDof(h_vdof, rsign);
+            double value = 0.0;
+            for (int j = 0; j < l_nd; j++)
+            {
+               const int l_vdof = l_vdofs[j + vd*l_nd];
+               const int o = FiniteElementSpace::DecodeDof(l_vdof, osign);
+               value += xd[o] * lP(i, j) * osign;
+            }
+            yd[r] = value * rsign;
+         }
+      }
+   }
+}
+
+void PRefinementTransferOperator::MultTranspose(const Vector &x,
+                                                Vector &y) const
+{
+   Mesh *mesh = hFESpace.GetMesh();
+   Array<int> l_vdofs, h_vdofs;
+   const int vdim = hFESpace.GetVDim();
+
+   Array<char> processed(hFESpace.GetVSize());
+   processed = 0;
+
+   y = 0.0;
+   const double *xd = x.HostRead();
+   double *yd = y.HostReadWrite();
+   for (int k = 0; k < mesh->GetNE(); k++)
+   {
+      const DenseMatrix &lP = localP[mesh->GetElementBaseGeometry(k)];
+      const int l_nd = lP.Width(), h_nd = lP.Height();
+      lFESpace.GetElementVDofs(k, l_vdofs);
+      hFESpace.GetElementVDofs(k, h_vdofs);
+
+      for (int vd = 0; vd < vdim; vd++)
+      {
+         for (int i = 0; i < h_nd; i++)
+         {
+            double rsign, osign;
+            const int h_vdof = h_vdofs[i + vd*h_nd];
+            const int r = FiniteElementSpace::DecodeDof(h_vdof, rsign);
+            // every fine dof contributes once, as it is set once in Mult()
+            if (processed[r]) { continue; }
+            processed[r] = 1;
+            const double value = xd[r] * rsign;
+            for (int j = 0; j < l_nd; j++)
+            {
+               const int l_vdof = l_vdofs[j + vd*l_nd];
+               const int o = FiniteElementSpace::DecodeDof(l_vdof, osign);
+               yd[o] += value * lP(i, j) * osign;
+            }
+         }
+      }
+   }
+}
+
+
 InterpolationGridTransfer::~InterpolationGridTransfer()
 {
    if (own_mass_integ) { delete mass_integ; }
@@ -2428,7 +2604,15 @@ const Operator &InterpolationGridTransfer::ForwardOperator()
    // Costruct F
    if (oper_type == Operator::ANY_TYPE)
    {
-      F.Reset(new FiniteElementSpace::RefinementOperator(&ran_fes, &dom_fes));
+      if (ran_fes.GetMesh() == dom_fes.GetMesh())
+      {
+         F.Reset(new PRefinementTransferOperator(dom_fes, ran_fes));
+      }
+      else
+      {
+         F.Reset(new FiniteElementSpace::RefinementOperator(&ran_fes,
+                                                            &dom_fes));
+      }
    }
    else if (oper_type == Operator::MFEM_SPARSEMAT)
    {
@@ -2458,6 +2642,9 @@ const Operator &InterpolationGridTransfer::BackwardOperator()
       return *B.Ptr();
    }
 
+   MFEM_VERIFY(ran_fes.GetMesh() != dom_fes.GetMesh(),
+               "the FE spaces must be defined on different meshes");
+
    // Construct B, if not set, define a suitable mass_integ
    if (!mass_integ && ran_fes.GetNE() > 0)
    {
@@ -2755,6 +2942,196 @@ void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
    });
 }
 
+L2FaceRestriction::L2FaceRestriction(const FiniteElementSpace &f,
+                                     FaceType type)
+   : fes(f),
+     nf(0),
+     nsides(type == FaceType::Interior ? 2 : 1),
+     nlayers(0),
+     nfdofs(0),
+     ndofs(fes.GetNDofs())
+{
+   Mesh &mesh = *fes.GetMesh();
+   mesh.GetFacesByType(type, faces);
+   nf = faces.Size();
+   width = fes.GetVSize();
+   height = 0;
+   if (fes.GetNE() == 0) { return; }
+
+   const int dim = mesh.Dimension();
+   const NodalTensorFiniteElement *el =
+      dynamic_cast<const NodalTensorFiniteElement*>(fes.GetFE(0));
+   MFEM_VERIFY(dynamic_cast<const L2_FECollection*>(fes.FEColl()) && el &&
+               dim > 1, "only L2 spaces of tensor-product elements in 2D and"
+               " 3D are supported");
+   MFEM_VERIFY(fes.GetVDim() == 1, "only scalar spaces are supported");
+   MFEM_VERIFY(mesh.Conforming(), "non-conforming meshes are not supported");
+#ifdef MFEM_USE_MPI
+   const ParMesh *pmesh = dynamic_cast<const ParMesh*>(&mesh);
+   MFEM_VERIFY(pmesh == NULL || pmesh->GetNSharedFaces() == 0,
+               "shared faces of parallel meshes are not supported");
+#endif
+   nlayers = el->GetOrder() + 1;
+   nfdofs = (dim == 2) ? nlayers : nlayers*nlayers;
+   height = nf*nsides*nfdofs*2;
+   const int nidx = nf*nsides*nfdofs*nlayers;
+
+   // The 1D nodes of the element, in lexicographic order
+   const Array<int> &dof_map = el->GetDofMap();
+   const IntegrationRule &nodes = el->GetNodes();
+   Array<double> nodes1d(nlayers);
+   for (int i = 0; i < nlayers; i++)
+   {
+      nodes1d[i] = nodes.IntPoint(dof_map.Size() ? dof_map[i] : i).x;
+   }
+
+   // The 1D basis at the face, the layers of the lines on the other side are
+   // reversed below so that the same values apply to both sides.
+   Vector val(nlayers), der(nlayers);
+   el->GetBasis1D().Eval(0.0, val, der);
+   b0.SetSize(nlayers);
+   g0.SetSize(nlayers);
+   for (int l = 0; l < nlayers; l++)
+   {
+      b0[l] = val(l);
+      g0[l] = der(l);
+   }
+
+   // Find the element dofs of the lines normal to the faces by mapping the
+   // face nodes to the reference elements of both sides.
+   scatter_indices.SetSize(nidx);
+   Array<int> dofs;
+   for (int fi = 0; fi < nf; fi++)
+   {
+      FaceElementTransformations *tr =
+         mesh.GetFaceElementTransformations(faces[fi], 4|8);
+      for (int s = 0; s < nsides; s++)
+      {
+         IntegrationPointTransformation &loc = (s == 0) ? tr->Loc1 : tr->Loc2;
+         fes.GetElementDofs((s == 0) ? tr->Elem1No : tr->Elem2No, dofs);
+         IntegrationPoint ip, eip;
+         ip.Init();
+         ip.x = ip.y = 0.5;
+         loc.Transform(ip, eip);
+         const double center[3] = { eip.x, eip.y, eip.z };
+         int normal = -1;
+         for (int d = 0; d < dim; d++)
+         {
+            if (std::abs(center[d]) < 1e-12 ||
+                std::abs(center[d] - 1.0) < 1e-12)
+            {
+               normal = d;
+            }
+         }
+         MFEM_VERIFY(normal >= 0, "invalid face transformation");
+         const bool first = (std::abs(center[normal]) < 1e-12);
+         for (int k = 0; k < nfdofs; k++)
+         {
+            ip.x = nodes1d[k % nlayers];
+            ip.y = (dim == 3) ? nodes1d[k / nlayers] : 0.0;
+            loc.Transform(ip, eip);
+            const double coord[3] = { eip.x, eip.y, eip.z };
+            int idx[3] = { 0, 0, 0 };
+            for (int d = 0; d < dim; d++)
+            {
+               if (d == normal) { continue; }
+               for (int i = 1; i < nlayers; i++)
+               {
+                  if (std::abs(coord[d] - nodes1d[i]) <
+                      std::abs(coord[d] - nodes1d[idx[d]])) { idx[d] = i; }
+               }
+               MFEM_VERIFY(std::abs(coord[d] - nodes1d[idx[d]]) < 1e-10,
+                           "face and element nodes do not match");
+            }
+            for (int l = 0; l < nlayers; l++)
+            {
+               idx[normal] = first ? l : nlayers - 1 - l;
+               const int lex = idx[0] + nlayers*(idx[1] + nlayers*idx[2]);
+               const int did = dof_map.Size() ? dof_map[lex] : lex;
+               scatter_indices[l + nlayers*(k + nfdofs*(s + nsides*fi))] =
+                  dofs[did];
+            }
+         }
+      }
+   }
+
+   // Build the transpose (gather) map from the scatter map
+   offsets.SetSize(ndofs + 1);
+   offsets = 0;
+   for (int i = 0; i < nidx; i++)
+   {
+      ++offsets[scatter_indices[i] + 1];
+   }
+   for (int i = 1; i <= ndofs; i++)
+   {
+      offsets[i] += offsets[i - 1];
+   }
+   gather_indices.SetSize(nidx);
+   for (int i = 0; i < nidx; i++)
+   {
+      gather_indices[offsets[scatter_indices[i]]++] = i;
+   }
+   for (int i = ndofs; i > 0; --i)
+   {
+      offsets[i] = offsets[i - 1];
+   }
+   offsets[0] = 0;
+}
+
+void L2FaceRestriction::Mult(const Vector &x, Vector &y) const
+{
+   const int nl = nlayers;
+   const int nfd = nfdofs;
+   auto d_indices = scatter_indices.Read();
+   auto B0 = b0.Read();
+   auto G0 = g0.Read();
+   auto d_x = x.Read();
+   auto d_y = Reshape(y.Write(), nfd, 2, nsides*nf);
+   MFEM_FORALL(i, nf*nsides*nfd,
+   {
+      double v = 0.0, w = 0.0;
+      for (int l = 0; l < nl; l++)
+      {
+         const double xl = d_x[d_indices[l + nl*i]];
+         v += B0[l] * xl;
+         w += G0[l] * xl;
+      }
+      d_y(i % nfd, 0, i / nfd) = v;
+      d_y(i % nfd, 1, i / nfd) = w;
+   });
+}
+
+void L2FaceRestriction::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void L2FaceRestriction::AddMultTranspose(const Vector &x, Vector &y) const
+{
+   const int nl = nlayers;
+   const int nfd = nfdofs;
+   auto d_offsets = offsets.Read();
+   auto d_indices = gather_indices.Read();
+   auto B0 = b0.Read();
+   auto G0 = g0.Read();
+   auto d_x = Reshape(x.Read(), nfd, 2, nsides*nf);
+   auto d_y = y.ReadWrite();
+   MFEM_FORALL(i, ndofs,
+   {
+      double dofValue = 0.0;
+      for (int j = d_offsets[i]; j < d_offsets[i + 1]; ++j)
+      {
+         // position of the dof in the normal lines, see scatter_indices
+         const int l = d_indices[j] % nl;
+         const int line = d_indices[j] / nl;
+         dofValue += B0[l] * d_x(line % nfd, 0, line / nfd) +
+                     G0[l] * d_x(line % nfd, 1, line / nfd);
+      }
+      d_y[i] += dofValue;
+   });
+}
+
 ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
                                        ElementDofOrdering e_ordering)
    : fes(f),
@@ -2765,7 +3142,8 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
      dof(ne > 0 ? fes.GetFE(0)->GetDof() : 0),
      nedofs(ne*dof),
      offsets(ndofs+1),
-     indices(ne*dof)
+     indices(ne*dof),
+     gatherMap(ne*dof)
 {
    // Assuming all finite elements are the same.
    height = vdim*ne*dof;
@@ -2777,15 +3155,15 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
       for (int e = 0; e < ne; ++e)
       {
          const FiniteElement *fe = fes.GetFE(e);
-         const TensorBasisElement* el =
-            dynamic_cast<const TensorBasisElement*>(fe);
-         if (el) { continue; }
+         if (dynamic_cast<const TensorBasisElement*>(fe)) { continue; }
+         if (dynamic_cast<const VectorTensorFiniteElement*>(fe)) { continue; }
          mfem_error("Finite element not suitable for lexicographic ordering");
       }
       const FiniteElement *fe = fes.GetFE(0);
       const TensorBasisElement* el =
          dynamic_cast<const TensorBasisElement*>(fe);
-      const Array<int> &fe_dof_map = el->GetDofMap();
+      const Array<int> &fe_dof_map = el ? el->GetDofMap() :
+         dynamic_cast<const VectorTensorFiniteElement*>(fe)->GetDofMap();
       MFEM_VERIFY(fe_dof_map.Size() > 0, "invalid dof map");
       dof_map = fe_dof_map.GetData();
    }
@@ -2800,7 +3178,8 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    {
       for (int d = 0; d < dof; ++d)
       {
-         const int gid = elementMap[dof*e + d];
+         const int sgid = elementMap[dof*e + d];
+         const int gid = (sgid >= 0) ? sgid : -1 - sgid;
          ++offsets[gid + 1];
       }
    }
@@ -2814,10 +3193,16 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    {
       for (int d = 0; d < dof; ++d)
       {
-         const int did = (!dof_reorder)?d:dof_map[d];
-         const int gid = elementMap[dof*e + did];
+         // Both the dof map of vector elements (e.g. ND and RT) and the
+         // element-to-dof table may encode a change of sign as -1-index.
+         const int sdid = (!dof_reorder)?d:dof_map[d];
+         const int did = (sdid >= 0) ? sdid : -1 - sdid;
+         const int sgid = elementMap[dof*e + did];
+         const int gid = (sgid >= 0) ? sgid : -1 - sgid;
          const int lid = dof*e + d;
-         indices[offsets[gid]++] = lid;
+         const bool plus = (sdid >= 0) == (sgid >= 0);
+         indices[offsets[gid]++] = plus ? lid : -1 - lid;
+         gatherMap[lid] = plus ? gid : -1 - gid;
       }
    }
    // We shifted the offsets vector by 1 by using it as a counter.
@@ -2848,8 +3233,10 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
          const double dofValue = d_x(t?c:i,t?i:c);
          for (int j = offset; j < nextOffset; ++j)
          {
-            const int idx_j = d_indices[j];
-            d_y(idx_j % nd, c, idx_j / nd) = dofValue;
+            const int sidx_j = d_indices[j];
+            const int idx_j = (sidx_j >= 0) ? sidx_j : -1 - sidx_j;
+            d_y(idx_j % nd, c, idx_j / nd) =
+               (sidx_j >= 0) ? dofValue : -dofValue;
          }
       }
    });
@@ -2874,8 +3261,38 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
          double dofValue = 0;
          for (int j = offset; j < nextOffset; ++j)
          {
-            const int idx_j = d_indices[j];
-            dofValue +=  d_x(idx_j % nd, c, idx_j / nd);
+            const int sidx_j = d_indices[j];
+            const int idx_j = (sidx_j >= 0) ? sidx_j : -1 - sidx_j;
+            dofValue += (sidx_j >= 0) ? d_x(idx_j % nd, c, idx_j / nd) :
+                        -d_x(idx_j % nd, c, idx_j / nd);
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int sidx_j = d_indices[j];
+            const int idx_j = (sidx_j >= 0) ? sidx_j : -1 - sidx_j;
+            dofValue += d_x(idx_j % nd, c, idx_j / nd);
          }
          d_y(t?c:i,t?i:c) = dofValue;
       }
@@ -2883,6 +3300,132 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 }
 
 
+// Decode an entry of the ElementRestriction indices or gatherMap arrays, where
+// a change of sign is encoded as -1-index.
+MFEM_HOST_DEVICE static inline int DecodeDof(const int sdof)
+{
+   return (sdof >= 0) ? sdof : -1 - sdof;
+}
+
+MFEM_HOST_DEVICE static inline double DecodeSign(const int sdof)
+{
+   return (sdof >= 0) ? 1.0 : -1.0;
+}
+
+// Return the smallest element containing both of the dofs whose local copies
+// are listed in the sorted ranges [i_begin,i_end) and [j_begin,j_end) of the
+// ElementRestriction indices array, or -1 if no such element exists.
+MFEM_HOST_DEVICE static inline
+int GetMinSharedElement(const int *indices, const int nd,
+                        int i_begin, const int i_end,
+                        int j_begin, const int j_end)
+{
+   while (i_begin < i_end && j_begin < j_end)
+   {
+      const int e_i = DecodeDof(indices[i_begin]) / nd;
+      const int e_j = DecodeDof(indices[j_begin]) / nd;
+      if (e_i == e_j) { return e_i; }
+      if (e_i < e_j) { i_begin++; }
+      else { j_begin++; }
+   }
+   return -1;
+}
+
+int ElementRestriction::FillI(Array<int> &I) const
+{
+   MFEM_VERIFY(vdim == 1, "vector spaces are not supported");
+   const int nd = dof;
+   I.SetSize(ndofs+1);
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_gatherMap = gatherMap.Read();
+   auto d_I = I.Write();
+   MFEM_FORALL(i, ndofs,
+   {
+      const int i_begin = d_offsets[i];
+      const int i_end = d_offsets[i+1];
+      int nnz = 0;
+      for (int k = i_begin; k < i_end; k++)
+      {
+         const int e = DecodeDof(d_indices[k]) / nd;
+         for (int jd = 0; jd < nd; jd++)
+         {
+            // count the entry (i,j) only in the first element sharing i and j
+            const int j = DecodeDof(d_gatherMap[e*nd + jd]);
+            const int min_e = GetMinSharedElement(d_indices, nd, i_begin, i_end,
+                                                  d_offsets[j], d_offsets[j+1]);
+            if (min_e == e) { nnz++; }
+         }
+      }
+      d_I[i+1] = nnz;
+   });
+   // The prefix sum is sequential, so it is done on the host.
+   int *h_I = I.HostReadWrite();
+   h_I[0] = 0;
+   for (int i = 0; i < ndofs; i++)
+   {
+      h_I[i+1] += h_I[i];
+   }
+   return h_I[ndofs];
+}
+
+void ElementRestriction::FillJAndData(const Vector &ea_data,
+                                      SparseMatrix &mat) const
+{
+   MFEM_VERIFY(vdim == 1, "vector spaces are not supported");
+   MFEM_VERIFY(mat.Finalized() && mat.Height() == ndofs, "invalid matrix");
+   const int nd = dof;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_gatherMap = gatherMap.Read();
+   auto d_I = mat.ReadI();
+   auto d_J = mat.WriteJ();
+   auto d_data = mat.WriteData();
+   auto A = Reshape(ea_data.Read(), nd, nd, ne);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int i_begin = d_offsets[i];
+      const int i_end = d_offsets[i+1];
+      int pos = d_I[i];
+      for (int k = i_begin; k < i_end; k++)
+      {
+         const int e = DecodeDof(d_indices[k]) / nd;
+         for (int jd = 0; jd < nd; jd++)
+         {
+            const int j = DecodeDof(d_gatherMap[e*nd + jd]);
+            const int j_begin = d_offsets[j];
+            const int j_end = d_offsets[j+1];
+            const int min_e = GetMinSharedElement(d_indices, nd, i_begin, i_end,
+                                                  j_begin, j_end);
+            if (min_e != e) { continue; }
+            // sum the contributions of all elements sharing i and j
+            double val = 0.0;
+            int ki = i_begin, kj = j_begin;
+            while (ki < i_end && kj < j_end)
+            {
+               const int lid_i = DecodeDof(d_indices[ki]);
+               const int lid_j = DecodeDof(d_indices[kj]);
+               const int e_i = lid_i / nd;
+               const int e_j = lid_j / nd;
+               if (e_i == e_j)
+               {
+                  const double s = DecodeSign(d_indices[ki]) *
+                                   DecodeSign(d_indices[kj]);
+                  val += s * A(lid_i % nd, lid_j % nd, e_i);
+                  ki++; kj++;
+               }
+               else if (e_i < e_j) { ki++; }
+               else { kj++; }
+            }
+            d_J[pos] = j;
+            d_data[pos] = val;
+            pos++;
+         }
+      }
+   });
+}
+
+
 QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
                                                const IntegrationRule &ir)
 {
@@ -3233,11 +3776,401 @@ void QuadratureInterpolator::Mult(
    }
 }
 
+template<const int T_VDIM, const int T_ND, const int T_NQ>
+void QuadratureInterpolator::EvalTranspose(
+   const int NE,
+   const int dim,
+   const int vdim,
+   const DofToQuad &maps,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int nd = maps.ndof;
+   const int nq = maps.nqpt;
+   const int ND = T_ND ? T_ND : nd;
+   const int NQ = T_NQ ? T_NQ : nq;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   auto B = Reshape(maps.B.Read(), NQ, ND);
+   auto G = Reshape(maps.G.Read(), NQ, dim, ND);
+   auto val = Reshape(use_val ? q_val.Read() : NULL, NQ, VDIM, NE);
+   auto der = Reshape(use_der ? q_der.Read() : NULL, NQ, VDIM, dim, NE);
+   auto E = Reshape(e_vec.Write(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int ND = T_ND ? T_ND : nd;
+      const int NQ = T_NQ ? T_NQ : nq;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      for (int d = 0; d < ND; ++d)
+      {
+         for (int c = 0; c < VDIM; c++)
+         {
+            double ed = 0.0;
+            if (use_val)
+            {
+               for (int q = 0; q < NQ; ++q) { ed += B(q,d)*val(q,c,e); }
+            }
+            if (use_der)
+            {
+               for (int k = 0; k < dim; k++)
+               {
+                  for (int q = 0; q < NQ; ++q) { ed += G(q,k,d)*der(q,c,k,e); }
+               }
+            }
+            E(d,c,e) = ed;
+         }
+      }
+   });
+}
+
+template<const int T_VDIM, const int T_D1D, const int T_Q1D>
+void QuadratureInterpolator::TensorEvalTranspose2D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<int> &dof_map,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int d1d = maps.ndof;
+   const int q1d = maps.nqpt;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   auto B = Reshape(maps.B.Read(), Q1D, D1D);
+   auto G = Reshape(maps.G.Read(), Q1D, D1D);
+   auto map = Reshape(dof_map.Read(), D1D, D1D);
+   auto val = Reshape(use_val ? q_val.Read() : NULL, Q1D, Q1D, VDIM, NE);
+   auto der = Reshape(use_der ? q_der.Read() : NULL, Q1D, Q1D, VDIM, 2, NE);
+   auto E = Reshape(e_vec.Write(), D1D*D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      for (int c = 0; c < VDIM; c++)
+      {
+         double sol_xy[max_D1D][max_D1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx) { sol_xy[dy][dx] = 0.0; }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            // [0]: B_x val + G_x der_x, [1]: B_x der_y
+            double sol_x[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx][0] = sol_x[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double v = use_val ? val(qx,qy,c,e) : 0.0;
+               const double gx = use_der ? der(qx,qy,c,0,e) : 0.0;
+               const double gy = use_der ? der(qx,qy,c,1,e) : 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx = B(qx,dx);
+                  sol_x[dx][0] += v*wx + gx*G(qx,dx);
+                  sol_x[dx][1] += gy*wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] += sol_x[dx][0]*wy + sol_x[dx][1]*wDy;
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               E(map(dx,dy),c,e) = sol_xy[dy][dx];
+            }
+         }
+      }
+   });
+}
+
+template<const int T_VDIM, const int T_D1D, const int T_Q1D>
+void QuadratureInterpolator::TensorEvalTranspose3D(
+   const int NE,
+   const int vdim,
+   const DofToQuad &maps,
+   const Array<int> &dof_map,
+   const Vector &q_val,
+   const Vector &q_der,
+   Vector &e_vec,
+   const int eval_flags)
+{
+   const int d1d = maps.ndof;
+   const int q1d = maps.nqpt;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_val = eval_flags & VALUES;
+   const bool use_der = eval_flags & DERIVATIVES;
+   auto B = Reshape(maps.B.Read(), Q1D, D1D);
+   auto G = Reshape(maps.G.Read(), Q1D, D1D);
+   auto map = Reshape(dof_map.Read(), D1D, D1D, D1D);
+   auto val = Reshape(use_val ? q_val.Read() : NULL, Q1D, Q1D, Q1D, VDIM, NE);
+   auto der = Reshape(use_der ? q_der.Read() : NULL,
+                      Q1D, Q1D, Q1D, VDIM, 3, NE);
+   auto E = Reshape(e_vec.Write(), D1D*D1D*D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      for (int c = 0; c < VDIM; c++)
+      {
+         double sol_xyz[max_D1D][max_D1D][max_D1D];
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx) { sol_xyz[dz][dy][dx] = 0.0; }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            // [0]: B_y (B_x val + G_x der_x) + G_y B_x der_y, [1]: B_xy der_z
+            double sol_xy[max_D1D][max_D1D][2];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx][0] = sol_xy[dy][dx][1] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               // [0]: B_x val + G_x der_x, [1]: B_x der_y, [2]: B_x der_z
+               double sol_x[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx][0] = sol_x[dx][1] = sol_x[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double v = use_val ? val(qx,qy,qz,c,e) : 0.0;
+                  const double gx = use_der ? der(qx,qy,qz,c,0,e) : 0.0;
+                  const double gy = use_der ? der(qx,qy,qz,c,1,e) : 0.0;
+                  const double gz = use_der ? der(qx,qy,qz,c,2,e) : 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx = B(qx,dx);
+                     sol_x[dx][0] += v*wx + gx*G(qx,dx);
+                     sol_x[dx][1] += gy*wx;
+                     sol_x[dx][2] += gz*wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx][0] += sol_x[dx][0]*wy + sol_x[dx][1]*wDy;
+                     sol_xy[dy][dx][1] += sol_x[dx][2]*wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xyz[dz][dy][dx] +=
+                        sol_xy[dy][dx][0]*wz + sol_xy[dy][dx][1]*wDz;
+                  }
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  E(map(dx,dy,dz),c,e) = sol_xyz[dz][dy][dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+// Check if the points of 'ir' are the tensor product of its first 'q1d'
+// points, in the order assumed by the DofToQuad::TENSOR maps.
+static bool IsTensorProductRule(const IntegrationRule &ir, const int dim,
+                                const int q1d)
+{
+   int nq = 1;
+   for (int d = 0; d < dim; d++) { nq *= q1d; }
+   if (ir.GetNPoints() != nq) { return false; }
+   for (int q = 0; q < nq; q++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(q);
+      const double c[3] = { ip.x, ip.y, ip.z };
+      for (int d = 0, s = 1; d < dim; d++, s *= q1d)
+      {
+         if (c[d] != ir.IntPoint((q/s) % q1d).x) { return false; }
+      }
+   }
+   return true;
+}
+
 void QuadratureInterpolator::MultTranspose(
    unsigned eval_flags, const Vector &q_val, const Vector &q_der,
    Vector &e_vec) const
 {
-   MFEM_ABORT("this method is not implemented yet");
+   MFEM_VERIFY(!(eval_flags & DETERMINANTS),
+               "the DETERMINANTS flag is not supported");
+   const int ne = fespace->GetNE();
+   if (ne == 0) { return; }
+   const int vdim = fespace->GetVDim();
+   const int dim = fespace->GetMesh()->Dimension();
+   const FiniteElement *fe = fespace->GetFE(0);
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+   const TensorBasisElement *tfe =
+      dynamic_cast<const TensorBasisElement*>(fe);
+   const int d1d = fe->GetOrder() + 1;
+   const int q1d = (int)floor(pow(ir->GetNPoints(), 1.0/dim) + 0.5);
+
+   if (use_tensor_products && tfe && (dim == 2 || dim == 3) &&
+       d1d <= MAX_D1D && q1d <= MAX_Q1D &&
+       IsTensorProductRule(*ir, dim, q1d))
+   {
+      const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::TENSOR);
+      Array<int> dof_map(tfe->GetDofMap());
+      if (dof_map.Size() == 0)
+      {
+         dof_map.SetSize(fe->GetDof());
+         for (int i = 0; i < dof_map.Size(); i++) { dof_map[i] = i; }
+      }
+      void (*eval_func)(
+         const int NE,
+         const int vdim,
+         const DofToQuad &maps,
+         const Array<int> &dof_map,
+         const Vector &q_val,
+         const Vector &q_der,
+         Vector &e_vec,
+         const int eval_flags) = NULL;
+      if (dim == 2)
+      {
+         if (vdim == 1)
+         {
+            switch ((d1d << 4) | q1d)
+            {
+               case 0x22: eval_func = &TensorEvalTranspose2D<1,2,2>; break;
+               case 0x23: eval_func = &TensorEvalTranspose2D<1,2,3>; break;
+               case 0x33: eval_func = &TensorEvalTranspose2D<1,3,3>; break;
+               case 0x34: eval_func = &TensorEvalTranspose2D<1,3,4>; break;
+               case 0x44: eval_func = &TensorEvalTranspose2D<1,4,4>; break;
+               case 0x45: eval_func = &TensorEvalTranspose2D<1,4,5>; break;
+               case 0x55: eval_func = &TensorEvalTranspose2D<1,5,5>; break;
+               case 0x56: eval_func = &TensorEvalTranspose2D<1,5,6>; break;
+               default:   eval_func = &TensorEvalTranspose2D<1>;
+            }
+         }
+         else if (vdim == 2)
+         {
+            switch ((d1d << 4) | q1d)
+            {
+               case 0x22: eval_func = &TensorEvalTranspose2D<2,2,2>; break;
+               case 0x23: eval_func = &TensorEvalTranspose2D<2,2,3>; break;
+               case 0x33: eval_func = &TensorEvalTranspose2D<2,3,3>; break;
+               case 0x34: eval_func = &TensorEvalTranspose2D<2,3,4>; break;
+               case 0x44: eval_func = &TensorEvalTranspose2D<2,4,4>; break;
+               case 0x45: eval_func = &TensorEvalTranspose2D<2,4,5>; break;
+               default:   eval_func = &TensorEvalTranspose2D<2>;
+            }
+         }
+         else
+         {
+            eval_func = &TensorEvalTranspose2D<>;
+         }
+      }
+      else
+      {
+         if (vdim == 1)
+         {
+            switch ((d1d << 4) | q1d)
+            {
+               case 0x22: eval_func = &TensorEvalTranspose3D<1,2,2>; break;
+               case 0x23: eval_func = &TensorEvalTranspose3D<1,2,3>; break;
+               case 0x33: eval_func = &TensorEvalTranspose3D<1,3,3>; break;
+               case 0x34: eval_func = &TensorEvalTranspose3D<1,3,4>; break;
+               case 0x44: eval_func = &TensorEvalTranspose3D<1,4,4>; break;
+               case 0x45: eval_func = &TensorEvalTranspose3D<1,4,5>; break;
+               case 0x55: eval_func = &TensorEvalTranspose3D<1,5,5>; break;
+               case 0x56: eval_func = &TensorEvalTranspose3D<1,5,6>; break;
+               default:   eval_func = &TensorEvalTranspose3D<1>;
+            }
+         }
+         else if (vdim == 3)
+         {
+            switch ((d1d << 4) | q1d)
+            {
+               case 0x22: eval_func = &TensorEvalTranspose3D<3,2,2>; break;
+               case 0x23: eval_func = &TensorEvalTranspose3D<3,2,3>; break;
+               case 0x33: eval_func = &TensorEvalTranspose3D<3,3,3>; break;
+               case 0x34: eval_func = &TensorEvalTranspose3D<3,3,4>; break;
+               case 0x44: eval_func = &TensorEvalTranspose3D<3,4,4>; break;
+               case 0x45: eval_func = &TensorEvalTranspose3D<3,4,5>; break;
+               default:   eval_func = &TensorEvalTranspose3D<3>;
+            }
+         }
+         else
+         {
+            eval_func = &TensorEvalTranspose3D<>;
+         }
+      }
+      eval_func(ne, vdim, maps, dof_map, q_val, q_der, e_vec, eval_flags);
+      return;
+   }
+
+   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
+   void (*eval_func)(
+      const int NE,
+      const int dim,
+      const int vdim,
+      const DofToQuad &maps,
+      const Vector &q_val,
+      const Vector &q_der,
+      Vector &e_vec,
+      const int eval_flags) = NULL;
+   switch (vdim)
+   {
+      case 1: eval_func = &EvalTranspose<1>; break;
+      case 2: eval_func = &EvalTranspose<2>; break;
+      case 3: eval_func = &EvalTranspose<3>; break;
+      default: eval_func = &EvalTranspose<>;
+   }
+   eval_func(ne, dim, vdim, maps, q_val, q_der, e_vec, eval_flags);
 }
 
 } // namespace mfem
@@ -78,6 +78,7 @@ class NURBSExtension;
 class BilinearFormIntegrator;
 class QuadratureSpace;
 class QuadratureInterpolator;
+class L2FaceRestriction;
 
 
 /** @brief Class FiniteElementSpace - responsible for providing FEM view of the
@@ -85,6 +86,7 @@ class QuadratureInterpolator;
 class FiniteElementSpace
 {
    friend class InterpolationGridTransfer;
+   friend class PRefinementTransferOperator;
 
 protected:
    /// The mesh that FE space lives on (not owned).
@@ -128,6 +130,8 @@ protected:
 
    /// The element restriction operators, see GetElementRestriction().
    mutable OperatorHandle L2E_nat, L2E_lex;
+   /// The face restriction operators, see GetFaceRestriction().
+   mutable OperatorHandle L2F_int, L2F_bdr;
 
    mutable Array<QuadratureInterpolator*> E2Q_array;
 
@@ -176,6 +180,9 @@ protected:
       RefinementOperator(const FiniteElementSpace *fespace,
                          const FiniteElementSpace *coarse_fes);
       virtual void Mult(const Vector &x, Vector &y) const;
+      /** Add the contribution of every fine dof once, i.e. the exact transpose
+          of Mult(), used e.g. for the restriction in multigrid. */
+      virtual void MultTranspose(const Vector &x, Vector &y) const;
       virtual ~RefinementOperator();
    };
 
@@ -314,6 +321,12 @@ public:
        The returned Operator is owned by the FiniteElementSpace. */
    const Operator *GetElementRestriction(ElementDofOrdering e_ordering) const;
 
+   /** @brief Return an Operator that converts L-vectors to face E-vectors on
+       the faces of the given @a type, see L2FaceRestriction. */
+   /** Only discontinuous spaces of nodal tensor-product elements are supported.
+       The returned Operator is owned by the FiniteElementSpace. */
+   const L2FaceRestriction *GetFaceRestriction(FaceType type) const;
+
    /** @brief Return a QuadratureInterpolator that interpolates E-vectors to
        quadrature point values and/or derivatives (Q-vectors). */
    /** An E-vector represents the element-wise discontinuous version of the FE
@@ -399,18 +412,29 @@ public:
    { return mesh->GetBdrElementType(i); }
 
    /// Returns ElementTransformation for the @a i-th element.
+   /** The returned object is shared by all elements of the mesh, see
+       Mesh::GetElementTransformation(int). */
    ElementTransformation *GetElementTransformation(int i) const
    { return mesh->GetElementTransformation(i); }
 
    /** @brief Returns the transformation defining the @a i-th element in the
        user-defined variable @a ElTr. */
-   void GetElementTransformation(int i, IsoparametricTransformation *ElTr)
+   /** Threads using separate @a ElTr objects may call this method
+       concurrently, see Mesh::GetElementTransformation(int,
+       IsoparametricTransformation *). */
+   void GetElementTransformation(int i, IsoparametricTransformation *ElTr) const
    { mesh->GetElementTransformation(i, ElTr); }
 
    /// Returns ElementTransformation for the @a i-th boundary element.
    ElementTransformation *GetBdrElementTransformation(int i) const
    { return mesh->GetBdrElementTransformation(i); }
 
+   /** @brief Returns the transformation defining the @a i-th boundary element
+       in the user-defined variable @a ElTr. */
+   void GetBdrElementTransformation(int i,
+                                    IsoparametricTransformation *ElTr) const
+   { mesh->GetBdrElementTransformation(i, ElTr); }
+
    int GetAttribute(int i) const { return mesh->GetAttribute(i); }
 
    int GetBdrAttribute(int i) const { return mesh->GetBdrAttribute(i); }
@@ -623,6 +647,11 @@ public:
        FiniteElementCollection is owned by the caller. */
    FiniteElementCollection *Load(Mesh *m, std::istream &input);
 
+   /** @brief Same as above, with the first line of the FiniteElementSpace
+       header already read from @a input into @a header. */
+   FiniteElementCollection *Load(Mesh *m, std::istream &input,
+                                 const std::string &header);
+
    virtual ~FiniteElementSpace();
 };
 
@@ -669,6 +698,31 @@ public:
 };
 
 
+/** @brief Matrix-free transfer Operator from a coarse FE space to a fine FE
+    space defined on the same mesh, e.g. a lower order and a higher order space
+    as in p-multigrid. */
+/** The action is the element-wise nodal interpolation of the coarse space
+    functions, see FiniteElement::GetTransferMatrix(), and MultTranspose() is
+    its exact transpose. Both spaces must have the same vector dimension. */
+class PRefinementTransferOperator : public Operator
+{
+protected:
+   const FiniteElementSpace &lFESpace; ///< Coarse (low-order) space, not owned
+   const FiniteElementSpace &hFESpace; ///< Fine (high-order) space, not owned
+   DenseMatrix localP[Geometry::NumGeom];
+
+public:
+   PRefinementTransferOperator(const FiniteElementSpace &lFESpace_,
+                               const FiniteElementSpace &hFESpace_);
+
+   /// Interpolate the coarse L-vector @a x to the fine L-vector @a y.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// Apply the transpose of the interpolation.
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+};
+
+
 /** @brief Base class for transfer algorithms that construct transfer Operator%s
     between two finite element (FE) spaces. */
 /** Generally, the two FE spaces (domain and range) can be defined on different
@@ -764,7 +818,11 @@ public:
     (VALUE, INTEGRAL, H_DIV, H_CURL - see class FiniteElement). Generally, the
     FE spaces can have different orders, however, in order for the backward
     operator to be well-defined, the (local) number of the fine dofs should not
-    be smaller than the number of coarse dofs. */
+    be smaller than the number of coarse dofs.
+
+    If both FE spaces are defined on the same mesh, the matrix-free forward
+    operator is a PRefinementTransferOperator; the backward operator and the
+    Operator::MFEM_SPARSEMAT type are not supported in that case. */
 class InterpolationGridTransfer : public GridTransfer
 {
 protected:
@@ -893,11 +951,28 @@ protected:
    const int nedofs;
    Array<int> offsets;
    Array<int> indices;
+   Array<int> gatherMap;
 
 public:
    ElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+   /** @brief Same as MultTranspose(), but ignoring the sign changes of the
+       element dofs. Used to assemble diagonals from their element values. */
+   void MultTransposeUnsigned(const Vector &x, Vector &y) const;
+
+   /** @brief Compute the row offsets @a I, of size ndofs+1, of the sparse
+       matrix assembled from element matrices with the sparsity pattern given
+       by this ElementRestriction. Returns the number of nonzeros. */
+   /** Only scalar spaces (vdim = 1) are supported. */
+   int FillI(Array<int> &I) const;
+
+   /** @brief Fill the column indices and the entries of the finalized sparse
+       matrix @a mat, whose row offsets were computed with FillI(), by
+       assembling the batched element matrices @a ea_data. */
+   /** The element matrices are stored as described in
+       BilinearFormIntegrator::AssembleEA(). */
+   void FillJAndData(const Vector &ea_data, SparseMatrix &mat) const;
 };
 
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
@@ -917,6 +992,48 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
 };
 
+/// Operator that converts L2 FiniteElementSpace L-vectors to face E-vectors.
+/** Objects of this type are typically created and owned by FiniteElementSpace
+    objects, see FiniteElementSpace::GetFaceRestriction().
+
+    For each face of the given FaceType (see Mesh::GetFacesByType()) and each
+    of its sides (two for interior faces, one for boundary faces), the face
+    E-vector contains the trace of the adjacent element on the face and its
+    derivative in the reference direction normal to the face, pointing into
+    the element, at the face dofs. Its layout is (nfdofs, 2, nsides, nfaces),
+    where the face dof index is lexicographic in the reference coordinates of
+    the face, so that both sides of an interior face use the same ordering.
+    Both values are computed from the element dofs on the line normal to the
+    face through the face dof, see e.g. DGDiffusionIntegrator. */
+class L2FaceRestriction : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   int nf;
+   const int nsides;
+   int nlayers;
+   int nfdofs;
+   const int ndofs;
+   Array<int> faces;
+   /// Element dofs of the normal lines, (nlayers, nfdofs, nsides, nfaces).
+   Array<int> scatter_indices;
+   Array<int> offsets;
+   Array<int> gather_indices;
+   /// 1D basis and its derivative at the face end of the normal lines.
+   Array<double> b0, g0;
+
+public:
+   L2FaceRestriction(const FiniteElementSpace&, FaceType);
+
+   /// Return the mesh indices of the faces, see Mesh::GetFacesByType().
+   const Array<int> &GetFaces() const { return faces; }
+
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   /// Add the transpose action of the restriction to @a y.
+   void AddMultTranspose(const Vector &x, Vector &y) const;
+};
+
 /** @brief A class that performs interpolation from an E-vector to quadrature
     point values and/or derivatives (Q-vectors). */
 /** An E-vector represents the element-wise discontinuous version of the FE
@@ -937,6 +1054,8 @@ protected:
 
    mutable bool use_tensor_products;
 
+public:
+   /// Limits of the compute kernels, Eval2D() and Eval3D().
    static const int MAX_NQ2D = 100;
    static const int MAX_ND2D = 100;
    static const int MAX_VDIM2D = 2;
@@ -945,7 +1064,6 @@ protected:
    static const int MAX_ND3D = 1000;
    static const int MAX_VDIM3D = 3;
 
-public:
    enum EvalFlags
    {
       VALUES       = 1 << 0,  ///< Evaluate the values at quadrature points
@@ -964,8 +1082,8 @@ public:
 
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
-   /** Currently, tensor product evaluations are not implemented and this method
-       has no effect. */
+   /** Currently, tensor product evaluations are only used in MultTranspose()
+       and only when the IntegrationRule is a tensor product of a 1D rule. */
    void DisableTensorProducts(bool disable = true) const
    { use_tensor_products = !disable; }
 
@@ -981,7 +1099,12 @@ public:
    void Mult(const Vector &e_vec, unsigned eval_flags,
              Vector &q_val, Vector &q_der, Vector &q_det) const;
 
-   /// Perform the transpose operation of Mult(). (TODO)
+   /// Perform the transpose operation of Mult().
+   /** The E-vector @a e_vec is set to the sum of the transposed interpolation
+       of @a q_val, when the VALUES flag is set, and of @a q_der, when the
+       DERIVATIVES flag is set, i.e. @a e_vec = B^T q_val + G^T q_der. The
+       quadrature Vector%s use the same layouts as in Mult() and @a e_vec must
+       be allocated by the caller. The DETERMINANTS flag is not supported. */
    void MultTranspose(unsigned eval_flags, const Vector &q_val,
                       const Vector &q_der, Vector &e_vec) const;
 
@@ -1008,6 +1131,43 @@ public:
                       Vector &q_der,
                       Vector &q_det,
                       const int eval_flags);
+
+   /// Template compute kernel for the transpose in any dimension.
+   template<const int T_VDIM = 0, const int T_ND = 0, const int T_NQ = 0>
+   static void EvalTranspose(const int NE,
+                             const int dim,
+                             const int vdim,
+                             const DofToQuad &maps,
+                             const Vector &q_val,
+                             const Vector &q_der,
+                             Vector &e_vec,
+                             const int eval_flags);
+
+   /** @brief Template sum-factorized compute kernel for the transpose in 2D,
+       using DofToQuad::TENSOR @a maps. */
+   /** The lexicographic element dof with index i is stored in @a e_vec at the
+       native index @a dof_map[i]. */
+   template<const int T_VDIM = 0, const int T_D1D = 0, const int T_Q1D = 0>
+   static void TensorEvalTranspose2D(const int NE,
+                                     const int vdim,
+                                     const DofToQuad &maps,
+                                     const Array<int> &dof_map,
+                                     const Vector &q_val,
+                                     const Vector &q_der,
+                                     Vector &e_vec,
+                                     const int eval_flags);
+
+   /** @brief Template sum-factorized compute kernel for the transpose in 3D,
+       see TensorEvalTranspose2D(). */
+   template<const int T_VDIM = 0, const int T_D1D = 0, const int T_Q1D = 0>
+   static void TensorEvalTranspose3D(const int NE,
+                                     const int vdim,
+                                     const DofToQuad &maps,
+                                     const Array<int> &dof_map,
+                                     const Vector &q_val,
+                                     const Vector &q_der,
+                                     Vector &e_vec,
+                                     const int eval_flags);
 };
 
 }
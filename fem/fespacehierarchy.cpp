@@ -0,0 +1,118 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of the classes FiniteElementSpaceHierarchy and
+// ParFiniteElementSpaceHierarchy.
+
+#include "fespacehierarchy.hpp"
+
+namespace mfem
+{
+
+FiniteElementSpaceHierarchy::FiniteElementSpaceHierarchy(
+   Mesh *mesh, FiniteElementSpace *fespace, bool ownM, bool ownFES)
+{
+   meshes.Append(mesh);
+   fespaces.Append(fespace);
+   ownedMeshes.Append(ownM);
+   ownedFES.Append(ownFES);
+}
+
+FiniteElementSpaceHierarchy::~FiniteElementSpaceHierarchy()
+{
+   for (int i = 0; i < transfers.Size(); i++) { delete transfers[i]; }
+   for (int i = fespaces.Size() - 1; i >= 0; i--)
+   {
+      if (ownedFES[i]) { delete fespaces[i]; }
+   }
+   for (int i = 0; i < fecs.Size(); i++) { delete fecs[i]; }
+   for (int i = meshes.Size() - 1; i >= 0; i--)
+   {
+      if (ownedMeshes[i]) { delete meshes[i]; }
+   }
+}
+
+void FiniteElementSpaceHierarchy::AddLevel(Mesh *mesh,
+                                           FiniteElementSpace *fespace,
+                                           bool ownM, bool ownFES)
+{
+   MFEM_VERIFY(fespace->GetMesh() == mesh, "invalid mesh of the FE space");
+   transfers.Append(new InterpolationGridTransfer(GetFinestFESpace(),
+                                                  *fespace));
+   meshes.Append(mesh);
+   fespaces.Append(fespace);
+   ownedMeshes.Append(ownM);
+   ownedFES.Append(ownFES);
+}
+
+void FiniteElementSpaceHierarchy::AddUniformlyRefinedLevel()
+{
+   const FiniteElementSpace &coarse = GetFinestFESpace();
+   Mesh *mesh = new Mesh(*coarse.GetMesh());
+   mesh->UniformRefinement();
+   FiniteElementSpace *fespace =
+      new FiniteElementSpace(mesh, coarse.FEColl(), coarse.GetVDim(),
+                             coarse.GetOrdering());
+   AddLevel(mesh, fespace, true, true);
+}
+
+void FiniteElementSpaceHierarchy::AddOrderRefinedLevel(
+   FiniteElementCollection *fec)
+{
+   const FiniteElementSpace &coarse = GetFinestFESpace();
+   Mesh *mesh = coarse.GetMesh();
+   FiniteElementSpace *fespace =
+      new FiniteElementSpace(mesh, fec, coarse.GetVDim(),
+                             coarse.GetOrdering());
+   fecs.Append(fec);
+   AddLevel(mesh, fespace, false, true);
+}
+
+const Operator &FiniteElementSpaceHierarchy::GetProlongationAtLevel(
+   int level) const
+{
+   MFEM_VERIFY(level > 0 && level < GetNumLevels(), "invalid level " << level);
+   return transfers[level-1]->TrueForwardOperator();
+}
+
+#ifdef MFEM_USE_MPI
+ParFiniteElementSpaceHierarchy::ParFiniteElementSpaceHierarchy(
+   ParMesh *mesh, ParFiniteElementSpace *fespace, bool ownM, bool ownFES)
+   : FiniteElementSpaceHierarchy(mesh, fespace, ownM, ownFES)
+{
+   // empty
+}
+
+void ParFiniteElementSpaceHierarchy::AddUniformlyRefinedLevel()
+{
+   ParFiniteElementSpace &coarse = GetFinestFESpace();
+   ParMesh *mesh = new ParMesh(*coarse.GetParMesh());
+   mesh->UniformRefinement();
+   ParFiniteElementSpace *fespace =
+      new ParFiniteElementSpace(mesh, coarse.FEColl(), coarse.GetVDim(),
+                                coarse.GetOrdering());
+   AddLevel(mesh, fespace, true, true);
+}
+
+void ParFiniteElementSpaceHierarchy::AddOrderRefinedLevel(
+   FiniteElementCollection *fec)
+{
+   ParFiniteElementSpace &coarse = GetFinestFESpace();
+   ParMesh *mesh = coarse.GetParMesh();
+   ParFiniteElementSpace *fespace =
+      new ParFiniteElementSpace(mesh, fec, coarse.GetVDim(),
+                                coarse.GetOrdering());
+   fecs.Append(fec);
+   AddLevel(mesh, fespace, false, true);
+}
+#endif
+
+} // namespace mfem
@@ -0,0 +1,105 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_FESPACEHIERARCHY
+#define MFEM_FESPACEHIERARCHY
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+#ifdef MFEM_USE_MPI
+#include "pfespace.hpp"
+#endif
+
+namespace mfem
+{
+
+/// Hierarchy of FiniteElementSpace%s with the prolongations between them.
+/** Level 0 is the coarsest level. Finer levels are added either by a uniform
+    refinement of the mesh of the finest level (h-refinement) or by a finite
+    element collection of a higher order on the same mesh (p-refinement). The
+    prolongations are the true-dof forward operators of
+    InterpolationGridTransfer, so their transpose is the restriction used in
+    multigrid. */
+class FiniteElementSpaceHierarchy
+{
+protected:
+   Array<Mesh*> meshes;
+   Array<FiniteElementSpace*> fespaces;
+   Array<FiniteElementCollection*> fecs; ///< Owned
+   Array<InterpolationGridTransfer*> transfers; ///< Owned
+   Array<bool> ownedMeshes, ownedFES;
+
+public:
+   /// Construct a hierarchy with the single (coarsest) level @a fespace.
+   FiniteElementSpaceHierarchy(Mesh *mesh, FiniteElementSpace *fespace,
+                               bool ownM, bool ownFES);
+
+   virtual ~FiniteElementSpaceHierarchy();
+
+   /// Return the number of levels.
+   int GetNumLevels() const { return fespaces.Size(); }
+
+   /// Return the index of the finest level.
+   int GetFinestLevelIndex() const { return GetNumLevels() - 1; }
+
+   /// Add a finer level with the given @a mesh and @a fespace.
+   /** The mesh of @a fespace must either be the mesh of the finest level or a
+       refinement of it, see InterpolationGridTransfer. */
+   void AddLevel(Mesh *mesh, FiniteElementSpace *fespace, bool ownM,
+                 bool ownFES);
+
+   /** @brief Add a level obtained by a uniform refinement of a copy of the mesh
+       of the finest level, using the same FiniteElementCollection. */
+   virtual void AddUniformlyRefinedLevel();
+
+   /** @brief Add a level on the mesh of the finest level with the given
+       (higher order) FiniteElementCollection, which is owned by this object. */
+   virtual void AddOrderRefinedLevel(FiniteElementCollection *fec);
+
+   /// Return the FiniteElementSpace at the given @a level.
+   virtual FiniteElementSpace &GetFESpaceAtLevel(int level) const
+   { return *fespaces[level]; }
+
+   /// Return the FiniteElementSpace of the finest level.
+   virtual FiniteElementSpace &GetFinestFESpace() const
+   { return *fespaces.Last(); }
+
+   /// Return the true-dof prolongation from @a level - 1 to @a level.
+   const Operator &GetProlongationAtLevel(int level) const;
+};
+
+#ifdef MFEM_USE_MPI
+/// Parallel version of FiniteElementSpaceHierarchy.
+class ParFiniteElementSpaceHierarchy : public FiniteElementSpaceHierarchy
+{
+public:
+   ParFiniteElementSpaceHierarchy(ParMesh *mesh, ParFiniteElementSpace *fespace,
+                                  bool ownM, bool ownFES);
+
+   /** @brief Add a level obtained by a uniform refinement of a copy of the
+       ParMesh of the finest level. */
+   virtual void AddUniformlyRefinedLevel();
+
+   /** @brief Add a level on the ParMesh of the finest level with the given
+       (higher order) FiniteElementCollection, which is owned by this object. */
+   virtual void AddOrderRefinedLevel(FiniteElementCollection *fec);
+
+   virtual ParFiniteElementSpace &GetFESpaceAtLevel(int level) const
+   { return static_cast<ParFiniteElementSpace&>(*fespaces[level]); }
+
+   virtual ParFiniteElementSpace &GetFinestFESpace() const
+   { return static_cast<ParFiniteElementSpace&>(*fespaces.Last()); }
+};
+#endif
+
+} // namespace mfem
+
+#endif
@@ -14,12 +14,14 @@
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
 
 #include <limits>
 #include <cstring>
 #include <string>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
 
 namespace mfem
@@ -34,7 +36,31 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
    UseDevice(true);
 
    fes = new FiniteElementSpace;
-   fec = fes->Load(m, input);
+
+   string header;
+   input >> ws;
+   getline(input, header);
+   filter_dos(header);
+   if (header == "MFEM binary grid function v1.0")
+   {
+      // see GridFunction::SaveBinary()
+      bin_io::BinaryReader reader(input, header.size() + 1);
+      string fes_str(reader.SectionSize("fespace"), '\0');
+      reader.BeginSection("fespace");
+      reader.Read(&fes_str[0], fes_str.size());
+      istringstream fes_input(fes_str);
+      fec = fes->Load(m, fes_input);
+
+      SetSize(fes->GetVSize());
+      MFEM_VERIFY(reader.SectionSize("data") == size*sizeof(double),
+                  "invalid binary grid function");
+      reader.BeginSection("data");
+      reader.Read(HostWrite(), size);
+      reader.Finish();
+      sequence = fes->GetSequence();
+      return;
+   }
+   fec = fes->Load(m, input, header);
 
    skip_comment_lines(input, '#');
    istream::int_type next_char = input.peek();
@@ -2650,6 +2676,23 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void GridFunction::SaveBinary(std::ostream &out) const
+{
+   ostringstream fes_out;
+   fes->Save(fes_out);
+   const string fes_str = fes_out.str();
+
+   bin_io::BinaryWriter writer(out, "MFEM binary grid function v1.0");
+   writer.AddSection("fespace", fes_str.size());
+   writer.AddSection("data", size*sizeof(double));
+   writer.BeginSection("fespace");
+   writer.Write(fes_str.data(), fes_str.size());
+   writer.BeginSection("data");
+   writer.Write(HostRead(), size);
+   writer.Finish();
+   out.flush();
+}
+
 void GridFunction::SaveVTK(std::ostream &out, const std::string &field_name,
                            int ref)
 {
@@ -91,8 +91,8 @@ public:
 
    /// Construct a GridFunction on the given Mesh, using the data from @a input.
    /** The content of @a input should be in the format created by the method
-       Save(). The reconstructed FiniteElementSpace and FiniteElementCollection
-       are owned by the GridFunction. */
+       Save() or SaveBinary(). The reconstructed FiniteElementSpace and
+       FiniteElementCollection are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
@@ -474,6 +474,13 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /** @brief Save the GridFunction to an output stream in the binary format
+       "MFEM binary grid function v1.0". */
+   /** The file contains the FiniteElementSpace header of Save() and the data
+       array, little-endian and aligned, see bin_io::BinaryWriter. It can be
+       read with the constructor GridFunction(Mesh *, std::istream &). */
+   virtual void SaveBinary(std::ostream &out) const;
+
    /** Write the GridFunction in VTK format. Note that Mesh::PrintVTK must be
        called first. The parameter ref > 0 must match the one used in
        Mesh::PrintVTK. */
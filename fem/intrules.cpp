@@ -899,7 +899,7 @@ const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
 
    if (!HaveIntRule(*ir_array, Order))
    {
-#ifdef MFEM_USE_LEGACY_OPENMP
+#if defined(MFEM_USE_OPENMP) || defined(MFEM_USE_LEGACY_OPENMP)
       #pragma omp critical
 #endif
       {
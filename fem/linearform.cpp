@@ -13,6 +13,10 @@
 
 #include "fem.hpp"
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -24,6 +28,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   ext = NULL;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -76,8 +81,43 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+void LinearForm::UseFastAssembly(bool use_fa)
+{
+   delete ext;
+   ext = use_fa ? new LinearFormExtension(this) : NULL;
+}
+
+bool LinearForm::SupportsDevice() const
+{
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      if (!dlfi[k]->SupportsDevice()) { return false; }
+   }
+   for (int k = 0; k < blfi.Size(); k++)
+   {
+      if (!blfi[k]->SupportsDevice()) { return false; }
+   }
+   if (flfi.Size() > 0) { return false; }
+
+   const Mesh &mesh = *fes->GetMesh();
+   const int dim = mesh.Dimension();
+   if (fes->GetNURBSext() || mesh.GetNumGeometries(dim) > 1) { return false; }
+   if (blfi.Size() > 0 && dim > 1 && mesh.GetNumGeometries(dim-1) > 1)
+   {
+      return false;
+   }
+   return true;
+}
+
 void LinearForm::Assemble()
 {
+   if (ext && SupportsDevice())
+   {
+      ext->Assemble();
+      AssembleDelta();
+      return;
+   }
+
    Array<int> vdofs;
    ElementTransformation *eltrans;
    Vector elemvect;
@@ -90,7 +130,20 @@ void LinearForm::Assemble()
    // The first use of AddElementVector() below will move it back to host
    // because both 'vdofs' and 'elemvect' are on host.
 
-   if (dlfi.Size())
+   bool threaded = false;
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   threaded = Device::Allows(Backend::OMP_MASK);
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      threaded = threaded && dlfi[k]->IsThreadSafe();
+   }
+#endif
+
+   if (dlfi.Size() && threaded)
+   {
+      AssembleDomainThreaded();
+   }
+   else if (dlfi.Size())
    {
       for (i = 0; i < fes -> GetNE(); i++)
       {
@@ -201,6 +254,71 @@ void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
    fes = f;
    NewDataAndSize((double *)v + v_offset, fes->GetVSize());
    ResetDeltaLocations();
+   if (ext) { ext->Update(); }
+}
+
+void LinearForm::AssembleDomainThreaded()
+{
+   // Every thread uses its own transformation, see
+   // FiniteElementSpace::GetElementTransformation(int,
+   // IsoparametricTransformation *). The element vectors of a block of
+   // elements are computed in parallel and then added in the same order as in
+   // the serial assembly, so the result is the same.
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      MFEM_VERIFY(dlfi[k]->IsThreadSafe(),
+                  "domain integrator #" << k << " is not thread-safe");
+   }
+   if (dlfi.Size() == 0) { return; }
+   const int NE = fes->GetNE();
+   const int nint = dlfi.Size();
+#ifdef MFEM_USE_OPENMP
+   const int block_size = 64*omp_get_max_threads();
+#else
+   const int block_size = 64;
+#endif
+   Array<Vector *> elvects(std::min(block_size, NE)*nint);
+   for (int k = 0; k < elvects.Size(); k++) { elvects[k] = new Vector; }
+   GridFunction *nodes = fes->GetMesh()->GetNodes();
+   if (nodes) { nodes->HostRead(); }
+   Array<int> vdofs;
+
+   for (int b = 0; b < NE; b += block_size)
+   {
+      const int nb = std::min(block_size, NE - b);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel
+#endif
+      {
+         IsoparametricTransformation eltrans;
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(dynamic,4)
+#endif
+         for (int k = 0; k < nb; k++)
+         {
+            const int i = b + k;
+            const FiniteElement &fe = *fes->GetFE(i);
+            fes->GetElementTransformation(i, &eltrans);
+            for (int j = 0; j < nint; j++)
+            {
+               Vector &elvect = *elvects[k*nint + j];
+               dlfi[j]->AssembleRHSElementVect(fe, eltrans, elvect);
+            }
+         }
+      }
+
+      // Add the element vectors of the block in element order
+      for (int k = 0; k < nb; k++)
+      {
+         fes->GetElementVDofs(b + k, vdofs);
+         for (int j = 0; j < nint; j++)
+         {
+            AddElementVector(vdofs, *elvects[k*nint + j]);
+         }
+      }
+   }
+
+   for (int k = 0; k < elvects.Size(); k++) { delete elvects[k]; }
 }
 
 void LinearForm::AssembleDelta()
@@ -258,6 +376,7 @@ LinearForm & LinearForm::operator=(const Vector &v)
 
 LinearForm::~LinearForm()
 {
+   delete ext;
    if (!extern_lfs)
    {
       int k;
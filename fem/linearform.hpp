@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "lininteg.hpp"
 #include "gridfunc.hpp"
+#include "linearform_ext.hpp"
 
 namespace mfem
 {
@@ -22,6 +23,8 @@ namespace mfem
 /// Class for linear form - Vector with associated FE space and LFIntegrators.
 class LinearForm : public Vector
 {
+   friend class LinearFormExtension;
+
 protected:
    /// FE space on which the LinearForm lives. Not owned.
    FiniteElementSpace *fes;
@@ -56,6 +59,9 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// Batched device assembly, see UseFastAssembly(). Owned.
+   LinearFormExtension *ext;
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -64,7 +70,7 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; UseDevice(true); }
+   { fes = f; extern_lfs = 0; ext = NULL; UseDevice(true); }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +85,7 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; UseDevice(true); }
+   LinearForm() { fes = NULL; extern_lfs = 0; ext = NULL; UseDevice(true); }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -87,7 +93,7 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; }
+   { fes = f; extern_lfs = 0; ext = NULL; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -152,9 +158,36 @@ public:
        corresponding pointer (to Array<int>) will be NULL. */
    Array<Array<int>*> *GetFLFI_Marker() { return &flfi_marker; }
 
+   /** @brief Enable or disable the batched assembly of the domain and boundary
+       integrators, see LinearFormExtension. */
+   /** When enabled, Assemble() evaluates the coefficients at all quadrature
+       points at once and computes the element vectors with sum factorization
+       on the device, provided that SupportsDevice() returns true. Otherwise,
+       the default element-by-element assembly is used. */
+   void UseFastAssembly(bool use_fa);
+
+   /** @brief Return true if all the integrators, the mesh and the space are
+       supported by the batched assembly, see UseFastAssembly(). */
+   /** The batched assembly requires meshes with a single element type, and
+       integrators implementing LinearFormIntegrator::AssembleDevice(). Boundary
+       face integrators are not supported. */
+   bool SupportsDevice() const;
+
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
+   /** When MFEM is built with MFEM_USE_OPENMP and MFEM_THREAD_SAFE, and an
+       OpenMP backend is enabled in the Device, the element vectors of the
+       domain integrators are computed by multiple threads, provided that all
+       of them are thread-safe, see LinearFormIntegrator::IsThreadSafe(). The
+       vectors are added in element order, so the result does not depend on
+       the number of threads. */
    void Assemble();
 
+   /** @brief Add the element vectors of the domain integrators to the linear
+       form, computing them for blocks of elements with OpenMP threads. */
+   /** This is the threaded part of Assemble(). All domain integrators must be
+       thread-safe. The result is the same as with the serial assembly. */
+   void AssembleDomainThreaded();
+
    /// Assembles delta functions of the linear form
    void AssembleDelta();
 
@@ -163,11 +196,18 @@ public:
        updated, e.g. after its associated Mesh object has been refined.
 
        @note This method does not perform assembly. */
-   void Update() { SetSize(fes->GetVSize()); ResetDeltaLocations(); }
+   void Update()
+   {
+      SetSize(fes->GetVSize()); ResetDeltaLocations();
+      if (ext) { ext->Update(); }
+   }
 
    /// Associate a new FE space, @a *f, with this object and Update() it. */
    void Update(FiniteElementSpace *f)
-   { fes = f; SetSize(f->GetVSize()); ResetDeltaLocations(); }
+   {
+      fes = f; SetSize(f->GetVSize()); ResetDeltaLocations();
+      if (ext) { ext->Update(); }
+   }
 
    /** @brief Associate a new FE space, @a *f, with this object and use the data
        of @a v, offset by @a v_offset, to initialize this object's Vector::data.
@@ -0,0 +1,150 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class LinearFormExtension
+
+#include "../general/forall.hpp"
+#include "linearform.hpp"
+
+namespace mfem
+{
+
+LinearFormExtension::LinearFormExtension(LinearForm *form)
+   : lf(form), elem_restrict(NULL)
+{
+   Update();
+}
+
+void LinearFormExtension::Update()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const int ne = fes.GetNE();
+   elem_restrict = NULL;
+   if (ne > 0)
+   {
+      // the native ordering is used for elements without tensor structure
+      const bool tensor =
+         dynamic_cast<const TensorBasisElement*>(fes.GetFE(0)) != NULL;
+      elem_restrict = fes.GetElementRestriction(
+                         tensor ? ElementDofOrdering::LEXICOGRAPHIC :
+                         ElementDofOrdering::NATIVE);
+      b.SetSize(elem_restrict->Height(), Device::GetMemoryType());
+      b.UseDevice(true);
+   }
+   markers.SetSize(ne);
+   markers = 1;
+   // the boundary maps are built by the first assembly
+   bdr_indices.DeleteAll();
+}
+
+void LinearFormExtension::SetupBoundary()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const int nbe = fes.GetNBE();
+   const int vsize = fes.GetVSize();
+   const int nd = nbe > 0 ? fes.GetBE(0)->GetDof()*fes.GetVDim() : 0;
+   const int size = nbe*nd;
+
+   bdr_indices.SetSize(size);
+   Array<int> vdofs;
+   for (int be = 0; be < nbe; be++)
+   {
+      fes.GetBdrElementVDofs(be, vdofs);
+      MFEM_VERIFY(vdofs.Size() == nd, "all the boundary elements must have the"
+                  " same number of dofs");
+      for (int i = 0; i < nd; i++)
+      {
+         MFEM_VERIFY(vdofs[i] >= 0, "spaces with signed dofs are not supported");
+         bdr_indices[i + nd*be] = vdofs[i];
+      }
+   }
+
+   // Build the transpose (gather) map
+   bdr_offsets.SetSize(vsize + 1);
+   bdr_offsets = 0;
+   for (int i = 0; i < size; i++)
+   {
+      ++bdr_offsets[bdr_indices[i] + 1];
+   }
+   for (int i = 1; i <= vsize; i++)
+   {
+      bdr_offsets[i] += bdr_offsets[i - 1];
+   }
+   bdr_gather.SetSize(size);
+   for (int i = 0; i < size; i++)
+   {
+      bdr_gather[bdr_offsets[bdr_indices[i]]++] = i;
+   }
+   for (int i = vsize; i > 0; --i)
+   {
+      bdr_offsets[i] = bdr_offsets[i - 1];
+   }
+   bdr_offsets[0] = 0;
+
+   bdr_markers.SetSize(nbe);
+   bdr_b.SetSize(size, Device::GetMemoryType());
+   bdr_b.UseDevice(true);
+}
+
+void LinearFormExtension::Assemble()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   Vector &y = *lf;
+
+   Array<LinearFormIntegrator*> &domain_integs = lf->dlfi;
+   if (domain_integs.Size() > 0 && elem_restrict)
+   {
+      b = 0.0;
+      for (int k = 0; k < domain_integs.Size(); k++)
+      {
+         domain_integs[k]->AssembleDevice(fes, markers, b);
+      }
+      elem_restrict->MultTranspose(b, y);
+   }
+   else
+   {
+      y = 0.0;
+   }
+
+   Array<LinearFormIntegrator*> &boundary_integs = lf->blfi;
+   if (boundary_integs.Size() > 0 && fes.GetNBE() > 0)
+   {
+      if (bdr_indices.Size() == 0) { SetupBoundary(); }
+      Mesh &mesh = *fes.GetMesh();
+      bdr_b = 0.0;
+      for (int k = 0; k < boundary_integs.Size(); k++)
+      {
+         const Array<int> *marker = lf->blfi_marker[k];
+         for (int be = 0; be < bdr_markers.Size(); be++)
+         {
+            const int attr = mesh.GetBdrAttribute(be);
+            bdr_markers[be] = (marker == NULL) || (*marker)[attr-1];
+         }
+         boundary_integs[k]->AssembleDevice(fes, bdr_markers, bdr_b);
+      }
+
+      auto d_offsets = bdr_offsets.Read();
+      auto d_gather = bdr_gather.Read();
+      auto d_b = bdr_b.Read();
+      auto d_y = y.ReadWrite();
+      MFEM_FORALL(i, fes.GetVSize(),
+      {
+         double dofValue = 0.0;
+         for (int j = d_offsets[i]; j < d_offsets[i + 1]; ++j)
+         {
+            dofValue += d_b[d_gather[j]];
+         }
+         d_y[i] += dofValue;
+      });
+   }
+}
+
+}
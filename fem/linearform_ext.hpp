@@ -0,0 +1,61 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_LINEARFORM_EXT
+#define MFEM_LINEARFORM_EXT
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+class LinearForm;
+
+/// Class extending the LinearForm class with a batched assembly on device.
+/** The domain integrators add the element vectors of all elements to an
+    E-vector, see LinearFormIntegrator::AssembleDevice(), which is then summed
+    into the LinearForm by the lexicographic ElementRestriction (native for
+    elements without tensor-product structure). The boundary integrators do the
+    same with an E-vector of the boundary elements, which is summed into the
+    LinearForm with the gather map built by this class. */
+class LinearFormExtension
+{
+protected:
+   LinearForm *lf; ///< Not owned
+
+   const Operator *elem_restrict; ///< Not owned
+   Array<int> markers; ///< All elements are marked
+   Vector b; ///< Domain E-vector
+
+   /// Boundary E-vector dof -> vdof map, (ndofs, vdim, nbe)
+   Array<int> bdr_indices;
+   /// Transpose of #bdr_indices in CSR format
+   Array<int> bdr_offsets, bdr_gather;
+   Array<int> bdr_markers;
+   Vector bdr_b; ///< Boundary E-vector
+
+   /// Setup the maps used by the boundary integrators.
+   void SetupBoundary();
+
+public:
+   LinearFormExtension(LinearForm *form);
+
+   /// Assemble the domain and boundary integrators of the LinearForm.
+   void Assemble();
+
+   /// Update the internal data after a change of the FiniteElementSpace.
+   void Update();
+};
+
+}
+
+#endif
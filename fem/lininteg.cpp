@@ -22,12 +22,22 @@ void LinearFormIntegrator::AssembleRHSElementVect(
    mfem_error("LinearFormIntegrator::AssembleRHSElementVect(...)");
 }
 
+void LinearFormIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers, Vector &b)
+{
+   MFEM_ABORT("LinearFormIntegrator::AssembleDevice(...)\n"
+              "   is not implemented for this class.");
+}
+
 
 void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
                                                 ElementTransformation &Tr,
                                                 Vector &elvect)
 {
    int dof = el.GetDof();
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
 
    shape.SetSize(dof);       // vector of size dof
    elvect.SetSize(dof);
@@ -172,6 +182,9 @@ void VectorDomainLFIntegrator::AssembleRHSElementVect(
    int dof  = el.GetDof();
 
    double val,cf;
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, Qvec;
+#endif
 
    shape.SetSize(dof);       // vector of size dof
 
@@ -213,6 +226,9 @@ void VectorDomainLFIntegrator::AssembleDeltaElementVect(
    MFEM_ASSERT(vec_delta != NULL, "coefficient must be VectorDeltaCoefficient");
    int vdim = Q.GetVDim();
    int dof  = fe.GetDof();
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, Qvec;
+#endif
 
    shape.SetSize(dof);
    fe.CalcPhysShape(Trans, shape);
@@ -305,6 +321,10 @@ void VectorFEDomainLFIntegrator::AssembleRHSElementVect(
 {
    int dof = el.GetDof();
    int spaceDim = Tr.GetSpaceDim();
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix vshape;
+   Vector vec;
+#endif
 
    vshape.SetSize(dof,spaceDim);
    vec.SetSize(spaceDim);
@@ -340,6 +360,10 @@ void VectorFEDomainLFIntegrator::AssembleDeltaElementVect(
    MFEM_ASSERT(vec_delta != NULL, "coefficient must be VectorDeltaCoefficient");
    int dof = fe.GetDof();
    int spaceDim = Trans.GetSpaceDim();
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix vshape;
+   Vector vec;
+#endif
 
    vshape.SetSize(dof, spaceDim);
    fe.CalcPhysVShape(Trans, vshape);
@@ -18,6 +18,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -36,6 +38,28 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /// Return true if the integrator implements AssembleDevice().
+   virtual bool SupportsDevice() const { return false; }
+
+   /** @brief Return true if AssembleRHSElementVect() can be called
+       concurrently for different elements, see LinearForm::Assemble(). */
+   /** This requires the integrator to use local work arrays when
+       MFEM_THREAD_SAFE is defined and its coefficients to be thread-safe, see
+       Coefficient::IsThreadSafe(). */
+   virtual bool IsThreadSafe() const { return false; }
+
+   /** @brief Batched assembly of the element vectors of all the elements of
+       @a fes (domain integrators) or of all its boundary elements (boundary
+       integrators), see LinearForm::UseFastAssembly(). */
+   /** The element vectors are added to the E-vector @a b: for domain
+       integrators it has the layout of the lexicographic ElementRestriction of
+       @a fes (native for elements without tensor-product structure), for
+       boundary integrators it is (ndofs, vdim, nbe) with the dofs in the native
+       ordering of the boundary elements. Only the elements with a nonzero entry
+       in @a markers, of size ne or nbe, contribute. */
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
    void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -92,7 +116,9 @@ public:
 /// Class for domain integration L(v) := (f, v)
 class DomainLFIntegrator : public DeltaLFIntegrator
 {
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
    Coefficient &Q;
    int oa, ob;
 public:
@@ -116,6 +142,13 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice() const { return true; }
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
+   virtual bool IsThreadSafe() const { return Q.IsThreadSafe(); }
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -136,6 +169,11 @@ public:
                                        ElementTransformation &Tr,
                                        Vector &elvect);
 
+   virtual bool SupportsDevice() const { return true; }
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -180,7 +218,9 @@ public:
 class VectorDomainLFIntegrator : public DeltaLFIntegrator
 {
 private:
+#ifndef MFEM_THREAD_SAFE
    Vector shape, Qvec;
+#endif
    VectorCoefficient &Q;
 
 public:
@@ -198,6 +238,13 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice() const { return true; }
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
+   virtual bool IsThreadSafe() const { return Q.IsThreadSafe(); }
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -232,8 +279,10 @@ class VectorFEDomainLFIntegrator : public DeltaLFIntegrator
 {
 private:
    VectorCoefficient &QF;
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix vshape;
    Vector vec;
+#endif
 
 public:
    VectorFEDomainLFIntegrator(VectorCoefficient &F)
@@ -247,6 +296,8 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool IsThreadSafe() const { return QF.IsThreadSafe(); }
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -0,0 +1,336 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "lininteg.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+// Batched (device) assembly of the linear form integrators
+//
+// The integrators compute the weighted coefficient values D at all quadrature
+// points of all elements and then apply B^T to them, with sum factorization
+// for tensor-product elements in 2D and 3D, adding the result to the E-vector.
+
+// Apply B^T for any type of element: y(d,c,e) += sum_q B(q,d) D(q,c,e)
+static void LFApplyBt(const int NE,
+                      const int VDIM,
+                      const int ND,
+                      const int NQ,
+                      const Array<double> &b,
+                      const Vector &_D,
+                      Vector &_y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(_D.Read(), NQ, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VDIM; c++)
+      {
+         for (int d = 0; d < ND; d++)
+         {
+            double sum = 0.0;
+            for (int q = 0; q < NQ; q++)
+            {
+               sum += B(q,d) * D(q,c,e);
+            }
+            y(d,c,e) += sum;
+         }
+      }
+   });
+}
+
+// Apply B^T with sum factorization on quadrilaterals
+static void LFApplyBt2D(const int NE,
+                        const int VDIM,
+                        const int D1D,
+                        const int Q1D,
+                        const Array<double> &b,
+                        const Vector &_D,
+                        Vector &_y)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D && Q1D <= MAX_Q1D, "order is too high");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto D = Reshape(_D.Read(), Q1D, Q1D, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double t[MAX_Q1D][MAX_D1D];
+      for (int c = 0; c < VDIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               t[qy][dx] = 0.0;
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  t[qy][dx] += B(qx,dx) * D(qx,qy,c,e);
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; dy++)
+         {
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               double sum = 0.0;
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  sum += B(qy,dy) * t[qy][dx];
+               }
+               y(dx,dy,c,e) += sum;
+            }
+         }
+      }
+   });
+}
+
+// Apply B^T with sum factorization on hexahedra
+static void LFApplyBt3D(const int NE,
+                        const int VDIM,
+                        const int D1D,
+                        const int Q1D,
+                        const Array<double> &b,
+                        const Vector &_D,
+                        Vector &_y)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D && Q1D <= MAX_Q1D, "order is too high");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto D = Reshape(_D.Read(), Q1D, Q1D, Q1D, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double t1[MAX_Q1D][MAX_Q1D][MAX_D1D];
+      double t2[MAX_Q1D][MAX_D1D][MAX_D1D];
+      for (int c = 0; c < VDIM; c++)
+      {
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  t1[qz][qy][dx] = 0.0;
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     t1[qz][qy][dx] += B(qx,dx) * D(qx,qy,qz,c,e);
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  t2[qz][dy][dx] = 0.0;
+                  for (int qy = 0; qy < Q1D; qy++)
+                  {
+                     t2[qz][dy][dx] += B(qy,dy) * t1[qz][qy][dx];
+                  }
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; dz++)
+         {
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  double sum = 0.0;
+                  for (int qz = 0; qz < Q1D; qz++)
+                  {
+                     sum += B(qz,dz) * t2[qz][dy][dx];
+                  }
+                  y(dx,dy,dz,c,e) += sum;
+               }
+            }
+         }
+      }
+   });
+}
+
+// Evaluate the scalar or vector coefficient at the quadrature points of all
+// elements. Constant coefficients are stored only once.
+static void LFCoefficientValues(Coefficient *Q, VectorCoefficient *VQ,
+                                const FiniteElementSpace &fes,
+                                const IntegrationRule &ir, Vector &coeff)
+{
+   const int ne = fes.GetNE();
+   const int nq = ir.GetNPoints();
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else if (VectorConstantCoefficient *cVQ =
+               dynamic_cast<VectorConstantCoefficient*>(VQ))
+   {
+      coeff = cVQ->GetVec();
+   }
+   else if (Q)
+   {
+      Q->EvalBatched(*fes.GetMesh(), ir, coeff);
+   }
+   else
+   {
+      const int vdim = VQ->GetVDim();
+      coeff.SetSize(vdim * nq * ne);
+      auto C = Reshape(coeff.HostWrite(), vdim, nq, ne);
+      Vector Qvec(vdim);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            VQ->Eval(Qvec, T, ip);
+            for (int c = 0; c < vdim; c++) { C(c,q,e) = Qvec(c); }
+         }
+      }
+   }
+}
+
+// Batched assembly of the domain integrators (f, v) with a scalar (VDIM = 1)
+// or vector coefficient f.
+static void LFDomainAssemble(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const int VDIM,
+                             const Vector &coeff,
+                             const Array<int> &markers,
+                             Vector &b)
+{
+   // Assumes all elements have the same type
+   Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   MFEM_VERIFY(fes.GetVDim() == VDIM, "the dimensions of the coefficient and "
+               "of the space do not match");
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+
+   // D(q,c,e) = marker(e) * W(q) * detJ(q,e) * f_c(q,e)
+   Vector D(NQ*VDIM*NE, Device::GetMemoryType());
+   const bool const_c = (coeff.Size() == VDIM);
+   auto W = ir.GetWeights().Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NE);
+   auto C = const_c ? Reshape(coeff.Read(), VDIM, 1, 1) :
+            Reshape(coeff.Read(), VDIM, NQ, NE);
+   auto M = markers.Read();
+   auto d_D = Reshape(D.Write(), NQ, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VDIM; c++)
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            const double f = const_c ? C(c,0,0) : C(c,q,e);
+            d_D(q,c,e) = M[e] ? W[q] * detJ(q,e) * f : 0.0;
+         }
+      }
+   });
+
+   const FiniteElement &el = *fes.GetFE(0);
+   const bool tensor = dynamic_cast<const TensorBasisElement*>(&el) != NULL;
+   const DofToQuad &maps =
+      el.GetDofToQuad(ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
+   if (tensor && dim == 2)
+   {
+      return LFApplyBt2D(NE, VDIM, maps.ndof, maps.nqpt, maps.B, D, b);
+   }
+   if (tensor && dim == 3)
+   {
+      return LFApplyBt3D(NE, VDIM, maps.ndof, maps.nqpt, maps.B, D, b);
+   }
+   // in 1D the tensor-product maps are the full ones in lexicographic order
+   LFApplyBt(NE, VDIM, maps.ndof, maps.nqpt, maps.B, D, b);
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        const Array<int> &markers, Vector &b)
+{
+   if (fes.GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleRHSElementVect()
+      ir = &IntRules.Get(el.GetGeomType(), oa * el.GetOrder() + ob);
+   }
+   Vector coeff;
+   LFCoefficientValues(&Q, NULL, fes, *ir, coeff);
+   LFDomainAssemble(fes, *ir, 1, coeff, markers, b);
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              const Array<int> &markers,
+                                              Vector &b)
+{
+   if (fes.GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleRHSElementVect()
+      ir = &IntRules.Get(el.GetGeomType(), 2*el.GetOrder());
+   }
+   Vector coeff;
+   LFCoefficientValues(NULL, &Q, fes, *ir, coeff);
+   LFDomainAssemble(fes, *ir, Q.GetVDim(), coeff, markers, b);
+}
+
+void BoundaryLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers, Vector &b)
+{
+   // Assumes all boundary elements have the same type
+   const int NBE = fes.GetNBE();
+   if (NBE == 0) { return; }
+   MFEM_VERIFY(fes.GetVDim() == 1, "only scalar spaces are supported");
+   const FiniteElement &el = *fes.GetBE(0);
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // same rule as in AssembleRHSElementVect()
+      ir = &IntRules.Get(el.GetGeomType(), oa * el.GetOrder() + ob);
+   }
+   const int NQ = ir->GetNPoints();
+
+   // The surface measure and the coefficient are evaluated together, since
+   // the geometric factors are not available for the boundary elements.
+   Vector D(NQ*NBE, Device::GetMemoryType());
+   auto d_D = Reshape(D.HostWrite(), NQ, NBE);
+   auto M = markers.HostRead();
+   for (int be = 0; be < NBE; be++)
+   {
+      if (M[be] == 0)
+      {
+         for (int q = 0; q < NQ; q++) { d_D(q,be) = 0.0; }
+         continue;
+      }
+      ElementTransformation &T = *fes.GetBdrElementTransformation(be);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         T.SetIntPoint(&ip);
+         d_D(q,be) = ip.weight * T.Weight() * Q.Eval(T, ip);
+      }
+   }
+   const DofToQuad &maps = el.GetDofToQuad(*ir, DofToQuad::FULL);
+   LFApplyBt(NBE, 1, maps.ndof, maps.nqpt, maps.B, D, b);
+}
+
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class GeometricMultigrid
+
+#include "multigrid.hpp"
+#include "../linalg/linalg.hpp"
+#ifdef MFEM_USE_MPI
+#include "pbilinearform.hpp"
+#endif
+
+namespace mfem
+{
+
+GeometricMultigrid::GeometricMultigrid(
+   const FiniteElementSpaceHierarchy &fespaces_)
+   : fespaces(fespaces_), coarsePrec(NULL), smootherOrder(2)
+{
+   // empty
+}
+
+GeometricMultigrid::~GeometricMultigrid()
+{
+   delete coarsePrec;
+   for (int i = 0; i < bfs.Size(); i++) { delete bfs[i]; }
+   for (int i = 0; i < essentialTrueDofs.Size(); i++)
+   {
+      delete essentialTrueDofs[i];
+   }
+}
+
+void GeometricMultigrid::Setup(const Array<int> &ess_bdr)
+{
+   MFEM_VERIFY(NumLevels() == 0, "Setup() was already called");
+   for (int level = 0; level < fespaces.GetNumLevels(); level++)
+   {
+      FiniteElementSpace &fes = fespaces.GetFESpaceAtLevel(level);
+      BilinearForm *form;
+#ifdef MFEM_USE_MPI
+      ParFiniteElementSpace *pfes = dynamic_cast<ParFiniteElementSpace*>(&fes);
+      if (pfes) { form = new ParBilinearForm(pfes); }
+      else
+#endif
+      {
+         form = new BilinearForm(&fes);
+      }
+      bfs.Append(form);
+      Array<int> *ess_tdofs = new Array<int>;
+      fes.GetEssentialTrueDofs(ess_bdr, *ess_tdofs);
+      essentialTrueDofs.Append(ess_tdofs);
+
+      AddIntegrators(*form);
+      if (level == 0)
+      {
+         ConstructCoarseOperatorAndSolver(*form, *ess_tdofs);
+      }
+      else
+      {
+         ConstructOperatorAndSmoother(level, *form, *ess_tdofs);
+      }
+   }
+}
+
+void GeometricMultigrid::ConstructCoarseOperatorAndSolver(
+   BilinearForm &form, const Array<int> &ess_tdofs)
+{
+   form.Assemble();
+   Solver *solver;
+#ifdef MFEM_USE_MPI
+   if (dynamic_cast<ParBilinearForm*>(&form))
+   {
+      OperatorHandle A(Operator::Hypre_ParCSR);
+      form.FormSystemMatrix(ess_tdofs, A);
+      HypreBoomerAMG *amg = new HypreBoomerAMG(*A.As<HypreParMatrix>());
+      amg->SetPrintLevel(0);
+      solver = amg;
+      AddLevel(A.Ptr(), solver, NULL, A.OwnsOperator(), true, false);
+      A.SetOperatorOwner(false);
+      return;
+   }
+#endif
+   OperatorHandle A(Operator::MFEM_SPARSEMAT);
+   form.FormSystemMatrix(ess_tdofs, A);
+   coarsePrec = new DSmoother(*A.As<SparseMatrix>());
+   CGSolver *cg = new CGSolver;
+   cg->SetRelTol(1e-10);
+   cg->SetAbsTol(0.0);
+   cg->SetMaxIter(1000);
+   cg->SetPrintLevel(-1);
+   cg->iterative_mode = false;
+   cg->SetOperator(*A.Ptr());
+   cg->SetPreconditioner(*coarsePrec);
+   solver = cg;
+   AddLevel(A.Ptr(), solver, NULL, A.OwnsOperator(), true, false);
+   A.SetOperatorOwner(false);
+}
+
+void GeometricMultigrid::ConstructOperatorAndSmoother(
+   int level, BilinearForm &form, const Array<int> &ess_tdofs)
+{
+   FiniteElementSpace &fes = fespaces.GetFESpaceAtLevel(level);
+   form.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   form.Assemble();
+   OperatorHandle A;
+   form.FormSystemMatrix(ess_tdofs, A);
+   Vector diag(fes.GetTrueVSize());
+   form.AssembleDiagonal(diag);
+
+   Solver *smoother;
+#ifdef MFEM_USE_MPI
+   ParFiniteElementSpace *pfes = dynamic_cast<ParFiniteElementSpace*>(&fes);
+   if (pfes)
+   {
+      smoother = new OperatorChebyshevSmoother(pfes->GetComm(), *A.Ptr(),
+                                               diag, ess_tdofs, smootherOrder);
+   }
+   else
+#endif
+   {
+      smoother = new OperatorChebyshevSmoother(*A.Ptr(), diag, ess_tdofs,
+                                               smootherOrder);
+   }
+   Operator *P =
+      const_cast<Operator*>(&fespaces.GetProlongationAtLevel(level));
+   AddLevel(A.Ptr(), smoother, P, A.OwnsOperator(), true, false);
+   A.SetOperatorOwner(false);
+}
+
+void GeometricMultigrid::FormFineLinearSystem(Vector &x, Vector &b,
+                                              OperatorHandle &A,
+                                              Vector &X, Vector &B)
+{
+   MFEM_VERIFY(NumLevels() > 0, "Setup() must be called first");
+   bfs.Last()->FormLinearSystem(*essentialTrueDofs.Last(), x, b, A, X, B);
+}
+
+void GeometricMultigrid::RecoverFineFEMSolution(const Vector &X,
+                                                const Vector &b, Vector &x)
+{
+   bfs.Last()->RecoverFEMSolution(X, b, x);
+}
+
+} // namespace mfem
@@ -0,0 +1,82 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_FEM_MULTIGRID
+#define MFEM_FEM_MULTIGRID
+
+#include "../config/config.hpp"
+#include "../linalg/multigrid.hpp"
+#include "fespacehierarchy.hpp"
+#include "bilinearform.hpp"
+
+namespace mfem
+{
+
+/// Geometric (h- and p-) multigrid on a FiniteElementSpaceHierarchy.
+/** The operators of the levels l > 0 are partially assembled BilinearForm%s
+    with essential boundary conditions, smoothed by OperatorChebyshevSmoother
+    with their assembled diagonals. The coarsest level is fully assembled and
+    solved with HypreBoomerAMG in parallel and with CGSolver in serial. The
+    prolongations are those of the FiniteElementSpaceHierarchy.
+
+    The integrators of the problem are defined by a derived class, see
+    AddIntegrators(), after which Setup() builds the levels. */
+class GeometricMultigrid : public Multigrid
+{
+protected:
+   const FiniteElementSpaceHierarchy &fespaces;
+   Array<BilinearForm*> bfs;
+   Array<Array<int>*> essentialTrueDofs;
+   Solver *coarsePrec; ///< Preconditioner of the serial coarse solver, owned
+   int smootherOrder;
+
+   /// Add the integrators of the problem to the BilinearForm of a level.
+   /** The BilinearForm takes ownership of the integrators, so new ones must
+       be created for every level. */
+   virtual void AddIntegrators(BilinearForm &form) = 0;
+
+   /// Construct the coarse operator and solver of level 0.
+   void ConstructCoarseOperatorAndSolver(BilinearForm &form,
+                                         const Array<int> &ess_tdofs);
+
+   /// Construct the partially assembled operator and smoother of a level.
+   void ConstructOperatorAndSmoother(int level, BilinearForm &form,
+                                     const Array<int> &ess_tdofs);
+
+public:
+   GeometricMultigrid(const FiniteElementSpaceHierarchy &fespaces_);
+
+   virtual ~GeometricMultigrid();
+
+   /// Set the order of the Chebyshev smoothers; the default is 2.
+   /** Must be called before Setup(). */
+   void SetSmootherOrder(int order) { smootherOrder = order; }
+
+   /** @brief Construct the BilinearForm%s, operators and smoothers of all
+       levels with the essential boundary attributes @a ess_bdr. */
+   void Setup(const Array<int> &ess_bdr);
+
+   /** @brief Form the linear system of the finest level, see
+       BilinearForm::FormLinearSystem(). */
+   void FormFineLinearSystem(Vector &x, Vector &b, OperatorHandle &A,
+                             Vector &X, Vector &B);
+
+   /** @brief Recover the solution of the finest level, see
+       BilinearForm::RecoverFEMSolution(). */
+   void RecoverFineFEMSolution(const Vector &X, const Vector &b, Vector &x);
+
+   /// Return the BilinearForm of the given @a level.
+   BilinearForm &GetFormAtLevel(int level) const { return *bfs[level]; }
+};
+
+} // namespace mfem
+
+#endif
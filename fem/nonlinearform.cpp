@@ -14,6 +14,36 @@
 namespace mfem
 {
 
+void NonlinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
+{
+   if (ext)
+   {
+      MFEM_ABORT("the assembly level has already been set!");
+   }
+   assembly = assembly_level;
+   switch (assembly)
+   {
+      case AssemblyLevel::FULL:
+         // the legacy element-by-element assembly, no extension
+         break;
+      case AssemblyLevel::PARTIAL:
+         ext = new PANonlinearFormExtension(this);
+         break;
+      default:
+         mfem_error("Unknown assembly level for this form.");
+   }
+}
+
+void NonlinearForm::Setup()
+{
+   if (ext)
+   {
+      MFEM_VERIFY(fnfi.Size() == 0 && bfnfi.Size() == 0,
+                  "face integrators are not supported with partial assembly");
+      ext->Assemble();
+   }
+}
+
 void NonlinearForm::SetEssentialBC(const Array<int> &bdr_attr_is_ess,
                                    Vector *rhs)
 {
@@ -117,9 +147,17 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
    const Vector &px = Prolongate(x);
    Vector &py = P ? aux2.SetSize(P->Height()), aux2 : y;
 
-   py = 0.0;
+   if (ext)
+   {
+      // the face integrators are verified to be empty in Setup()
+      ext->Mult(px, py);
+   }
+   else
+   {
+      py = 0.0;
+   }
 
-   if (dnfi.Size())
+   if (!ext && dnfi.Size())
    {
       for (int i = 0; i < fes->GetNE(); i++)
       {
@@ -232,6 +270,16 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
 
 Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
+   if (ext)
+   {
+      // The essential b.c. are imposed here also in parallel
+      Operator *grad = &ext->GetGradient(Prolongate(x));
+      if (P) { grad = new RAPOperator(*P, *grad, *P); }
+      delete paGrad;
+      paGrad = new ConstrainedOperator(grad, ess_tdof_list, P != NULL);
+      return *paGrad;
+   }
+
    const int skip_zeros = 0;
    Array<int> vdofs;
    Vector el_x;
@@ -380,15 +428,20 @@ void NonlinearForm::Update()
    height = width = fes->GetTrueVSize();
    delete cGrad; cGrad = NULL;
    delete Grad; Grad = NULL;
+   delete paGrad; paGrad = NULL;
    ess_tdof_list.SetSize(0); // essential b.c. will need to be set again
    sequence = fes->GetSequence();
    // Do not modify aux1 and aux2, their size will be set before use.
    P = fes->GetProlongationMatrix();
    cP = dynamic_cast<const SparseMatrix*>(P);
+   // the partial assembly needs to be setup again
+   if (ext) { ext->Update(); }
 }
 
 NonlinearForm::~NonlinearForm()
 {
+   delete paGrad;
+   delete ext;
    delete cGrad;
    delete Grad;
    for (int i = 0; i <  dnfi.Size(); i++) { delete  dnfi[i]; }
@@ -14,6 +14,8 @@
 
 #include "../config/config.hpp"
 #include "nonlininteg.hpp"
+#include "nonlinearform_ext.hpp"
+#include "bilinearform.hpp"
 #include "gridfunc.hpp"
 
 namespace mfem
@@ -22,6 +24,15 @@ namespace mfem
 class NonlinearForm : public Operator
 {
 protected:
+   /// The assembly level.
+   AssemblyLevel assembly;
+
+   /// Extension for supporting different AssemblyLevel%s
+   /** For nonlinear operators, the "matrix" assembly levels usually do not make
+       sense, so only PARTIAL and FULL (the default, which does not use an
+       extension) are supported. */
+   NonlinearFormExtension *ext; // owned
+
    /// FE space on which the form lives.
    FiniteElementSpace *fes; // not owned
 
@@ -37,6 +48,9 @@ protected:
 
    mutable SparseMatrix *Grad, *cGrad; // owned
 
+   /// The gradient Operator with AssemblyLevel::PARTIAL, see GetGradient().
+   mutable Operator *paGrad; // owned
+
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
 
@@ -59,14 +73,28 @@ public:
    /** As an Operator, the NonlinearForm has input and output size equal to the
        number of true degrees of freedom, i.e. f->GetTrueVSize(). */
    NonlinearForm(FiniteElementSpace *f)
-      : Operator(f->GetTrueVSize()), fes(f), Grad(NULL), cGrad(NULL),
+      : Operator(f->GetTrueVSize()), assembly(AssemblyLevel::FULL), ext(NULL),
+        fes(f), Grad(NULL), cGrad(NULL), paGrad(NULL),
         sequence(f->GetSequence()), P(f->GetProlongationMatrix()),
         cP(dynamic_cast<const SparseMatrix*>(P))
    { }
 
+   /// Set the desired assembly level. The default is AssemblyLevel::FULL.
+   /** With AssemblyLevel::PARTIAL, the domain integrators have to implement the
+       NonlinearFormIntegrator methods AssemblePA(), AddMultPA(),
+       AssembleGradPA() and AddMultGradPA(), and face integrators are not
+       supported. The gradient is then a matrix-free Operator, i.e. no
+       SparseMatrix is assembled by GetGradient().
+
+       This method must be called before assembly. */
+   void SetAssemblyLevel(AssemblyLevel assembly_level);
+
    FiniteElementSpace *FESpace() { return fes; }
    const FiniteElementSpace *FESpace() const { return fes; }
 
+   /// Access all integrators added with AddDomainIntegrator().
+   Array<NonlinearFormIntegrator*> *GetDNFI() { return &dnfi; }
+
    /// Adds new Domain Integrator.
    void AddDomainIntegrator(NonlinearFormIntegrator *nlfi)
    { dnfi.Append(nlfi); }
@@ -104,6 +132,15 @@ public:
    /// Return a (read-only) list of all essential true dofs.
    const Array<int> &GetEssentialTrueDofs() const { return ess_tdof_list; }
 
+   /// Setup the NonlinearForm for the current AssemblyLevel.
+   /** With AssemblyLevel::PARTIAL, the data of the integrators that does not
+       depend on the state, e.g. the geometric factors at the quadrature
+       points, is computed and stored. This method has to be called after all
+       integrators are added and before Mult() or GetGradient(), and again after
+       Update() or a change of the mesh nodes. With AssemblyLevel::FULL it has
+       no effect. */
+   void Setup();
+
    /// Compute the enery corresponding to the state @a x.
    /** In general, @a x may have non-homogeneous essential boundary values.
 
@@ -134,6 +171,9 @@ public:
        The returned object is valid until the next call to this method or the
        destruction of this object.
 
+       With AssemblyLevel::PARTIAL, the returned Operator is matrix-free: it
+       applies the linearized integrators at the quadrature points.
+
        In general, @a x may have non-homogeneous essential boundary values.
 
        The state @a x must be a true-dof vector. */
@@ -0,0 +1,105 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementations of classes NonlinearFormExtension and
+// PANonlinearFormExtension.
+
+#include "../general/forall.hpp"
+#include "nonlinearform.hpp"
+
+namespace mfem
+{
+
+NonlinearFormExtension::NonlinearFormExtension(NonlinearForm *form)
+   : Operator(form->FESpace()->GetVSize()), nlf(form)
+{
+   // empty
+}
+
+
+// Data and methods for partially-assembled nonlinear forms
+PANonlinearFormExtension::PANonlinearFormExtension(NonlinearForm *form)
+   : NonlinearFormExtension(form), fes(*form->FESpace()), elem_restrict(NULL),
+     grad(*this)
+{
+   Update();
+}
+
+void PANonlinearFormExtension::Update()
+{
+   height = width = fes.GetVSize();
+   grad.Update();
+   // QuadratureInterpolator uses the native ordering
+   elem_restrict = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   if (elem_restrict)
+   {
+      localX.SetSize(elem_restrict->Height(), Device::GetMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetMemoryType());
+      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+   }
+}
+
+void PANonlinearFormExtension::Assemble()
+{
+   Array<NonlinearFormIntegrator*> &integrators = *nlf->GetDNFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AssemblePA(fes);
+   }
+}
+
+void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *nlf->GetDNFI();
+   elem_restrict->Mult(x, localX);
+   localY = 0.0;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AddMultPA(localX, localY);
+   }
+   elem_restrict->MultTranspose(localY, y);
+}
+
+Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *nlf->GetDNFI();
+   elem_restrict->Mult(x, localX);
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AssembleGradPA(localX, fes);
+   }
+   return grad;
+}
+
+PANonlinearFormExtension::Gradient::Gradient(
+   const PANonlinearFormExtension &e) : ext(e)
+{
+   // the size is set by Update()
+}
+
+void PANonlinearFormExtension::Gradient::Update()
+{
+   height = width = ext.fes.GetVSize();
+}
+
+void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.nlf->GetDNFI();
+   ext.elem_restrict->Mult(x, ext.localX);
+   ext.localY = 0.0;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AddMultGradPA(ext.localX, ext.localY);
+   }
+   ext.elem_restrict->MultTranspose(ext.localY, y);
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_NONLINEARFORM_EXT
+#define MFEM_NONLINEARFORM_EXT
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+class NonlinearForm;
+
+/// Class extending the NonlinearForm class to support the different
+/// AssemblyLevel%s.
+/** The input and output of the extension Operator are L-vectors, i.e. their
+    size is the number of vector dofs of the FiniteElementSpace. */
+class NonlinearFormExtension : public Operator
+{
+protected:
+   NonlinearForm *nlf; ///< Not owned
+
+public:
+   NonlinearFormExtension(NonlinearForm *form);
+
+   /// Assemble at the AssemblyLevel of the subclass.
+   virtual void Assemble() = 0;
+
+   /// Return the gradient at the L-vector @a x, as an Operator on L-vectors.
+   /** The returned object is valid until the next call to this method. */
+   virtual Operator &GetGradient(const Vector &x) const = 0;
+
+   /// Update the internal data after a change of the FiniteElementSpace.
+   virtual void Update() = 0;
+};
+
+/// Data and methods for partially-assembled nonlinear forms
+/** The domain integrators act on E-vectors in the native element dof ordering,
+    see NonlinearFormIntegrator::AddMultPA(). The gradient is never assembled
+    as a matrix: its action is computed from the data stored at the quadrature
+    points by NonlinearFormIntegrator::AssembleGradPA(). */
+class PANonlinearFormExtension : public NonlinearFormExtension
+{
+protected:
+   /// Matrix-free action of the gradient, see GetGradient().
+   class Gradient : public Operator
+   {
+   protected:
+      const PANonlinearFormExtension &ext;
+
+   public:
+      Gradient(const PANonlinearFormExtension &e);
+
+      virtual void Mult(const Vector &x, Vector &y) const;
+
+      /// Update the size after a change of the FiniteElementSpace.
+      void Update();
+   };
+
+   const FiniteElementSpace &fes; ///< Not owned
+   const Operator *elem_restrict; ///< Not owned
+   mutable Vector localX, localY;
+   mutable Gradient grad;
+
+public:
+   PANonlinearFormExtension(NonlinearForm *form);
+
+   void Assemble();
+
+   void Mult(const Vector &x, Vector &y) const;
+
+   Operator &GetGradient(const Vector &x) const;
+
+   void Update();
+};
+
+}
+
+#endif
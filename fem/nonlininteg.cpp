@@ -55,6 +55,31 @@ double NonlinearFormIntegrator::GetElementEnergy(
    return 0.0;
 }
 
+void NonlinearFormIntegrator::AssemblePA(const FiniteElementSpace&)
+{
+   mfem_error("NonlinearFormIntegrator::AssemblePA"
+              " is not overloaded!");
+}
+
+void NonlinearFormIntegrator::AddMultPA(const Vector&, Vector&) const
+{
+   mfem_error("NonlinearFormIntegrator::AddMultPA"
+              " is not overloaded!");
+}
+
+void NonlinearFormIntegrator::AssembleGradPA(const Vector&,
+                                             const FiniteElementSpace&)
+{
+   mfem_error("NonlinearFormIntegrator::AssembleGradPA"
+              " is not overloaded!");
+}
+
+void NonlinearFormIntegrator::AddMultGradPA(const Vector&, Vector&) const
+{
+   mfem_error("NonlinearFormIntegrator::AddMultGradPA"
+              " is not overloaded!");
+}
+
 
 void BlockNonlinearFormIntegrator::AssembleElementVector(
    const Array<const FiniteElement *> &el,
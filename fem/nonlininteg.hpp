@@ -19,6 +19,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /** The abstract base class NonlinearFormIntegrator is used to express the
     local action of a general nonlinear finite element operator. In addition
     it may provide the capability to assemble the local gradient operator
@@ -68,6 +70,35 @@ public:
                                    ElementTransformation &Tr,
                                    const Vector &elfun);
 
+   /// Method defining partial assembly.
+   /** The result of the partial assembly is stored internally so that it can be
+       used later in the methods AddMultPA() and AssembleGradPA(). */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   /// Method for partially assembled action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
+       the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   /// Prepare the partially assembled gradient at the state @a x.
+   /** The state @a x is an E-vector in the native element dof ordering, see
+       PANonlinearFormExtension. The result is stored internally so that it can
+       be used later in the method AddMultGradPA().
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   /// Method for partially assembled gradient action.
+   /** Perform the action of the gradient assembled by the last call to
+       AssembleGradPA() on the E-vector @a x and add the result to the E-vector
+       @a y. */
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -153,6 +184,31 @@ public:
    */
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const = 0;
+
+   /** @brief Evaluate the 1st Piola-Kirchhoff stress tensor at all quadrature
+       points @a ir of all elements of @a fes, see EvalP().
+       @param[in] Jpt  The target->physical Jacobian matrices, stored as a
+                       Vector of size dim x dim x nq x ne.
+       @param[out]  P  The evaluated stress tensors, with the layout of @a Jpt.
+
+       The default implementation calls EvalP() at every point, after setting
+       the transformation of the element, see SetTransformation(). */
+   virtual void EvalPBatched(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const Vector &Jpt, Vector &P);
+
+   /** @brief Evaluate the derivative of the 1st Piola-Kirchhoff stress tensor
+       at all quadrature points @a ir of all elements of @a fes.
+       @param[in] Jpt  The target->physical Jacobian matrices, stored as a
+                       Vector of size dim x dim x nq x ne.
+       @param[out]  H  The 4th order tensors d(P_ij)_d(Jpt_kl), stored as a
+                       Vector of size dim x dim x dim x dim x nq x ne.
+
+       The default implementation calls AssembleH() at every point with the
+       identity as the basis gradient matrix. */
+   virtual void EvalHBatched(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const Vector &Jpt, Vector &H);
 };
 
 
@@ -206,6 +262,18 @@ public:
 
    virtual void AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   /** With constant parameters the stress is evaluated on the device, see
+       HyperelasticModel::EvalPBatched(). */
+   virtual void EvalPBatched(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const Vector &Jpt, Vector &P);
+
+   /** With constant parameters the derivative of the stress is evaluated on
+       the device, see HyperelasticModel::EvalHBatched(). */
+   virtual void EvalHBatched(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const Vector &Jpt, Vector &H);
 };
 
 
@@ -233,9 +301,24 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension
+   const FiniteElementSpace *pa_fes; ///< Not owned
+   const IntegrationRule *pa_ir;     ///< Not owned
+   const DofToQuad *maps;            ///< Not owned
+   int dim, ne, nq;
+   Vector pa_Jrt;          ///< Jrt at quadrature points, dim x dim x nq x ne
+   Vector pa_W;            ///< Quadrature weights times det(Jtr), nq x ne
+   Vector pa_H;            ///< Linearized stress in reference coordinates
+   mutable Vector pa_dX;   ///< Reference gradients of the input E-vector
+   mutable Vector pa_Jpt, pa_P;
+
+   /// Compute Jpt at the quadrature points from the state E-vector @a x.
+   void ComputeJpt(const Vector &x) const;
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m)
+      : model(m), pa_fes(NULL), pa_ir(NULL), maps(NULL) { }
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -252,6 +335,14 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
@@ -0,0 +1,461 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "nonlininteg.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+// PA Hyperelastic Integrator
+//
+// The deformation gradients Jpt are computed at the quadrature points from the
+// reference gradients given by the QuadratureInterpolator. The stress P(Jpt)
+// and its derivative H = dP/dJpt are evaluated by the HyperelasticModel, in a
+// batched way, and are then pulled back to the reference element, where the
+// transposed gradients of the basis functions are applied.
+//
+// All matrices are stored in column-major order, dim x dim per point.
+
+// Compute the inverse of the matrix A, returning its determinant.
+MFEM_HOST_DEVICE static inline
+double HyperelasticInverse(const int dim, const double *A, double *Ai)
+{
+   if (dim == 2)
+   {
+      const double det = A[0]*A[3] - A[1]*A[2];
+      const double s = 1.0/det;
+      Ai[0] =  A[3]*s; Ai[2] = -A[2]*s;
+      Ai[1] = -A[1]*s; Ai[3] =  A[0]*s;
+      return det;
+   }
+   Ai[0] = A[4]*A[8] - A[7]*A[5];
+   Ai[1] = A[7]*A[2] - A[1]*A[8];
+   Ai[2] = A[1]*A[5] - A[4]*A[2];
+   Ai[3] = A[5]*A[6] - A[3]*A[8];
+   Ai[4] = A[0]*A[8] - A[6]*A[2];
+   Ai[5] = A[3]*A[2] - A[0]*A[5];
+   Ai[6] = A[3]*A[7] - A[4]*A[6];
+   Ai[7] = A[6]*A[1] - A[0]*A[7];
+   Ai[8] = A[0]*A[4] - A[3]*A[1];
+   const double det = A[0]*Ai[0] + A[3]*Ai[1] + A[6]*Ai[2];
+   const double s = 1.0/det;
+   for (int i = 0; i < 9; i++) { Ai[i] *= s; }
+   return det;
+}
+
+void HyperelasticModel::EvalPBatched(const FiniteElementSpace &fes,
+                                     const IntegrationRule &ir,
+                                     const Vector &Jpt, Vector &P)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   const double *h_J = Jpt.HostRead();
+   double *h_P = P.HostWrite();
+   DenseMatrix J(dim), Pq;
+   for (int e = 0; e < NE; e++)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      SetTransformation(T);
+      for (int q = 0; q < NQ; q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         const int offset = dim*dim*(q + NQ*e);
+         for (int i = 0; i < dim*dim; i++) { J.GetData()[i] = h_J[offset+i]; }
+         Pq.UseExternalData(h_P + offset, dim, dim);
+         EvalP(J, Pq);
+      }
+   }
+}
+
+void HyperelasticModel::EvalHBatched(const FiniteElementSpace &fes,
+                                     const IntegrationRule &ir,
+                                     const Vector &Jpt, Vector &H)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   const double *h_J = Jpt.HostRead();
+   auto h_H = Reshape(H.HostWrite(), dim, dim, dim, dim, NQ, NE);
+   // With the identity as basis gradient, the dofs coincide with the entries
+   // of Jpt: A(j+i*dim,l+k*dim) = d(P_ij)_d(Jpt_kl).
+   DenseMatrix J(dim), A(dim*dim), Id(dim);
+   Id = 0.0;
+   for (int i = 0; i < dim; i++) { Id(i,i) = 1.0; }
+   for (int e = 0; e < NE; e++)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      SetTransformation(T);
+      for (int q = 0; q < NQ; q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         const int offset = dim*dim*(q + NQ*e);
+         for (int i = 0; i < dim*dim; i++) { J.GetData()[i] = h_J[offset+i]; }
+         A = 0.0;
+         AssembleH(J, Id, 1.0, A);
+         for (int l = 0; l < dim; l++)
+            for (int k = 0; k < dim; k++)
+               for (int j = 0; j < dim; j++)
+                  for (int i = 0; i < dim; i++)
+                  {
+                     h_H(i,j,k,l,q,e) = A(j+i*dim,l+k*dim);
+                  }
+      }
+   }
+}
+
+void NeoHookeanModel::EvalPBatched(const FiniteElementSpace &fes,
+                                   const IntegrationRule &ir,
+                                   const Vector &Jpt, Vector &P)
+{
+   if (have_coeffs)
+   {
+      HyperelasticModel::EvalPBatched(fes, ir, Jpt, P);
+      return;
+   }
+   const int DIM = fes.GetMesh()->Dimension();
+   const int N = ir.GetNPoints()*fes.GetNE();
+   const double MU = mu, KB = K, G = g;
+   auto d_J = Jpt.Read();
+   auto d_P = P.Write();
+   MFEM_FORALL(p, N,
+   {
+      const int dim = DIM;
+      const double *J = d_J + dim*dim*p;
+      double *Pp = d_P + dim*dim*p;
+      double Ji[9];
+      const double dJ = HyperelasticInverse(dim, J, Ji);
+      double JJ = 0.0;
+      for (int i = 0; i < dim*dim; i++) { JJ += J[i]*J[i]; }
+      const double a = MU*pow(dJ, -2.0/dim);
+      const double b = KB*(dJ/G - 1.0)/G - a*JJ/(dim*dJ);
+      // P = a J + b adj(J)^t, where adj(J)^t = det(J) J^{-t}
+      for (int j = 0; j < dim; j++)
+      {
+         for (int i = 0; i < dim; i++)
+         {
+            Pp[i+dim*j] = a*J[i+dim*j] + b*dJ*Ji[j+dim*i];
+         }
+      }
+   });
+}
+
+void NeoHookeanModel::EvalHBatched(const FiniteElementSpace &fes,
+                                   const IntegrationRule &ir,
+                                   const Vector &Jpt, Vector &H)
+{
+   if (have_coeffs)
+   {
+      HyperelasticModel::EvalHBatched(fes, ir, Jpt, H);
+      return;
+   }
+   const int DIM = fes.GetMesh()->Dimension();
+   const int N = ir.GetNPoints()*fes.GetNE();
+   const double MU = mu, KB = K, G = g;
+   auto d_J = Jpt.Read();
+   auto d_H = H.Write();
+   MFEM_FORALL(p, N,
+   {
+      const int dim = DIM;
+      const double *J = d_J + dim*dim*p;
+      double *Hp = d_H + dim*dim*dim*dim*p;
+      double Ji[9];
+      const double dJ = HyperelasticInverse(dim, J, Ji);
+      double JJ = 0.0;
+      for (int i = 0; i < dim*dim; i++) { JJ += J[i]*J[i]; }
+      // Same coefficients as in NeoHookeanModel::AssembleH()
+      const double sJ = dJ/G;
+      const double a  = MU*pow(dJ, -2.0/dim);
+      const double bc = a*JJ/dim;
+      const double b  = bc - KB*sJ*(sJ - 1.0);
+      const double c  = 2.0*bc/dim + KB*sJ*(2.0*sJ - 1.0);
+      const double a2 = -2.0*a/dim;
+      // H_ijkl = a d_ik d_jl + a2 (J_ij Ji_lk + Ji_ji J_kl)
+      //        + b Ji_jk Ji_li + c Ji_ji Ji_lk
+      for (int l = 0; l < dim; l++)
+      {
+         for (int k = 0; k < dim; k++)
+         {
+            for (int j = 0; j < dim; j++)
+            {
+               for (int i = 0; i < dim; i++)
+               {
+                  const double J_ij = J[i+dim*j], J_kl = J[k+dim*l];
+                  const double Ji_lk = Ji[l+dim*k], Ji_ji = Ji[j+dim*i];
+                  const double Ji_jk = Ji[j+dim*k], Ji_li = Ji[l+dim*i];
+                  double h = a2*(J_ij*Ji_lk + Ji_ji*J_kl) +
+                             b*Ji_jk*Ji_li + c*Ji_ji*Ji_lk;
+                  if (i == k && j == l) { h += a; }
+                  Hp[i+dim*(j+dim*(k+dim*l))] = h;
+               }
+            }
+         }
+      }
+   });
+}
+
+// Jrt = J^{-1} and W = w det(J) from the reference->target Jacobians J
+static void PAHyperelasticSetup(const int NE,
+                                const int DIM,
+                                const int NQ,
+                                const Array<double> &w,
+                                const Vector &j,
+                                Vector &jrt,
+                                Vector &w_detJ)
+{
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   auto Jrt = jrt.Write();
+   auto WdetJ = Reshape(w_detJ.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double Jtr[9] = { 0.0 };
+         for (int b = 0; b < DIM; b++)
+         {
+            for (int a = 0; a < DIM; a++) { Jtr[a+DIM*b] = J(q,a,b,e); }
+         }
+         double *Jrt_q = Jrt + DIM*DIM*(q + NQ*e);
+         WdetJ(q,e) = W[q] * HyperelasticInverse(DIM, Jtr, Jrt_q);
+      }
+   });
+}
+
+// Jpt(c,j) = sum_k dX(c,k) Jrt(k,j)
+static void PAHyperelasticJpt(const int NE,
+                              const int DIM,
+                              const int NQ,
+                              const Vector &dx,
+                              const Vector &jrt,
+                              Vector &jpt)
+{
+   auto dX = Reshape(dx.Read(), NQ, DIM, DIM, NE);
+   auto Jrt = Reshape(jrt.Read(), DIM, DIM, NQ, NE);
+   auto Jpt = Reshape(jpt.Write(), DIM, DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int j = 0; j < DIM; j++)
+         {
+            for (int c = 0; c < DIM; c++)
+            {
+               double s = 0.0;
+               for (int k = 0; k < DIM; k++) { s += dX(q,c,k,e)*Jrt(k,j,q,e); }
+               Jpt(c,j,q,e) = s;
+            }
+         }
+      }
+   });
+}
+
+// y(i,c) += sum_q sum_k G(q,k,i) W(q) (P Jrt^t)(c,k)
+static void PAHyperelasticApplyP(const int NE,
+                                 const int DIM,
+                                 const int ND,
+                                 const int NQ,
+                                 const Array<double> &g,
+                                 const Vector &p,
+                                 const Vector &jrt,
+                                 const Vector &w_detJ,
+                                 Vector &y)
+{
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto P = Reshape(p.Read(), DIM, DIM, NQ, NE);
+   auto Jrt = Reshape(jrt.Read(), DIM, DIM, NQ, NE);
+   auto W = Reshape(w_detJ.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double F[3][3];
+         for (int c = 0; c < DIM; c++)
+         {
+            for (int k = 0; k < DIM; k++)
+            {
+               double s = 0.0;
+               for (int j = 0; j < DIM; j++) { s += P(c,j,q,e)*Jrt(k,j,q,e); }
+               F[c][k] = W(q,e)*s;
+            }
+         }
+         for (int c = 0; c < DIM; c++)
+         {
+            for (int i = 0; i < ND; i++)
+            {
+               double s = 0.0;
+               for (int k = 0; k < DIM; k++) { s += G(q,k,i)*F[c][k]; }
+               Y(i,c,e) += s;
+            }
+         }
+      }
+   });
+}
+
+// Pull back the derivative of the stress to the reference element, in place:
+// H(c,k,d,m) <- W sum_j sum_l Jrt(k,j) H(c,j,d,l) Jrt(m,l)
+static void PAHyperelasticPullBack(const int NE,
+                                   const int DIM,
+                                   const int NQ,
+                                   const Vector &jrt,
+                                   const Vector &w_detJ,
+                                   Vector &h)
+{
+   auto Jrt = Reshape(jrt.Read(), DIM, DIM, NQ, NE);
+   auto W = Reshape(w_detJ.Read(), NQ, NE);
+   auto H = Reshape(h.ReadWrite(), DIM, DIM, DIM, DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double T[81];
+         for (int m = 0; m < DIM; m++)
+            for (int d = 0; d < DIM; d++)
+               for (int j = 0; j < DIM; j++)
+                  for (int c = 0; c < DIM; c++)
+                  {
+                     double s = 0.0;
+                     for (int l = 0; l < DIM; l++)
+                     {
+                        s += H(c,j,d,l,q,e)*Jrt(m,l,q,e);
+                     }
+                     T[c+DIM*(j+DIM*(d+DIM*m))] = s;
+                  }
+         for (int m = 0; m < DIM; m++)
+            for (int d = 0; d < DIM; d++)
+               for (int k = 0; k < DIM; k++)
+                  for (int c = 0; c < DIM; c++)
+                  {
+                     double s = 0.0;
+                     for (int j = 0; j < DIM; j++)
+                     {
+                        s += Jrt(k,j,q,e)*T[c+DIM*(j+DIM*(d+DIM*m))];
+                     }
+                     H(c,k,d,m,q,e) = W(q,e)*s;
+                  }
+      }
+   });
+}
+
+// y(i,c) += sum_q sum_k G(q,k,i) sum_d sum_m H(c,k,d,m) dX(d,m)
+static void PAHyperelasticApplyH(const int NE,
+                                 const int DIM,
+                                 const int ND,
+                                 const int NQ,
+                                 const Array<double> &g,
+                                 const Vector &h,
+                                 const Vector &dx,
+                                 Vector &y)
+{
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto H = Reshape(h.Read(), DIM, DIM, DIM, DIM, NQ, NE);
+   auto dX = Reshape(dx.Read(), NQ, DIM, DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double F[3][3];
+         for (int c = 0; c < DIM; c++)
+         {
+            for (int k = 0; k < DIM; k++)
+            {
+               double s = 0.0;
+               for (int m = 0; m < DIM; m++)
+               {
+                  for (int d = 0; d < DIM; d++)
+                  {
+                     s += H(c,k,d,m,q,e)*dX(q,d,m,e);
+                  }
+               }
+               F[c][k] = s;
+            }
+         }
+         for (int c = 0; c < DIM; c++)
+         {
+            for (int i = 0; i < ND; i++)
+            {
+               double s = 0.0;
+               for (int k = 0; k < DIM; k++) { s += G(q,k,i)*F[c][k]; }
+               Y(i,c,e) += s;
+            }
+         }
+      }
+   });
+}
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   pa_fes = &fes;
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "the vector dimension of the space must be the mesh dimension");
+   if (ne == 0) { return; }
+   // Assumes all elements have the same type
+   const FiniteElement &el = *fes.GetFE(0);
+   pa_ir = IntRule ? IntRule :
+           &IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3);
+   nq = pa_ir->GetNPoints();
+   maps = &el.GetDofToQuad(*pa_ir, DofToQuad::FULL);
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(*pa_ir, GeometricFactors::JACOBIANS);
+   pa_Jrt.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   pa_W.SetSize(nq*ne, Device::GetMemoryType());
+   PAHyperelasticSetup(ne, dim, nq, pa_ir->GetWeights(), geom->J,
+                       pa_Jrt, pa_W);
+}
+
+void HyperelasticNLFIntegrator::ComputeJpt(const Vector &x) const
+{
+   const QuadratureInterpolator *qi = pa_fes->GetQuadratureInterpolator(*pa_ir);
+   Vector empty;
+   pa_dX.SetSize(nq*dim*dim*ne, Device::GetMemoryType());
+   qi->Mult(x, QuadratureInterpolator::DERIVATIVES, empty, pa_dX, empty);
+   pa_Jpt.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   PAHyperelasticJpt(ne, dim, nq, pa_dX, pa_Jrt, pa_Jpt);
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   ComputeJpt(x);
+   pa_P.SetSize(pa_Jpt.Size(), Device::GetMemoryType());
+   model->EvalPBatched(*pa_fes, *pa_ir, pa_Jpt, pa_P);
+   PAHyperelasticApplyP(ne, dim, maps->ndof, nq, maps->G, pa_P, pa_Jrt, pa_W,
+                        y);
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(&fes == pa_fes, "AssemblePA() must be called first");
+   if (ne == 0) { return; }
+   ComputeJpt(x);
+   pa_H.SetSize(dim*dim*dim*dim*nq*ne, Device::GetMemoryType());
+   model->EvalHBatched(*pa_fes, *pa_ir, pa_Jpt, pa_H);
+   PAHyperelasticPullBack(ne, dim, nq, pa_Jrt, pa_W, pa_H);
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const QuadratureInterpolator *qi = pa_fes->GetQuadratureInterpolator(*pa_ir);
+   Vector empty;
+   qi->Mult(x, QuadratureInterpolator::DERIVATIVES, empty, pa_dX, empty);
+   PAHyperelasticApplyH(ne, dim, maps->ndof, nq, maps->G, pa_H, pa_dX, y);
+}
+
+}
@@ -315,6 +315,11 @@ public:
        the local dofs. */
    virtual void Save(std::ostream &out) const;
 
+   /// Save the local portion of the ParGridFunction in binary format.
+   /** Like Save(), this takes into account the signs of the local dofs, see
+       GridFunction::SaveBinary(). */
+   virtual void SaveBinary(std::ostream &out) const;
+
    /// Merge the local grid functions
    void SaveAsOne(std::ostream &out = mfem::out);
 
@@ -93,6 +93,8 @@ void ParNonlinearForm::Mult(const Vector &x, Vector &y) const
 
 const SparseMatrix &ParNonlinearForm::GetLocalGradient(const Vector &x) const
 {
+   MFEM_VERIFY(!ext, "the local gradient is not assembled with partial "
+               "assembly");
    NonlinearForm::GetGradient(x); // (re)assemble Grad, no b.c.
 
    return *Grad;
@@ -100,6 +102,12 @@ const SparseMatrix &ParNonlinearForm::GetLocalGradient(const Vector &x) const
 
 Operator &ParNonlinearForm::GetGradient(const Vector &x) const
 {
+   if (ext)
+   {
+      // matrix-free RAP of the local gradient, with b.c.
+      return NonlinearForm::GetGradient(x);
+   }
+
    ParFiniteElementSpace *pfes = ParFESpace();
 
    pGrad.Clear();
@@ -52,7 +52,8 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    /// Return the local gradient matrix for the given true-dof vector x.
-   /** The returned matrix does NOT have any boundary conditions imposed. */
+   /** The returned matrix does NOT have any boundary conditions imposed. It is
+       not available with AssemblyLevel::PARTIAL. */
    const SparseMatrix &GetLocalGradient(const Vector &x) const;
 
    virtual Operator &GetGradient(const Vector &x) const;
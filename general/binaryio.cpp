@@ -0,0 +1,211 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "binaryio.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace mfem
+{
+
+namespace bin_io
+{
+
+static std::size_t align(std::size_t offset, std::size_t alignment)
+{
+   return (offset + alignment - 1) / alignment * alignment;
+}
+
+static std::size_t index_offset(std::size_t header_size)
+{
+   return align(header_size, 8);
+}
+
+const int BinaryWriter::Alignment;
+const int BinaryWriter::NameSize;
+
+BinaryWriter::BinaryWriter(std::ostream &os, const std::string &header)
+   : os(os), header(header), pos(0), current(-1)
+{
+   MFEM_VERIFY(little_endian(), "binary files require a little-endian host");
+}
+
+void BinaryWriter::AddSection(const std::string &name, std::size_t size)
+{
+   MFEM_VERIFY(current < 0, "all sections must be added before writing");
+   MFEM_VERIFY(name.size() <= (std::size_t) NameSize, "section name too long: " << name);
+   Section sec;
+   sec.name = name;
+   sec.size = size;
+   sec.offset = 0;
+   sections.push_back(sec);
+}
+
+void BinaryWriter::Pad(std::size_t offset)
+{
+   MFEM_ASSERT(offset >= pos, "");
+   static const char zeros[Alignment] = { 0 };
+   while (pos < offset)
+   {
+      const std::size_t n = std::min<std::size_t>(offset - pos, Alignment);
+      os.write(zeros, n);
+      pos += n;
+   }
+}
+
+void BinaryWriter::WriteIndex()
+{
+   // compute the offsets of the sections
+   const std::size_t num_sec = sections.size();
+   std::size_t offset = index_offset(header.size() + 1) +
+                        sizeof(int64_t)*(1 + num_sec*(NameSize/8 + 2));
+   for (std::size_t i = 0; i < num_sec; i++)
+   {
+      offset = align(offset, Alignment);
+      sections[i].offset = offset;
+      offset += sections[i].size;
+   }
+
+   os << header << '\n';
+   pos = header.size() + 1;
+   Pad(index_offset(pos));
+   int64_t n = num_sec;
+   Write(&n, 1);
+   for (std::size_t i = 0; i < num_sec; i++)
+   {
+      char sec_name[NameSize] = { 0 };
+      std::memcpy(sec_name, sections[i].name.data(), sections[i].name.size());
+      int64_t data[2] = { (int64_t) sections[i].offset,
+                          (int64_t) sections[i].size
+                        };
+      Write(sec_name, NameSize);
+      Write(data, 2);
+   }
+}
+
+void BinaryWriter::BeginSection(const std::string &name)
+{
+   if (current < 0)
+   {
+      WriteIndex();
+   }
+   else
+   {
+      const Section &sec = sections[current];
+      MFEM_VERIFY(pos == sec.offset + sec.size,
+                  "incomplete section: " << sec.name);
+   }
+   current++;
+   MFEM_VERIFY(current < (int) sections.size() &&
+               sections[current].name == name,
+               "section " << name << " was not declared next");
+   Pad(sections[current].offset);
+}
+
+void BinaryWriter::Finish()
+{
+   if (current < 0) { WriteIndex(); }
+   MFEM_VERIFY(current == (int) sections.size() - 1, "missing sections");
+   if (current >= 0)
+   {
+      const Section &sec = sections[current];
+      MFEM_VERIFY(pos == sec.offset + sec.size,
+                  "incomplete section: " << sec.name);
+   }
+   Pad(align(pos, Alignment));
+}
+
+BinaryReader::BinaryReader(std::istream &is, std::size_t header_size)
+   : is(is), pos(header_size), end(0), start(is.tellg())
+{
+   MFEM_VERIFY(little_endian(), "binary files require a little-endian host");
+   if (start >= 0) { start -= header_size; }
+   Skip(index_offset(pos));
+
+   int64_t num_sec;
+   end = pos + sizeof(int64_t);
+   Read(&num_sec, 1);
+   MFEM_VERIFY(num_sec >= 0, "invalid binary file index");
+   sections.resize(num_sec);
+   for (int64_t i = 0; i < num_sec; i++)
+   {
+      char name[BinaryWriter::NameSize];
+      int64_t data[2];
+      end = pos + sizeof(name) + sizeof(data);
+      Read(name, BinaryWriter::NameSize);
+      Read(data, 2);
+      sections[i].name.assign(name, std::find(name, name + sizeof(name), 0));
+      sections[i].offset = data[0];
+      sections[i].size = data[1];
+   }
+   end = pos;
+}
+
+int BinaryReader::Find(const std::string &name) const
+{
+   for (std::size_t i = 0; i < sections.size(); i++)
+   {
+      if (sections[i].name == name) { return i; }
+   }
+   return -1;
+}
+
+std::size_t BinaryReader::SectionSize(const std::string &name) const
+{
+   const int i = Find(name);
+   MFEM_VERIFY(i >= 0, "section not found: " << name);
+   return sections[i].size;
+}
+
+void BinaryReader::Skip(std::size_t offset)
+{
+   MFEM_VERIFY(offset >= pos, "binary file sections must be read in order");
+   is.ignore(offset - pos);
+   MFEM_VERIFY(is, "error reading binary data");
+   pos = offset;
+}
+
+void BinaryReader::BeginSection(const std::string &name)
+{
+   const int i = Find(name);
+   MFEM_VERIFY(i >= 0, "section not found: " << name);
+   Skip(sections[i].offset);
+   end = sections[i].offset + sections[i].size;
+}
+
+void BinaryReader::SeekSection(const std::string &name, std::size_t offset)
+{
+   const int i = Find(name);
+   MFEM_VERIFY(i >= 0, "section not found: " << name);
+   MFEM_VERIFY(offset <= sections[i].size, "offset past the end of " << name);
+   MFEM_VERIFY(start >= 0, "the binary stream is not seekable");
+   pos = sections[i].offset + offset;
+   end = sections[i].offset + sections[i].size;
+   is.clear();
+   is.seekg(start + (std::streamoff) pos);
+   MFEM_VERIFY(is, "error seeking in binary data");
+}
+
+void BinaryReader::Finish()
+{
+   std::size_t file_end = pos;
+   for (std::size_t i = 0; i < sections.size(); i++)
+   {
+      file_end = std::max(file_end, sections[i].offset + sections[i].size);
+   }
+   Skip(align(file_end, BinaryWriter::Alignment));
+}
+
+} // namespace mfem::bin_io
+
+} // namespace mfem
@@ -13,8 +13,11 @@
 #define MFEM_BINARYIO
 
 #include "../config/config.hpp"
+#include "error.hpp"
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace mfem
 {
@@ -38,6 +41,125 @@ inline T read(std::istream& is)
    return value;
 }
 
+template<typename T>
+inline void write_array(std::ostream& os, const T *data, std::size_t n)
+{
+   os.write((const char*) data, n*sizeof(T));
+}
+
+template<typename T>
+inline void read_array(std::istream& is, T *data, std::size_t n)
+{
+   is.read((char*) data, n*sizeof(T));
+}
+
+/// Return true if the host stores integers in little-endian byte order.
+inline bool little_endian()
+{
+   const int one = 1;
+   return *(const char*) &one == 1;
+}
+
+/// Writer of MFEM's indexed binary files, e.g. Mesh::PrintBinary().
+/** A binary file starts with a text line identifying its type and version,
+    e.g. "MFEM binary mesh v1.0", padded with zeros to a multiple of 8 bytes.
+    The index follows: the number of sections and, for each section, its name
+    (16 bytes, padded with zeros), its offset from the start of the file and
+    its size in bytes, all as 64-bit integers. The sections are stored in the
+    order of the index, each one starting at an offset aligned to #Alignment
+    bytes, and the file is padded to a multiple of #Alignment bytes. All data
+    is little-endian, so the arrays in a memory mapped file can be used in
+    place. */
+class BinaryWriter
+{
+public:
+   static const int Alignment = 64;
+   static const int NameSize = 16;
+
+   /// Start a binary file with the given type/version line (without '\n').
+   BinaryWriter(std::ostream &os, const std::string &header);
+
+   /// Declare the next section and its size in bytes.
+   void AddSection(const std::string &name, std::size_t size);
+
+   /** @brief Begin writing the section @a name, which must be the next of
+       the declared sections. The first call writes the header and index. */
+   void BeginSection(const std::string &name);
+
+   /// Write @a n values to the current section.
+   template<typename T>
+   void Write(const T *data, std::size_t n)
+   {
+      write_array(os, data, n);
+      pos += n*sizeof(T);
+   }
+
+   /// Check that all sections were written and pad the end of the file.
+   void Finish();
+
+protected:
+   struct Section { std::string name; std::size_t offset, size; };
+
+   std::ostream &os;
+   std::string header;
+   std::vector<Section> sections;
+   std::size_t pos;
+   int current;
+
+   void WriteIndex();
+   void Pad(std::size_t offset);
+};
+
+/// Reader of the binary files written by BinaryWriter.
+class BinaryReader
+{
+public:
+   /** @brief Read the index of a binary file whose header line, of
+       @a header_size bytes including the '\n', was already read from
+       @a is. */
+   BinaryReader(std::istream &is, std::size_t header_size);
+
+   /// Return true if the file contains the section @a name.
+   bool HasSection(const std::string &name) const
+   { return Find(name) >= 0; }
+
+   /// Return the size in bytes of the section @a name.
+   std::size_t SectionSize(const std::string &name) const;
+
+   /** @brief Skip to the beginning of the section @a name. The sections must
+       be read in the order in which they are stored. */
+   void BeginSection(const std::string &name);
+
+   /** @brief Position the reader @a offset bytes into the section @a name.
+       Unlike BeginSection(), the sections can be visited in any order, but
+       the stream must be seekable, e.g. an std::ifstream. */
+   void SeekSection(const std::string &name, std::size_t offset = 0);
+
+   /// Read @a n values from the current section.
+   template<typename T>
+   void Read(T *data, std::size_t n)
+   {
+      MFEM_VERIFY(pos + n*sizeof(T) <= end, "reading past the section end");
+      read_array(is, data, n);
+      MFEM_VERIFY(is, "error reading binary data");
+      pos += n*sizeof(T);
+   }
+
+   /// Skip to the end of the file, leaving @a is after its padding.
+   void Finish();
+
+protected:
+   struct Section { std::string name; std::size_t offset, size; };
+
+   std::istream &is;
+   std::vector<Section> sections;
+   std::size_t pos, end;
+   std::streamoff start; // stream position of the file start, or -1
+
+   int Find(const std::string &name) const;
+   void Skip(std::size_t offset);
+};
+
 } // namespace mfem::bin_io
 
 } // namespace mfem
@@ -0,0 +1,200 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class BSRMatrix
+
+#include "bsrmat.hpp"
+#include "../general/forall.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+BSRMatrix::BSRMatrix(const SparseMatrix &mat, int bs)
+   : Operator(mat.Height(), mat.Width()), bsize(bs)
+{
+   MFEM_VERIFY(mat.Finalized(), "the SparseMatrix must be finalized");
+   MFEM_VERIFY(!mat.HasSymmetricStorage(),
+               "SparseMatrix with symmetric storage is not supported");
+   MFEM_VERIFY(bs > 0 && height % bs == 0 && width % bs == 0,
+               "the matrix size " << height << " x " << width
+               << " is not a multiple of the block size " << bs);
+   nbrows = height / bs;
+   const int nbcols = width / bs;
+   const int *mI = mat.HostReadI();
+   const int *mJ = mat.HostReadJ();
+   const double *mA = mat.HostReadData();
+
+   // Find the block sparsity; 'pos' maps a block column to its position in
+   // the current block row.
+   Array<int> pos(nbcols);
+   pos = -1;
+   I.SetSize(nbrows + 1);
+   I[0] = 0;
+   J.SetSize(0);
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int r = i*bs; r < (i+1)*bs; r++)
+      {
+         for (int j = mI[r]; j < mI[r+1]; j++)
+         {
+            const int bj = mJ[j] / bs;
+            if (pos[bj] < I[i]) { pos[bj] = J.Size(); J.Append(bj); }
+         }
+      }
+      std::sort(J.GetData() + I[i], J.GetData() + J.Size());
+      I[i+1] = J.Size();
+   }
+
+   // Copy the entries; the blocks are row-major.
+   A.SetSize(J.Size()*bs*bs);
+   A = 0.0;
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++) { pos[J[k]] = k; }
+      for (int r = 0; r < bs; r++)
+      {
+         const int row = i*bs + r;
+         for (int j = mI[row]; j < mI[row+1]; j++)
+         {
+            const int k = pos[mJ[j] / bs];
+            A[(k*bs + r)*bs + mJ[j] % bs] += mA[j];
+         }
+      }
+   }
+}
+
+SparseMatrix *BSRMatrix::ToSparseMatrix() const
+{
+   const int bs = bsize;
+   int *mI = new int[height + 1];
+   int *mJ = new int[A.Size()];
+   double *mA = new double[A.Size()];
+   mI[0] = 0;
+   for (int i = 0; i < nbrows; i++)
+   {
+      const int nb = I[i+1] - I[i];
+      for (int r = 0; r < bs; r++)
+      {
+         const int row = i*bs + r;
+         mI[row+1] = mI[row] + nb*bs;
+         int p = mI[row];
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            for (int c = 0; c < bs; c++, p++)
+            {
+               mJ[p] = J[k]*bs + c;
+               mA[p] = A[(k*bs + r)*bs + c];
+            }
+         }
+      }
+   }
+   return new SparseMatrix(mI, mJ, mA, height, width);
+}
+
+// The block size is a template parameter for the common sizes, so that the
+// loops over the entries of a block are unrolled and vectorized. T_BS = 0 is
+// the generic version.
+template<int T_BS>
+static void BSRAddMult(const int nbrows, const int bs_,
+                       const Array<int> &I_, const Array<int> &J_,
+                       const Vector &A_, const Vector &x_, Vector &y_,
+                       const double a)
+{
+   const int bs = T_BS ? T_BS : bs_;
+   auto I = I_.Read();
+   auto J = J_.Read();
+   auto A = A_.Read();
+   auto x = x_.Read();
+   auto y = y_.ReadWrite();
+   MFEM_FORALL(i, nbrows,
+   {
+      const int BS = T_BS ? T_BS : bs;
+      const int end = I[i+1];
+      for (int r = 0; r < BS; r++)
+      {
+         double d = 0.0;
+         for (int k = I[i]; k < end; k++)
+         {
+            const double *Ak = A + (k*BS + r)*BS;
+            const double *xk = x + J[k]*BS;
+            for (int c = 0; c < BS; c++)
+            {
+               d += Ak[c] * xk[c];
+            }
+         }
+         y[i*BS + r] += a * d;
+      }
+   });
+}
+
+void BSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true);
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void BSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void BSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   switch (bsize)
+   {
+      case 1: BSRAddMult<1>(nbrows, bsize, I, J, A, x, y, a); break;
+      case 2: BSRAddMult<2>(nbrows, bsize, I, J, A, x, y, a); break;
+      case 3: BSRAddMult<3>(nbrows, bsize, I, J, A, x, y, a); break;
+      case 4: BSRAddMult<4>(nbrows, bsize, I, J, A, x, y, a); break;
+      default: BSRAddMult<0>(nbrows, bsize, I, J, A, x, y, a); break;
+   }
+}
+
+void BSRMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                 const double a) const
+{
+   MFEM_ASSERT(height == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix height (" << height << ")");
+   MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix width (" << width << ")");
+   const int bs = bsize;
+   const int *hI = I.HostRead();
+   const int *hJ = J.HostRead();
+   const double *hA = A.HostRead();
+   const double *hx = x.HostRead();
+   double *hy = y.HostReadWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int k = hI[i]; k < hI[i+1]; k++)
+      {
+         double *yk = hy + hJ[k]*bs;
+         for (int r = 0; r < bs; r++)
+         {
+            const double xr = a * hx[i*bs + r];
+            const double *Ak = hA + (k*bs + r)*bs;
+            for (int c = 0; c < bs; c++)
+            {
+               yk[c] += Ak[c] * xr;
+            }
+         }
+      }
+   }
+}
+
+} // namespace mfem
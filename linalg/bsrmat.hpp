@@ -0,0 +1,79 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_BSRMAT_HPP
+#define MFEM_BSRMAT_HPP
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/// Sparse matrix in the block compressed sparse row (BSR) format.
+/** The matrix is partitioned into dense square blocks of size #bsize and only
+    the blocks with at least one entry are stored, with a single column index
+    per block. This is the natural structure of the matrices of vector finite
+    element spaces with Ordering::byVDIM, where #bsize is the vector dimension,
+    and it reduces the index traffic of the matrix-vector product by a factor
+    of #bsize^2 compared to the CSR format of SparseMatrix.
+
+    The matrix is constructed from a finalized SparseMatrix and its sparsity
+    and values can not be modified afterwards. */
+class BSRMatrix : public Operator
+{
+protected:
+   int bsize; ///< Size of the square blocks
+   int nbrows; ///< Number of block rows, #height / #bsize
+   /// Block row offsets, size #nbrows + 1.
+   Array<int> I;
+   /// Block column indices, size I[#nbrows], sorted within each block row.
+   Array<int> J;
+   /** @brief Entries of the blocks, size I[#nbrows] * #bsize^2. Each block is
+       stored contiguously in row-major order. */
+   Vector A;
+
+public:
+   /// Convert the finalized SparseMatrix @a mat to BSR with block size @a bs.
+   /** The height and the width of @a mat must be multiples of @a bs. */
+   BSRMatrix(const SparseMatrix &mat, int bs);
+
+   /// Return the size of the blocks.
+   int GetBlockSize() const { return bsize; }
+
+   /// Return the number of stored blocks.
+   int NumNonZeroBlocks() const { return J.Size(); }
+
+   /// Return the number of stored entries, including the explicit zeros.
+   int NumStoredEntries() const { return A.Size(); }
+
+   /// Convert back to a (finalized) SparseMatrix, dropping no entries.
+   SparseMatrix *ToSparseMatrix() const;
+
+   /// y = A x
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y = A^t x
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// y += a A^t x
+   /** The transpose product is computed on the host. */
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const double a = 1.0) const;
+};
+
+} // namespace mfem
+
+#endif
@@ -15,9 +15,12 @@
 // Linear algebra header file
 
 #include "vector.hpp"
+#include "multivector.hpp"
 #include "operator.hpp"
 #include "matrix.hpp"
 #include "sparsemat.hpp"
+#include "bsrmat.hpp"
+#include "sellmat.hpp"
 #include "complex_operator.hpp"
 #include "blockvector.hpp"
 #include "blockmatrix.hpp"
@@ -26,6 +29,7 @@
 #include "densemat.hpp"
 #include "ode.hpp"
 #include "solvers.hpp"
+#include "multigrid.hpp"
 #include "handle.hpp"
 #include "invariants.hpp"
 
@@ -0,0 +1,169 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class Multigrid
+
+#include "multigrid.hpp"
+
+namespace mfem
+{
+
+Multigrid::Multigrid()
+   : cycleType(CycleType::VCYCLE), preSmoothingSteps(1), postSmoothingSteps(1)
+{
+   // empty
+}
+
+Multigrid::Multigrid(const Array<Operator*> &operators_,
+                     const Array<Solver*> &smoothers_,
+                     const Array<Operator*> &prolongations_,
+                     const Array<bool> &owned_operators,
+                     const Array<bool> &owned_smoothers,
+                     const Array<bool> &owned_prolongations)
+   : cycleType(CycleType::VCYCLE), preSmoothingSteps(1), postSmoothingSteps(1)
+{
+   MFEM_VERIFY(operators_.Size() > 0, "at least one level is required");
+   MFEM_VERIFY(smoothers_.Size() == operators_.Size() &&
+               owned_operators.Size() == operators_.Size() &&
+               owned_smoothers.Size() == operators_.Size(),
+               "incompatible number of operators and smoothers");
+   MFEM_VERIFY(prolongations_.Size() == operators_.Size() - 1 &&
+               owned_prolongations.Size() == operators_.Size() - 1,
+               "incompatible number of prolongations");
+   for (int l = 0; l < operators_.Size(); l++)
+   {
+      AddLevel(operators_[l], smoothers_[l],
+               (l > 0) ? prolongations_[l-1] : NULL,
+               owned_operators[l], owned_smoothers[l],
+               (l > 0) ? owned_prolongations[l-1] : false);
+   }
+}
+
+Multigrid::~Multigrid()
+{
+   for (int l = 0; l < operators.Size(); l++)
+   {
+      if (ownedOperators[l]) { delete operators[l]; }
+      if (ownedSmoothers[l]) { delete smoothers[l]; }
+      delete X[l];
+      delete Y[l];
+      delete R[l];
+      delete Z[l];
+   }
+   for (int l = 0; l < prolongations.Size(); l++)
+   {
+      if (ownedProlongations[l]) { delete prolongations[l]; }
+   }
+}
+
+void Multigrid::AddLevel(Operator *opr, Solver *smoother,
+                         Operator *prolongation, bool own_operator,
+                         bool own_smoother, bool own_prolongation)
+{
+   MFEM_VERIFY(opr && smoother, "invalid operator or smoother");
+   MFEM_VERIFY(opr->Height() == opr->Width(), "the operator must be square");
+   if (operators.Size() > 0)
+   {
+      MFEM_VERIFY(prolongation != NULL, "missing prolongation");
+      MFEM_VERIFY(prolongation->Height() == opr->Height() &&
+                  prolongation->Width() == operators.Last()->Height(),
+                  "incompatible prolongation size");
+      prolongations.Append(prolongation);
+      ownedProlongations.Append(own_prolongation);
+   }
+   else if (own_prolongation)
+   {
+      delete prolongation;
+   }
+   operators.Append(opr);
+   smoothers.Append(smoother);
+   ownedOperators.Append(own_operator);
+   ownedSmoothers.Append(own_smoother);
+
+   const int n = opr->Height();
+   X.Append(new Vector(n));
+   Y.Append(new Vector(n));
+   R.Append(new Vector(n));
+   Z.Append(new Vector(n));
+   X.Last()->UseDevice(true);
+   Y.Last()->UseDevice(true);
+   R.Last()->UseDevice(true);
+   Z.Last()->UseDevice(true);
+
+   height = width = n;
+}
+
+void Multigrid::SetCycle(CycleType cycle_type, int pre_smoothing_steps,
+                         int post_smoothing_steps)
+{
+   cycleType = cycle_type;
+   preSmoothingSteps = pre_smoothing_steps;
+   postSmoothingSteps = post_smoothing_steps;
+}
+
+void Multigrid::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(NumLevels() > 0, "the multigrid hierarchy is empty");
+   MFEM_ASSERT(x.Size() == height && y.Size() == width,
+               "incompatible input or output size");
+   const int l = GetFinestLevelIndex();
+   *X[l] = x;
+   if (iterative_mode) { *Y[l] = y; }
+   else { *Y[l] = 0.0; }
+   Cycle(l);
+   y = *Y[l];
+}
+
+void Multigrid::Smooth(int level, int steps) const
+{
+   const Operator &A = *operators[level];
+   Solver &S = *smoothers[level];
+   Vector &x = *X[level], &y = *Y[level], &r = *R[level], &z = *Z[level];
+   for (int i = 0; i < steps; i++)
+   {
+      A.Mult(y, r);
+      subtract(x, r, r); // r = x - A y
+      S.Mult(r, z);
+      y += z;
+   }
+}
+
+void Multigrid::Cycle(int level) const
+{
+   if (level == 0)
+   {
+      Smooth(0, 1); // coarse solve
+      return;
+   }
+
+   Smooth(level, preSmoothingSteps);
+
+   // Restrict the residual to the coarser level
+   const Operator &A = *operators[level];
+   const Operator &P = *prolongations[level-1];
+   A.Mult(*Y[level], *R[level]);
+   subtract(*X[level], *R[level], *R[level]);
+   P.MultTranspose(*R[level], *X[level-1]);
+   *Y[level-1] = 0.0;
+
+   // A second correction with an exact coarse solve has no effect
+   const bool w_cycle = (cycleType == CycleType::WCYCLE) && (level > 1);
+   Cycle(level-1);
+   if (w_cycle) { Cycle(level-1); }
+
+   // Prolongate the coarse grid correction
+   P.Mult(*Y[level-1], *Z[level]);
+   *Y[level] += *Z[level];
+
+   Smooth(level, postSmoothingSteps);
+}
+
+} // namespace mfem
@@ -0,0 +1,106 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_MULTIGRID
+#define MFEM_MULTIGRID
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "operator.hpp"
+
+namespace mfem
+{
+
+/// Multigrid solver defined by the Operator%s, smoothers and prolongations of
+/// a hierarchy of levels.
+/** Level 0 is the coarsest level and its "smoother" is the coarse solver. The
+    prolongation of level l > 0 maps vectors of level l-1 to level l and its
+    transpose is used as the restriction of the residual. The smoothers are
+    applied with Solver::iterative_mode set to false, i.e. as preconditioners
+    of the residual equation. Mult() applies one cycle, so Multigrid can be
+    used as a preconditioner, e.g. in CGSolver, or wrapped in SLISolver for a
+    stand-alone iteration. */
+class Multigrid : public Solver
+{
+public:
+   enum class CycleType
+   {
+      VCYCLE, ///< One recursive coarse grid correction per level
+      WCYCLE  ///< Two recursive coarse grid corrections per level
+   };
+
+protected:
+   Array<Operator*> operators;
+   Array<Solver*> smoothers;
+   Array<Operator*> prolongations;
+   Array<bool> ownedOperators, ownedSmoothers, ownedProlongations;
+
+   CycleType cycleType;
+   int preSmoothingSteps, postSmoothingSteps;
+
+   mutable Array<Vector*> X, Y, R, Z;
+
+   /// Apply one cycle at @a level to the residual equation in X and Y.
+   void Cycle(int level) const;
+
+   /// Apply @a steps smoothing steps at @a level, updating Y.
+   void Smooth(int level, int steps) const;
+
+public:
+   /// Construct an empty Multigrid, see AddLevel().
+   Multigrid();
+
+   /// Construct a Multigrid from the given levels.
+   /** The arrays @a prolongations and @a owned_prolongations have one entry
+       less than the other arrays: prolongations[l] maps level l to l+1. */
+   Multigrid(const Array<Operator*> &operators_,
+             const Array<Solver*> &smoothers_,
+             const Array<Operator*> &prolongations_,
+             const Array<bool> &owned_operators,
+             const Array<bool> &owned_smoothers,
+             const Array<bool> &owned_prolongations);
+
+   virtual ~Multigrid();
+
+   /// Add a finer level with the given Operator, smoother and prolongation.
+   /** The @a prolongation from the previous level is ignored for the first
+       (coarsest) level and can be NULL. */
+   void AddLevel(Operator *opr, Solver *smoother, Operator *prolongation,
+                 bool own_operator, bool own_smoother, bool own_prolongation);
+
+   /// Return the number of levels.
+   int NumLevels() const { return operators.Size(); }
+
+   /// Return the index of the finest level.
+   int GetFinestLevelIndex() const { return NumLevels() - 1; }
+
+   /// Return the Operator at the given @a level.
+   const Operator *GetOperatorAtLevel(int level) const
+   { return operators[level]; }
+
+   /// Return the smoother at the given @a level.
+   Solver *GetSmootherAtLevel(int level) const { return smoothers[level]; }
+
+   /// Set the cycle type and the number of pre- and post-smoothing steps.
+   void SetCycle(CycleType cycle_type, int pre_smoothing_steps,
+                 int post_smoothing_steps);
+
+   /// Apply one multigrid cycle on the finest level.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// Not supported: the Operator%s are given by the levels.
+   virtual void SetOperator(const Operator &op)
+   { MFEM_ABORT("SetOperator is not supported in Multigrid!"); }
+};
+
+} // namespace mfem
+
+#endif
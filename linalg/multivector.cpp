@@ -0,0 +1,42 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class MultiVector
+
+#include "multivector.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+void MultiVector::AddScaled(const Vector &a, const MultiVector &X)
+{
+   MFEM_ASSERT(X.vsize == vsize && X.nvecs == nvecs &&
+               a.Size() == nvecs, "incompatible sizes");
+   const int n = vsize;
+   auto d_a = a.Read();
+   auto d_x = X.Read();
+   auto d_y = ReadWrite();
+   MFEM_FORALL(i, n*nvecs, d_y[i] += d_a[i/n] * d_x[i];);
+}
+
+void MultiVector::ScaleAndAdd(const Vector &a, const MultiVector &X)
+{
+   MFEM_ASSERT(X.vsize == vsize && X.nvecs == nvecs &&
+               a.Size() == nvecs, "incompatible sizes");
+   const int n = vsize;
+   auto d_a = a.Read();
+   auto d_x = X.Read();
+   auto d_y = ReadWrite();
+   MFEM_FORALL(i, n*nvecs, d_y[i] = d_a[i/n] * d_y[i] + d_x[i];);
+}
+
+} // namespace mfem
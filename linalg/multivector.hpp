@@ -0,0 +1,79 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_MULTIVECTOR
+#define MFEM_MULTIVECTOR
+
+#include "../config/config.hpp"
+#include "vector.hpp"
+
+namespace mfem
+{
+
+/// A set of vectors of the same size stored contiguously.
+/** The vectors are stored one after the other (column-major), so that vector
+    j occupies the entries [j*n, (j+1)*n) of the underlying Vector, where n is
+    VectorSize(). The MultiVector is used to apply an Operator to many vectors
+    at once, see Operator::MultMulti(), which lets the operator read its data
+    once for all the vectors. */
+class MultiVector : public Vector
+{
+protected:
+   int vsize; ///< Size of every vector
+   int nvecs; ///< Number of vectors
+
+public:
+   /// Create an empty MultiVector.
+   MultiVector() : vsize(0), nvecs(0) { }
+
+   /// Create a MultiVector of @a k vectors of size @a n.
+   MultiVector(int n, int k) : Vector(n*k), vsize(n), nvecs(k) { }
+
+   /// Create a MultiVector of @a k vectors of size @a n using external data.
+   MultiVector(double *data, int n, int k)
+      : Vector(data, n*k), vsize(n), nvecs(k) { }
+
+   /// Resize to @a k vectors of size @a n; the data is not preserved.
+   void SetSize(int n, int k) { Vector::SetSize(n*k); vsize = n; nvecs = k; }
+
+   /// Make this a reference to the first @a n*k entries of @a base.
+   void MakeRef(Vector &base, int n, int k)
+   { Vector::MakeRef(base, 0, n*k); vsize = n; nvecs = k; }
+
+   /// Return the size of the vectors.
+   int VectorSize() const { return vsize; }
+
+   /// Return the number of vectors.
+   int NumVectors() const { return nvecs; }
+
+   /// Make @a v a reference to the vector @a j.
+   void GetVector(int j, Vector &v)
+   { v.MakeRef(*this, j*vsize, vsize); }
+
+   /// Make @a v a reference to the vector @a j.
+   /** The data of @a v must not be modified. */
+   void GetVector(int j, Vector &v) const
+   { v.MakeRef(const_cast<MultiVector&>(*this), j*vsize, vsize); }
+
+   /// Set all entries to @a value.
+   MultiVector &operator=(double value)
+   { Vector::operator=(value); return *this; }
+
+   /// Vector j += a(j) X_j for all vectors j.
+   void AddScaled(const Vector &a, const MultiVector &X);
+
+   /// Vector j = a(j) * (vector j) + X_j for all vectors j.
+   void ScaleAndAdd(const Vector &a, const MultiVector &X);
+};
+
+} // namespace mfem
+
+#endif
@@ -134,6 +134,21 @@ void Operator::PrintMatlab(std::ostream & out, int n, int m) const
    }
 }
 
+void Operator::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_VERIFY(X.NumVectors() == Y.NumVectors(),
+               "incompatible number of vectors: " << X.NumVectors() << ", "
+               << Y.NumVectors());
+   Vector x, y;
+   for (int j = 0; j < X.NumVectors(); j++)
+   {
+      X.GetVector(j, x);
+      Y.GetVector(j, y);
+      Mult(x, y);
+   }
+}
+
+
 
 void TimeDependentOperator::ExplicitMult(const Vector &, Vector &) const
 {
@@ -264,6 +279,22 @@ RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
    APx.SetSize(A.Height(), mem_type);
 }
 
+void RAPOperator::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   const int k = X.NumVectors();
+   PX.SetSize(P.Height(), k);
+   APX.SetSize(A.Height(), k);
+   P.MultMulti(X, PX);
+   A.MultMulti(PX, APX);
+   Vector apx, y;
+   for (int j = 0; j < k; j++)
+   {
+      APX.GetVector(j, apx);
+      Y.GetVector(j, y);
+      Rt.MultTranspose(apx, y);
+   }
+}
+
 
 TripleProductOperator::TripleProductOperator(
    const Operator *A, const Operator *B, const Operator *C,
@@ -377,4 +408,34 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    });
 }
 
+void ConstrainedOperator::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->MultMulti(X, Y);
+      return;
+   }
+
+   const int n = X.VectorSize(), k = X.NumVectors();
+   Z.SetSize(n, k);
+   Z = X;
+
+   auto idx = constraint_list.Read();
+   // Use read+write access - we are modifying sub-vectors of Z
+   auto d_Z = Z.ReadWrite();
+   MFEM_FORALL(i, csz*k, d_Z[idx[i%csz] + (i/csz)*n] = 0.0;);
+
+   A->MultMulti(Z, Y);
+
+   auto d_X = X.Read();
+   // Use read+write access - we are modifying sub-vectors of Y
+   auto d_Y = Y.ReadWrite();
+   MFEM_FORALL(i, csz*k,
+   {
+      const int id = idx[i%csz] + (i/csz)*n;
+      d_Y[id] = d_X[id];
+   });
+}
+
 }
@@ -13,6 +13,7 @@
 #define MFEM_OPERATOR
 
 #include "vector.hpp"
+#include "multivector.hpp"
 
 namespace mfem
 {
@@ -69,6 +70,13 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Operator application to all vectors of @a X: `Y_j=A(X_j)`. The
+       MultiVector @a Y must have the size of the output. */
+   /** The default behavior in class Operator is to call Mult() for every
+       vector. Derived classes can override this method to read their data
+       once for all the vectors. */
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -489,6 +497,7 @@ private:
    const Operator & P;
    mutable Vector Px;
    mutable Vector APx;
+   mutable MultiVector PX, APX;
    MemoryClass mem_class;
 
 public:
@@ -501,6 +510,9 @@ public:
    virtual void Mult(const Vector & x, Vector & y) const
    { P.Mult(x, Px); A.Mult(Px, APx); Rt.MultTranspose(APx, y); }
 
+   /// Operator application to all vectors of @a X.
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
    /// Application of the transpose.
    virtual void MultTranspose(const Vector & x, Vector & y) const
    { Rt.Mult(x, APx); A.MultTranspose(APx, Px); P.MultTranspose(Px, y); }
@@ -546,6 +558,7 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable MultiVector Z;       ///< Auxiliary MultiVector.
    MemoryClass mem_class;
 
 public:
@@ -581,6 +594,9 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Constrained operator application to all vectors of @a X, see Mult().
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
    /// Destructor: destroys the unconstrained Operator, if owned.
    virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
 };
@@ -0,0 +1,194 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of class SELLMatrix
+
+#include "sellmat.hpp"
+#include "../general/forall.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+// Maximum chunk size of the generic matrix-vector product kernel
+static const int MAX_SELL_CHUNK_SIZE = 32;
+
+SELLMatrix::SELLMatrix(const SparseMatrix &mat, int chunk_size_, int sigma_)
+   : Operator(mat.Height(), mat.Width()),
+     chunk_size(chunk_size_), sigma(sigma_)
+{
+   MFEM_VERIFY(mat.Finalized(), "the SparseMatrix must be finalized");
+   MFEM_VERIFY(!mat.HasSymmetricStorage(),
+               "SparseMatrix with symmetric storage is not supported");
+   MFEM_VERIFY(chunk_size > 0 && chunk_size <= MAX_SELL_CHUNK_SIZE,
+               "invalid chunk size: " << chunk_size);
+   MFEM_VERIFY(sigma == 1 || (sigma > 0 && sigma % chunk_size == 0),
+               "sigma (" << sigma << ") must be 1 or a multiple of the chunk"
+               " size (" << chunk_size << ")");
+   const int C = chunk_size;
+   const int *mI = mat.HostReadI();
+   const int *mJ = mat.HostReadJ();
+   const double *mA = mat.HostReadData();
+   nnz = mI[height];
+
+   // Sort the rows by decreasing length within the windows of sigma rows.
+   nchunks = (height + C - 1) / C;
+   rows.SetSize(nchunks*C);
+   rows = -1;
+   for (int i = 0; i < height; i++) { rows[i] = i; }
+   if (sigma > 1)
+   {
+      for (int w = 0; w < height; w += sigma)
+      {
+         const int end = std::min(w + sigma, height);
+         std::stable_sort(rows.GetData() + w, rows.GetData() + end,
+                          [mI](int r1, int r2)
+         { return mI[r1+1] - mI[r1] > mI[r2+1] - mI[r2]; });
+      }
+   }
+
+   // The chunk widths are the lengths of their longest rows.
+   chunk_offsets.SetSize(nchunks + 1);
+   chunk_offsets[0] = 0;
+   for (int c = 0; c < nchunks; c++)
+   {
+      int len = 0;
+      for (int r = 0; r < C; r++)
+      {
+         const int row = rows[c*C + r];
+         if (row >= 0) { len = std::max(len, mI[row+1] - mI[row]); }
+      }
+      chunk_offsets[c+1] = chunk_offsets[c] + len*C;
+   }
+
+   const int size = chunk_offsets[nchunks];
+   J.SetSize(size);
+   A.SetSize(size);
+   J = 0;
+   A = 0.0;
+   for (int c = 0; c < nchunks; c++)
+   {
+      for (int r = 0; r < C; r++)
+      {
+         const int row = rows[c*C + r];
+         if (row < 0) { continue; }
+         int p = chunk_offsets[c] + r;
+         for (int j = mI[row]; j < mI[row+1]; j++, p += C)
+         {
+            J[p] = mJ[j];
+            A[p] = mA[j];
+         }
+      }
+   }
+}
+
+// The chunk size is a template parameter for the SIMD widths of AVX2 and
+// AVX-512, so that the loops over the rows of a chunk are vectorized. T_C = 0
+// is the generic version.
+template<int T_C>
+static void SELLAddMult(const int nchunks, const int c_,
+                        const Array<int> &offsets_, const Array<int> &rows_,
+                        const Array<int> &J_, const Vector &A_,
+                        const Vector &x_, Vector &y_, const double a)
+{
+   const int C_ = T_C ? T_C : c_;
+   auto offsets = offsets_.Read();
+   auto rows = rows_.Read();
+   auto J = J_.Read();
+   auto A = A_.Read();
+   auto x = x_.Read();
+   auto y = y_.ReadWrite();
+   MFEM_FORALL(c, nchunks,
+   {
+      const int C = T_C ? T_C : C_;
+      constexpr int MAX_C = T_C ? T_C : MAX_SELL_CHUNK_SIZE;
+      double d[MAX_C];
+      for (int r = 0; r < C; r++) { d[r] = 0.0; }
+      for (int p = offsets[c]; p < offsets[c+1]; p += C)
+      {
+         for (int r = 0; r < C; r++)
+         {
+            d[r] += A[p + r] * x[J[p + r]];
+         }
+      }
+      for (int r = 0; r < C; r++)
+      {
+         const int row = rows[c*C + r];
+         if (row >= 0) { y[row] += a * d[r]; }
+      }
+   });
+}
+
+void SELLMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true);
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void SELLMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void SELLMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+   const int C = chunk_size;
+   switch (C)
+   {
+      case 4:
+         SELLAddMult<4>(nchunks, C, chunk_offsets, rows, J, A, x, y, a);
+         break;
+      case 8:
+         SELLAddMult<8>(nchunks, C, chunk_offsets, rows, J, A, x, y, a);
+         break;
+      default:
+         SELLAddMult<0>(nchunks, C, chunk_offsets, rows, J, A, x, y, a);
+         break;
+   }
+}
+
+void SELLMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                  const double a) const
+{
+   MFEM_ASSERT(height == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix height (" << height << ")");
+   MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix width (" << width << ")");
+   const int C = chunk_size;
+   const int *hoffsets = chunk_offsets.HostRead();
+   const int *hrows = rows.HostRead();
+   const int *hJ = J.HostRead();
+   const double *hA = A.HostRead();
+   const double *hx = x.HostRead();
+   double *hy = y.HostReadWrite();
+   for (int c = 0; c < nchunks; c++)
+   {
+      for (int r = 0; r < C; r++)
+      {
+         const int row = hrows[c*C + r];
+         if (row < 0) { continue; }
+         const double xr = a * hx[row];
+         for (int p = hoffsets[c] + r; p < hoffsets[c+1]; p += C)
+         {
+            hy[hJ[p]] += hA[p] * xr;
+         }
+      }
+   }
+}
+
+} // namespace mfem
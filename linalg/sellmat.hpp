@@ -0,0 +1,93 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_SELLMAT_HPP
+#define MFEM_SELLMAT_HPP
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/// Sparse matrix in the sliced ELLPACK (SELL-C-sigma) format.
+/** The rows are grouped in chunks of #chunk_size consecutive rows, and every
+    chunk is stored column-major in ELLPACK format, padded with zeros to the
+    length of its longest row. The matrix-vector product then processes the
+    #chunk_size rows of a chunk together with unit-stride accesses to the
+    values and the column indices, which the compiler can vectorize; a chunk
+    size of 4 or 8 matches the SIMD width of AVX2 or AVX-512 in double
+    precision.
+
+    To reduce the padding, the rows may be sorted by decreasing length within
+    windows of #sigma rows before they are grouped in chunks. With #sigma = 1
+    the original row order is kept.
+
+    See M. Kreutzer et al., "A unified sparse matrix data format for efficient
+    general sparse matrix-vector multiplication on modern processors with wide
+    SIMD units", SIAM J. Sci. Comput. 36(5), 2014.
+
+    The matrix is constructed from a finalized SparseMatrix and its sparsity
+    and values can not be modified afterwards. */
+class SELLMatrix : public Operator
+{
+protected:
+   int chunk_size; ///< Number of rows in a chunk, C
+   int sigma; ///< Size of the row sorting windows
+   int nchunks; ///< Number of chunks
+   /// Offsets of the chunks in #J and #A, size #nchunks + 1.
+   Array<int> chunk_offsets;
+   /** @brief The row of each slot of the chunks, size #nchunks * #chunk_size.
+       The slots of the last chunk which are beyond #height are set to -1. */
+   Array<int> rows;
+   /// Column indices of the entries; the padding entries have column 0.
+   Array<int> J;
+   /** @brief Entries of the chunks. Entry j of the slot r of chunk c is at
+       chunk_offsets[c] + j * #chunk_size + r. */
+   Vector A;
+   int nnz; ///< Number of entries of the original matrix
+
+public:
+   /// Convert the finalized SparseMatrix @a mat to SELL-C-sigma.
+   /** The @a sigma must be 1 or a multiple of @a chunk_size. */
+   SELLMatrix(const SparseMatrix &mat, int chunk_size = 8, int sigma = 1);
+
+   /// Return the number of rows in a chunk.
+   int GetChunkSize() const { return chunk_size; }
+
+   /// Return the size of the row sorting windows.
+   int GetSigma() const { return sigma; }
+
+   /// Return the number of entries of the original SparseMatrix.
+   int NumNonZeroElems() const { return nnz; }
+
+   /// Return the number of stored entries, including the padding.
+   int NumStoredEntries() const { return A.Size(); }
+
+   /// y = A x
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y = A^t x
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// y += a A^t x
+   /** The transpose product is computed on the host. */
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const double a = 1.0) const;
+};
+
+} // namespace mfem
+
+#endif
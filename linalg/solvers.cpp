@@ -66,6 +66,60 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+double IterativeSolver::GlobalSum(double s) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &s, 1, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return s;
+}
+
+void IterativeSolver::Dots(const MultiVector &x, const MultiVector &y,
+                           Vector &d) const
+{
+   const int k = x.NumVectors();
+   MFEM_ASSERT(y.NumVectors() == k, "incompatible number of vectors");
+   d.SetSize(k);
+   Vector xj, yj;
+   for (int j = 0; j < k; j++)
+   {
+      x.GetVector(j, xj);
+      y.GetVector(j, yj);
+      d(j) = xj * yj;
+   }
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      // A single reduction for all the vectors
+      MPI_Allreduce(MPI_IN_PLACE, d.GetData(), k, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+}
+
+void IterativeSolver::StartReduction(double *buf, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Iallreduce(MPI_IN_PLACE, buf, n, MPI_DOUBLE, MPI_SUM, comm,
+                     &reduction_request);
+   }
+#endif
+}
+
+void IterativeSolver::FinishReduction() const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Wait(&reduction_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -166,6 +220,169 @@ void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
    MFEM_FORALL(i, N, Y[i] += DI[i] * R[i]; );
 }
 
+OperatorChebyshevSmoother::OperatorChebyshevSmoother(
+   const Operator &op, const Vector &d, const Array<int> &ess_tdofs,
+   int ord, int power_iterations, double power_tolerance)
+   :
+   Solver(d.Size()),
+   order(ord),
+   N(d.Size()),
+   max_eig(0.0),
+   lower_fraction(0.3),
+   oper(&op)
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+   Setup(d, ess_tdofs);
+   max_eig = EstimateLargestEigenvalue(power_iterations, power_tolerance);
+}
+
+#ifdef MFEM_USE_MPI
+OperatorChebyshevSmoother::OperatorChebyshevSmoother(
+   MPI_Comm comm_, const Operator &op, const Vector &d,
+   const Array<int> &ess_tdofs, int ord, int power_iterations,
+   double power_tolerance)
+   :
+   Solver(d.Size()),
+   order(ord),
+   N(d.Size()),
+   max_eig(0.0),
+   lower_fraction(0.3),
+   oper(&op),
+   comm(comm_)
+{
+   Setup(d, ess_tdofs);
+   max_eig = EstimateLargestEigenvalue(power_iterations, power_tolerance);
+}
+#endif
+
+void OperatorChebyshevSmoother::Setup(const Vector &d,
+                                      const Array<int> &ess_tdof_list)
+{
+   MFEM_VERIFY(order > 0, "invalid order: " << order);
+   diag.SetSize(N);
+   dinv.SetSize(N);
+   residual.SetSize(N);
+   direction.SetSize(N);
+   helper.SetSize(N);
+   diag.UseDevice(true);
+   dinv.UseDevice(true);
+   residual.UseDevice(true);
+   direction.UseDevice(true);
+   helper.UseDevice(true);
+   auto D = d.Read();
+   auto DG = diag.Write();
+   auto DI = dinv.Write();
+   MFEM_FORALL(i, N, { DG[i] = D[i]; DI[i] = 1.0 / D[i]; });
+   auto I = ess_tdof_list.Read();
+   MFEM_FORALL(i, ess_tdof_list.Size(), { DG[I[i]] = 1.0; DI[I[i]] = 1.0; });
+}
+
+double OperatorChebyshevSmoother::Dot(const Vector &x, const Vector &y) const
+{
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL) { return InnerProduct(comm, x, y); }
+#endif
+   return x * y;
+}
+
+double OperatorChebyshevSmoother::EstimateLargestEigenvalue(int iterations,
+                                                            double tolerance)
+{
+   // Power method for the generalized eigenproblem A v = lambda D v, whose
+   // eigenvalues are those of D^{-1} A. The Rayleigh quotients (v,Av)/(v,Dv)
+   // increase monotonically to the largest eigenvalue for symmetric A.
+   Vector &v = direction, &z = residual, &Dv = helper;
+   if (iterations == 0) { return 0.0; }
+   v.Randomize(12345);
+   double eig = 0.0;
+   for (int it = 0; it < iterations; it++)
+   {
+      const int n = N;
+      auto DG = diag.Read();
+      auto V = v.Read();
+      auto DV = Dv.Write();
+      MFEM_FORALL(i, n, DV[i] = DG[i] * V[i]; );
+      const double vDv = Dot(v, Dv);
+      MFEM_VERIFY(vDv > 0.0, "the diagonal must be positive");
+      oper->Mult(v, z);
+      const double eig_old = eig;
+      eig = Dot(v, z) / vDv;
+      if (it > 0 && std::abs(eig - eig_old) <= tolerance * std::abs(eig))
+      {
+         break;
+      }
+      // v <- D^{-1} A v / |D^{-1} A v|_D
+      const double s = 1.0 / std::sqrt(std::abs(eig) * vDv);
+      auto DI = dinv.Read();
+      auto Z = z.Read();
+      auto VW = v.Write();
+      MFEM_FORALL(i, n, VW[i] = s * DI[i] * Z[i]; );
+   }
+   return eig;
+}
+
+void OperatorChebyshevSmoother::Mult(const Vector &x, Vector &y) const
+{
+   // Chebyshev iteration for D^{-1} A on the interval [lower, upper], see
+   // Y. Saad, "Iterative Methods for Sparse Linear Systems", Algorithm 12.1.
+   MFEM_VERIFY(max_eig > 0.0, "no estimate of the largest eigenvalue");
+   const double upper = max_eig;
+   const double lower = lower_fraction * max_eig;
+   const double theta = 0.5 * (upper + lower);
+   const double delta = 0.5 * (upper - lower);
+   const double sigma = theta / delta;
+   double rho = 1.0 / sigma;
+
+   if (iterative_mode)
+   {
+      oper->Mult(y, residual);  // r = A x
+      subtract(x, residual, residual); // r = b - A x
+   }
+   else
+   {
+      residual = x;
+      y.UseDevice(true);
+      y = 0.0;
+   }
+
+   const int n = N;
+   auto DI = dinv.Read();
+   {
+      // r <- D^{-1} r, d = r / theta, y += d
+      const double s = 1.0 / theta;
+      auto R = residual.ReadWrite();
+      auto D = direction.Write();
+      auto Y = y.ReadWrite();
+      MFEM_FORALL(i, n,
+      {
+         R[i] *= DI[i];
+         D[i] = s * R[i];
+         Y[i] += D[i];
+      });
+   }
+   for (int k = 1; k < order; k++)
+   {
+      oper->Mult(direction, helper);
+      const double rho_new = 1.0 / (2.0 * sigma - rho);
+      const double a = rho_new * rho;
+      const double b = 2.0 * rho_new / delta;
+      rho = rho_new;
+      // r <- r - D^{-1} A d, d <- a d + b r, y += d
+      auto H = helper.Read();
+      auto R = residual.ReadWrite();
+      auto D = direction.ReadWrite();
+      auto Y = y.ReadWrite();
+      MFEM_FORALL(i, n,
+      {
+         R[i] -= DI[i] * H[i];
+         D[i] = a * D[i] + b * R[i];
+         Y[i] += D[i];
+      });
+   }
+}
+
 
 void SLISolver::UpdateVectors()
 {
@@ -344,6 +561,85 @@ void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void IterativeRefinementSolver::SetOperator(const Operator &op)
+{
+   oper = &op;
+   height = op.Height();
+   width = op.Width();
+   r.SetSize(width);
+   c.SetSize(width);
+}
+
+void IterativeRefinementSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(prec != NULL, "the inner solver is not set");
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   const double nom0 = Norm(r);
+   MFEM_ASSERT(IsFinite(nom0), "nom0 = " << nom0);
+   const double tol = std::max(rel_tol*nom0, abs_tol);
+   double nom = nom0;
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  ||r|| = "
+                << nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 0; true; )
+   {
+      if (nom <= tol)
+      {
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      c = 0.0;
+      prec->Mult(r, c);  // c = M r
+      x += c;
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+      nom = Norm(r);
+      MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  ||r|| = "
+                   << nom << '\n';
+      }
+   }
+
+   if (print_level == 2 && converged)
+   {
+      mfem::out << "Number of refinement iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  ||r|| = "
+                << nom << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "IterativeRefinement: No convergence!" << '\n';
+   }
+   final_norm = nom;
+}
+
 void CGSolver::UpdateVectors()
 {
    r.SetSize(width);
@@ -419,17 +715,17 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    for (i = 1; true; )
    {
       alpha = nom/den;
-      add(x,  alpha, d, x);     //  x = x + alpha d
-      add(r, -alpha, z, r);     //  r = r - alpha A d
-
       if (prec)
       {
+         add(x,  alpha, d, x);  //  x = x + alpha d
+         add(r, -alpha, z, r);  //  r = r - alpha A d
          prec->Mult(r, z);      //  z = B r
          betanom = Dot(r, z);
       }
       else
       {
-         betanom = Dot(r, r);
+         //  x = x + alpha d, r = r - alpha A d and (r, r) in a single pass
+         betanom = GlobalSum(AddTwoAndDot(alpha, d, x, -alpha, z, r, r));
       }
       MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
 
@@ -509,6 +805,311 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    final_norm = sqrt(betanom);
 }
 
+void PipelinedCGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   u.SetSize(width);
+   w.SetSize(width);
+   m.SetSize(width);
+   n.SetSize(width);
+   p.SetSize(width);
+   s.SetSize(width);
+   q.SetSize(width);
+   z.SetSize(width);
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   // Preconditioned pipelined CG, Algorithm 4 in P. Ghysels, W. Vanroose,
+   // "Hiding global synchronization latency in the preconditioned Conjugate
+   // Gradient algorithm", Parallel Computing, 40 (2014).
+   double dots[2], gamma, gamma_old = 0.0, delta, alpha = 0.0, beta;
+   double r0 = 0.0, nom0 = 0.0;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   else
+   {
+      u = r;
+   }
+   oper->Mult(u, w);    // w = A u
+
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 0; true; i++)
+   {
+      dots[0] = r * u;
+      dots[1] = w * u;
+      StartReduction(dots, 2);
+
+      // Overlap the reduction with the preconditioner and the operator
+      if (prec)
+      {
+         prec->Mult(w, m); // m = B w
+      }
+      else
+      {
+         m = w;
+      }
+      oper->Mult(m, n);    // n = A m
+
+      FinishReduction();
+      gamma = dots[0];
+      delta = dots[1];
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+      MFEM_ASSERT(IsFinite(delta), "delta = " << delta);
+
+      if (i == 0)
+      {
+         nom0 = gamma;
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+         if (print_level == 1 || print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << gamma << (print_level == 3 ? " ...\n" : "\n");
+         }
+      }
+      else if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << '\n';
+      }
+      if (gamma <= r0)
+      {
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (i == max_iter)
+      {
+         break;
+      }
+
+      if (i == 0)
+      {
+         beta = 0.0;
+         alpha = gamma/delta;
+      }
+      else
+      {
+         beta = gamma/gamma_old;
+         alpha = gamma/(delta - beta*gamma/alpha);
+      }
+      const double den = gamma/alpha; // den = (A p, p)
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PipelinedCG: The operator is not positive definite. "
+                      << "(Ap, p) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      gamma_old = gamma;
+
+      if (i == 0)
+      {
+         z = n;
+         q = m;
+         s = w;
+         p = u;
+      }
+      else
+      {
+         add(n, beta, z, z);  // z = n + beta z
+         add(m, beta, q, q);  // q = m + beta q
+         add(w, beta, s, s);  // s = w + beta s
+         add(u, beta, p, p);  // p = u + beta p
+      }
+      x.Add(alpha, p);        // x = x + alpha p
+      r.Add(-alpha, s);       // r = r - alpha s
+      u.Add(-alpha, q);       // u = u - alpha q
+      w.Add(-alpha, z);       // w = w - alpha z
+   }
+
+   if (print_level == 2 && converged)
+   {
+      mfem::out << "Number of PipelinedCG iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter
+                << "  (B r, r) = " << gamma << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "PipelinedCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 && final_iter > 0)
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (gamma/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(gamma);
+}
+
+void ChronopoulosGearCGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   u.SetSize(width);
+   w.SetSize(width);
+   p.SetSize(width);
+   s.SetSize(width);
+}
+
+void ChronopoulosGearCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   // Preconditioned CG with the Chronopoulos-Gear recurrence for alpha, see
+   // Algorithm 2 in Ghysels and Vanroose, Parallel Computing, 40 (2014).
+   double dots[2], gamma, gamma_old = 0.0, delta, alpha = 0.0, beta;
+   double r0 = 0.0, nom0 = 0.0;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 0; true; i++)
+   {
+      if (prec)
+      {
+         prec->Mult(r, u); // u = B r
+      }
+      else
+      {
+         u = r;
+      }
+      oper->Mult(u, w);    // w = A u
+      dots[0] = r * u;
+      dots[1] = w * u;
+      StartReduction(dots, 2);
+
+      // Overlap the reduction with the update of the solution from the
+      // previous iteration
+      if (i > 0)
+      {
+         x.Add(alpha, p);  // x = x + alpha p
+      }
+
+      FinishReduction();
+      gamma = dots[0];
+      delta = dots[1];
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+      MFEM_ASSERT(IsFinite(delta), "delta = " << delta);
+
+      if (i == 0)
+      {
+         nom0 = gamma;
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+         if (print_level == 1 || print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << gamma << (print_level == 3 ? " ...\n" : "\n");
+         }
+      }
+      else if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << '\n';
+      }
+      if (gamma <= r0)
+      {
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (i == max_iter)
+      {
+         break;
+      }
+
+      if (i == 0)
+      {
+         beta = 0.0;
+         alpha = gamma/delta;
+      }
+      else
+      {
+         beta = gamma/gamma_old;
+         alpha = gamma/(delta - beta*gamma/alpha);
+      }
+      const double den = gamma/alpha; // den = (A p, p)
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "ChronopoulosGearCG: The operator is not positive "
+                      << "definite. (Ap, p) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      gamma_old = gamma;
+
+      if (i == 0)
+      {
+         p = u;
+         s = w;
+      }
+      else
+      {
+         add(u, beta, p, p);  // p = u + beta p
+         add(w, beta, s, s);  // s = A p = w + beta s
+      }
+      r.Add(-alpha, s);       // r = r - alpha s
+   }
+
+   if (print_level == 2 && converged)
+   {
+      mfem::out << "Number of ChronopoulosGearCG iterations: " << final_iter
+                << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter
+                << "  (B r, r) = " << gamma << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "ChronopoulosGearCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 && final_iter > 0)
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (gamma/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(gamma);
+}
+
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter, int max_num_iter,
         double RTOLERANCE, double ATOLERANCE)
@@ -537,6 +1138,147 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void BatchedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MultiVector B, X;
+   B.MakeRef(const_cast<Vector&>(b), b.Size(), 1);
+   X.MakeRef(x, x.Size(), 1);
+   MultMulti(B, X);
+}
+
+void BatchedCGSolver::MultMulti(const MultiVector &B, MultiVector &X) const
+{
+   const int n = width, k = B.NumVectors();
+   MFEM_VERIFY(X.NumVectors() == k, "incompatible number of vectors");
+   R.SetSize(n, k);
+   D.SetSize(n, k);
+   Z.SetSize(n, k);
+   alpha.SetSize(k);
+   beta.SetSize(k);
+   r0.SetSize(k);
+
+   if (iterative_mode)
+   {
+      oper->MultMulti(X, R);
+      subtract(B, R, R); // R = B - A X
+   }
+   else
+   {
+      R = B;
+      X = 0.0;
+   }
+
+   if (prec)
+   {
+      prec->MultMulti(R, Z); // Z = M R
+      D = Z;
+   }
+   else
+   {
+      D = R;
+   }
+   Dots(D, R, nom);
+
+   // The vectors that have not converged, yet
+   Array<bool> active(k);
+   int num_active = 0;
+   for (int j = 0; j < k; j++)
+   {
+      MFEM_ASSERT(IsFinite(nom(j)), "nom = " << nom(j));
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+      active[j] = (nom(j) > r0(j));
+      num_active += active[j];
+   }
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+                << nom.Max() << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   converged = 1;
+   final_iter = 0;
+   while (num_active > 0)
+   {
+      if (final_iter == max_iter)
+      {
+         converged = 0;
+         break;
+      }
+      final_iter++;
+
+      oper->MultMulti(D, Z); // Z = A D
+      Dots(D, Z, den);
+      for (int j = 0; j < k; j++)
+      {
+         alpha(j) = 0.0;
+         if (!active[j]) { continue; }
+         MFEM_ASSERT(IsFinite(den(j)), "den = " << den(j));
+         if (den(j) <= 0.0)
+         {
+            if (print_level >= 0)
+            {
+               mfem::out << "BatchedCG: The operator is not positive definite"
+                         << " for vector " << j << ". (Ad, d) = " << den(j)
+                         << '\n';
+            }
+            // Stop the iterations of this vector
+            active[j] = false;
+            num_active--;
+            converged = 0;
+            continue;
+         }
+         alpha(j) = nom(j)/den(j);
+      }
+      X.AddScaled(alpha, D); // X = X + alpha D
+      alpha.Neg();
+      R.AddScaled(alpha, Z); // R = R - alpha A D
+
+      if (prec)
+      {
+         prec->MultMulti(R, Z); // Z = M R
+         Dots(R, Z, betanom);
+      }
+      else
+      {
+         Dots(R, R, betanom);
+      }
+
+      for (int j = 0; j < k; j++)
+      {
+         beta(j) = 0.0;
+         if (!active[j]) { continue; }
+         MFEM_ASSERT(IsFinite(betanom(j)), "betanom = " << betanom(j));
+         beta(j) = betanom(j)/nom(j);
+         nom(j) = betanom(j);
+         if (betanom(j) < r0(j))
+         {
+            active[j] = false;
+            num_active--;
+         }
+      }
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << final_iter
+                   << "  max (B r, r) = " << nom.Max() << '\n';
+      }
+      if (num_active == 0) { break; }
+
+      // D = Z + beta D, the vectors that have stopped are not used anymore
+      D.ScaleAndAdd(beta, prec ? Z : R);
+   }
+
+   final_norm = sqrt(nom.Max());
+   if (print_level == 2 || (print_level == 3 && converged))
+   {
+      mfem::out << "Number of BatchedCG iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BatchedCG: No convergence!" << '\n';
+   }
+}
+
+
 inline void GeneratePlaneRotation(double &dx, double &dy,
                                   double &cs, double &sn)
 {
@@ -938,6 +1680,217 @@ void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void BatchedGMRESSolver::Residual(const MultiVector &B, const MultiVector &X,
+                                  MultiVector &R, MultiVector &W) const
+{
+   oper->MultMulti(X, W);
+   subtract(B, W, W);
+   if (prec)
+   {
+      prec->MultMulti(W, R); // R = M (B - A X)
+   }
+   else
+   {
+      R = W;
+   }
+}
+
+void BatchedGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   MultiVector B, X;
+   B.MakeRef(const_cast<Vector&>(b), b.Size(), 1);
+   X.MakeRef(x, x.Size(), 1);
+   MultMulti(B, X);
+}
+
+void BatchedGMRESSolver::MultMulti(const MultiVector &B, MultiVector &X) const
+{
+   // Restarted GMRES for every vector, as in GMRESSolver::Mult(), where the
+   // Krylov vectors of all the right-hand sides are stored in MultiVectors.
+   const int n = width, nv = B.NumVectors();
+   MFEM_VERIFY(X.NumVectors() == nv, "incompatible number of vectors");
+
+   DenseTensor H(m+1, m, nv);
+   DenseMatrix s(m+1, nv), cs(m+1, nv), sn(m+1, nv), y(m+1, nv);
+   MultiVector R(n, nv), W(n, nv);
+   Array<MultiVector *> V(m+1);
+   V = NULL;
+   Vector beta(nv), tol(nv), h, scale(nv);
+   Array<bool> active(nv);
+   Array<int> last(nv);
+
+   if (iterative_mode)
+   {
+      Residual(B, X, R, W);
+   }
+   else
+   {
+      X = 0.0;
+      if (prec) { prec->MultMulti(B, R); }
+      else { R = B; }
+   }
+   Dots(R, R, beta);
+   int num_active = 0;
+   for (int c = 0; c < nv; c++)
+   {
+      beta(c) = sqrt(beta(c));
+      MFEM_ASSERT(IsFinite(beta(c)), "beta = " << beta(c));
+      tol(c) = std::max(rel_tol*beta(c), abs_tol);
+      active[c] = (beta(c) > tol(c));
+      num_active += active[c];
+   }
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  max ||B r|| = " << beta.Max()
+                << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   final_iter = 0;
+   int j = 1;
+   while (num_active > 0 && j <= max_iter)
+   {
+      if (V[0] == NULL) { V[0] = new MultiVector(n, nv); }
+      for (int c = 0; c < nv; c++)
+      {
+         scale(c) = active[c] ? 1.0/beta(c) : 0.0;
+         last[c] = -1;
+      }
+      *V[0] = 0.0;
+      V[0]->AddScaled(scale, R);
+      s = 0.0;
+      for (int c = 0; c < nv; c++) { s(0,c) = active[c] ? beta(c) : 0.0; }
+
+      int i;
+      for (i = 0; i < m && j <= max_iter && num_active > 0; i++, j++)
+      {
+         if (prec)
+         {
+            oper->MultMulti(*V[i], R);
+            prec->MultMulti(R, W);   // W = M A V[i]
+         }
+         else
+         {
+            oper->MultMulti(*V[i], W);
+         }
+
+         for (int k = 0; k <= i; k++)
+         {
+            Dots(W, *V[k], h);       // H(k,i) = W * V[k]
+            for (int c = 0; c < nv; c++) { H(k,i,c) = h(c); }
+            h.Neg();
+            W.AddScaled(h, *V[k]);   // W -= H(k,i) * V[k]
+         }
+         Dots(W, W, h);
+         for (int c = 0; c < nv; c++)
+         {
+            H(i+1,i,c) = sqrt(h(c)); // H(i+1,i) = ||W||
+            MFEM_ASSERT(IsFinite(H(i+1,i,c)), "Norm(w) = " << H(i+1,i,c));
+            scale(c) = (active[c] && H(i+1,i,c) > 0.0) ? 1.0/H(i+1,i,c) : 0.0;
+         }
+         if (V[i+1] == NULL) { V[i+1] = new MultiVector(n, nv); }
+         *V[i+1] = 0.0;
+         V[i+1]->AddScaled(scale, W); // V[i+1] = W / H(i+1,i)
+
+         double max_resid = 0.0;
+         for (int c = 0; c < nv; c++)
+         {
+            if (!active[c]) { continue; }
+            for (int k = 0; k < i; k++)
+            {
+               ApplyPlaneRotation(H(k,i,c), H(k+1,i,c), cs(k,c), sn(k,c));
+            }
+            GeneratePlaneRotation(H(i,i,c), H(i+1,i,c), cs(i,c), sn(i,c));
+            ApplyPlaneRotation(H(i,i,c), H(i+1,i,c), cs(i,c), sn(i,c));
+            ApplyPlaneRotation(s(i,c), s(i+1,c), cs(i,c), sn(i,c));
+            last[c] = i;
+
+            const double resid = fabs(s(i+1,c));
+            MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+            beta(c) = resid;
+            max_resid = std::max(max_resid, resid);
+            if (resid <= tol(c))
+            {
+               active[c] = false;
+               num_active--;
+            }
+         }
+         final_iter = j;
+
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  max ||B r|| = " << max_resid << '\n';
+         }
+      }
+
+      // Update the solutions with the Krylov vectors of this pass: backsolve
+      // for every vector up to its last iteration
+      y = 0.0;
+      for (int c = 0; c < nv; c++)
+      {
+         for (int l = last[c]; l >= 0; l--)
+         {
+            y(l,c) = s(l,c);
+            for (int k = l + 1; k <= last[c]; k++)
+            {
+               y(l,c) -= H(l,k,c) * y(k,c);
+            }
+            y(l,c) /= H(l,l,c);
+         }
+      }
+      for (int k = 0; k < i; k++)
+      {
+         for (int c = 0; c < nv; c++) { scale(c) = y(k,c); }
+         X.AddScaled(scale, *V[k]);
+      }
+
+      if (num_active > 0 && j <= max_iter)
+      {
+         if (print_level == 1)
+         {
+            mfem::out << "Restarting..." << '\n';
+         }
+         Residual(B, X, R, W);
+         Dots(R, R, beta);
+         for (int c = 0; c < nv; c++)
+         {
+            beta(c) = sqrt(beta(c));
+            MFEM_ASSERT(IsFinite(beta(c)), "beta = " << beta(c));
+            if (active[c] && beta(c) <= tol(c))
+            {
+               active[c] = false;
+               num_active--;
+            }
+         }
+      }
+   }
+
+   converged = (num_active == 0);
+   if (!converged) { final_iter = max_iter; }
+   final_norm = beta.Max();
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (final_iter-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  max ||B r|| = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      mfem::out << "BatchedGMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BatchedGMRES: No convergence!\n";
+   }
+   for (int i = 0; i < V.Size(); i++)
+   {
+      delete V[i];
+   }
+}
+
 void BiCGSTABSolver::UpdateVectors()
 {
    p.SetSize(width);
@@ -1020,8 +1973,8 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       }
       oper->Mult(phat, v);     //  v = A * phat
       alpha = rho_1 / Dot(rtilde, v);
-      add(r, -alpha, v, s); //  s = r - alpha * v
-      resid = Norm(s);
+      //  s = r - alpha * v
+      resid = sqrt(GlobalSum(AddAndDot(r, -alpha, v, s, s)));
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (resid < tol_goal)
       {
@@ -1049,10 +2002,9 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       omega = Dot(t, s) / Dot(t, t);
       x.Add(alpha, phat);   //  x += alpha * phat
       x.Add(omega, shat);   //  x += omega * shat
-      add(s, -omega, t, r); //  r = s - omega * t
-
+      //  r = s - omega * t
+      resid = sqrt(GlobalSum(AddAndDot(s, -omega, t, r, r)));
       rho_2 = rho_1;
-      resid = Norm(r);
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (print_level >= 0)
       {
@@ -1178,17 +2130,18 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
       {
          q.Add(-beta, v0);
       }
-      add(q, -alpha, v1, v0);
 
       delta = gamma1*alpha - gamma0*sigma1*beta;
       rho3 = sigma0*beta;
       rho2 = sigma1*alpha + gamma0*gamma1*beta;
       if (!prec)
       {
-         beta = Norm(v0);
+         // v0 = q - alpha v1 and its norm in a single pass
+         beta = sqrt(GlobalSum(AddAndDot(q, -alpha, v1, v0, v0)));
       }
       else
       {
+         add(q, -alpha, v1, v0);
          prec->Mult(v0, q);
          beta = sqrt(Dot(v0, q));
       }
@@ -37,6 +37,7 @@ class IterativeSolver : public Solver
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm;
+   mutable MPI_Request reduction_request;
 #endif
 
 protected:
@@ -52,6 +53,21 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+   /** @brief Return the sum of the local values @a s, e.g. inner products
+       computed with AddAndDot(), over all processors. */
+   double GlobalSum(double s) const;
+   /// Compute the inner products of all the vectors, d(j) = (x_j, y_j).
+   void Dots(const MultiVector &x, const MultiVector &y, Vector &d) const;
+
+   /** @brief Start the global sums of the @a n local values in @a buf, which
+       are replaced by the sums. */
+   /** In parallel, MPI_Iallreduce() is used so that local work can be done
+       before the sums are needed; FinishReduction() must be called before
+       @a buf is used. In serial, this is a no-op. */
+   void StartReduction(double *buf, int n) const;
+
+   /// Wait for the reduction started by StartReduction() to complete.
+   void FinishReduction() const;
 
 public:
    IterativeSolver();
@@ -116,6 +132,74 @@ private:
 };
 
 
+/// Chebyshev polynomial smoothing for a given Operator (no matrix necessary).
+/** The smoother applies @a order steps of the Chebyshev iteration to the
+    Jacobi preconditioned operator D^{-1} A, where D is a given vector, e.g. the
+    diagonal obtained with BilinearForm::AssembleDiagonal(). The polynomial
+    damps the part [lower, upper] of the spectrum of D^{-1} A where upper is an
+    estimate of the largest eigenvalue and lower = upper * fraction, see
+    SetLowerBoundFraction(). Only the action of the operator and device Vector
+    kernels are used, so the smoother is useful with partially assembled
+    operators, e.g. in matrix-free multigrid. As with OperatorJacobiSmoother,
+    the underlying operator is assumed to act as the identity on the entries in
+    ess_tdof_list. */
+class OperatorChebyshevSmoother : public Solver
+{
+public:
+   /** @brief Setup the smoother, estimating the largest eigenvalue of D^{-1} A
+       with @a power_iterations steps of the power method. */
+   /** If @a power_iterations is 0, no estimate is computed and it must be set
+       with SetMaxEigenvalueEstimate() before using the smoother. */
+   OperatorChebyshevSmoother(const Operator &oper, const Vector &d,
+                             const Array<int> &ess_tdof_list, int order,
+                             int power_iterations = 10,
+                             double power_tolerance = 1e-8);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Parallel version of the above constructor, where the inner
+       products of the power method are global over @a comm. */
+   OperatorChebyshevSmoother(MPI_Comm comm, const Operator &oper,
+                             const Vector &d, const Array<int> &ess_tdof_list,
+                             int order, int power_iterations = 10,
+                             double power_tolerance = 1e-8);
+#endif
+
+   ~OperatorChebyshevSmoother() {}
+
+   void Mult(const Vector &x, Vector &y) const;
+
+   void SetOperator(const Operator &op) { oper = &op; }
+
+   /** @brief Set the lower bound of the damped spectrum as a fraction of the
+       largest eigenvalue estimate. The default is 0.3. */
+   void SetLowerBoundFraction(double fraction) { lower_fraction = fraction; }
+
+   /// Set the estimate of the largest eigenvalue of D^{-1} A.
+   void SetMaxEigenvalueEstimate(double max_eig_estimate)
+   { max_eig = max_eig_estimate; }
+
+   /// Return the estimate of the largest eigenvalue of D^{-1} A.
+   double GetMaxEigenvalueEstimate() const { return max_eig; }
+
+private:
+   const int order;
+   const int N;
+   Vector diag, dinv;
+   double max_eig, lower_fraction;
+   mutable Vector residual, direction, helper;
+
+   const Operator *oper;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm; // MPI_COMM_NULL for local inner products
+#endif
+
+   void Setup(const Vector &d, const Array<int> &ess_tdof_list);
+   double Dot(const Vector &x, const Vector &y) const;
+   double EstimateLargestEigenvalue(int iterations, double tolerance);
+};
+
+
 /// Stationary linear iteration: x <- x + B (b - A x)
 class SLISolver : public IterativeSolver
 {
@@ -148,6 +232,35 @@ void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
          double RTOLERANCE = 1e-12, double ATOLERANCE = 1e-24);
 
 
+/// Iterative refinement (defect correction) with an inexact inner solver
+/** The iteration is x = x + M (b - A x), where the residual is computed with
+    the operator A given to SetOperator() and the correction with the inner
+    solver M given to SetPreconditioner(). Unlike in the other iterative
+    solvers, SetOperator() does not set the operator of the inner solver: M is
+    typically a cheaper approximation of A^{-1}, e.g. a few CG iterations on
+    a single precision partially assembled form, see
+    DiffusionIntegrator::SetSinglePrecisionPA(), while the residual is kept in
+    double precision. The iteration stops when ||b - A x|| is reduced by the
+    relative tolerance or below the absolute tolerance. */
+class IterativeRefinementSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, c;
+
+public:
+   IterativeRefinementSolver() { }
+
+#ifdef MFEM_USE_MPI
+   IterativeRefinementSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Set the operator A, the inner solver is not modified.
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
 /// Conjugate gradient method
 class CGSolver : public IterativeSolver
 {
@@ -169,6 +282,59 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/// Pipelined conjugate gradient method
+/** The Ghysels-Vanroose variant of preconditioned CG: the two inner products of
+    an iteration are combined into one global reduction, which is overlapped
+    with the application of the preconditioner and the operator. Each
+    iteration applies both once, as CGSolver, at the cost of extra vector
+    updates and storage. Since the residual is updated by recurrences, the
+    attainable accuracy can be slightly lower than with CGSolver. */
+class PipelinedCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, m, n, p, s, q, z;
+
+   void UpdateVectors();
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/// Conjugate gradient method with a single reduction per iteration
+/** The Chronopoulos-Gear variant of preconditioned CG computes both inner
+    products of an iteration after the operator application, so that they
+    are combined into one global reduction. The reduction is non-blocking and
+    it is overlapped with the update of the solution, which is delayed by one
+    iteration. */
+class ChronopoulosGearCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, p, s;
+
+   void UpdateVectors();
+
+public:
+   ChronopoulosGearCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   ChronopoulosGearCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
 /// Conjugate gradient method. (tolerances are squared)
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter = 0, int max_num_iter = 1000,
@@ -199,6 +365,63 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/// Conjugate gradient method for many right-hand sides
+/** The right-hand sides of MultMulti() are solved simultaneously with
+    independent CG iterations that share the applications of the operator and
+    of the preconditioner, see Operator::MultMulti(), so that operators with a
+    native MultMulti() read their data once per iteration for all the vectors.
+    The iterations of a vector stop when it has converged. The convergence
+    statistics are those of the slowest vector. */
+class BatchedCGSolver : public IterativeSolver
+{
+protected:
+   mutable MultiVector R, D, Z;
+   mutable Vector alpha, beta, nom, den, betanom, r0;
+
+public:
+   BatchedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BatchedCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Solve A X_j = B_j for all vectors j of @a B.
+   virtual void MultMulti(const MultiVector &B, MultiVector &X) const;
+
+   /// Solve A x = b, the same as MultMulti() with a single vector.
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/// GMRES method for many right-hand sides
+/** The right-hand sides of MultMulti() are solved with independent restarted
+    GMRES iterations that share the applications of the operator and of the
+    preconditioner, as in BatchedCGSolver. */
+class BatchedGMRESSolver : public IterativeSolver
+{
+protected:
+   int m; // see SetKDim()
+
+   /// Compute R = M (B - A X) with W as a temporary.
+   void Residual(const MultiVector &B, const MultiVector &X, MultiVector &R,
+                 MultiVector &W) const;
+
+public:
+   BatchedGMRESSolver() { m = 50; }
+
+#ifdef MFEM_USE_MPI
+   BatchedGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+#endif
+
+   /// Set the number of iteration to perform between restarts, default is 50.
+   void SetKDim(int dim) { m = dim; }
+
+   /// Solve A X_j = B_j for all vectors j of @a B.
+   virtual void MultMulti(const MultiVector &B, MultiVector &X) const;
+
+   /// Solve A x = b, the same as MultMulti() with a single vector.
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
 /// FGMRES method
 class FGMRESSolver : public IterativeSolver
 {
@@ -22,6 +22,11 @@
 #include <algorithm>
 #include <limits>
 #include <cstring>
+#include <vector>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace mfem
 {
@@ -35,7 +40,8 @@ SparseMatrix::SparseMatrix(int nrows, int ncols)
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
-     isSorted(false)
+     isSorted(false),
+     symStorage(false)
 {
    // We probably do not need to set the ownership flags here.
    I.Reset(); I.SetHostPtrOwner(true);
@@ -58,7 +64,8 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n)
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
-     isSorted(false)
+     isSorted(false),
+     symStorage(false)
 {
    I.Wrap(i, height+1, true);
    J.Wrap(j, I[height], true);
@@ -76,7 +83,8 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n,
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
-     isSorted(issorted)
+     isSorted(issorted),
+     symStorage(false)
 {
    I.Wrap(i, height+1, ownij);
    J.Wrap(j, I[height], ownij);
@@ -104,6 +112,7 @@ SparseMatrix::SparseMatrix(int nrows, int ncols, int rowsize)
    , ColPtrNode(NULL)
    , At(NULL)
    , isSorted(false)
+   , symStorage(false)
 {
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
@@ -181,6 +190,7 @@ SparseMatrix::SparseMatrix(const SparseMatrix &mat, bool copy_graph)
    ColPtrNode = NULL;
    At = NULL;
    isSorted = mat.isSorted;
+   symStorage = mat.symStorage;
 }
 
 SparseMatrix::SparseMatrix(const Vector &v)
@@ -190,6 +200,7 @@ SparseMatrix::SparseMatrix(const Vector &v)
    , ColPtrNode(NULL)
    , At(NULL)
    , isSorted(true)
+   , symStorage(false)
 {
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
@@ -230,6 +241,7 @@ void SparseMatrix::MakeRef(const SparseMatrix &master)
    J = master.J; J.ClearOwnerFlags();
    A = master.A; A.ClearOwnerFlags();
    isSorted = master.isSorted;
+   symStorage = master.symStorage;
 }
 
 void SparseMatrix::SetEmpty()
@@ -247,6 +259,7 @@ void SparseMatrix::SetEmpty()
    NodesMem = NULL;
 #endif
    isSorted = false;
+   symStorage = false;
 }
 
 int SparseMatrix::RowSize(const int i) const
@@ -435,6 +448,7 @@ double &SparseMatrix::operator()(int i, int j)
                << "j = " << j);
 
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+   if (symStorage && j < i) { mfem::Swap(i, j); }
 
    for (int k = I[i], end = I[i+1]; k < end; k++)
    {
@@ -459,6 +473,7 @@ const double &SparseMatrix::operator()(int i, int j) const
                << "i = " << i << ", "
                << "j = " << j);
 
+   if (symStorage && j < i) { mfem::Swap(i, j); }
    if (Finalized())
    {
       for (int k = I[i], end = I[i+1]; k < end; k++)
@@ -538,6 +553,7 @@ void SparseMatrix::ToDenseMatrix(DenseMatrix & B) const
       for (int cj=0; cj<this->RowSize(r); cj++)
       {
          B(r, col[cj]) = val[cj];
+         if (symStorage) { B(col[cj], r) = val[cj]; }
       }
    }
 }
@@ -549,6 +565,50 @@ void SparseMatrix::Mult(const Vector &x, Vector &y) const
    AddMult(x, y);
 }
 
+void SparseMatrix::MultMulti(const MultiVector &X, MultiVector &Y) const
+{
+   MFEM_VERIFY(X.NumVectors() == Y.NumVectors(),
+               "incompatible number of vectors");
+   MFEM_ASSERT(width == X.VectorSize() && height == Y.VectorSize(),
+               "incompatible vector sizes");
+   if (!Finalized() || symStorage)
+   {
+      Operator::MultMulti(X, Y);
+      return;
+   }
+
+   // Every row is traversed once per chunk of up to MAX_V vectors, with the
+   // partial sums kept in registers
+   const int MAX_V = 8;
+   const int height = this->height;
+   const int width = this->width;
+   const int k = X.NumVectors();
+   const int nnz = J.Capacity();
+   auto d_I = Read(I, height+1);
+   auto d_J = Read(J, nnz);
+   auto d_A = Read(A, nnz);
+   auto d_X = X.Read();
+   Y.UseDevice(true);
+   auto d_Y = Y.Write();
+   MFEM_FORALL(i, height,
+   {
+      const int begin = d_I[i], end = d_I[i+1];
+      for (int v0 = 0; v0 < k; v0 += MAX_V)
+      {
+         const int nv = (k - v0 < MAX_V) ? k - v0 : MAX_V;
+         double d[MAX_V];
+         for (int v = 0; v < nv; v++) { d[v] = 0.0; }
+         for (int j = begin; j < end; j++)
+         {
+            const double a = d_A[j];
+            const double *x = d_X + d_J[j] + v0*width;
+            for (int v = 0; v < nv; v++) { d[v] += a * x[v*width]; }
+         }
+         for (int v = 0; v < nv; v++) { d_Y[i + (v0+v)*height] = d[v]; }
+      }
+   });
+}
+
 void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
 {
    MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
@@ -569,13 +629,22 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
          for ( ; row != NULL; row = row->Prev)
          {
             b += row->Value * xp[row->Column];
+            if (symStorage && row->Column != i)
+            {
+               yp[row->Column] += a * row->Value * xp[i];
+            }
          }
-         *yp += a * b;
-         yp++;
+         yp[i] += a * b;
       }
       return;
    }
 
+   if (symStorage)
+   {
+      SymAddMult(x, y, a);
+      return;
+   }
+
 #ifndef MFEM_USE_LEGACY_OPENMP
    const int height = this->height;
    const int nnz = J.Capacity();
@@ -628,6 +697,12 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    MFEM_ASSERT(width == y.Size(), "Output vector size (" << y.Size()
                << ") must match matrix width (" << width << ")");
 
+   if (symStorage)
+   {
+      AddMult(x, y, a);
+      return;
+   }
+
    if (!Finalized())
    {
       double *yp = y.GetData();
@@ -667,6 +742,7 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
 
 void SparseMatrix::BuildTranspose() const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    if (At == NULL)
    {
       At = Transpose(*this);
@@ -682,6 +758,12 @@ void SparseMatrix::ResetTranspose() const
 void SparseMatrix::PartMult(
    const Array<int> &rows, const Vector &x, Vector &y) const
 {
+   if (symStorage)
+   {
+      for (int i = 0; i < rows.Size(); i++) { y(rows[i]) = 0.0; }
+      PartAddMult(rows, x, y);
+      return;
+   }
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
    const int n = rows.Size();
@@ -708,6 +790,24 @@ void SparseMatrix::PartMult(
 void SparseMatrix::PartAddMult(
    const Array<int> &rows, const Vector &x, Vector &y, const double a) const
 {
+   if (symStorage)
+   {
+      MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+      // the entries left of the diagonal are stored in the rows above
+      Array<int> marked(height);
+      marked = 0;
+      for (int i = 0; i < rows.Size(); i++) { marked[rows[i]] = 1; }
+      for (int i = 0; i < height; i++)
+      {
+         for (int j = I[i]; j < I[i+1]; j++)
+         {
+            const int c = J[j];
+            if (marked[i]) { y(i) += a * A[j] * x(c); }
+            if (c != i && marked[c]) { y(c) += a * A[j] * x(i); }
+         }
+      }
+      return;
+   }
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
    for (int i = 0; i < rows.Size(); i++)
@@ -725,6 +825,7 @@ void SparseMatrix::PartAddMult(
 
 void SparseMatrix::BooleanMult(const Array<int> &x, Array<int> &y) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_ASSERT(Finalized(), "Matrix must be finalized.");
    MFEM_ASSERT(x.Size() == Width(), "Input vector size (" << x.Size()
                << ") must match matrix width (" << Width() << ")");
@@ -756,6 +857,7 @@ void SparseMatrix::BooleanMult(const Array<int> &x, Array<int> &y) const
 void SparseMatrix::BooleanMultTranspose(const Array<int> &x,
                                         Array<int> &y) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_ASSERT(Finalized(), "Matrix must be finalized.");
    MFEM_ASSERT(x.Size() == Height(), "Input vector size (" << x.Size()
                << ") must match matrix height (" << Height() << ")");
@@ -802,6 +904,8 @@ double SparseMatrix::InnerProduct(const Vector &x, const Vector &y) const
          for (int j = I[i], end = I[i+1]; j < end; j++)
          {
             a += A[j] * x(J[j]);
+            // the entry a_ji of the lower triangle
+            if (symStorage && J[j] != i) { prod += A[j] * x(i) * y(J[j]); }
          }
       }
       else
@@ -809,6 +913,10 @@ double SparseMatrix::InnerProduct(const Vector &x, const Vector &y) const
          for (RowNode *np = Rows[i]; np != NULL; np = np->Prev)
          {
             a += np->Value * x(np->Column);
+            if (symStorage && np->Column != i)
+            {
+               prod += np->Value * x(i) * y(np->Column);
+            }
          }
       }
       prod += a * y(i);
@@ -819,6 +927,9 @@ double SparseMatrix::InnerProduct(const Vector &x, const Vector &y) const
 
 void SparseMatrix::GetRowSums(Vector &x) const
 {
+   // with symmetric storage, the entries a_ij, j > i, are also added to the
+   // rows j > i, which are summed later
+   if (symStorage) { x = 0.0; }
    for (int i = 0; i < height; i++)
    {
       double a = 0.0;
@@ -827,6 +938,7 @@ void SparseMatrix::GetRowSums(Vector &x) const
          for (int j = I[i], end = I[i+1]; j < end; j++)
          {
             a += A[j];
+            if (symStorage && J[j] != i) { x(J[j]) += A[j]; }
          }
       }
       else
@@ -834,14 +946,17 @@ void SparseMatrix::GetRowSums(Vector &x) const
          for (RowNode *np = Rows[i]; np != NULL; np = np->Prev)
          {
             a += np->Value;
+            if (symStorage && np->Column != i) { x(np->Column) += np->Value; }
          }
       }
-      x(i) = a;
+      if (symStorage) { x(i) += a; }
+      else { x(i) = a; }
    }
 }
 
 double SparseMatrix::GetRowNorml1(int irow) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_VERIFY(irow < height,
                "row " << irow << " not in matrix with height " << height);
 
@@ -1005,8 +1120,80 @@ void SparseMatrix::Finalize(int skip_zeros, bool fix_empty_rows)
    Rows = NULL;
 }
 
+void SparseMatrix::SetSymmetricStorage()
+{
+   MFEM_VERIFY(height == width, "Matrix must be square, not height = "
+               << height << ", width = " << width);
+   if (symStorage) { return; }
+   symStorage = true;
+
+   if (!Finalized())
+   {
+      // Unlink the entries with j < i
+      for (int i = 0; i < height; i++)
+      {
+         RowNode **node_pp = &Rows[i];
+         while (*node_pp != NULL)
+         {
+            RowNode *node_p = *node_pp;
+            if (node_p->Column < i)
+            {
+               *node_pp = node_p->Prev;
+#ifndef MFEM_USE_MEMALLOC
+               delete node_p;
+#endif
+            }
+            else
+            {
+               node_pp = &node_p->Prev;
+            }
+         }
+      }
+      return;
+   }
+
+   // Copy the upper triangle into new, smaller arrays
+   ResetTranspose();
+   const int nnz = J.Capacity();
+   const int *Ip = HostRead(I, height+1);
+   const int *Jp = HostRead(J, nnz);
+   const double *Ap = HostRead(A, nnz);
+   int new_nnz = 0;
+   for (int i = 0; i < height; i++)
+   {
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         if (Jp[j] >= i) { new_nnz++; }
+      }
+   }
+
+   Memory<int> new_I(height+1), new_J(new_nnz);
+   Memory<double> new_A(new_nnz);
+   new_I[0] = 0;
+   for (int i = 0, k = 0; i < height; i++)
+   {
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         if (Jp[j] >= i)
+         {
+            new_J[k] = Jp[j];
+            new_A[k] = Ap[j];
+            k++;
+         }
+      }
+      new_I[i+1] = k;
+   }
+   I.Delete();
+   J.Delete();
+   A.Delete();
+   I = new_I;
+   J = new_J;
+   A = new_A;
+}
+
 void SparseMatrix::GetBlocks(Array2D<SparseMatrix *> &blocks) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    int br = blocks.NumRows(), bc = blocks.NumCols();
    int nr = (height + br - 1)/br, nc = (width + bc - 1)/bc;
 
@@ -1097,6 +1284,7 @@ void SparseMatrix::GetBlocks(Array2D<SparseMatrix *> &blocks) const
 
 double SparseMatrix::IsSymmetric() const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    if (height != width)
    {
       return infinity();
@@ -1139,6 +1327,7 @@ double SparseMatrix::IsSymmetric() const
 
 void SparseMatrix::Symmetrize()
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
    int i, j;
@@ -1262,6 +1451,7 @@ MatrixInverse *SparseMatrix::Inverse() const
 
 void SparseMatrix::EliminateRow(int row, const double sol, Vector &rhs)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    RowNode *aux;
 
    MFEM_ASSERT(row < height && row >= 0,
@@ -1278,6 +1468,7 @@ void SparseMatrix::EliminateRow(int row, const double sol, Vector &rhs)
 
 void SparseMatrix::EliminateRow(int row, DiagonalPolicy dpolicy)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    RowNode *aux;
 
    MFEM_ASSERT(row < height && row >= 0,
@@ -1310,6 +1501,7 @@ void SparseMatrix::EliminateRow(int row, DiagonalPolicy dpolicy)
 
 void SparseMatrix::EliminateCol(int col, DiagonalPolicy dpolicy)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_ASSERT(col < width && col >= 0,
                "Col " << col << " not in matrix of width " << width);
    MFEM_ASSERT(dpolicy != DIAG_KEEP, "Diagonal policy must not be DIAG_KEEP");
@@ -1351,6 +1543,8 @@ void SparseMatrix::EliminateCol(int col, DiagonalPolicy dpolicy)
 void SparseMatrix::EliminateCols(const Array<int> &cols, const Vector *x,
                                  Vector *b)
 {
+   MFEM_VERIFY(!symStorage, "eliminating only columns breaks the symmetry, "
+               "see EliminateRowCol()");
    if (Rows == NULL)
    {
       for (int i = 0; i < height; i++)
@@ -1387,12 +1581,68 @@ void SparseMatrix::EliminateCols(const Array<int> &cols, const Vector *x,
    }
 }
 
+template <typename F>
+void SparseMatrix::SymRowColEntries(int rc, F f)
+{
+   if (Rows)
+   {
+      for (int i = 0; i < rc; i++)
+      {
+         for (RowNode *nd = Rows[i]; nd != NULL; nd = nd->Prev)
+         {
+            if (nd->Column == rc) { f(i, rc, nd->Value); break; }
+         }
+      }
+      for (RowNode *nd = Rows[rc]; nd != NULL; nd = nd->Prev)
+      {
+         f(rc, nd->Column, nd->Value);
+      }
+   }
+   else
+   {
+      for (int i = 0; i < rc; i++)
+      {
+         for (int j = I[i]; j < I[i+1]; j++)
+         {
+            if (J[j] == rc) { f(i, rc, A[j]); break; }
+         }
+      }
+      for (int j = I[rc]; j < I[rc+1]; j++)
+      {
+         f(rc, J[j], A[j]);
+      }
+   }
+}
+
 void SparseMatrix::EliminateRowCol(int rc, const double sol, Vector &rhs,
                                    DiagonalPolicy dpolicy)
 {
    MFEM_ASSERT(rc < height && rc >= 0,
                "Row " << rc << " not in matrix of height " << height);
 
+   if (symStorage)
+   {
+      SymRowColEntries(rc, [&](int i, int j, double &a)
+      {
+         if (i == j)
+         {
+            switch (dpolicy)
+            {
+               case DIAG_KEEP: rhs(rc) = a * sol; break;
+               case DIAG_ONE: a = 1.0; rhs(rc) = sol; break;
+               case DIAG_ZERO: a = 0.; rhs(rc) = 0.; break;
+               default: mfem_error("SparseMatrix::EliminateRowCol () #1");
+            }
+         }
+         else
+         {
+            rhs(i == rc ? j : i) -= sol * a;
+            a = 0.0;
+         }
+      });
+      return;
+   }
+
    if (Rows == NULL)
    {
       for (int j = I[rc]; j < I[rc+1]; j++)
@@ -1489,6 +1739,23 @@ void SparseMatrix::EliminateRowColMultipleRHS(int rc, const Vector &sol,
 {
    MFEM_ASSERT(rc < height && rc >= 0,
                "Row " << rc << " not in matrix of height " << height);
+
+   if (symStorage)
+   {
+      SymRowColEntries(rc, [&](int i, int j, double &a)
+      {
+         for (int r = 0; r < rhs.Width(); r++)
+         {
+            if (i != j) { rhs(i == rc ? j : i, r) -= sol(r) * a; }
+            else if (dpolicy == DIAG_KEEP) { rhs(rc, r) = a * sol(r); }
+            else if (dpolicy == DIAG_ONE) { rhs(rc, r) = sol(r); }
+            else { rhs(rc, r) = 0.0; }
+         }
+         if (i != j || dpolicy == DIAG_ZERO) { a = 0.0; }
+         else if (dpolicy == DIAG_ONE) { a = 1.0; }
+      });
+      return;
+   }
    MFEM_ASSERT(sol.Size() == rhs.Width(), "solution size (" << sol.Size()
                << ") must match rhs width (" << rhs.Width() << ")");
 
@@ -1612,6 +1879,16 @@ void SparseMatrix::EliminateRowCol(int rc, DiagonalPolicy dpolicy)
    MFEM_ASSERT(rc < height && rc >= 0,
                "Row " << rc << " not in matrix of height " << height);
 
+   if (symStorage)
+   {
+      SymRowColEntries(rc, [&](int i, int j, double &a)
+      {
+         if (i != j || dpolicy == DIAG_ZERO) { a = 0.0; }
+         else if (dpolicy == DIAG_ONE) { a = 1.0; }
+      });
+      return;
+   }
+
    if (Rows == NULL)
    {
       for (int j = I[rc]; j < I[rc+1]; j++)
@@ -1691,6 +1968,15 @@ void SparseMatrix::EliminateRowColDiag(int rc, double value)
    MFEM_ASSERT(rc < height && rc >= 0,
                "Row " << rc << " not in matrix of height " << height);
 
+   if (symStorage)
+   {
+      SymRowColEntries(rc, [&](int i, int j, double &a)
+      {
+         a = (i == j) ? value : 0.0;
+      });
+      return;
+   }
+
    if (Rows == NULL)
    {
       for (int j = I[rc]; j < I[rc+1]; j++)
@@ -1752,6 +2038,13 @@ void SparseMatrix::EliminateRowColDiag(int rc, double value)
 void SparseMatrix::EliminateRowCol(int rc, SparseMatrix &Ae,
                                    DiagonalPolicy dpolicy)
 {
+   if (symStorage)
+   {
+      Array<int> rows(1);
+      rows[0] = rc;
+      EliminateRowCols(rows, Ae, dpolicy);
+      return;
+   }
    if (Rows)
    {
       RowNode *nd, *nd2;
@@ -1843,6 +2136,56 @@ void SparseMatrix::EliminateRowCol(int rc, SparseMatrix &Ae,
    }
 }
 
+void SparseMatrix::EliminateRowCols(const Array<int> &rc, SparseMatrix &Ae,
+                                    DiagonalPolicy dpolicy)
+{
+   if (!symStorage)
+   {
+      for (int k = 0; k < rc.Size(); k++)
+      {
+         EliminateRowCol(rc[k], Ae, dpolicy);
+      }
+      return;
+   }
+
+   Array<int> marked(height);
+   marked = 0;
+   for (int k = 0; k < rc.Size(); k++) { marked[rc[k]] = 1; }
+   // the entry a = A(i,j), j >= i, also stands for A(j,i)
+   auto eliminate = [&](int i, int j, double &a)
+   {
+      if (!marked[i] && !marked[j]) { return; }
+      if (i != j)
+      {
+         Ae.Add(i, j, a);
+         Ae.Add(j, i, a);
+         a = 0.0;
+         return;
+      }
+      switch (dpolicy)
+      {
+         case DIAG_ONE: Ae.Add(i, i, a - 1.0); a = 1.0; break;
+         case DIAG_ZERO: Ae.Add(i, i, a); a = 0.0; break;
+         case DIAG_KEEP: break;
+         default: mfem_error("SparseMatrix::EliminateRowCols");
+      }
+   };
+   for (int i = 0; i < height; i++)
+   {
+      if (Rows)
+      {
+         for (RowNode *nd = Rows[i]; nd != NULL; nd = nd->Prev)
+         {
+            eliminate(i, nd->Column, nd->Value);
+         }
+      }
+      else
+      {
+         for (int j = I[i]; j < I[i+1]; j++) { eliminate(i, J[j], A[j]); }
+      }
+   }
+}
+
 void SparseMatrix::SetDiagIdentity()
 {
    for (int i = 0; i < height; i++)
@@ -1856,6 +2199,7 @@ void SparseMatrix::SetDiagIdentity()
 
 void SparseMatrix::EliminateZeroRows(const double threshold)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    for (int i = 0; i < height; i++)
    {
       double zero = 0.0;
@@ -1913,6 +2257,59 @@ void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
          }
       }
    }
+   else if (symStorage)
+   {
+      const int s = height;
+      const int nnz = J.Capacity();
+      const int *Ip = HostRead(I, s+1);
+      const int *Jp = HostRead(J, nnz);
+      const double *Ap = HostRead(A, nnz);
+      double *yp = y.HostReadWrite();
+      const double *xp = x.HostRead();
+
+      // The entries left of the diagonal in row i are stored in the rows above
+      // it: their products with the new values are accumulated in 'lsum'.
+      Vector lsum(s);
+      double *lp = lsum.HostWrite();
+      for (int i = 0; i < s; i++) { lp[i] = 0.0; }
+
+      for (int i = 0; i < s; i++)
+      {
+         const int beg = Ip[i], end = Ip[i+1];
+         double sum = lp[i];
+         int d = -1;
+         for (int j = beg; j < end; j++)
+         {
+            const int c = Jp[j];
+            if (c == i)
+            {
+               d = j;
+            }
+            else
+            {
+               sum += Ap[j] * yp[c];
+            }
+         }
+
+         if (d >= 0 && Ap[d] != 0.0)
+         {
+            yp[i] = (xp[i] - sum) / Ap[d];
+         }
+         else if (xp[i] == sum)
+         {
+            yp[i] = sum;
+         }
+         else
+         {
+            mfem_error("SparseMatrix::Gauss_Seidel_forw(...) #3");
+         }
+
+         for (int j = beg; j < end; j++)
+         {
+            if (Jp[j] != i) { lp[Jp[j]] += Ap[j] * yp[i]; }
+         }
+      }
+   }
    else
    {
       const int s = height;
@@ -1996,6 +2393,60 @@ void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
          }
       }
    }
+   else if (symStorage)
+   {
+      const int s = height;
+      const int nnz = J.Capacity();
+      const int *Ip = HostRead(I, s+1);
+      const int *Jp = HostRead(J, nnz);
+      const double *Ap = HostRead(A, nnz);
+      double *yp = y.HostReadWrite();
+      const double *xp = x.HostRead();
+
+      // The entries left of the diagonal multiply values that are not updated
+      // before row i, so their products are computed upfront, in 'lsum'.
+      Vector lsum(s);
+      double *lp = lsum.HostWrite();
+      for (int i = 0; i < s; i++) { lp[i] = 0.0; }
+      for (int i = 0; i < s; i++)
+      {
+         for (int j = Ip[i]; j < Ip[i+1]; j++)
+         {
+            if (Jp[j] != i) { lp[Jp[j]] += Ap[j] * yp[i]; }
+         }
+      }
+
+      for (int i = s-1; i >= 0; i--)
+      {
+         double sum = lp[i];
+         int d = -1;
+         for (int j = Ip[i], end = Ip[i+1]; j < end; j++)
+         {
+            const int c = Jp[j];
+            if (c == i)
+            {
+               d = j;
+            }
+            else
+            {
+               sum += Ap[j] * yp[c];
+            }
+         }
+
+         if (d >= 0 && Ap[d] != 0.0)
+         {
+            yp[i] = (xp[i] - sum) / Ap[d];
+         }
+         else if (xp[i] == sum)
+         {
+            yp[i] = sum;
+         }
+         else
+         {
+            mfem_error("SparseMatrix::Gauss_Seidel_back(...) #3");
+         }
+      }
+   }
    else
    {
       const int s = height;
@@ -2042,6 +2493,7 @@ void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
 
 double SparseMatrix::GetJacobiScaling() const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
    double sc = 1.0;
@@ -2078,6 +2530,20 @@ void SparseMatrix::Jacobi(const Vector &b, const Vector &x0, Vector &x1,
 {
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
+   if (symStorage)
+   {
+      // x1 = x0 + sc D^{-1} (b - A x0)
+      Vector r(b), d;
+      AddMult(x0, r, -1.0);
+      GetDiag(d);
+      for (int i = 0; i < height; i++)
+      {
+         MFEM_VERIFY(d(i) != 0.0, "SparseMatrix::Jacobi(...) #3");
+         x1(i) = x0(i) + sc * r(i) / d(i);
+      }
+      return;
+   }
+
    for (int i = 0; i < height; i++)
    {
       int d = -1;
@@ -2139,6 +2605,7 @@ void SparseMatrix::DiagScale(const Vector &b, Vector &x, double sc) const
 void SparseMatrix::Jacobi2(const Vector &b, const Vector &x0, Vector &x1,
                            double sc) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
    for (int i = 0; i < height; i++)
@@ -2163,6 +2630,7 @@ void SparseMatrix::Jacobi2(const Vector &b, const Vector &x0, Vector &x1,
 void SparseMatrix::Jacobi3(const Vector &b, const Vector &x0, Vector &x1,
                            double sc) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
 
    for (int i = 0; i < height; i++)
@@ -2205,6 +2673,7 @@ void SparseMatrix::AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
          MFEM_ASSERT(gj < width,
                      "Trying to insert a column " << gj << " outside the matrix width "
                      << width);
+         if (symStorage && gj < gi) { continue; }
          a = subm(i, j);
          if (skip_zeros && a == 0.0)
          {
@@ -2237,6 +2706,7 @@ void SparseMatrix::Set(const int i, const int j, const double A)
    MFEM_ASSERT(gj < width,
                "Trying to set a column " << gj << " outside the matrix width "
                << width);
+   if (symStorage && gj < gi) { return; }
    if (t < 0) { a = -a; }
    _Set_(gi, gj, a);
 }
@@ -2256,6 +2726,7 @@ void SparseMatrix::Add(const int i, const int j, const double A)
    MFEM_ASSERT(gj < width,
                "Trying to insert a column " << gj << " outside the matrix width "
                << width);
+   if (symStorage && gj < gi) { return; }
    if (t < 0) { a = -a; }
    _Add_(gi, gj, a);
 }
@@ -2286,6 +2757,7 @@ void SparseMatrix::SetSubMatrix(const Array<int> &rows, const Array<int> &cols,
          MFEM_ASSERT(gj < width,
                      "Trying to set a column " << gj << " outside the matrix width "
                      << width);
+         if (symStorage && gj < gi) { continue; }
          if (t < 0) { a = -a; }
          _Set_(gj, a);
       }
@@ -2321,6 +2793,7 @@ void SparseMatrix::SetSubMatrixTranspose(const Array<int> &rows,
          MFEM_ASSERT(gj < width,
                      "Trying to set a column " << gj << " outside the matrix width "
                      << width);
+         if (symStorage && gj < gi) { continue; }
          if (t < 0) { a = -a; }
          _Set_(gj, a);
       }
@@ -2331,6 +2804,7 @@ void SparseMatrix::SetSubMatrixTranspose(const Array<int> &rows,
 void SparseMatrix::GetSubMatrix(const Array<int> &rows, const Array<int> &cols,
                                 DenseMatrix &subm) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    int i, j, gi, gj, s, t;
    double a;
 
@@ -2379,6 +2853,7 @@ bool SparseMatrix::RowIsEmpty(const int row) const
 
 int SparseMatrix::GetRow(const int row, Array<int> &cols, Vector &srow) const
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    RowNode *n;
    int j, gi;
 
@@ -2420,6 +2895,7 @@ int SparseMatrix::GetRow(const int row, Array<int> &cols, Vector &srow) const
 void SparseMatrix::SetRow(const int row, const Array<int> &cols,
                           const Vector &srow)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    int gi, gj, s, t;
    double a;
 
@@ -2467,6 +2943,7 @@ void SparseMatrix::SetRow(const int row, const Array<int> &cols,
 void SparseMatrix::AddRow(const int row, const Array<int> &cols,
                           const Vector &srow)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    int j, gi, gj, s, t;
    double a;
 
@@ -2498,6 +2975,7 @@ void SparseMatrix::AddRow(const int row, const Array<int> &cols,
 
 void SparseMatrix::ScaleRow(const int row, const double scale)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    int i;
 
    if ((i=row) < 0)
@@ -2526,6 +3004,7 @@ void SparseMatrix::ScaleRow(const int row, const double scale)
 
 void SparseMatrix::ScaleRows(const Vector & sl)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    double scale;
    if (Rows != NULL)
    {
@@ -2557,6 +3036,7 @@ void SparseMatrix::ScaleRows(const Vector & sl)
 
 void SparseMatrix::ScaleColumns(const Vector & sr)
 {
+   MFEM_VERIFY(!symStorage, "not supported with symmetric storage");
    if (Rows != NULL)
    {
       RowNode *aux;
@@ -2585,6 +3065,7 @@ void SparseMatrix::ScaleColumns(const Vector & sr)
 
 SparseMatrix &SparseMatrix::operator+=(const SparseMatrix &B)
 {
+   MFEM_VERIFY(symStorage == B.symStorage, "not supported with symmetric storage");
    MFEM_ASSERT(height == B.height && width == B.width,
                "Mismatch of this matrix size and rhs.  This height = "
                << height << ", width = " << width << ", B.height = "
@@ -2615,6 +3096,7 @@ SparseMatrix &SparseMatrix::operator+=(const SparseMatrix &B)
 
 void SparseMatrix::Add(const double a, const SparseMatrix &B)
 {
+   MFEM_VERIFY(symStorage == B.symStorage, "not supported with symmetric storage");
    for (int i = 0; i < height; i++)
    {
       B.SetColPtr(i);
@@ -2940,58 +3422,209 @@ void SparseMatrixFunction (SparseMatrix & S, double (*f)(double))
    }
 }
 
+// Number of threads of the sparse matrix products: the OpenMP threads when an
+// OpenMP backend is enabled in the Device, otherwise one thread. At most one
+// thread per row is used.
+static int SparseProductThreads(int nrows)
+{
+#ifdef MFEM_USE_OPENMP
+   if (Device::Allows(Backend::OMP_MASK))
+   {
+      return std::max(1, std::min(omp_get_max_threads(), nrows));
+   }
+#endif
+   return 1;
+}
+
+// First row of thread t when nrows rows are split into nthreads contiguous
+// ranges. With the row offsets I of a CSR matrix, the ranges have about the
+// same number of rows plus nonzeros, otherwise the same number of rows.
+static int RowRangeBegin(const int t, const int nthreads, const int nrows,
+                         const int *I)
+{
+   if (t >= nthreads) { return nrows; }
+   if (I == NULL) { return (int)(((long long)nrows * t) / nthreads); }
+   // Smallest row r with I[r] + r >= t*(I[nrows] + nrows)/nthreads
+   const long long target =
+      ((long long)(I[nrows] - I[0]) + nrows) * t / nthreads;
+   int lo = 0, hi = nrows;
+   while (lo < hi)
+   {
+      const int mid = lo + (hi - lo)/2;
+      if ((long long)(I[mid] - I[0]) + mid < target) { lo = mid + 1; }
+      else { hi = mid; }
+   }
+   return lo;
+}
+
+// Call body(t, begin, end) for the threads t = 0,...,nthreads-1, in parallel,
+// where [begin, end) is the contiguous range of the rows of thread t, see
+// RowRangeBegin().
+template <typename BODY>
+static void ForAllRowRanges(const int nthreads, const int nrows, const int *I,
+                            BODY &&body)
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+   if (nthreads > 1)
+#endif
+   for (int t = 0; t < nthreads; t++)
+   {
+      body(t, RowRangeBegin(t, nthreads, nrows, I),
+           RowRangeBegin(t+1, nthreads, nrows, I));
+   }
+}
+
+void SparseMatrix::SymAddMult(const Vector &x, Vector &y,
+                              const double a) const
+{
+   const int height = this->height;
+   const int nnz = J.Capacity();
+   const int *Ip = HostRead(I, height+1);
+   const int *Jp = HostRead(J, nnz);
+   const double *Ap = HostRead(A, nnz);
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+
+   // Row i contributes a_ij x_j to y_i and, for j > i, a_ij x_i to y_j. Every
+   // thread adds the contributions to its own rows directly to y, and those
+   // to the rows below its range to a separate buffer. The buffers are summed
+   // into y in a second pass. A buffer grows only up to the last row reached
+   // by the thread, i.e. its size is bounded by the bandwidth of the matrix.
+   const int nt = SparseProductThreads(height);
+   std::vector<std::vector<double>> buf(nt);
+
+   ForAllRowRanges(nt, height, Ip, [&](int t, int begin, int end)
+   {
+      std::vector<double> &bt = buf[t];
+      for (int i = begin; i < end; i++)
+      {
+         const double axi = a * xp[i];
+         double d = 0.0;
+         for (int j = Ip[i]; j < Ip[i+1]; j++)
+         {
+            const int c = Jp[j];
+            d += Ap[j] * xp[c];
+            if (c == i) { continue; }
+            if (c < end) { yp[c] += Ap[j] * axi; continue; }
+            const std::size_t k = c - end;
+            if (k >= bt.size())
+            {
+               bt.resize(std::min<std::size_t>(height - end,
+                                               std::max(k + 1, 2*bt.size())));
+            }
+            bt[k] += Ap[j] * axi;
+         }
+         yp[i] += a * d;
+      }
+   });
+
+   if (nt == 1) { return; }
+   ForAllRowRanges(nt, height, Ip, [&](int t, int begin, int end)
+   {
+      for (int s = 0; s < t; s++)
+      {
+         const int end_s = RowRangeBegin(s+1, nt, height, Ip);
+         const std::vector<double> &bs = buf[s];
+         const int last = std::min<long long>(end, end_s + (long long)bs.size());
+         for (int i = begin; i < last; i++) { yp[i] += bs[i-end_s]; }
+      }
+   });
+}
+
 SparseMatrix *Transpose (const SparseMatrix &A)
 {
+   MFEM_VERIFY(!A.HasSymmetricStorage(), "not supported with symmetric storage");
    MFEM_VERIFY(
       A.Finalized(),
       "Finalize must be called before Transpose. Use TransposeRowMatrix instead");
 
-   int i, j, end;
-   const int *A_i, *A_j;
-   int m, n, nnz, *At_i, *At_j;
-   const double *A_data;
-   double *At_data;
-
-   m      = A.Height(); // number of rows of A
-   n      = A.Width();  // number of columns of A
-   nnz    = A.NumNonZeroElems();
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
+   const int m = A.Height(); // number of rows of A
+   const int n = A.Width();  // number of columns of A
+   const int nnz = A.NumNonZeroElems();
+   const int *A_i = A.GetI();
+   const int *A_j = A.GetJ();
+   const double *A_data = A.GetData();
 
-   At_i = new int[n+1];
-   At_j = new int[nnz];
-   At_data = new double[nnz];
+   int *At_i = new int[n+1];
+   int *At_j = new int[nnz];
+   double *At_data = new double[nnz];
 
-   for (i = 0; i <= n; i++)
+   // Every thread counts the entries in the columns of its rows, and the
+   // entries of thread t in column j are placed after those of the threads
+   // before t, so the rows of At are sorted as in the serial algorithm. The
+   // counters of a thread cover only the range of columns of its rows, which
+   // is narrow for banded or local matrices, e.g. prolongations. If the ranges
+   // add up to more than twice the number of columns, one thread is used.
+   int nt = SparseProductThreads(m);
+   Array<int> col_lo(nt), col_hi(nt);
+   ForAllRowRanges(nt, m, A_i, [&](int t, int begin, int end)
    {
-      At_i[i] = 0;
-   }
-   for (i = 0; i < nnz; i++)
+      int lo = n, hi = -1;
+      for (int j = A_i[begin]; j < A_i[end]; j++)
+      {
+         lo = std::min(lo, A_j[j]);
+         hi = std::max(hi, A_j[j]);
+      }
+      col_lo[t] = lo;
+      col_hi[t] = std::max(lo, hi + 1);
+   });
+   long long span = 0;
+   for (int t = 0; t < nt; t++) { span += col_hi[t] - col_lo[t]; }
+   if (nt > 1 && span > 2*(long long)n)
    {
-      At_i[A_j[i]+1]++;
+      nt = 1;
+      col_lo.SetSize(1);
+      col_hi.SetSize(1);
    }
-   for (i = 1; i < n; i++)
+   if (nt == 1) { col_lo[0] = 0; col_hi[0] = n; }
+
+   // The counters of thread t, for the columns col_lo[t] <= j < col_hi[t],
+   // are offsets[col_start[t] + j - col_lo[t]].
+   Array<int> col_start(nt+1);
+   col_start[0] = 0;
+   for (int t = 0; t < nt; t++)
    {
-      At_i[i+1] += At_i[i];
+      col_start[t+1] = col_start[t] + col_hi[t] - col_lo[t];
    }
+   Array<int> offsets(col_start[nt]);
+   offsets = 0;
+   ForAllRowRanges(nt, m, A_i, [&](int t, int begin, int end)
+   {
+      int *count = offsets.GetData() + col_start[t] - col_lo[t];
+      for (int j = A_i[begin]; j < A_i[end]; j++)
+      {
+         count[A_j[j]]++;
+      }
+   });
 
-   for (i = j = 0; i < m; i++)
+   At_i[0] = 0;
+   for (int j = 0, sum = 0; j < n; j++)
    {
-      end = A_i[i+1];
-      for ( ; j < end; j++)
+      for (int t = 0; t < nt; t++)
       {
-         At_j[At_i[A_j[j]]] = i;
-         At_data[At_i[A_j[j]]] = A_data[j];
-         At_i[A_j[j]]++;
+         if (j < col_lo[t] || j >= col_hi[t]) { continue; }
+         int &offset = offsets[col_start[t] + j - col_lo[t]];
+         const int count = offset;
+         offset = sum;
+         sum += count;
       }
+      At_i[j+1] = sum;
    }
 
-   for (i = n; i > 0; i--)
+   ForAllRowRanges(nt, m, A_i, [&](int t, int begin, int end)
    {
-      At_i[i] = At_i[i-1];
-   }
-   At_i[0] = 0;
+      int *pos = offsets.GetData() + col_start[t] - col_lo[t];
+      for (int i = begin; i < end; i++)
+      {
+         for (int j = A_i[i]; j < A_i[i+1]; j++)
+         {
+            const int k = pos[A_j[j]]++;
+            At_j[k] = i;
+            At_data[k] = A_data[j];
+         }
+      }
+   });
 
    return  new SparseMatrix(At_i, At_j, At_data, n, m);
 }
@@ -3076,71 +3709,67 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                     SparseMatrix *OAB)
 {
-   int nrowsA, ncolsA, nrowsB, ncolsB;
-   const int *A_i, *A_j, *B_i, *B_j;
-   int *C_i, *C_j, *B_marker;
-   const double *A_data, *B_data;
-   double *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   double a_entry, b_entry;
-   SparseMatrix *C;
-
-   nrowsA = A.Height();
-   ncolsA = A.Width();
-   nrowsB = B.Height();
-   ncolsB = B.Width();
+   MFEM_VERIFY(!A.HasSymmetricStorage() && !B.HasSymmetricStorage(), "not supported with symmetric storage");
+   const int nrowsA = A.Height();
+   const int ncolsA = A.Width();
+   const int nrowsB = B.Height();
+   const int ncolsB = B.Width();
 
    MFEM_VERIFY(ncolsA == nrowsB,
                "number of columns of A (" << ncolsA
                << ") must equal number of rows of B (" << nrowsB << ")");
 
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
-   B_i    = B.GetI();
-   B_j    = B.GetJ();
-   B_data = B.GetData();
-
-   B_marker = new int[ncolsB];
+   const int *A_i = A.GetI();
+   const int *A_j = A.GetJ();
+   const double *A_data = A.GetData();
+   const int *B_i = B.GetI();
+   const int *B_j = B.GetJ();
+   const double *B_data = B.GetData();
 
-   for (ib = 0; ib < ncolsB; ib++)
-   {
-      B_marker[ib] = -1;
-   }
+   // The rows of C are computed by the threads in contiguous ranges, every
+   // thread using its own dense marker array B_marker.
+   const int nt = SparseProductThreads(nrowsA);
+   int *C_i, *C_j;
+   double *C_data;
+   SparseMatrix *C;
 
    if (OAB == NULL)
    {
+      // Symbolic phase: count the entries of the rows of C
       C_i = new int[nrowsA+1];
-
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
+      ForAllRowRanges(nt, nrowsA, A_i, [&](int, int begin, int end)
       {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         Array<int> B_marker(ncolsB);
+         B_marker = -1;
+         for (int ic = begin; ic < end; ic++)
          {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            int num_nonzeros = 0;
+            for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
             {
-               jb = B_j[ib];
-               if (B_marker[jb] != ic)
+               const int ja = A_j[ia];
+               for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
                {
-                  B_marker[jb] = ic;
-                  num_nonzeros++;
+                  const int jb = B_j[ib];
+                  if (B_marker[jb] != ic)
+                  {
+                     B_marker[jb] = ic;
+                     num_nonzeros++;
+                  }
                }
             }
+            C_i[ic+1] = num_nonzeros;
          }
-         C_i[ic+1] = num_nonzeros;
+      });
+      C_i[0] = 0;
+      for (int ic = 0; ic < nrowsA; ic++)
+      {
+         C_i[ic+1] += C_i[ic];
       }
 
-      C_j    = new int[num_nonzeros];
-      C_data = new double[num_nonzeros];
+      C_j    = new int[C_i[nrowsA]];
+      C_data = new double[C_i[nrowsA]];
 
       C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
-
-      for (ib = 0; ib < ncolsB; ib++)
-      {
-         B_marker[ib] = -1;
-      }
    }
    else
    {
@@ -3153,50 +3782,56 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                   << " ncolsB = " << ncolsB
                   << ", C->Width() = " << C->Width());
 
-      // C_i    = C -> GetI(); // not used
+      C_i    = C -> GetI();
       C_j    = C -> GetJ();
       C_data = C -> GetData();
    }
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
+   // Numeric phase; B_marker[jb] is the position of column jb in C_j, so the
+   // entries before row_start belong to previous rows.
+   Array<int> mismatch(nt);
+   mismatch = 0;
+   ForAllRowRanges(nt, nrowsA, A_i, [&](int t, int begin, int end)
    {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+      Array<int> B_marker(ncolsB);
+      B_marker = -1;
+      for (int ic = begin; ic < end; ic++)
       {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+         const int row_start = C_i[ic];
+         int counter = row_start;
+         for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
          {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
+            const int ja = A_j[ia];
+            const double a_entry = A_data[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
             {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
+               const int jb = B_j[ib];
+               const double b_entry = B_data[ib];
+               if (B_marker[jb] < row_start)
                {
-                  C_j[counter] = jb;
+                  B_marker[jb] = counter;
+                  if (OAB == NULL)
+                  {
+                     C_j[counter] = jb;
+                  }
+                  C_data[counter] = a_entry*b_entry;
+                  counter++;
+               }
+               else
+               {
+                  C_data[B_marker[jb]] += a_entry*b_entry;
                }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
-            }
-            else
-            {
-               C_data[B_marker[jb]] += a_entry*b_entry;
             }
          }
+         if (counter != C_i[ic+1]) { mismatch[t] = 1; }
       }
-   }
+   });
 
    MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
-
-   delete [] B_marker;
+      mismatch.Max() == 0,
+      "With pre-allocated output matrix, the number of non-zeros in some rows"
+      " did not match the number of entries changed from matrix-matrix"
+      " multiply");
 
    return C;
 }
@@ -3342,14 +3977,181 @@ DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P)
    return _RAP;
 }
 
+// Fused product R A P: every row of R A is computed in a dense accumulator of
+// its thread and multiplied with P right away, so R A is never stored. The
+// entries of the rows of the result are in the same order as those of
+// Mult(*Mult(R, A), P). If ORAP is not NULL, it must have the structure of the
+// result, as computed by this function.
+static SparseMatrix *FusedRAP(const SparseMatrix &R, const SparseMatrix &A,
+                              const SparseMatrix &P, SparseMatrix *ORAP)
+{
+   MFEM_VERIFY(!R.HasSymmetricStorage() && !A.HasSymmetricStorage() &&
+               !P.HasSymmetricStorage(), "not supported with symmetric storage");
+   const int nrows = R.Height();
+   const int ncolsA = A.Width();
+   const int ncols = P.Width();
+
+   MFEM_VERIFY(R.Width() == A.Height() && ncolsA == P.Height(),
+               "incompatible matrix sizes in RAP: R is " << nrows << " x "
+               << R.Width() << ", A is " << A.Height() << " x " << ncolsA
+               << " and P is " << P.Height() << " x " << ncols);
+
+   const int *R_i = R.GetI(), *R_j = R.GetJ();
+   const int *A_i = A.GetI(), *A_j = A.GetJ();
+   const int *P_i = P.GetI(), *P_j = P.GetJ();
+   const double *R_data = R.GetData();
+   const double *A_data = A.GetData();
+   const double *P_data = P.GetData();
+
+   const int nt = SparseProductThreads(nrows);
+   int *C_i, *C_j;
+   double *C_data;
+   SparseMatrix *C;
+
+   if (ORAP == NULL)
+   {
+      // Symbolic phase: RA_cols are the columns of the current row of R A
+      C_i = new int[nrows+1];
+      ForAllRowRanges(nt, nrows, R_i, [&](int, int begin, int end)
+      {
+         Array<int> RA_marker(ncolsA), C_marker(ncols), RA_cols;
+         RA_marker = -1;
+         C_marker = -1;
+         for (int ic = begin; ic < end; ic++)
+         {
+            RA_cols.SetSize(0);
+            for (int ir = R_i[ic]; ir < R_i[ic+1]; ir++)
+            {
+               const int jr = R_j[ir];
+               for (int ia = A_i[jr]; ia < A_i[jr+1]; ia++)
+               {
+                  const int ja = A_j[ia];
+                  if (RA_marker[ja] != ic)
+                  {
+                     RA_marker[ja] = ic;
+                     RA_cols.Append(ja);
+                  }
+               }
+            }
+            int num_nonzeros = 0;
+            for (int k = 0; k < RA_cols.Size(); k++)
+            {
+               const int ja = RA_cols[k];
+               for (int ip = P_i[ja]; ip < P_i[ja+1]; ip++)
+               {
+                  const int jp = P_j[ip];
+                  if (C_marker[jp] != ic)
+                  {
+                     C_marker[jp] = ic;
+                     num_nonzeros++;
+                  }
+               }
+            }
+            C_i[ic+1] = num_nonzeros;
+         }
+      });
+      C_i[0] = 0;
+      for (int ic = 0; ic < nrows; ic++)
+      {
+         C_i[ic+1] += C_i[ic];
+      }
+
+      C_j    = new int[C_i[nrows]];
+      C_data = new double[C_i[nrows]];
+
+      C = new SparseMatrix(C_i, C_j, C_data, nrows, ncols);
+   }
+   else
+   {
+      C = ORAP;
+
+      MFEM_VERIFY(nrows == C->Height() && ncols == C->Width(),
+                  "Input matrix sizes do not match output sizes"
+                  << " nrows = " << nrows
+                  << ", C->Height() = " << C->Height()
+                  << " ncols = " << ncols
+                  << ", C->Width() = " << C->Width());
+
+      C_i    = C->GetI();
+      C_j    = C->GetJ();
+      C_data = C->GetData();
+   }
+
+   // Numeric phase: C_marker[jp] is the position of column jp in C_j
+   Array<int> mismatch(nt);
+   mismatch = 0;
+   ForAllRowRanges(nt, nrows, R_i, [&](int t, int begin, int end)
+   {
+      Array<int> RA_marker(ncolsA), C_marker(ncols), RA_cols;
+      Vector RA_data(ncolsA);
+      RA_marker = -1;
+      C_marker = -1;
+      for (int ic = begin; ic < end; ic++)
+      {
+         RA_cols.SetSize(0);
+         for (int ir = R_i[ic]; ir < R_i[ic+1]; ir++)
+         {
+            const int jr = R_j[ir];
+            const double r_entry = R_data[ir];
+            for (int ia = A_i[jr]; ia < A_i[jr+1]; ia++)
+            {
+               const int ja = A_j[ia];
+               if (RA_marker[ja] != ic)
+               {
+                  RA_marker[ja] = ic;
+                  RA_cols.Append(ja);
+                  RA_data(ja) = r_entry*A_data[ia];
+               }
+               else
+               {
+                  RA_data(ja) += r_entry*A_data[ia];
+               }
+            }
+         }
+
+         const int row_start = C_i[ic];
+         int counter = row_start;
+         for (int k = 0; k < RA_cols.Size(); k++)
+         {
+            const int ja = RA_cols[k];
+            const double ra_entry = RA_data(ja);
+            for (int ip = P_i[ja]; ip < P_i[ja+1]; ip++)
+            {
+               const int jp = P_j[ip];
+               if (C_marker[jp] < row_start)
+               {
+                  C_marker[jp] = counter;
+                  if (ORAP == NULL)
+                  {
+                     C_j[counter] = jp;
+                  }
+                  C_data[counter] = ra_entry*P_data[ip];
+                  counter++;
+               }
+               else
+               {
+                  C_data[C_marker[jp]] += ra_entry*P_data[ip];
+               }
+            }
+         }
+         if (counter != C_i[ic+1]) { mismatch[t] = 1; }
+      }
+   });
+
+   MFEM_VERIFY(
+      mismatch.Max() == 0,
+      "With pre-allocated output matrix, the number of non-zeros in some rows"
+      " did not match the number of entries changed from RAP");
+
+   return C;
+}
+
 SparseMatrix *RAP (const SparseMatrix &A, const SparseMatrix &R,
                    SparseMatrix *ORAP)
 {
-   SparseMatrix *P  = Transpose (R);
-   SparseMatrix *AP = Mult (A, *P);
+   SparseMatrix *P = Transpose (R);
+   SparseMatrix *_RAP = FusedRAP (R, A, *P, ORAP);
    delete P;
-   SparseMatrix *_RAP = Mult (R, *AP, ORAP);
-   delete AP;
    return _RAP;
 }
 
@@ -3357,10 +4159,8 @@ SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
                   const SparseMatrix &P)
 {
    SparseMatrix * R = Transpose(Rt);
-   SparseMatrix * RA = Mult(*R,A);
+   SparseMatrix * out = FusedRAP(*R, A, P, NULL);
    delete R;
-   SparseMatrix * out = Mult(*RA, P);
-   delete RA;
    return out;
 }
 
@@ -3386,6 +4186,7 @@ SparseMatrix *Mult_AtDA (const SparseMatrix &A, const Vector &D,
 SparseMatrix * Add(double a, const SparseMatrix & A, double b,
                    const SparseMatrix & B)
 {
+   MFEM_VERIFY(!A.HasSymmetricStorage() && !B.HasSymmetricStorage(), "not supported with symmetric storage");
    int nrows = A.Height();
    int ncols = A.Width();
 
@@ -3496,6 +4297,7 @@ SparseMatrix * Add(Array<SparseMatrix *> & Ai)
 void Add(const SparseMatrix &A,
          double alpha, DenseMatrix &B)
 {
+   MFEM_VERIFY(!A.HasSymmetricStorage(), "not supported with symmetric storage");
    for (int r = 0; r < B.Height(); r++)
    {
       const int    * colA = A.GetRowColumns(r);
@@ -3528,6 +4330,7 @@ DenseMatrix *OuterProduct(const DenseMatrix &A, const DenseMatrix &B)
 /// Produces a block matrix with blocks A_{ij}*B
 SparseMatrix *OuterProduct(const DenseMatrix &A, const SparseMatrix &B)
 {
+   MFEM_VERIFY(!B.HasSymmetricStorage(), "not supported with symmetric storage");
    int mA = A.Height(), nA = A.Width();
    int mB = B.Height(), nB = B.Width();
 
@@ -3557,6 +4360,7 @@ SparseMatrix *OuterProduct(const DenseMatrix &A, const SparseMatrix &B)
 /// Produces a block matrix with blocks A_{ij}*B
 SparseMatrix *OuterProduct(const SparseMatrix &A, const DenseMatrix &B)
 {
+   MFEM_VERIFY(!A.HasSymmetricStorage(), "not supported with symmetric storage");
    int mA = A.Height(), nA = A.Width();
    int mB = B.Height(), nB = B.Width();
 
@@ -3586,6 +4390,7 @@ SparseMatrix *OuterProduct(const SparseMatrix &A, const DenseMatrix &B)
 /// Produces a block matrix with blocks A_{ij}*B
 SparseMatrix *OuterProduct(const SparseMatrix &A, const SparseMatrix &B)
 {
+   MFEM_VERIFY(!A.HasSymmetricStorage() && !B.HasSymmetricStorage(), "not supported with symmetric storage");
    int mA = A.Height(), nA = A.Width();
    int mB = B.Height(), nB = B.Width();
 
@@ -3634,6 +4439,7 @@ void SparseMatrix::Swap(SparseMatrix &other)
 #endif
 
    mfem::Swap(isSorted, other.isSorted);
+   mfem::Swap(symStorage, other.symStorage);
 }
 
 }
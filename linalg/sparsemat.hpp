@@ -77,9 +77,21 @@ protected:
    /// Are the columns sorted already.
    bool isSorted;
 
+   /** @brief Is only the upper triangle, j >= i, of a symmetric matrix stored.
+       See SetSymmetricStorage(). */
+   bool symStorage;
+
    void Destroy();   // Delete all owned data
    void SetEmpty();  // Init all entries with empty values
 
+   /// y += a * A * x with symmetric storage, on the host.
+   void SymAddMult(const Vector &x, Vector &y, const double a) const;
+
+   /** @brief With symmetric storage, call f(i, j, a) for the entries a =
+       A(i,j) stored in row @a rc and for the entries of column @a rc stored in
+       the rows i < rc. */
+   template <typename F> void SymRowColEntries(int rc, F f);
+
 public:
    /// Create an empty SparseMatrix.
    SparseMatrix() { SetEmpty(); }
@@ -267,6 +279,10 @@ public:
    /// y += A * x (default)  or  y += a * A * x
    void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
 
+   /** @brief Matrix multiplication with all vectors of @a X: Y_j = A X_j. The
+       matrix entries are read once for all the vectors. */
+   virtual void MultMulti(const MultiVector &X, MultiVector &Y) const;
+
    /// Multiply a vector with the transposed matrix. y = At * x
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -382,6 +398,14 @@ public:
    void EliminateRowCol(int rc, SparseMatrix &Ae,
                         DiagonalPolicy dpolicy = DIAG_ONE);
 
+   /** @brief Eliminate the rows and columns listed in @a rc, as
+       EliminateRowCol(int, SparseMatrix &, DiagonalPolicy) does for each of
+       them. */
+   /** With symmetric storage, the column entries of the rows are found in one
+       pass over the matrix, instead of one pass per row. */
+   void EliminateRowCols(const Array<int> &rc, SparseMatrix &Ae,
+                         DiagonalPolicy dpolicy = DIAG_ONE);
+
    /// If a row contains only one diag entry of zero, set it to 1.
    void SetDiagIdentity();
    /// If a row contains only zeros, set its diagonal to 1.
@@ -420,6 +444,31 @@ public:
    bool Finalized() const { return !A.Empty(); }
    bool areColumnsSorted() const { return isSorted; }
 
+   /** @brief Switch to the symmetric storage mode, where only the upper
+       triangle, j >= i, of a symmetric matrix is stored. */
+   /** The matrix must be square. Its strictly lower triangle is removed, i.e.
+       the matrix is assumed to be symmetric. If the matrix is not finalized,
+       the entries with j < i are skipped by the assembly methods, e.g.
+       AddSubMatrix(), from now on.
+
+       In this mode, Mult(), AddMult(), MultTranspose(), AddMultTranspose(),
+       InnerProduct(), GetRowSums(), ToDenseMatrix(), GetDiag(),
+       Gauss_Seidel_forw(), Gauss_Seidel_back(), Jacobi(), DiagScale() and the
+       element access operators act on the full symmetric matrix. The products
+       are computed on the host, in parallel when an OpenMP backend is enabled
+       in the Device. The symmetric elimination of rows and columns, i.e.
+       EliminateRowCol(), EliminateRowCols(), EliminateRowColMultipleRHS() and
+       EliminateRowColDiag(), and PartMult() and PartAddMult() are supported,
+       so essential boundary conditions can be eliminated with
+       BilinearForm::FormLinearSystem(). Methods that need the rows of the full
+       matrix or break the symmetry, e.g. GetRow(), EliminateRow(),
+       EliminateCols(), Transpose(), Mult() and RAP() of two matrices, and the
+       conversions to BSRMatrix and SELLMatrix, are not supported. */
+   void SetSymmetricStorage();
+
+   /// Is only the upper triangle stored? See SetSymmetricStorage().
+   bool HasSymmetricStorage() const { return symStorage; }
+
    /** @brief Remove entries smaller in absolute value than a given tolerance
        @a tol. If @a fix_empty_rows is true, a zero value is inserted in the
        diagonal entry (for square matrices only) */
@@ -574,6 +623,7 @@ void SparseMatrixFunction(SparseMatrix &S, double (*f)(double));
 
 
 /// Transpose of a sparse matrix. A must be finalized.
+/** Computed in parallel when an OpenMP backend is enabled in the Device. */
 SparseMatrix *Transpose(const SparseMatrix &A);
 /// Transpose of a sparse matrix. A does not need to be a CSR matrix.
 SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
@@ -584,7 +634,8 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
     result in @a OAB. If @a OAB is NULL, we create a new SparseMatrix to store
     the result and return a pointer to it.
 
-    All matrices must be finalized. */
+    All matrices must be finalized. The rows of the product are computed in
+    parallel when an OpenMP backend is enabled in the Device. */
 SparseMatrix *Mult(const SparseMatrix &A, const SparseMatrix &B,
                    SparseMatrix *OAB = NULL);
 
@@ -605,11 +656,13 @@ DenseMatrix *RAP(const SparseMatrix &A, DenseMatrix &P);
 DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P);
 
 /** RAP matrix product (with P=R^T). ORAP is like OAB above.
-    All matrices must be finalized. */
+    All matrices must be finalized. The product is fused: the rows of R A are
+    multiplied with P as soon as they are computed, without forming R A, in
+    parallel as in Mult(). */
 SparseMatrix *RAP(const SparseMatrix &A, const SparseMatrix &R,
                   SparseMatrix *ORAP = NULL);
 
-/// General RAP with given R^T, A and P
+/// General RAP with given R^T, A and P, fused as the RAP above.
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
                   const SparseMatrix &P);
 
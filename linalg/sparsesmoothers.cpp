@@ -15,7 +15,9 @@
 #include "matrix.hpp"
 #include "sparsemat.hpp"
 #include "sparsesmoothers.hpp"
+#include "../general/forall.hpp"
 #include <iostream>
+#include <algorithm>
 
 namespace mfem
 {
@@ -108,4 +110,270 @@ void DSmoother::Mult(const Vector &x, Vector &y) const
    }
 }
 
+
+/// Create the ILU(k) smoother and factorize the matrix.
+ILUSmoother::ILUSmoother(const SparseMatrix &a, int k)
+   : fill_level(k)
+{
+   SetOperator(a);
+}
+
+void ILUSmoother::SetOperator(const Operator &a)
+{
+   SparseSmoother::SetOperator(a);
+   MFEM_VERIFY(oper->Finalized(), "the SparseMatrix must be finalized");
+   MFEM_VERIFY(!oper->HasSymmetricStorage(),
+               "SparseMatrix with symmetric storage is not supported");
+   MFEM_VERIFY(height == width, "the SparseMatrix must be square");
+   MFEM_VERIFY(fill_level >= 0, "invalid level of fill: " << fill_level);
+
+   // Reuse the symbolic factorization if the pattern has not changed
+   const int n = height;
+   const int nnz = oper->NumNonZeroElems();
+   const int *Ai = oper->GetI(), *Aj = oper->GetJ();
+   bool same_pattern = (A_I.Size() == n+1 && A_J.Size() == nnz);
+   for (int i = 0; same_pattern && i <= n; i++)
+   {
+      same_pattern = (A_I[i] == Ai[i]);
+   }
+   for (int p = 0; same_pattern && p < nnz; p++)
+   {
+      same_pattern = (A_J[p] == Aj[p]);
+   }
+   if (!same_pattern)
+   {
+      A_I.SetSize(n+1);
+      A_J.SetSize(nnz);
+      for (int i = 0; i <= n; i++) { A_I[i] = Ai[i]; }
+      for (int p = 0; p < nnz; p++) { A_J[p] = Aj[p]; }
+      SymbolicFactorization();
+   }
+   NumericFactorization();
+}
+
+// Group the rows in wavefronts for the triangular solve with the entries at
+// positions [begin[i], end[i]) of the rows i, which must be processed in the
+// given order of the rows.
+static void LevelSchedule(const Array<int> &order, const int *begin,
+                          const int *end, const Array<int> &J,
+                          Array<int> &offsets, Array<int> &rows)
+{
+   const int n = order.Size();
+   Array<int> level(n);
+   int num_levels = 0;
+   for (int k = 0; k < n; k++)
+   {
+      const int i = order[k];
+      int l = 0;
+      for (int p = begin[i]; p < end[i]; p++)
+      {
+         l = std::max(l, level[J[p]] + 1);
+      }
+      level[i] = l;
+      num_levels = std::max(num_levels, l + 1);
+   }
+
+   offsets.SetSize(num_levels + 1);
+   offsets = 0;
+   for (int i = 0; i < n; i++) { offsets[level[i]+1]++; }
+   offsets.PartialSum();
+   rows.SetSize(n);
+   for (int k = 0; k < n; k++)
+   {
+      const int i = order[k];
+      rows[offsets[level[i]]++] = i;
+   }
+   for (int l = num_levels; l > 0; l--) { offsets[l] = offsets[l-1]; }
+   offsets[0] = 0;
+}
+
+void ILUSmoother::SymbolicFactorization()
+{
+   const int n = height;
+
+   // The columns of the current row are kept in a sorted linked list, with
+   // next[] the next column, n the end of the list and n+1 its head. The
+   // levels of the entries are in row_level[], -1 for columns not in the
+   // list, and in entry_level[] for the entries of the previous rows.
+   const int END = n, HEAD = n+1;
+   Array<int> next(n+2), row_level(n), entry_level, cols;
+   row_level = -1;
+   I.SetSize(n+1);
+   J.SetSize(0);
+   diag.SetSize(n);
+   I[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      // The entries of the matrix and the diagonal have level 0
+      cols.SetSize(0);
+      cols.Append(i);
+      for (int p = A_I[i]; p < A_I[i+1]; p++) { cols.Append(A_J[p]); }
+      cols.Sort();
+      cols.Unique();
+      int prev = HEAD;
+      for (int c = 0; c < cols.Size(); c++)
+      {
+         next[prev] = cols[c];
+         row_level[cols[c]] = 0;
+         prev = cols[c];
+      }
+      next[prev] = END;
+
+      // Add the fill-in of the elimination of the columns k < i
+      if (fill_level > 0)
+      {
+         for (int k = next[HEAD]; k < i; k = next[k])
+         {
+            const int lev_ik = row_level[k];
+            for (int q = diag[k]+1; q < I[k+1]; q++)
+            {
+               const int j = J[q];
+               const int lev = lev_ik + entry_level[q] + 1;
+               if (lev > fill_level) { continue; }
+               if (row_level[j] < 0)
+               {
+                  int pos = k;
+                  while (next[pos] < j) { pos = next[pos]; }
+                  next[j] = next[pos];
+                  next[pos] = j;
+                  row_level[j] = lev;
+               }
+               else
+               {
+                  row_level[j] = std::min(row_level[j], lev);
+               }
+            }
+         }
+      }
+
+      for (int j = next[HEAD]; j != END; j = next[j])
+      {
+         if (j == i) { diag[i] = J.Size(); }
+         J.Append(j);
+         entry_level.Append(row_level[j]);
+         row_level[j] = -1;
+      }
+      I[i+1] = J.Size();
+   }
+   LU.SetSize(J.Size());
+
+   // Map the entries of the matrix to the pattern of the factors
+   Array<int> pos(n);
+   A_to_LU.SetSize(A_J.Size());
+   for (int i = 0; i < n; i++)
+   {
+      for (int p = I[i]; p < I[i+1]; p++) { pos[J[p]] = p; }
+      for (int p = A_I[i]; p < A_I[i+1]; p++) { A_to_LU[p] = pos[A_J[p]]; }
+   }
+
+   // Wavefronts of the forward solve with the strictly lower part, in
+   // increasing row order, and of the backward solve with the strictly upper
+   // part, in decreasing row order
+   Array<int> order(n), upper_begin(n);
+   for (int i = 0; i < n; i++) { order[i] = i; }
+   for (int i = 0; i < n; i++) { upper_begin[i] = diag[i] + 1; }
+   LevelSchedule(order, I.GetData(), diag.GetData(), J,
+                 lower_offsets, lower_rows);
+   for (int i = 0; i < n; i++) { order[i] = n-1-i; }
+   LevelSchedule(order, upper_begin.GetData(), I.GetData() + 1, J,
+                 upper_offsets, upper_rows);
+}
+
+void ILUSmoother::NumericFactorization()
+{
+   const int n = height;
+   const double *Ad = oper->GetData();
+   const int *hI = I.HostRead();
+   const int *hJ = J.HostRead();
+   const int *hdiag = diag.HostRead();
+   double *hLU = LU.HostWrite();
+   for (int p = 0; p < LU.Size(); p++) { hLU[p] = 0.0; }
+   for (int p = 0; p < A_to_LU.Size(); p++) { hLU[A_to_LU[p]] += Ad[p]; }
+
+   // IKJ variant of the Gaussian elimination restricted to the pattern, see
+   // Y. Saad, "Iterative Methods for Sparse Linear Systems", Algorithm 10.4.
+   Array<int> pos(n);
+   pos = -1;
+   for (int i = 0; i < n; i++)
+   {
+      for (int p = hI[i]; p < hI[i+1]; p++) { pos[hJ[p]] = p; }
+      for (int p = hI[i]; p < hdiag[i]; p++)
+      {
+         const int k = hJ[p];
+         const double l_ik = (hLU[p] /= hLU[hdiag[k]]);
+         for (int q = hdiag[k]+1; q < hI[k+1]; q++)
+         {
+            const int j = pos[hJ[q]];
+            if (j >= 0) { hLU[j] -= l_ik * hLU[q]; }
+         }
+      }
+      MFEM_VERIFY(hLU[hdiag[i]] != 0.0, "zero pivot in row " << i);
+      for (int p = hI[i]; p < hI[i+1]; p++) { pos[hJ[p]] = -1; }
+   }
+}
+
+void ILUSmoother::Mult(const Vector &x, Vector &y) const
+{
+   const int n = height;
+   z.SetSize(n);
+   z.UseDevice(true);
+   const Vector *b = &x;
+   if (iterative_mode)
+   {
+      r.SetSize(n);
+      r.UseDevice(true);
+      oper->Mult(y, r);
+      subtract(x, r, r);
+      b = &r;
+   }
+
+   auto d_I = I.Read();
+   auto d_J = J.Read();
+   auto d_LU = LU.Read();
+   auto d_diag = diag.Read();
+   auto d_b = b->Read();
+
+   // Forward solve with the unit lower triangular factor: z = L^{-1} b
+   auto d_z = z.Write();
+   const int *loffsets = lower_offsets.HostRead();
+   auto d_lrows = lower_rows.Read();
+   for (int l = 0; l < NumLowerLevels(); l++)
+   {
+      const int *rows = d_lrows + loffsets[l];
+      MFEM_FORALL(k, loffsets[l+1] - loffsets[l],
+      {
+         const int i = rows[k];
+         double s = d_b[i];
+         for (int p = d_I[i]; p < d_diag[i]; p++)
+         {
+            s -= d_LU[p] * d_z[d_J[p]];
+         }
+         d_z[i] = s;
+      });
+   }
+
+   // Backward solve with the upper triangular factor: z = U^{-1} z. Every row
+   // only reads entries of z of the rows of previous wavefronts, so the solve
+   // is done in place.
+   const int *uoffsets = upper_offsets.HostRead();
+   auto d_urows = upper_rows.Read();
+   for (int l = 0; l < NumUpperLevels(); l++)
+   {
+      const int *rows = d_urows + uoffsets[l];
+      MFEM_FORALL(k, uoffsets[l+1] - uoffsets[l],
+      {
+         const int i = rows[k];
+         double s = d_z[i];
+         for (int p = d_diag[i]+1; p < d_I[i+1]; p++)
+         {
+            s -= d_LU[p] * d_z[d_J[p]];
+         }
+         d_z[i] = s / d_LU[d_diag[i]];
+      });
+   }
+
+   if (iterative_mode) { y += z; }
+   else { y = z; }
+}
+
 }
@@ -73,6 +73,79 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 };
 
+/// Incomplete LU factorization ILU(k) of a sparse matrix
+/** The sparsity pattern of the factors is the pattern of the matrix plus the
+    fill-in entries of level at most k, see Y. Saad, "Iterative Methods for
+    Sparse Linear Systems", Section 10.3.3. ILU(0) keeps the pattern of the
+    matrix. The unit lower and the upper triangular factors are stored in a
+    single CSR matrix with sorted rows.
+
+    The triangular solves are level-scheduled: the rows are grouped in
+    wavefronts which only depend on the rows of the previous wavefronts, and
+    the rows of a wavefront are processed in parallel with the active device
+    backend, e.g. OpenMP.
+
+    The symbolic factorization (the sparsity pattern of the factors and the
+    wavefronts) is reused by SetOperator() when the sparsity pattern of the
+    new matrix is the same, e.g. after changing the values of the matrix in
+    place, so only the numeric factorization is repeated. */
+class ILUSmoother : public SparseSmoother
+{
+protected:
+   int fill_level; ///< The level of fill k of ILU(k)
+
+   /// @name The L and U factors in CSR format.
+   ///@{
+   Array<int> I, J;
+   Vector LU;
+   Array<int> diag; ///< Positions of the diagonal entries in #J
+   ///@}
+
+   /// Positions of the entries of the matrix in the pattern of the factors
+   Array<int> A_to_LU;
+
+   /// The sparsity pattern of the matrix of the symbolic factorization
+   Array<int> A_I, A_J;
+
+   /// @name Rows of the wavefronts of the forward and backward solves.
+   ///@{
+   Array<int> lower_offsets, lower_rows;
+   Array<int> upper_offsets, upper_rows;
+   ///@}
+
+   mutable Vector z, r;
+
+   /// Compute the pattern of the factors and the wavefronts.
+   void SymbolicFactorization();
+
+   /// Compute the values of the factors.
+   void NumericFactorization();
+
+public:
+   /// Create an ILU(k) smoother with level of fill @a k.
+   ILUSmoother(int k = 0) : fill_level(k) { }
+
+   /// Create the ILU(k) factorization of @a a with level of fill @a k.
+   ILUSmoother(const SparseMatrix &a, int k = 0);
+
+   /// Set the (finalized, square) SparseMatrix and factorize it.
+   /** The symbolic factorization is reused if the matrix has the same
+       sparsity pattern as the previous one. */
+   virtual void SetOperator(const Operator &a);
+
+   /// Return the number of entries of the factors.
+   int NumNonZeroElems() const { return J.Size(); }
+
+   /// Return the number of wavefronts of the forward and backward solves.
+   int NumLowerLevels() const { return lower_offsets.Size() - 1; }
+   int NumUpperLevels() const { return upper_offsets.Size() - 1; }
+
+   /// Apply the inverse of the incomplete factorization: y = (LU)^{-1} x.
+   /** If #iterative_mode is true, y is updated with the correction of the
+       residual x - A y instead. */
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
 }
 
 #endif
@@ -930,6 +930,50 @@ static double cuVectorDot(const int N, const double *X, const double *Y)
    for (int i = 0; i < dot_sz; i++) { dot += h_dot[i]; }
    return dot;
 }
+
+// z = x + a*y, v += b*u (if v is not NULL) and the block sums of z*w
+static __global__ void cuKernelAddDot(const int N, double *gdsr,
+                                      const double *x, const double a,
+                                      const double *y, double *z,
+                                      const double b, const double *u,
+                                      double *v, const double *w)
+{
+   __shared__ double s_dot[MFEM_CUDA_BLOCKS];
+   const int n = blockDim.x*blockIdx.x + threadIdx.x;
+   const int tid = threadIdx.x;
+   double dot = 0.0;
+   if (n < N)
+   {
+      const double zn = x[n] + a*y[n];
+      z[n] = zn;
+      if (v) { v[n] += b*u[n]; }
+      dot = zn*w[n];
+   }
+   s_dot[tid] = dot;
+   for (int workers=blockDim.x>>1; workers>0; workers>>=1)
+   {
+      __syncthreads();
+      if (tid < workers) { s_dot[tid] += s_dot[tid+workers]; }
+   }
+   if (tid==0) { gdsr[blockIdx.x] = s_dot[0]; }
+}
+
+static double cuVectorAddDot(const int N, const double *X, const double a,
+                             const double *Y, double *Z, const double b,
+                             const double *U, double *V, const double *W)
+{
+   const int blockSize = MFEM_CUDA_BLOCKS;
+   const int gridSize = (N+blockSize-1)/blockSize;
+   cuda_reduce_buf.SetSize(gridSize);
+   Memory<double> &buf = cuda_reduce_buf.GetMemory();
+   double *d_dot = buf.Write(MemoryClass::CUDA, gridSize);
+   cuKernelAddDot<<<gridSize,blockSize>>>(N, d_dot, X, a, Y, Z, b, U, V, W);
+   MFEM_GPU_CHECK(cudaGetLastError());
+   const double *h_dot = buf.Read(MemoryClass::HOST, gridSize);
+   double dot = 0.0;
+   for (int i = 0; i < gridSize; i++) { dot += h_dot[i]; }
+   return dot;
+}
 #endif // MFEM_USE_CUDA
 
 #ifdef MFEM_USE_HIP
@@ -1019,6 +1063,51 @@ static double hipVectorDot(const int N, const double *X, const double *Y)
    for (int i = 0; i < dot_sz; i++) { dot += h_dot[i]; }
    return dot;
 }
+
+// z = x + a*y, v += b*u (if v is not NULL) and the block sums of z*w
+static __global__ void hipKernelAddDot(const int N, double *gdsr,
+                                       const double *x, const double a,
+                                       const double *y, double *z,
+                                       const double b, const double *u,
+                                       double *v, const double *w)
+{
+   __shared__ double s_dot[MFEM_CUDA_BLOCKS];
+   const int n = hipBlockDim_x*hipBlockIdx_x + hipThreadIdx_x;
+   const int tid = hipThreadIdx_x;
+   double dot = 0.0;
+   if (n < N)
+   {
+      const double zn = x[n] + a*y[n];
+      z[n] = zn;
+      if (v) { v[n] += b*u[n]; }
+      dot = zn*w[n];
+   }
+   s_dot[tid] = dot;
+   for (int workers=hipBlockDim_x>>1; workers>0; workers>>=1)
+   {
+      __syncthreads();
+      if (tid < workers) { s_dot[tid] += s_dot[tid+workers]; }
+   }
+   if (tid==0) { gdsr[hipBlockIdx_x] = s_dot[0]; }
+}
+
+static double hipVectorAddDot(const int N, const double *X, const double a,
+                              const double *Y, double *Z, const double b,
+                              const double *U, double *V, const double *W)
+{
+   const int blockSize = MFEM_CUDA_BLOCKS;
+   const int gridSize = (N+blockSize-1)/blockSize;
+   cuda_reduce_buf.SetSize(gridSize);
+   Memory<double> &buf = cuda_reduce_buf.GetMemory();
+   double *d_dot = buf.Write(MemoryClass::CUDA, gridSize);
+   hipLaunchKernelGGL(hipKernelAddDot,gridSize,blockSize,0,0,
+                      N,d_dot,X,a,Y,Z,b,U,V,W);
+   MFEM_GPU_CHECK(hipGetLastError());
+   const double *h_dot = buf.Read(MemoryClass::HOST, gridSize);
+   double dot = 0.0;
+   for (int i = 0; i < gridSize; i++) { dot += h_dot[i]; }
+   return dot;
+}
 #endif // MFEM_USE_HIP
 
 double Vector::operator*(const Vector &v) const
@@ -1074,6 +1163,92 @@ vector_dot_cpu:
    return operator*(v_data);
 }
 
+// z = x + a*y, v += b*u (if v is not NULL) and return (z, w), in one pass
+static double VectorAddDot(const Vector &x, const double a, const Vector &y,
+                           Vector &z, const double b, const Vector *u,
+                           Vector *v, const Vector &w)
+{
+   const int N = z.Size();
+   const bool use_dev = x.UseDevice() || y.UseDevice() || z.UseDevice() ||
+                        w.UseDevice() || (v && v->UseDevice());
+   // Note: get read access first, in case z is the same as x, y or w.
+   auto d_x = x.Read(use_dev);
+   auto d_y = y.Read(use_dev);
+   auto d_w = w.Read(use_dev);
+   const double *d_u = u ? u->Read(use_dev) : NULL;
+   double *d_v = v ? v->ReadWrite(use_dev) : NULL;
+   auto d_z = z.Write(use_dev);
+
+   if (!use_dev) { goto vector_add_dot_cpu; }
+
+#ifdef MFEM_USE_CUDA
+   if (Device::Allows(Backend::CUDA_MASK))
+   {
+      return cuVectorAddDot(N, d_x, a, d_y, d_z, b, d_u, d_v, d_w);
+   }
+#endif
+
+#ifdef MFEM_USE_HIP
+   if (Device::Allows(Backend::HIP_MASK))
+   {
+      return hipVectorAddDot(N, d_x, a, d_y, d_z, b, d_u, d_v, d_w);
+   }
+#endif
+
+#ifdef MFEM_USE_OPENMP
+   if (Device::Allows(Backend::OMP_MASK))
+   {
+      double dot = 0.0;
+      #pragma omp parallel for reduction(+:dot)
+      for (int i = 0; i < N; i++)
+      {
+         const double zi = d_x[i] + a*d_y[i];
+         d_z[i] = zi;
+         if (d_v) { d_v[i] += b*d_u[i]; }
+         dot += zi*d_w[i];
+      }
+      return dot;
+   }
+#endif
+
+   // Other device backends: update the vectors, then reduce separately
+   MFEM_FORALL(i, N,
+   {
+      d_z[i] = d_x[i] + a*d_y[i];
+      if (d_v) { d_v[i] += b*d_u[i]; }
+   });
+   return z * w;
+
+vector_add_dot_cpu:
+   double dot = 0.0;
+   for (int i = 0; i < N; i++)
+   {
+      const double zi = d_x[i] + a*d_y[i];
+      d_z[i] = zi;
+      if (d_v) { d_v[i] += b*d_u[i]; }
+      dot += zi*d_w[i];
+   }
+   return dot;
+}
+
+double AddAndDot(const Vector &x, const double a, const Vector &y, Vector &z,
+                 const Vector &w)
+{
+   MFEM_ASSERT(x.Size() == z.Size() && y.Size() == z.Size() &&
+               w.Size() == z.Size(), "incompatible Vectors!");
+   return VectorAddDot(x, a, y, z, 0.0, NULL, NULL, w);
+}
+
+double AddTwoAndDot(const double a, const Vector &p, Vector &x,
+                    const double b, const Vector &q, Vector &r,
+                    const Vector &w)
+{
+   MFEM_ASSERT(p.Size() == x.Size() && q.Size() == r.Size() &&
+               w.Size() == r.Size() && x.Size() == r.Size(),
+               "incompatible Vectors!");
+   return VectorAddDot(r, b, q, r, a, &p, &x, w);
+}
+
 double Vector::Min() const
 {
    if (size == 0) { return infinity(); }
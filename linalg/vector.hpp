@@ -567,6 +567,24 @@ inline double InnerProduct(MPI_Comm comm, const Vector &x, const Vector &y)
 }
 #endif
 
+/** @brief Fused update and inner product: set z = x + a * y and return the
+    inner product of the new z and w. */
+/** The vectors are read and written in a single pass. The vector @a z may be
+    the same as @a x or @a y, and @a w may be the same as @a z, e.g. to compute
+    the squared norm of the result. In parallel, the local inner product is
+    returned, as in InnerProduct(const Vector&, const Vector&). */
+double AddAndDot(const Vector &x, const double a, const Vector &y, Vector &z,
+                 const Vector &w);
+
+/** @brief Fused double update and inner product: set x += a * p, r += b * q
+    and return the inner product of the new r and w. */
+/** This is the solution and residual update of CG, where @a w is the same as
+    @a r. As in AddAndDot(), all vectors are accessed in a single pass and the
+    local inner product is returned. */
+double AddTwoAndDot(const double a, const Vector &p, Vector &x,
+                    const double b, const Vector &q, Vector &r,
+                    const Vector &w);
+
 } // namespace mfem
 
 #endif
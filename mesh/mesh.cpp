@@ -16,6 +16,7 @@
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
 #include "../general/device.hpp"
+#include "../general/binaryio.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -372,8 +373,9 @@ void Mesh::GetElementTransformation(int i, const Vector &nodes,
    if (Nodes == NULL)
    {
       MFEM_ASSERT(nodes.Size() == spaceDim*GetNV(), "");
-      int       nv = elements[i]->GetNVertices();
-      const int *v = elements[i]->GetVertices();
+      Geometry::Type geom;
+      const int *v = GetElementVerticesAndGeometry(i, geom);
+      const int nv = Geometry::NumVerts[geom];
       int n = vertices.Size();
       pm.SetSize(spaceDim, nv);
       for (int k = 0; k < spaceDim; k++)
@@ -978,6 +980,7 @@ void Mesh::Init()
    NURBSext = NULL;
    ncmesh = NULL;
    last_operation = Mesh::NONE;
+   compact_storage = false;
 }
 
 void Mesh::InitTables()
@@ -1016,7 +1019,9 @@ void Mesh::DestroyPointers()
 
    delete NURBSext;
 
-   for (int i = 0; i < NumOfElements; i++)
+   // with the compact storage, 'elements' holds the elements created on demand
+   const int num_elem = compact_storage ? elements.Size() : NumOfElements;
+   for (int i = 0; i < num_elem; i++)
    {
       FreeElement(elements[i]);
    }
@@ -1061,6 +1066,9 @@ void Mesh::Destroy()
 
    attributes.DeleteAll();
    bdr_attributes.DeleteAll();
+
+   ClearCompactElementStorage();
+   compact_storage = false;
 }
 
 void Mesh::DeleteLazyTables()
@@ -1102,6 +1110,114 @@ void Mesh::SetAttributes()
    }
 }
 
+void Mesh::UseCompactElementStorage(bool use)
+{
+   if (use == compact_storage) { return; }
+   if (use)
+   {
+      MFEM_VERIFY(!ncmesh && !NURBSext, "nonconforming and NURBS meshes do "
+                  "not support compact element storage");
+#ifdef MFEM_USE_MPI
+      MFEM_VERIFY(!dynamic_cast<ParMesh*>(this),
+                  "ParMesh does not support compact element storage");
+#endif
+      MFEM_VERIFY(elements.Size() == NumOfElements,
+                  "the mesh is not finalized");
+      if (last_operation == Mesh::REFINE && NumOfElements)
+      {
+         // cache the transformations, they are stored in the elements
+         GetRefinementTransforms();
+      }
+      BuildCompactElementStorage();
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         FreeElement(elements[i]);
+      }
+      elements.DeleteAll();
+      compact_storage = true;
+   }
+   else
+   {
+      elements.SetSize(NumOfElements, NULL);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         if (!elements[i]) { elements[i] = NewCompactElement(i); }
+      }
+      compact_storage = false;
+      ClearCompactElementStorage();
+   }
+}
+
+void Mesh::BuildCompactElementStorage()
+{
+   int count[Geometry::NumGeom];
+   for (int g = 0; g < Geometry::NumGeom; g++) { count[g] = 0; }
+
+   compact_geom.SetSize(NumOfElements);
+   compact_index.SetSize(NumOfElements);
+   compact_attributes.SetSize(NumOfElements);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int g = elements[i]->GetGeometryType();
+      compact_geom[i] = (char) g;
+      compact_index[i] = count[g]++;
+      compact_attributes[i] = elements[i]->GetAttribute();
+   }
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      compact_vertices[g].SetSize(Geometry::NumVerts[g]*count[g]);
+   }
+   compact_tet_flags.SetSize(count[Geometry::TETRAHEDRON]);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int g = compact_geom[i], nv = Geometry::NumVerts[g];
+      const int *v = elements[i]->GetVertices();
+      int *cv = compact_vertices[g].GetData() + nv*compact_index[i];
+      for (int j = 0; j < nv; j++) { cv[j] = v[j]; }
+      if (g == Geometry::TETRAHEDRON)
+      {
+         compact_tet_flags[compact_index[i]] =
+            static_cast<Tetrahedron*>(elements[i])->GetRefinementFlag();
+      }
+   }
+}
+
+void Mesh::ClearCompactElementStorage()
+{
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      compact_vertices[g].DeleteAll();
+   }
+   compact_geom.DeleteAll();
+   compact_index.DeleteAll();
+   compact_attributes.DeleteAll();
+   compact_tet_flags.DeleteAll();
+}
+
+Element *Mesh::NewCompactElement(int i) const
+{
+   Geometry::Type geom;
+   const int *v = GetElementVerticesAndGeometry(i, geom);
+   Element *el = const_cast<Mesh*>(this)->NewElement(geom);
+   el->SetVertices(v);
+   el->SetAttribute(compact_attributes[i]);
+   if (geom == Geometry::TETRAHEDRON)
+   {
+      static_cast<Tetrahedron*>(el)->SetRefinementFlag(
+         compact_tet_flags[compact_index[i]]);
+   }
+   return el;
+}
+
+const Element *Mesh::GetCompactElement(int i) const
+{
+   // the elements created on demand are kept in 'elements'
+   Array<Element*> &elems = const_cast<Array<Element*>&>(elements);
+   if (elems.Size() == 0) { elems.SetSize(NumOfElements, NULL); }
+   if (!elems[i]) { elems[i] = NewCompactElement(i); }
+   return elems[i];
+}
+
 void Mesh::InitMesh(int _Dim, int _spaceDim, int NVert, int NElem, int NBdrElem)
 {
    SetEmpty();
@@ -1565,6 +1681,8 @@ void Mesh::GetHilbertElementOrdering(Array<int> &ordering)
 
 void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 {
+   EnsureElementObjects();
+
    if (NURBSext)
    {
       MFEM_WARNING("element reordering of NURBS meshes is not supported.");
@@ -2212,6 +2330,7 @@ void Mesh::FinalizeTopology(bool generate_bdr)
    //   2) ncmesh may be defined
    //   3) el_to_edge may be allocated (it will be re-computed)
 
+   EnsureElementObjects();
    FinalizeCheck();
    bool generate_edges = true;
 
@@ -2277,6 +2396,8 @@ void Mesh::FinalizeTopology(bool generate_bdr)
 
 void Mesh::Finalize(bool refine, bool fix_orientation)
 {
+   EnsureElementObjects();
+
    if (NURBSext || ncmesh)
    {
       MFEM_ASSERT(CheckElementOrientation(false) == 0, "");
@@ -2324,7 +2445,10 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
       }
       else
       {
-         FinalizeTopology(); // Re-computes some data unnecessarily.
+         // Re-computes some data unnecessarily. Do not generate boundary
+         // elements: this was done, if requested, by the first call, and a
+         // ParMesh partition may have no boundary elements.
+         FinalizeTopology(false);
       }
 
       // TODO: maybe introduce Mesh::NODE_REORDER operation and FESpace::
@@ -2828,10 +2952,25 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    last_operation = Mesh::NONE;
 
    // Duplicate the elements
-   elements.SetSize(NumOfElements);
-   for (int i = 0; i < NumOfElements; i++)
+   compact_storage = mesh.compact_storage;
+   if (compact_storage)
    {
-      elements[i] = mesh.elements[i]->Duplicate(this);
+      for (int g = 0; g < Geometry::NumGeom; g++)
+      {
+         mesh.compact_vertices[g].Copy(compact_vertices[g]);
+      }
+      mesh.compact_geom.Copy(compact_geom);
+      mesh.compact_index.Copy(compact_index);
+      mesh.compact_attributes.Copy(compact_attributes);
+      mesh.compact_tet_flags.Copy(compact_tet_flags);
+   }
+   else
+   {
+      elements.SetSize(NumOfElements);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         elements[i] = mesh.elements[i]->Duplicate(this);
+      }
    }
 
    // Copy the vertices
@@ -3097,7 +3236,7 @@ void Mesh::SetMeshGen()
    meshgen = mesh_geoms = 0;
    for (int i = 0; i < NumOfElements; i++)
    {
-      const Element::Type type = GetElement(i)->GetType();
+      const Element::Type type = GetElementType(i);
       switch (type)
       {
          case Element::TETRAHEDRON:
@@ -3155,6 +3294,7 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    filter_dos(mesh_type);
 
    // MFEM's native mesh formats
+   bool mfem_bin = (mesh_type == "MFEM binary mesh v1.0");
    bool mfem_v10 = (mesh_type == "MFEM mesh v1.0");
    bool mfem_v11 = (mesh_type == "MFEM mesh v1.1");
    bool mfem_v12 = (mesh_type == "MFEM mesh v1.2");
@@ -3170,6 +3310,10 @@ void Mesh::Loader(std::istream &input, int generate_edges,
       }
       ReadMFEMMesh(input, mfem_v11, curved);
    }
+   else if (mfem_bin)
+   {
+      ReadBinaryMesh(input, mesh_type.size() + 1, curved);
+   }
    else if (mesh_type == "linemesh") // 1D mesh
    {
       ReadLineMesh(input);
@@ -3902,6 +4046,8 @@ int Mesh::CheckElementOrientation(bool fix_it)
    int i, j, k, wo = 0, fo = 0, *vi = 0;
    double *v[4];
 
+   EnsureElementObjects();
+
    if (Dim == 2 && spaceDim == 2)
    {
       DenseMatrix J(2, 2);
@@ -4263,6 +4409,34 @@ void Mesh::GetGeometries(int dim, Array<Geometry::Type> &el_geoms) const
    }
 }
 
+// The vertex pairs of the edges of the elements of the given geometry, as
+// returned by Element::GetEdgeVertices().
+typedef int EdgeVertices[2];
+static const EdgeVertices *GetGeometryEdges(Geometry::Type geom, int &ne)
+{
+   switch (geom)
+   {
+      case Geometry::TRIANGLE:
+         ne = Geometry::Constants<Geometry::TRIANGLE>::NumEdges;
+         return Geometry::Constants<Geometry::TRIANGLE>::Edges;
+      case Geometry::SQUARE:
+         ne = Geometry::Constants<Geometry::SQUARE>::NumEdges;
+         return Geometry::Constants<Geometry::SQUARE>::Edges;
+      case Geometry::TETRAHEDRON:
+         ne = Geometry::Constants<Geometry::TETRAHEDRON>::NumEdges;
+         return Geometry::Constants<Geometry::TETRAHEDRON>::Edges;
+      case Geometry::CUBE:
+         ne = Geometry::Constants<Geometry::CUBE>::NumEdges;
+         return Geometry::Constants<Geometry::CUBE>::Edges;
+      case Geometry::PRISM:
+         ne = Geometry::Constants<Geometry::PRISM>::NumEdges;
+         return Geometry::Constants<Geometry::PRISM>::Edges;
+      default: // points and segments have no edges
+         ne = 0;
+         return NULL;
+   }
+}
+
 void Mesh::GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const
 {
    if (el_to_edge)
@@ -4275,12 +4449,14 @@ void Mesh::GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const
                  "is not generated.");
    }
 
-   const int *v = elements[i]->GetVertices();
-   const int ne = elements[i]->GetNEdges();
+   Geometry::Type geom;
+   const int *v = GetElementVerticesAndGeometry(i, geom);
+   int ne;
+   const EdgeVertices *ev = GetGeometryEdges(geom, ne);
    cor.SetSize(ne);
    for (int j = 0; j < ne; j++)
    {
-      const int *e = elements[i]->GetEdgeVertices(j);
+      const int *e = ev[j];
       cor[j] = (v[e[0]] < v[e[1]]) ? (1) : (-1);
    }
 }
@@ -4412,7 +4588,9 @@ Table *Mesh::GetEdgeVertexTable() const
 
 Table *Mesh::GetVertexToElementTable()
 {
-   int i, j, nv, *v;
+   int i, j, nv;
+   const int *v;
+   Geometry::Type geom;
 
    Table *vert_elem = new Table;
 
@@ -4420,8 +4598,8 @@ Table *Mesh::GetVertexToElementTable()
 
    for (i = 0; i < NumOfElements; i++)
    {
-      nv = elements[i]->GetNVertices();
-      v  = elements[i]->GetVertices();
+      v  = GetElementVerticesAndGeometry(i, geom);
+      nv = Geometry::NumVerts[geom];
       for (j = 0; j < nv; j++)
       {
          vert_elem->AddAColumnInRow(v[j]);
@@ -4432,8 +4610,8 @@ Table *Mesh::GetVertexToElementTable()
 
    for (i = 0; i < NumOfElements; i++)
    {
-      nv = elements[i]->GetNVertices();
-      v  = elements[i]->GetVertices();
+      v  = GetElementVerticesAndGeometry(i, geom);
+      nv = Geometry::NumVerts[geom];
       for (j = 0; j < nv; j++)
       {
          vert_elem->AddConnection(v[j], i);
@@ -4552,6 +4730,27 @@ int Mesh::GetBdrElementEdgeIndex(int i) const
    return -1;
 }
 
+void Mesh::GetFacesByType(FaceType type, Array<int> &faces) const
+{
+   faces.SetSize(0);
+   if (type == FaceType::Interior)
+   {
+      for (int f = 0; f < GetNumFaces(); f++)
+      {
+         if (FaceIsInterior(f)) { faces.Append(f); }
+      }
+      return;
+   }
+   for (int i = 0; i < GetNBE(); i++)
+   {
+      const int f = GetBdrElementEdgeIndex(i);
+      // skip the interior, shared, and non-conforming faces, see
+      // GetBdrFaceTransformations()
+      if (FaceIsTrueInterior(f) || faces_info[f].NCFace >= 0) { continue; }
+      faces.Append(f);
+   }
+}
+
 void Mesh::GetBdrElementAdjacentElement(int bdr_el, int &el, int &info) const
 {
    int fid = GetBdrElementEdgeIndex(bdr_el);
@@ -4574,7 +4773,19 @@ void Mesh::GetBdrElementAdjacentElement(int bdr_el, int &el, int &info) const
 
 Element::Type Mesh::GetElementType(int i) const
 {
-   return elements[i]->GetType();
+   if (!compact_storage) { return elements[i]->GetType(); }
+   switch (GetElementBaseGeometry(i))
+   {
+      case Geometry::POINT:       return Element::POINT;
+      case Geometry::SEGMENT:     return Element::SEGMENT;
+      case Geometry::TRIANGLE:    return Element::TRIANGLE;
+      case Geometry::SQUARE:      return Element::QUADRILATERAL;
+      case Geometry::TETRAHEDRON: return Element::TETRAHEDRON;
+      case Geometry::CUBE:        return Element::HEXAHEDRON;
+      case Geometry::PRISM:       return Element::WEDGE;
+      default: MFEM_ABORT("invalid element geometry");
+   }
+   return Element::POINT;
 }
 
 Element::Type Mesh::GetBdrElementType(int i) const
@@ -4586,9 +4797,10 @@ void Mesh::GetPointMatrix(int i, DenseMatrix &pointmat) const
 {
    int k, j, nv;
    const int *v;
+   Geometry::Type geom;
 
-   v  = elements[i]->GetVertices();
-   nv = elements[i]->GetNVertices();
+   v  = GetElementVerticesAndGeometry(i, geom);
+   nv = Geometry::NumVerts[geom];
 
    pointmat.SetSize(spaceDim, nv);
    for (k = 0; k < spaceDim; k++)
@@ -4665,11 +4877,13 @@ void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
    {
       for (int i = 0; i < NumOfElements; i++)
       {
-         const int *v = elements[i]->GetVertices();
-         const int ne = elements[i]->GetNEdges();
+         Geometry::Type geom;
+         const int *v = GetElementVerticesAndGeometry(i, geom);
+         int ne;
+         const EdgeVertices *ev = GetGeometryEdges(geom, ne);
          for (int j = 0; j < ne; j++)
          {
-            const int *e = elements[i]->GetEdgeVertices(j);
+            const int *e = ev[j];
             v_to_v.Push(v[e[0]], v[e[1]]);
          }
       }
@@ -4686,7 +4900,33 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
    NumberOfEdges = v_to_v.NumberOfEntries();
 
    // Fill the element to edge table
-   GetElementArrayEdgeTable(elements, v_to_v, e_to_f);
+   if (!compact_storage)
+   {
+      GetElementArrayEdgeTable(elements, v_to_v, e_to_f);
+   }
+   else
+   {
+      e_to_f.MakeI(NumOfElements);
+      for (i = 0; i < NumOfElements; i++)
+      {
+         int ne;
+         GetGeometryEdges(GetElementBaseGeometry(i), ne);
+         e_to_f.AddColumnsInRow(i, ne);
+      }
+      e_to_f.MakeJ();
+      for (i = 0; i < NumOfElements; i++)
+      {
+         Geometry::Type geom;
+         const int *v = GetElementVerticesAndGeometry(i, geom);
+         int ne;
+         const EdgeVertices *ev = GetGeometryEdges(geom, ne);
+         for (int j = 0; j < ne; j++)
+         {
+            e_to_f.AddConnection(i, v_to_v(v[ev[j][0]], v[ev[j][1]]));
+         }
+      }
+      e_to_f.ShiftUpI();
+   }
 
    if (Dim == 2)
    {
@@ -4886,7 +5126,8 @@ void Mesh::GenerateFaces()
    }
    for (i = 0; i < NumOfElements; i++)
    {
-      const int *v = elements[i]->GetVertices();
+      Geometry::Type geom;
+      const int *v = GetElementVerticesAndGeometry(i, geom);
       const int *ef;
       if (Dim == 1)
       {
@@ -4896,19 +5137,20 @@ void Mesh::GenerateFaces()
       else if (Dim == 2)
       {
          ef = el_to_edge->GetRow(i);
-         const int ne = elements[i]->GetNEdges();
+         const int ne = Geometry::NumEdges[geom];
          for (int j = 0; j < ne; j++)
          {
-            const int *e = elements[i]->GetEdgeVertices(j);
+            const int *e = (geom == Geometry::TRIANGLE) ?
+                           tri_t::Edges[j] : quad_t::Edges[j];
             AddSegmentFaceElement(j, ef[j], i, v[e[0]], v[e[1]]);
          }
       }
       else
       {
          ef = el_to_face->GetRow(i);
-         switch (GetElementType(i))
+         switch (geom)
          {
-            case Element::TETRAHEDRON:
+            case Geometry::TETRAHEDRON:
             {
                for (int j = 0; j < 4; j++)
                {
@@ -4918,7 +5160,7 @@ void Mesh::GenerateFaces()
                }
                break;
             }
-            case Element::WEDGE:
+            case Geometry::PRISM:
             {
                for (int j = 0; j < 2; j++)
                {
@@ -4934,7 +5176,7 @@ void Mesh::GenerateFaces()
                }
                break;
             }
-            case Element::HEXAHEDRON:
+            case Geometry::CUBE:
             {
                for (int j = 0; j < 6; j++)
                {
@@ -5009,10 +5251,11 @@ STable3D *Mesh::GetFacesTable()
    STable3D *faces_tbl = new STable3D(NumOfVertices);
    for (int i = 0; i < NumOfElements; i++)
    {
-      const int *v = elements[i]->GetVertices();
-      switch (GetElementType(i))
+      Geometry::Type geom;
+      const int *v = GetElementVerticesAndGeometry(i, geom);
+      switch (geom)
       {
-         case Element::TETRAHEDRON:
+         case Geometry::TETRAHEDRON:
          {
             for (int j = 0; j < 4; j++)
             {
@@ -5021,7 +5264,7 @@ STable3D *Mesh::GetFacesTable()
             }
             break;
          }
-         case Element::WEDGE:
+         case Geometry::PRISM:
          {
             for (int j = 0; j < 2; j++)
             {
@@ -5035,7 +5278,7 @@ STable3D *Mesh::GetFacesTable()
             }
             break;
          }
-         case Element::HEXAHEDRON:
+         case Geometry::CUBE:
          {
             // find the face by the vertices with the smallest 3 numbers
             // z = 0, y = 0, x = 1, y = 1, x = 0, z = 1
@@ -5055,7 +5298,8 @@ STable3D *Mesh::GetFacesTable()
 
 STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
 {
-   int i, *v;
+   int i;
+   const int *v;
    STable3D *faces_tbl;
 
    if (el_to_face != NULL)
@@ -5066,10 +5310,11 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    faces_tbl = new STable3D(NumOfVertices);
    for (i = 0; i < NumOfElements; i++)
    {
-      v = elements[i]->GetVertices();
-      switch (GetElementType(i))
+      Geometry::Type geom;
+      v = GetElementVerticesAndGeometry(i, geom);
+      switch (geom)
       {
-         case Element::TETRAHEDRON:
+         case Geometry::TETRAHEDRON:
          {
             for (int j = 0; j < 4; j++)
             {
@@ -5079,7 +5324,7 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
             }
             break;
          }
-         case Element::WEDGE:
+         case Geometry::PRISM:
          {
             for (int j = 0; j < 2; j++)
             {
@@ -5095,7 +5340,7 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
             }
             break;
          }
-         case Element::HEXAHEDRON:
+         case Geometry::CUBE:
          {
             // find the face by the vertices with the smallest 3 numbers
             // z = 0, y = 0, x = 1, y = 1, x = 0, z = 1
@@ -5173,6 +5418,8 @@ void Mesh::ReorientTetMesh()
       return;
    }
 
+   EnsureElementObjects();
+
    DeleteLazyTables();
 
    DSTable *old_v_to_v = NULL;
@@ -5964,6 +6211,8 @@ void FindTMax(Vector &c, Vector &x, double &tmax,
 
 void Mesh::CheckDisplacements(const Vector &displacements, double &tmax)
 {
+   EnsureElementObjects();
+
    int nvs = vertices.Size();
    DenseMatrix P, V, DS, PDS(spaceDim), VDS(spaceDim);
    Vector c(spaceDim+1), x(spaceDim);
@@ -6953,6 +7202,8 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
    int i, j, ind, nedges;
    Array<int> v;
 
+   EnsureElementObjects();
+
    DeleteLazyTables();
 
    if (ncmesh)
@@ -7193,6 +7444,8 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
 void Mesh::NonconformingRefinement(const Array<Refinement> &refinements,
                                    int nc_limit)
 {
+   EnsureElementObjects();
+
    MFEM_VERIFY(!NURBSext, "Nonconforming refinement of NURBS meshes is "
                "not supported. Project the NURBS to Nodes first.");
 
@@ -7414,6 +7667,16 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
 
    mfem::Swap(geom_factors, other.geom_factors);
 
+   mfem::Swap(compact_storage, other.compact_storage);
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      mfem::Swap(compact_vertices[g], other.compact_vertices[g]);
+   }
+   mfem::Swap(compact_geom, other.compact_geom);
+   mfem::Swap(compact_index, other.compact_index);
+   mfem::Swap(compact_attributes, other.compact_attributes);
+   mfem::Swap(compact_tet_flags, other.compact_tet_flags);
+
    if (non_geometry)
    {
       mfem::Swap(NURBSext, other.NURBSext);
@@ -7452,8 +7715,27 @@ void Mesh::GetElementData(const Array<Element*> &elem_array, int geom,
    }
 }
 
+void Mesh::GetElementData(int geom, Array<int> &elem_vtx,
+                          Array<int> &attr) const
+{
+   if (!compact_storage)
+   {
+      GetElementData(elements, geom, elem_vtx, attr);
+      return;
+   }
+   compact_vertices[geom].Copy(elem_vtx);
+   attr.SetSize(0);
+   attr.Reserve(elem_vtx.Size()/Geometry::NumVerts[geom]);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      if (compact_geom[i] == geom) { attr.Append(compact_attributes[i]); }
+   }
+}
+
 void Mesh::UniformRefinement(int ref_algo)
 {
+   EnsureElementObjects();
+
    if (NURBSext)
    {
       NURBSUniformRefinement();
@@ -7562,6 +7844,8 @@ void Mesh::GeneralRefinement(const Array<int> &el_to_refine, int nonconforming,
 
 void Mesh::EnsureNCMesh(bool triangles_nonconforming)
 {
+   EnsureElementObjects();
+
    MFEM_VERIFY(!NURBSext, "Cannot convert a NURBS mesh to an NC mesh. "
                "Project the NURBS to Nodes first.");
 
@@ -8076,6 +8360,7 @@ const CoarseFineTransformations& Mesh::GetRefinementTransforms()
 
 void Mesh::PrintXG(std::ostream &out) const
 {
+   MFEM_VERIFY(!compact_storage, "the mesh uses compact element storage");
    MFEM_ASSERT(Dim==spaceDim, "2D Manifold meshes not supported");
    int i, j;
    Array<int> v;
@@ -8276,7 +8561,14 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
        << "\n\nelements\n" << NumOfElements << '\n';
    for (i = 0; i < NumOfElements; i++)
    {
-      PrintElement(elements[i], out);
+      if (!compact_storage)
+      {
+         PrintElement(elements[i], out);
+         continue;
+      }
+      Element *el = NewCompactElement(i);
+      PrintElement(el, out);
+      const_cast<Mesh*>(this)->FreeElement(el);
    }
 
    out << "\nboundary\n" << NumOfBdrElements << '\n';
@@ -8321,8 +8613,136 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
    }
 }
 
+static void GetElementArrays(const Array<Element*> &elems, Array<int> &attr,
+                             Array<char> &geom, Array<int> &vert)
+{
+   const int ne = elems.Size();
+   int nv = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      nv += elems[i]->GetNVertices();
+   }
+   attr.SetSize(ne);
+   geom.SetSize(ne);
+   vert.SetSize(nv);
+   nv = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      const Element *el = elems[i];
+      attr[i] = el->GetAttribute();
+      geom[i] = (char) el->GetGeometryType();
+      const int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         vert[nv++] = v[j];
+      }
+   }
+}
+
+void Mesh::PrintBinary(std::ostream &out) const
+{
+   MFEM_VERIFY(!NURBSext, "NURBS meshes are not supported in binary format");
+
+   Array<int> elem_attr, elem_vert, bdr_attr, bdr_vert;
+   Array<char> elem_geom, bdr_geom;
+   if (!compact_storage)
+   {
+      GetElementArrays(elements, elem_attr, elem_geom, elem_vert);
+   }
+   else
+   {
+      elem_attr = compact_attributes;
+      elem_geom = compact_geom;
+      int nv = 0;
+      for (int g = 0; g < Geometry::NumGeom; g++)
+      {
+         nv += compact_vertices[g].Size();
+      }
+      elem_vert.SetSize(nv);
+      nv = 0;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         Geometry::Type geom;
+         const int *v = GetElementVerticesAndGeometry(i, geom);
+         for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+         {
+            elem_vert[nv++] = v[j];
+         }
+      }
+   }
+   GetElementArrays(boundary, bdr_attr, bdr_geom, bdr_vert);
+
+   Array<int> vertex_parents, coarse_elements;
+   if (ncmesh)
+   {
+      ncmesh->GetVertexParents(vertex_parents);
+      ncmesh->GetCoarseElements(coarse_elements);
+   }
+
+   const int dims[5] = { Dim, spaceDim, NumOfVertices, NumOfElements,
+                         NumOfBdrElements
+                       };
+
+   bin_io::BinaryWriter writer(out, "MFEM binary mesh v1.0");
+   writer.AddSection("dimensions", sizeof(dims));
+   writer.AddSection("elem_attr", elem_attr.Size()*sizeof(int));
+   writer.AddSection("elem_geom", elem_geom.Size());
+   writer.AddSection("elem_vert", elem_vert.Size()*sizeof(int));
+   writer.AddSection("bdr_attr", bdr_attr.Size()*sizeof(int));
+   writer.AddSection("bdr_geom", bdr_geom.Size());
+   writer.AddSection("bdr_vert", bdr_vert.Size()*sizeof(int));
+   if (ncmesh)
+   {
+      writer.AddSection("vertex_parents", vertex_parents.Size()*sizeof(int));
+      writer.AddSection("coarse_elements", coarse_elements.Size()*sizeof(int));
+   }
+   if (!Nodes)
+   {
+      writer.AddSection("vertices",
+                        (size_t) NumOfVertices*spaceDim*sizeof(double));
+   }
+
+   writer.BeginSection("dimensions");
+   writer.Write(dims, 5);
+   writer.BeginSection("elem_attr");
+   writer.Write(elem_attr.GetData(), elem_attr.Size());
+   writer.BeginSection("elem_geom");
+   writer.Write(elem_geom.GetData(), elem_geom.Size());
+   writer.BeginSection("elem_vert");
+   writer.Write(elem_vert.GetData(), elem_vert.Size());
+   writer.BeginSection("bdr_attr");
+   writer.Write(bdr_attr.GetData(), bdr_attr.Size());
+   writer.BeginSection("bdr_geom");
+   writer.Write(bdr_geom.GetData(), bdr_geom.Size());
+   writer.BeginSection("bdr_vert");
+   writer.Write(bdr_vert.GetData(), bdr_vert.Size());
+   if (ncmesh)
+   {
+      writer.BeginSection("vertex_parents");
+      writer.Write(vertex_parents.GetData(), vertex_parents.Size());
+      writer.BeginSection("coarse_elements");
+      writer.Write(coarse_elements.GetData(), coarse_elements.Size());
+   }
+   if (!Nodes)
+   {
+      writer.BeginSection("vertices");
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         writer.Write(vertices[i](), spaceDim);
+      }
+   }
+   writer.Finish();
+
+   if (Nodes)
+   {
+      Nodes->SaveBinary(out);
+   }
+   out.flush();
+}
+
 void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 {
+   MFEM_VERIFY(!compact_storage, "the mesh uses compact element storage");
    int i;
    Array<int> vert;
 
@@ -8365,6 +8785,8 @@ void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 
 void Mesh::PrintVTK(std::ostream &out)
 {
+   EnsureElementObjects();
+
    out <<
        "# vtk DataFile Version 3.0\n"
        "Generated by MFEM\n"
@@ -8553,27 +8975,38 @@ void Mesh::PrintVTK(std::ostream &out)
    out.flush();
 }
 
-void Mesh::PrintVTU(std::string fname)
+void Mesh::PrintVTU(std::string fname, VTKFormat format,
+                    int compression_level)
 {
    fname = fname + ".vtu";
-   std::fstream out(fname.c_str(),std::ios::out);
-   out << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">"
-       << std::endl;
-   out << "<UnstructuredGrid>" << std::endl;
-   PrintVTU(out,1);
-   out << "</Piece>" <<
-       std::endl; // needed to close the piece open in the PrintVTU method
-   out << "</UnstructuredGrid>" << std::endl;
-   out << "</VTKFile>" << std::endl;
+   std::ofstream out(fname.c_str(), std::ios::out | std::ios::binary);
+   VTKDataWriter writer(out, format, compression_level);
+   writer.BeginFile("UnstructuredGrid");
+   do
+   {
+      PrintVTU(writer, 1);
+      // close the piece open in the PrintVTU method
+      writer.Markup() << "</Piece>\n";
+   }
+   while (writer.NextPass());
+   writer.EndFile();
 
    out.close();
 }
 
 void Mesh::PrintVTU(std::ostream &out, int ref)
+{
+   VTKDataWriter writer(out, VTKFormat::ASCII);
+   PrintVTU(writer, ref);
+}
+
+void Mesh::PrintVTU(VTKDataWriter &writer, int ref)
 {
    int np, nc, size;
    RefinedGeometry *RefG;
    DenseMatrix pmat;
+   std::ostream &out = writer.Markup();
+   const bool data = writer.WritesData();
 
    // count the points, cells, size
    np = nc = size = 0;
@@ -8587,90 +9020,78 @@ void Mesh::PrintVTU(std::ostream &out, int ref)
       size += (RefG->RefGeoms.Size() / nv) * (nv + 1);
    }
 
-   out << "<Piece NumberOfPoints=\"" << np << "\" NumberOfCells=\"" << nc << "\">"
-       << std::endl;
+   out << "<Piece NumberOfPoints=\"" << np << "\" NumberOfCells=\"" << nc
+       << "\">\n";
 
    // print out the points
-   out << "<Points>" << std::endl;
-   out << "<DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">"
-       << std::endl;
-   for (int i = 0; i < GetNE(); i++)
+   out << "<Points>\n";
+   writer.BeginArray<double>(NULL, 3, 3*np);
+   for (int i = 0; data && i < GetNE(); i++)
    {
       RefG = GlobGeometryRefiner.Refine(
                 GetElementBaseGeometry(i), ref, 1);
 
       GetElementTransformation(i)->Transform(RefG->RefPts, pmat);
 
+      if (pmat.Height() == 3)
+      {
+         writer.Write(pmat.Data(), 3*pmat.Width());
+         continue;
+      }
       for (int j = 0; j < pmat.Width(); j++)
       {
-         out << pmat(0, j) << ' ';
-         if (pmat.Height() > 1)
-         {
-            out << pmat(1, j) << ' ';
-            if (pmat.Height() > 2)
-            {
-               out << pmat(2, j);
-            }
-            else
-            {
-               out << 0.0;
-            }
-         }
-         else
+         for (int d = 0; d < 3; d++)
          {
-            out << 0.0 << ' ' << 0.0;
+            writer.Write((d < pmat.Height()) ? pmat(d, j) : 0.0);
          }
-         out << '\n';
       }
    }
-   out << "</DataArray>" << std::endl;
-   out << "</Points>" << std::endl;
+   writer.EndArray();
+   out << "</Points>\n";
 
-   out << "<Cells>" << std::endl;
-   out << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">" <<
-       std::endl;
+   out << "<Cells>\n";
    // connectivity
-   std::vector<int> offset;
-   int coff = 0;
+   writer.BeginArray<int>("connectivity", 1, size - nc);
    np = 0;
-   for (int i = 0; i < GetNE(); i++)
+   for (int i = 0; data && i < GetNE(); i++)
    {
       Geometry::Type geom = GetElementBaseGeometry(i);
-      int nv = Geometries.GetVertices(geom)->GetNPoints();
       RefG = GlobGeometryRefiner.Refine(geom, ref, 1);
       Array<int> &RG = RefG->RefGeoms;
 
-      for (int j = 0; j < RG.Size(); )
+      for (int j = 0; j < RG.Size(); j++)
       {
-         // out << nv;
-         coff = coff+nv;
-         offset.push_back(coff);
-
-         for (int k = 0; k < nv; k++, j++)
-         {
-            out << ' ' << np + RG[j];
-         }
-         out << '\n';
+         writer.Write(np + RG[j]);
       }
       np += RefG->RefPts.GetNPoints();
    }
-   out << "</DataArray>" << std::endl;
+   writer.EndArray();
 
-   out << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">" <<
-       std::endl;
    // offsets
-   for (size_t ii=0; ii<offset.size(); ii++) { out<<offset[ii]<<std::endl;}
-   out << "</DataArray>" << std::endl;
-   out << "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">" <<
-       std::endl;
+   writer.BeginArray<int>("offsets", 1, nc);
+   int coff = 0;
+   for (int i = 0; data && i < GetNE(); i++)
+   {
+      Geometry::Type geom = GetElementBaseGeometry(i);
+      int nv = Geometries.GetVertices(geom)->GetNPoints();
+      RefG = GlobGeometryRefiner.Refine(geom, ref, 1);
+      for (int j = 0; j < RefG->RefGeoms.Size(); j += nv)
+      {
+         coff = coff+nv;
+         writer.Write(coff);
+      }
+   }
+   writer.EndArray();
+
    // cell types
-   for (int i = 0; i < GetNE(); i++)
+   writer.BeginArray<unsigned char>("types", 1, nc);
+   for (int i = 0; data && i < GetNE(); i++)
    {
       Geometry::Type geom = GetElementBaseGeometry(i);
       int nv = Geometries.GetVertices(geom)->GetNPoints();
       RefG = GlobGeometryRefiner.Refine(geom, ref, 1);
       Array<int> &RG = RefG->RefGeoms;
-      int vtk_cell_type = 5;
+      unsigned char vtk_cell_type = 5;
 
       switch (geom)
       {
@@ -8688,16 +9109,15 @@ void Mesh::PrintVTU(std::ostream &out, int ref)
 
       for (int j = 0; j < RG.Size(); j += nv)
       {
-         out << vtk_cell_type << '\n';
+         writer.Write(vtk_cell_type);
       }
    }
-   out << "</DataArray>" << std::endl;
-   out << "</Cells>" << std::endl;
+   writer.EndArray();
+   out << "</Cells>\n";
 
-   out << "<CellData Scalars=\"material\">" << std::endl;
-   out << "<DataArray type=\"Int32\" Name=\"material\" format=\"ascii\">" <<
-       std::endl;
-   for (int i = 0; i < GetNE(); i++)
+   out << "<CellData Scalars=\"material\">\n";
+   writer.BeginArray<int>("material", 1, nc);
+   for (int i = 0; data && i < GetNE(); i++)
    {
       Geometry::Type geom = GetElementBaseGeometry(i);
       int nv = Geometries.GetVertices(geom)->GetNPoints();
@@ -8705,11 +9125,11 @@ void Mesh::PrintVTU(std::ostream &out, int ref)
       int attr = GetAttribute(i);
       for (int j = 0; j < RefG->RefGeoms.Size(); j += nv)
       {
-         out << attr << '\n';
+         writer.Write(attr);
       }
    }
-   out << "</DataArray>" << std::endl;
-   out << "</CellData>" << std::endl;
+   writer.EndArray();
+   out << "</CellData>\n";
 }
 
 
@@ -8948,6 +9368,7 @@ void Mesh::GetElementColoring(Array<int> &colors, int el0)
 void Mesh::PrintWithPartitioning(int *partitioning, std::ostream &out,
                                  int elem_attr) const
 {
+   MFEM_VERIFY(!compact_storage, "the mesh uses compact element storage");
    if (Dim != 3 && Dim != 2) { return; }
 
    int i, j, k, l, nv, nbe, *v;
@@ -9068,6 +9489,8 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
                                          std::ostream &out,
                                          int interior_faces)
 {
+   EnsureElementObjects();
+
    MFEM_ASSERT(Dim == spaceDim, "2D Manifolds not supported\n");
    if (Dim != 3 && Dim != 2) { return; }
 
@@ -9438,6 +9861,7 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
 
 void Mesh::PrintSurfaces(const Table & Aface_face, std::ostream &out) const
 {
+   MFEM_VERIFY(!compact_storage, "the mesh uses compact element storage");
    int i, j;
 
    if (NURBSext)
@@ -10485,6 +10909,7 @@ Mesh *Extrude2D(Mesh *mesh, const int nz, const double sz)
 #ifdef MFEM_DEBUG
 void Mesh::DebugDump(std::ostream &out) const
 {
+   MFEM_VERIFY(!compact_storage, "the mesh uses compact element storage");
    // dump vertices and edges (NCMesh "nodes")
    out << NumOfVertices + NumOfEdges << "\n";
    for (int i = 0; i < NumOfVertices; i++)
@@ -19,6 +19,7 @@
 #include "tetrahedron.hpp"
 #include "vertex.hpp"
 #include "ncmesh.hpp"
+#include "vtk.hpp"
 #include "../fem/eltrans.hpp"
 #include "../fem/coefficient.hpp"
 #include "../general/gzstream.hpp"
@@ -41,6 +42,9 @@ class ParMesh;
 class ParNCMesh;
 #endif
 
+/// Classification of the faces used by the face restrictions and integrators.
+enum class FaceType : bool { Interior, Boundary };
+
 
 class Mesh
 {
@@ -140,6 +144,22 @@ protected:
    mutable Table *face_edge;
    mutable Table *edge_vertex;
 
+   /// @name Compact element storage, see UseCompactElementStorage()
+   ///@{
+   bool compact_storage;
+   /// Vertex indices of the elements of every geometry, stored contiguously.
+   Array<int> compact_vertices[Geometry::NumGeom];
+   /// Geometry of every element.
+   Array<char> compact_geom;
+   /// Index of every element among the elements of its geometry, i.e. its
+   /// position in #compact_vertices.
+   Array<int> compact_index;
+   /// Attribute of every element.
+   Array<int> compact_attributes;
+   /// Refinement flags of the tetrahedra, indexed like #compact_vertices.
+   Array<int> compact_tet_flags;
+   ///@}
+
    IsoparametricTransformation Transformation, Transformation2;
    IsoparametricTransformation BdrTransformation;
    IsoparametricTransformation FaceTransformation, EdgeTransformation;
@@ -208,6 +228,7 @@ protected:
    // Readers for different mesh formats, used in the Load() method.
    // The implementations of these methods are in mesh_readers.cpp.
    void ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved);
+   void ReadBinaryMesh(std::istream &input, int header_size, int &curved);
    void ReadLineMesh(std::istream &input);
    void ReadNetgen2DMesh(std::istream &input, int &curved);
    void ReadNetgen3DMesh(std::istream &input);
@@ -248,6 +269,34 @@ protected:
    void PrepareNodeReorder(DSTable **old_v_to_v, Table **old_elem_vert);
    void DoNodeReorder(DSTable *old_v_to_v, Table *old_elem_vert);
 
+   /// Fill the compact element storage arrays from #elements.
+   void BuildCompactElementStorage();
+   /// Return the on-demand element @a i of the compact element storage.
+   const Element *GetCompactElement(int i) const;
+   /// Clear the compact element storage arrays.
+   void ClearCompactElementStorage();
+   /// Create element @a i from the compact element storage.
+   Element *NewCompactElement(int i) const;
+   /** Create the Element objects of the mesh, leaving the compact element
+       storage mode if it is enabled. */
+   void EnsureElementObjects()
+   { if (compact_storage) { UseCompactElementStorage(false); } }
+
+   /** Return the vertex indices of element @a i and set @a geom to its
+       geometry, reading the compact storage if it is enabled. */
+   const int *GetElementVerticesAndGeometry(int i, Geometry::Type &geom) const
+   {
+      if (compact_storage)
+      {
+         const int g = compact_geom[i];
+         geom = Geometry::Type(g);
+         return compact_vertices[g].GetData() +
+                Geometry::NumVerts[g]*compact_index[i];
+      }
+      geom = elements[i]->GetGeometryType();
+      return elements[i]->GetVertices();
+   }
+
    STable3D *GetFacesTable();
    STable3D *GetElementToFaceTable(int ret_ftbl = 0);
 
@@ -557,6 +606,25 @@ public:
 
    void SetAttributes();
 
+   /** @brief Enable or disable the compact, structure-of-arrays storage of the
+       element connectivity. */
+   /** In this mode the Element objects are deleted: the vertex indices of the
+       elements of every geometry are stored in one contiguous array, next to
+       arrays with the geometry and the attribute of every element. The element
+       queries, the transformations, the face and edge tables, and Print() and
+       PrintBinary() read these arrays directly. The const GetElement() creates
+       the requested element on demand and keeps it until the mode is left.
+
+       Operations that modify the elements, e.g. the non-const GetElement(),
+       refinement, reordering, Finalize(), and CheckElementOrientation(),
+       recreate the Element objects and leave this mode; call this method again
+       afterwards to compact the mesh again. Nonconforming, NURBS and parallel
+       meshes are not supported. */
+   void UseCompactElementStorage(bool use = true);
+
+   /// Return true if the compact element storage is enabled.
+   bool HasCompactElementStorage() const { return compact_storage; }
+
 #ifdef MFEM_USE_GECKO
    /** This is our integration with the Gecko library.  This will call the
        Gecko library to find an element ordering that will increase memory
@@ -727,8 +795,7 @@ public:
    /// being updated and should not be used!
    double *GetVertex(int i) { return vertices[i](); }
 
-   void GetElementData(int geom, Array<int> &elem_vtx, Array<int> &attr) const
-   { GetElementData(elements, geom, elem_vtx, attr); }
+   void GetElementData(int geom, Array<int> &elem_vtx, Array<int> &attr) const;
 
    void GetBdrElementData(int geom, Array<int> &bdr_elem_vtx,
                           Array<int> &bdr_attr) const
@@ -743,11 +810,19 @@ public:
                                   bool zerocopy = false);
 
    const Element* const *GetElementsArray() const
-   { return elements.GetData(); }
+   {
+      MFEM_VERIFY(!compact_storage, "the mesh uses compact element storage");
+      return elements.GetData();
+   }
 
-   const Element *GetElement(int i) const { return elements[i]; }
+   /** With the compact element storage, the element is created on demand; see
+       UseCompactElementStorage(). */
+   const Element *GetElement(int i) const
+   { return compact_storage ? GetCompactElement(i) : elements[i]; }
 
-   Element *GetElement(int i) { return elements[i]; }
+   /** With the compact element storage, this method leaves that mode; see
+       UseCompactElementStorage(). */
+   Element *GetElement(int i) { EnsureElementObjects(); return elements[i]; }
 
    const Element *GetBdrElement(int i) const { return boundary[i]; }
 
@@ -762,7 +837,8 @@ public:
 
    Geometry::Type GetElementBaseGeometry(int i) const
    {
-      return elements[i]->GetGeometryType();
+      return compact_storage ? Geometry::Type(compact_geom[i]) :
+             elements[i]->GetGeometryType();
    }
 
    Geometry::Type GetBdrElementBaseGeometry(int i) const
@@ -805,7 +881,13 @@ public:
 
    /// Returns the indices of the vertices of element i.
    void GetElementVertices(int i, Array<int> &v) const
-   { elements[i]->GetVertices(v); }
+   {
+      if (!compact_storage) { elements[i]->GetVertices(v); return; }
+      Geometry::Type geom;
+      const int *ev = GetElementVerticesAndGeometry(i, geom);
+      v.SetSize(Geometry::NumVerts[geom]);
+      for (int j = 0; j < v.Size(); j++) { v[j] = ev[j]; }
+   }
 
    /// Returns the indices of the vertices of boundary element i.
    void GetBdrElementVertices(int i, Array<int> &v) const
@@ -876,9 +958,16 @@ public:
 
    /** Builds the transformation defining the i-th element in the user-defined
        variable. */
+   /** Different threads may call this method concurrently, with different
+       @a ElTr objects, e.g. in a multithreaded assembly loop. If the mesh has
+       nodes, they must be valid on the host before the threads start, e.g.
+       after calling GetNodes()->HostRead(). */
    void GetElementTransformation(int i, IsoparametricTransformation *ElTr);
 
    /// Returns the transformation defining the i-th element
+   /** The returned object is a member of the Mesh that is overwritten by every
+       call, so this method can not be used by multiple threads. Use
+       GetElementTransformation(int, IsoparametricTransformation *) instead. */
    ElementTransformation *GetElementTransformation(int i);
 
    /** Return the transformation defining the i-th element assuming
@@ -960,6 +1049,12 @@ public:
    void GetFaceElements (int Face, int *Elem1, int *Elem2) const;
    void GetFaceInfos (int Face, int *Inf1, int *Inf2) const;
 
+   /** @brief Return in @a faces the indices of the faces of the given @a type:
+       the interior faces, or the faces of the boundary elements, in the order
+       in which they are visited by BilinearForm::Assemble(). */
+   /** Shared and non-conforming faces are not included. */
+   void GetFacesByType(FaceType type, Array<int> &faces) const;
+
    Geometry::Type GetFaceGeometryType(int Face) const;
    Element::Type  GetFaceElementType(int Face) const;
 
@@ -971,10 +1066,19 @@ public:
    int CheckBdrElementOrientation(bool fix_it = true);
 
    /// Return the attribute of element i.
-   int GetAttribute(int i) const { return elements[i]->GetAttribute(); }
+   int GetAttribute(int i) const
+   {
+      return compact_storage ? compact_attributes[i] :
+             elements[i]->GetAttribute();
+   }
 
    /// Set the attribute of element i.
-   void SetAttribute(int i, int attr) { elements[i]->SetAttribute(attr); }
+   void SetAttribute(int i, int attr)
+   {
+      if (!compact_storage) { elements[i]->SetAttribute(attr); return; }
+      compact_attributes[i] = attr;
+      if (elements.Size() && elements[i]) { elements[i]->SetAttribute(attr); }
+   }
 
    /// Return the attribute of boundary element i.
    int GetBdrAttribute(int i) const { return boundary[i]->GetAttribute(); }
@@ -1160,6 +1264,18 @@ public:
    /// \see mfem::ogzstream() for on-the-fly compression of ascii outputs
    virtual void Print(std::ostream &out = mfem::out) const { Printer(out); }
 
+   /** @brief Print the mesh to the given stream using the binary MFEM mesh
+       format, "MFEM binary mesh v1.0". */
+   /** The file consists of an index followed by aligned, little-endian arrays
+       with the element and boundary attributes, geometries and vertex indices,
+       the vertex coordinates and, for nonconforming meshes, the vertex and
+       element hierarchy, see bin_io::BinaryWriter. The Nodes of a curved mesh
+       follow in the format of GridFunction::SaveBinary(). The file can be read
+       with the Mesh constructors and Load(), like the ascii formats. NURBS
+       meshes are not supported. */
+   /// \see mfem::ogzstream() for on-the-fly compression of binary outputs
+   void PrintBinary(std::ostream &out) const;
+
    /// Print the mesh in VTK format (linear and quadratic meshes only).
    /// \see mfem::ogzstream() for on-the-fly compression of ascii outputs
    void PrintVTK(std::ostream &out);
@@ -1170,10 +1286,19 @@ public:
    /// \see mfem::ogzstream() for on-the-fly compression of ascii outputs
    void PrintVTK(std::ostream &out, int ref, int field_data=0);
    /** Print the mesh in VTU format. The parameter ref > 0 specifies an element
-       subdivision number (useful for high order fields and curved meshes). */
+       subdivision number (useful for high order fields and curved meshes).
+       The mesh is written in ascii as an open Piece element, which the caller
+       closes after adding any PointData. */
    void PrintVTU(std::ostream &out, int ref=1);
-   /** Print the mesh in VTU format with file name fname. */
-   void PrintVTU(std::string fname);
+   /** @brief Print the mesh as an open Piece element with the arrays written
+       by @a writer, see VTKDataWriter. */
+   void PrintVTU(VTKDataWriter &writer, int ref=1);
+   /** @brief Print the mesh in VTU format with file name fname (the extension
+       .vtu is added), using the given data @a format. */
+   /** A @a compression_level between 1 and 9 compresses the data with zlib in
+       the VTKFormat::BINARY format, see VTKDataWriter. */
+   void PrintVTU(std::string fname, VTKFormat format = VTKFormat::ASCII,
+                 int compression_level = 0);
 
    void GetElementColoring(Array<int> &colors, int el0 = 0);
 
@@ -12,6 +12,7 @@
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
 
 #include <iostream>
 #include <cstdio>
@@ -113,6 +114,99 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+static void ReadBinaryElements(Mesh &mesh, bin_io::BinaryReader &reader,
+                               const std::string &prefix,
+                               Array<Element*> &elems)
+{
+   const int ne = elems.Size();
+   Array<int> attr(ne), vert(reader.SectionSize(prefix + "_vert")/sizeof(int));
+   Array<char> geom(ne);
+   MFEM_VERIFY(reader.SectionSize(prefix + "_attr") == ne*sizeof(int) &&
+               reader.SectionSize(prefix + "_geom") == (size_t) ne,
+               "invalid binary mesh file");
+
+   reader.BeginSection(prefix + "_attr");
+   reader.Read(attr.GetData(), ne);
+   reader.BeginSection(prefix + "_geom");
+   reader.Read(geom.GetData(), ne);
+   reader.BeginSection(prefix + "_vert");
+   reader.Read(vert.GetData(), vert.Size());
+
+   for (int i = 0, k = 0; i < ne; i++)
+   {
+      MFEM_VERIFY(geom[i] >= 0 && geom[i] < Geometry::NumGeom,
+                  "invalid element geometry in binary mesh file");
+      Element *el = mesh.NewElement(geom[i]);
+      el->SetAttribute(attr[i]);
+      const int nv = el->GetNVertices();
+      MFEM_VERIFY(k + nv <= vert.Size(), "invalid binary mesh file");
+      el->SetVertices(vert.GetData() + k);
+      k += nv;
+      elems[i] = el;
+   }
+}
+
+void Mesh::ReadBinaryMesh(std::istream &input, int header_size, int &curved)
+{
+   // Read MFEM binary mesh v1.0 format, see Mesh::PrintBinary()
+   bin_io::BinaryReader reader(input, header_size);
+
+   int dims[5];
+   MFEM_VERIFY(reader.SectionSize("dimensions") == sizeof(dims),
+               "invalid binary mesh file");
+   reader.BeginSection("dimensions");
+   reader.Read(dims, 5);
+   Dim = dims[0];
+   spaceDim = dims[1];
+   NumOfVertices = dims[2];
+   NumOfElements = dims[3];
+   NumOfBdrElements = dims[4];
+
+   elements.SetSize(NumOfElements);
+   ReadBinaryElements(*this, reader, "elem", elements);
+   boundary.SetSize(NumOfBdrElements);
+   ReadBinaryElements(*this, reader, "bdr", boundary);
+
+   vertices.SetSize(NumOfVertices);
+   if (reader.HasSection("vertex_parents"))
+   {
+      Array<int> vertex_parents(
+         reader.SectionSize("vertex_parents")/sizeof(int));
+      reader.BeginSection("vertex_parents");
+      reader.Read(vertex_parents.GetData(), vertex_parents.Size());
+      ncmesh = new NCMesh(this, vertex_parents);
+
+      Array<int> coarse_elements(
+         reader.SectionSize("coarse_elements")/sizeof(int));
+      reader.BeginSection("coarse_elements");
+      reader.Read(coarse_elements.GetData(), coarse_elements.Size());
+      ncmesh->LoadCoarseElements(coarse_elements);
+   }
+
+   if (reader.HasSection("vertices"))
+   {
+      MFEM_VERIFY(reader.SectionSize("vertices") ==
+                  (size_t) NumOfVertices*spaceDim*sizeof(double),
+                  "invalid binary mesh file");
+      reader.BeginSection("vertices");
+      for (int j = 0; j < NumOfVertices; j++)
+      {
+         reader.Read(vertices[j](), spaceDim);
+      }
+
+      // initialize vertex positions in NCMesh
+      if (ncmesh) { ncmesh->SetVertexPositions(vertices); }
+   }
+   else
+   {
+      // the nodes follow the mesh
+      curved = 1;
+   }
+   reader.Finish();
+
+   if (remove_unused_vertices) { RemoveUnusedVertices(); }
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
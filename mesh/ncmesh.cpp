@@ -74,8 +74,33 @@ void NCMesh::GeomInfo::Initialize(const mfem::Element* elem)
 }
 
 
+static void ReadVertexParents(std::istream &input, Array<int> &parents)
+{
+   int nv;
+   input >> nv;
+   parents.SetSize(3*nv);
+   for (int i = 0; i < 3*nv; i++)
+   {
+      input >> parents[i];
+   }
+   MFEM_VERIFY(input, "problem reading vertex parents.");
+}
+
 NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
    : shadow(1024, 2048)
+{
+   Array<int> parents;
+   if (vertex_parents) { ReadVertexParents(*vertex_parents, parents); }
+   InitFromMesh(mesh, vertex_parents ? &parents : NULL);
+}
+
+NCMesh::NCMesh(const Mesh *mesh, const Array<int> &vertex_parents)
+   : shadow(1024, 2048)
+{
+   InitFromMesh(mesh, &vertex_parents);
+}
+
+void NCMesh::InitFromMesh(const Mesh *mesh, const Array<int> *vertex_parents)
 {
    Dim = mesh->Dimension();
    spaceDim = mesh->SpaceDimension();
@@ -103,8 +128,7 @@ NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
       MFEM_ASSERT(node == id, "");
    }
 
-   // if a mesh file is being read, load the vertex hierarchy now;
-   // 'vertex_parents' must be at the appropriate section in the mesh file
+   // if a mesh file is being read, load the vertex hierarchy now
    if (vertex_parents)
    {
       LoadVertexParents(*vertex_parents);
@@ -4637,13 +4661,37 @@ void NCMesh::PrintVertexParents(std::ostream &out) const
 
 void NCMesh::LoadVertexParents(std::istream &input)
 {
-   int nv;
-   input >> nv;
-   while (nv--)
+   Array<int> parents;
+   ReadVertexParents(input, parents);
+   LoadVertexParents(parents);
+}
+
+void NCMesh::GetVertexParents(Array<int> &parents) const
+{
+   parents.SetSize(0);
+   for (node_const_iterator node = nodes.cbegin(); node != nodes.cend(); ++node)
    {
-      int id, p1, p2;
-      input >> id >> p1 >> p2;
-      MFEM_VERIFY(input, "problem reading vertex parents.");
+      if (node->HasVertex() && node->p1 != node->p2)
+      {
+         const Node &p1 = nodes[node->p1];
+         const Node &p2 = nodes[node->p2];
+
+         MFEM_ASSERT(p1.HasVertex(), "");
+         MFEM_ASSERT(p2.HasVertex(), "");
+
+         parents.Append(node->vert_index);
+         parents.Append(p1.vert_index);
+         parents.Append(p2.vert_index);
+      }
+   }
+}
+
+void NCMesh::LoadVertexParents(const Array<int> &parents)
+{
+   MFEM_VERIFY(parents.Size() % 3 == 0, "invalid vertex parents.");
+   for (int i = 0; i < parents.Size(); i += 3)
+   {
+      int id = parents[i], p1 = parents[i+1], p2 = parents[i+2];
 
       MFEM_VERIFY(nodes.IdExists(id), "vertex " << id << " not found.");
       MFEM_VERIFY(nodes.IdExists(p1), "parent " << p1 << " not found.");
@@ -4678,7 +4726,8 @@ void NCMesh::SetVertexPositions(const Array<mfem::Vertex> &mvertices)
    }
 }
 
-int NCMesh::PrintElements(std::ostream &out, int elem, int &coarse_id) const
+int NCMesh::CollectCoarseElements(int elem, int &coarse_id,
+                                  Array<int> &coarse) const
 {
    const Element &el = elements[elem];
    if (el.ref_type)
@@ -4686,16 +4735,13 @@ int NCMesh::PrintElements(std::ostream &out, int elem, int &coarse_id) const
       int child_id[8], nch = 0;
       for (int i = 0; i < 8 && el.child[i] >= 0; i++)
       {
-         child_id[nch++] = PrintElements(out, el.child[i], coarse_id);
+         child_id[nch++] =
+            CollectCoarseElements(el.child[i], coarse_id, coarse);
       }
       MFEM_ASSERT(nch == ref_type_num_children[(int) el.ref_type], "");
 
-      out << (int) el.ref_type;
-      for (int i = 0; i < nch; i++)
-      {
-         out << " " << child_id[i];
-      }
-      out << "\n";
+      coarse.Append((int) el.ref_type);
+      coarse.Append(child_id, nch);
       return coarse_id++; // return new id for this coarse element
    }
    else
@@ -4704,17 +4750,34 @@ int NCMesh::PrintElements(std::ostream &out, int elem, int &coarse_id) const
    }
 }
 
+void NCMesh::GetCoarseElements(Array<int> &coarse) const
+{
+   coarse.SetSize(0);
+   int coarse_id = leaf_elements.Size();
+   for (int i = 0; i < root_state.Size(); i++)
+   {
+      CollectCoarseElements(i, coarse_id, coarse);
+   }
+}
+
 void NCMesh::PrintCoarseElements(std::ostream &out) const
 {
    // print the number of non-leaf elements
    out << (elements.Size() - free_element_ids.Size() - leaf_elements.Size())
        << "\n";
 
-   // print the hierarchy recursively
-   int coarse_id = leaf_elements.Size();
-   for (int i = 0; i < root_state.Size(); i++)
+   // print the hierarchy, children before their parents
+   Array<int> coarse;
+   GetCoarseElements(coarse);
+   for (int i = 0; i < coarse.Size(); )
    {
-      PrintElements(out, i, coarse_id);
+      const int nch = ref_type_num_children[coarse[i]];
+      out << coarse[i++];
+      for (int j = 0; j < nch; j++)
+      {
+         out << " " << coarse[i++];
+      }
+      out << "\n";
    }
 }
 
@@ -4743,13 +4806,34 @@ void NCMesh::LoadCoarseElements(std::istream &input)
    int ne;
    input >> ne;
 
-   bool iso = true;
-
-   // load the coarse elements
+   Array<int> coarse;
    while (ne--)
    {
       int ref_type;
       input >> ref_type;
+      MFEM_VERIFY(input && ref_type > 0 && ref_type < 8,
+                  "problem reading coarse elements.");
+      coarse.Append(ref_type);
+      for (int i = 0, id; i < ref_type_num_children[ref_type]; i++)
+      {
+         input >> id;
+         coarse.Append(id);
+      }
+   }
+   MFEM_VERIFY(input, "problem reading coarse elements.");
+
+   LoadCoarseElements(coarse);
+}
+
+void NCMesh::LoadCoarseElements(const Array<int> &coarse)
+{
+   bool iso = true;
+
+   // load the coarse elements
+   for (int k = 0; k < coarse.Size(); )
+   {
+      int ref_type = coarse[k++];
+      MFEM_VERIFY(ref_type > 0 && ref_type < 8, "invalid refinement type.");
 
       int elem = AddElement(Element(Geometry::INVALID, 0));
       Element &el = elements[elem];
@@ -4759,9 +4843,10 @@ void NCMesh::LoadCoarseElements(std::istream &input)
 
       // load child IDs and make parent-child links
       int nch = ref_type_num_children[ref_type];
+      MFEM_VERIFY(k + nch <= coarse.Size(), "invalid coarse elements.");
       for (int i = 0, id; i < nch; i++)
       {
-         input >> id;
+         id = coarse[k++];
          MFEM_VERIFY(id >= 0, "");
          MFEM_VERIFY(id < leaf_elements.Size() ||
                      id < elements.Size()-free_element_ids.Size(),
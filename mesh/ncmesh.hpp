@@ -105,6 +105,10 @@ public:
        section of the mesh file which contains the vertex hierarchy. */
    explicit NCMesh(const Mesh *mesh, std::istream *vertex_parents = NULL);
 
+   /** Same as above, with the vertex hierarchy of a nonconforming mesh being
+       loaded given as in GetVertexParents(). */
+   NCMesh(const Mesh *mesh, const Array<int> &vertex_parents);
+
    NCMesh(const NCMesh &other); // deep copy
 
    virtual ~NCMesh();
@@ -347,6 +351,22 @@ public:
    /// I/O: Load the element refinement hierarchy from a mesh file.
    void LoadCoarseElements(std::istream &input);
 
+   /** I/O: Return the vertex parent hierarchy as triples (vertex, parent1,
+       parent2), used by the binary mesh format. */
+   void GetVertexParents(Array<int> &parents) const;
+
+   /** I/O: Return the element refinement hierarchy, used by the binary mesh
+       format. Each coarse element is stored as its refinement type followed
+       by the indices of its children, in the order of the "coarse_elements"
+       section of the mesh file. */
+   void GetCoarseElements(Array<int> &coarse) const;
+
+   /// I/O: Load the vertex parent hierarchy given as in GetVertexParents().
+   void LoadVertexParents(const Array<int> &parents);
+
+   /// I/O: Load the element refinement hierarchy as in GetCoarseElements().
+   void LoadCoarseElements(const Array<int> &coarse);
+
    /// I/O: Set positions of all vertices (used by mesh loader).
    void SetVertexPositions(const Array<mfem::Vertex> &vertices);
 
@@ -815,7 +835,10 @@ protected: // implementation
    void CountSplits(int elem, int splits[3]) const;
    void GetLimitRefinements(Array<Refinement> &refinements, int max_level);
 
-   int PrintElements(std::ostream &out, int elem, int &coarse_id) const;
+   void InitFromMesh(const Mesh *mesh, const Array<int> *vertex_parents);
+
+   int CollectCoarseElements(int elem, int &coarse_id,
+                             Array<int> &coarse) const;
    void CopyElements(int elem, const BlockArray<Element> &tmp_elements,
                      Array<int> &index_map);
 
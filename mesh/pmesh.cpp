@@ -19,9 +19,13 @@
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
+#include "../general/binaryio.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <limits>
 
 using namespace std;
 
@@ -1057,6 +1061,780 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    // TODO: AMR meshes, NURBS meshes?
 }
 
+// Exchange variable-size buckets of data between all ranks: send[r] is sent to
+// rank r and the data received from rank r is stored in recv[recv_off[r]] ..
+// recv[recv_off[r+1]-1].
+template <typename T>
+static void ExchangeBuckets(MPI_Comm comm, MPI_Datatype type,
+                            const vector<vector<T> > &send,
+                            vector<T> &recv, vector<int> &recv_off)
+{
+   const int nranks = send.size();
+   vector<int> send_cnt(nranks), send_off(nranks+1), recv_cnt(nranks);
+   send_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      send_cnt[r] = send[r].size();
+      send_off[r+1] = send_off[r] + send_cnt[r];
+   }
+   MPI_Alltoall(send_cnt.data(), 1, MPI_INT, recv_cnt.data(), 1, MPI_INT,
+                comm);
+   recv_off.resize(nranks+1);
+   recv_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      recv_off[r+1] = recv_off[r] + recv_cnt[r];
+   }
+
+   vector<T> send_buf(send_off[nranks]);
+   for (int r = 0; r < nranks; r++)
+   {
+      std::copy(send[r].begin(), send[r].end(),
+                send_buf.begin() + send_off[r]);
+   }
+   recv.resize(recv_off[nranks]);
+   MPI_Alltoallv(send_buf.data(), send_cnt.data(), send_off.data(), type,
+                 recv.data(), recv_cnt.data(), recv_off.data(), type, comm);
+}
+
+// The global vertices are split into contiguous blocks, one per rank. The rank
+// holding the block of a vertex is its "home": it reads the vertex coordinates
+// and keeps track of the ranks using the vertex.
+static long long VertexBlockStart(long long nv, int nranks, int rank)
+{
+   return nv*rank/nranks;
+}
+
+static int VertexHome(long long nv, int nranks, long long gv)
+{
+   return (int) (((gv+1)*nranks - 1)/nv);
+}
+
+// Send the sorted global vertex ids 'gverts' to their homes. Since the homes
+// are ordered like the vertices, the replies received from all homes, in rank
+// order, follow the order of 'gverts'.
+static void SendToHomes(MPI_Comm comm, long long nv, const vector<int> &gverts,
+                        vector<int> &recv, vector<int> &recv_off)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   vector<vector<int> > send(nranks);
+   for (size_t i = 0; i < gverts.size(); i++)
+   {
+      send[VertexHome(nv, nranks, gverts[i])].push_back(gverts[i]);
+   }
+   ExchangeBuckets(comm, MPI_INT, send, recv, recv_off);
+}
+
+// Return the sorted unique global vertex ids used by the element records in
+// 'data' (see ReadElementSlice).
+static void GetRecordVertices(const vector<int> &data, vector<int> &gverts)
+{
+   gverts.clear();
+   for (size_t k = 0; k < data.size(); k += 2 + Geometry::NumVerts[data[k+1]])
+   {
+      const int nv = Geometry::NumVerts[data[k+1]];
+      gverts.insert(gverts.end(), &data[k+2], &data[k+2] + nv);
+   }
+   std::sort(gverts.begin(), gverts.end());
+   gverts.erase(std::unique(gverts.begin(), gverts.end()), gverts.end());
+}
+
+// Read the contiguous slice of the elements (prefix "elem") or the boundary
+// elements (prefix "bdr") of a binary mesh file assigned to this rank. Each
+// element is stored in 'data' as: attribute, geometry, global vertex ids.
+static void ReadElementSlice(bin_io::BinaryReader &reader, MPI_Comm comm,
+                             const string &prefix, long long num_elems,
+                             vector<int> &data)
+{
+   int nranks, rank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &rank);
+   const long long e0 = num_elems*rank/nranks;
+   const int ne = num_elems*(rank+1)/nranks - e0;
+
+   vector<int> attr(ne);
+   vector<char> geom(ne);
+   reader.SeekSection(prefix + "_attr", e0*sizeof(int));
+   reader.Read(attr.data(), ne);
+   reader.SeekSection(prefix + "_geom", e0);
+   reader.Read(geom.data(), ne);
+
+   long long nv = 0, v0 = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      MFEM_VERIFY(geom[i] >= 0 && geom[i] < Geometry::NumGeom,
+                  "invalid element geometry: " << (int) geom[i]);
+      nv += Geometry::NumVerts[(int) geom[i]];
+   }
+   MPI_Exscan(&nv, &v0, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   if (rank == 0) { v0 = 0; } // MPI_Exscan leaves v0 undefined on rank 0
+
+   vector<int> verts(nv);
+   reader.SeekSection(prefix + "_vert", v0*sizeof(int));
+   reader.Read(verts.data(), nv);
+
+   data.clear();
+   data.reserve(2*ne + nv);
+   for (int i = 0, k = 0; i < ne; i++)
+   {
+      const int nvi = Geometry::NumVerts[(int) geom[i]];
+      data.push_back(attr[i]);
+      data.push_back(geom[i]);
+      data.insert(data.end(), verts.begin() + k, verts.begin() + k + nvi);
+      k += nvi;
+   }
+}
+
+// Return the Morton (Z-order) index of the point 'x' in the box [xmin, xmax].
+static unsigned long long MortonKey(const double *x, const double *xmin,
+                                    const double *xmax, int dim)
+{
+   const int bits = std::min(63/dim, 31);
+   unsigned q[3];
+   for (int d = 0; d < dim; d++)
+   {
+      const double t = (xmax[d] > xmin[d]) ?
+                       (x[d] - xmin[d])/(xmax[d] - xmin[d]) : 0.0;
+      q[d] = (unsigned) (t*((1u << bits) - 1));
+   }
+   unsigned long long key = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int d = 0; d < dim; d++)
+      {
+         key = (key << 1) | ((q[d] >> b) & 1u);
+      }
+   }
+   return key;
+}
+
+// Split the global sequence of the 'keys' of all ranks into contiguous ranges
+// with approximately equal numbers of keys, using regular samples of the local
+// keys to pick the splitters. Return the range (rank) of each local key.
+static void PartitionKeys(MPI_Comm comm,
+                          const vector<unsigned long long> &keys,
+                          vector<int> &part)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+
+   vector<unsigned long long> sorted(keys);
+   std::sort(sorted.begin(), sorted.end());
+   const long long n = sorted.size();
+   int ns = std::min<long long>(n, std::max(16, 65536/nranks));
+   vector<unsigned long long> samples(ns);
+   for (int i = 0; i < ns; i++) { samples[i] = sorted[n*i/ns]; }
+
+   vector<int> counts(nranks), displs(nranks+1);
+   MPI_Allgather(&ns, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                 comm);
+   displs[0] = 0;
+   for (int r = 0; r < nranks; r++) { displs[r+1] = displs[r] + counts[r]; }
+   vector<unsigned long long> all_samples(displs[nranks]);
+   MPI_Allgatherv(samples.data(), ns, MPI_UNSIGNED_LONG_LONG,
+                  all_samples.data(), counts.data(), displs.data(),
+                  MPI_UNSIGNED_LONG_LONG, comm);
+   std::sort(all_samples.begin(), all_samples.end());
+
+   const long long total = all_samples.size();
+   part.assign(keys.size(), 0);
+   if (total == 0) { return; } // no keys on any rank
+
+   vector<unsigned long long> splitters(nranks-1);
+   for (int r = 0; r < nranks-1; r++)
+   {
+      splitters[r] = all_samples[total*(r+1)/nranks];
+   }
+   for (size_t i = 0; i < keys.size(); i++)
+   {
+      part[i] = std::upper_bound(splitters.begin(), splitters.end(), keys[i])
+                - splitters.begin();
+   }
+}
+
+// Compare entity keys of a fixed length, see FindEntityRanks.
+struct EntityKeyLess
+{
+   const int *keys;
+   int nk;
+   EntityKeyLess(const int *keys, int nk) : keys(keys), nk(nk) { }
+   bool operator()(int a, int b) const
+   {
+      return std::lexicographical_compare(keys + a*nk, keys + (a+1)*nk,
+                                          keys + b*nk, keys + (b+1)*nk);
+   }
+};
+
+// Find the ranks containing each of the given mesh entities (edges or faces).
+// An entity is identified by 'nk' global vertex ids, sorted and padded with -1,
+// and is resolved by the home of its first vertex. On return, the sorted ranks
+// containing entity i are ranks_J[ranks_I[i]] .. ranks_J[ranks_I[i+1]-1].
+static void FindEntityRanks(MPI_Comm comm, long long nv, int nk,
+                            const vector<int> &keys,
+                            vector<int> &ranks_I, vector<int> &ranks_J)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   const int nq = keys.size()/nk;
+
+   vector<vector<int> > send(nranks), queries(nranks);
+   for (int i = 0; i < nq; i++)
+   {
+      const int home = VertexHome(nv, nranks, keys[i*nk]);
+      send[home].insert(send[home].end(), &keys[i*nk], &keys[i*nk] + nk);
+      queries[home].push_back(i);
+   }
+   vector<int> recv, recv_off;
+   ExchangeBuckets(comm, MPI_INT, send, recv, recv_off);
+
+   // match the keys received from all ranks
+   const int nr = recv.size()/nk;
+   vector<int> order(nr), source(nr), run(nr), run_ranks, run_off(1, 0);
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int i = recv_off[r]/nk; i < recv_off[r+1]/nk; i++) { source[i] = r; }
+   }
+   for (int i = 0; i < nr; i++) { order[i] = i; }
+   EntityKeyLess less(recv.data(), nk);
+   std::sort(order.begin(), order.end(), less);
+   for (int i = 0; i < nr; )
+   {
+      int j = i;
+      for ( ; j < nr && !less(order[i], order[j]); j++)
+      {
+         run[order[j]] = run_off.size()-1;
+         run_ranks.push_back(source[order[j]]);
+      }
+      std::sort(run_ranks.begin() + run_off.back(), run_ranks.end());
+      run_off.push_back(run_ranks.size());
+      i = j;
+   }
+
+   // reply with the list of ranks for each query, in the order received
+   for (int r = 0; r < nranks; r++)
+   {
+      send[r].clear();
+      for (int i = recv_off[r]/nk; i < recv_off[r+1]/nk; i++)
+      {
+         const int k = run[i];
+         send[r].push_back(run_off[k+1] - run_off[k]);
+         send[r].insert(send[r].end(), run_ranks.begin() + run_off[k],
+                        run_ranks.begin() + run_off[k+1]);
+      }
+   }
+   ExchangeBuckets(comm, MPI_INT, send, recv, recv_off);
+
+   vector<int> reply(nq);
+   for (int r = 0, p = 0; r < nranks; r++)
+   {
+      for (size_t j = 0; j < queries[r].size(); j++)
+      {
+         reply[queries[r][j]] = p;
+         p += 1 + recv[p];
+      }
+   }
+   ranks_I.resize(nq+1);
+   ranks_I[0] = 0;
+   ranks_J.clear();
+   for (int i = 0; i < nq; i++)
+   {
+      const int p = reply[i];
+      ranks_J.insert(ranks_J.end(), &recv[p+1], &recv[p+1] + recv[p]);
+      ranks_I[i+1] = ranks_J.size();
+   }
+}
+
+// Return the number of ranks in the intersection of the rank lists of the
+// local vertices 'lv', storing them in 'common'.
+static int CommonRanks(const vector<int> &ranks_I, const vector<int> &ranks_J,
+                       const int *lv, int n, vector<int> &common)
+{
+   common.assign(&ranks_J[ranks_I[lv[0]]], &ranks_J[ranks_I[lv[0]+1]]);
+   vector<int> tmp;
+   for (int i = 1; i < n && common.size() > 1; i++)
+   {
+      tmp.clear();
+      std::set_intersection(common.begin(), common.end(),
+                            &ranks_J[ranks_I[lv[i]]],
+                            &ranks_J[ranks_I[lv[i]+1]],
+                            std::back_inserter(tmp));
+      common.swap(tmp);
+   }
+   return common.size();
+}
+
+// Return the index of the face with vertices 'v' in 'faces_tbl', or -1.
+static int FindFace(const STable3D &faces_tbl, const int *v, int nv)
+{
+   int sv[4] = { v[0], v[1], v[2], (nv == 4) ? v[3] : -1 };
+   std::sort(sv, sv + nv);
+   // quadrilaterals are stored by their three smallest vertices
+   return faces_tbl.Index(sv[0], sv[1], sv[2]);
+}
+
+// Build the table of the shared entities in each group, except the local group
+// 0, given the group of each shared entity.
+static void MakeGroupTable(int ngroups, const vector<int> &entity_group,
+                           Table &group_entity)
+{
+   group_entity.MakeI(ngroups-1);
+   for (size_t i = 0; i < entity_group.size(); i++)
+   {
+      group_entity.AddAColumnInRow(entity_group[i]-1);
+   }
+   group_entity.MakeJ();
+   for (size_t i = 0; i < entity_group.size(); i++)
+   {
+      group_entity.AddConnection(entity_group[i]-1, i);
+   }
+   group_entity.ShiftUpI();
+}
+
+// Replace the local list of attributes by the union of the lists of all ranks.
+static void GatherAttributes(MPI_Comm comm, Array<int> &attr)
+{
+   int nranks, n = attr.Size();
+   MPI_Comm_size(comm, &nranks);
+   vector<int> counts(nranks), displs(nranks+1);
+   MPI_Allgather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+   displs[0] = 0;
+   for (int r = 0; r < nranks; r++) { displs[r+1] = displs[r] + counts[r]; }
+   Array<int> all(displs[nranks]);
+   MPI_Allgatherv(attr.GetData(), n, MPI_INT, all.GetData(), counts.data(),
+                  displs.data(), MPI_INT, comm);
+   all.Sort();
+   all.Unique();
+   all.Copy(attr);
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const char *filename, bool sfc_partitioning,
+                 bool refine)
+   : gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   ncmesh = pncmesh = NULL;
+
+   ifstream input(filename, ios::in | ios::binary);
+   MFEM_VERIFY(input.good(), "cannot open mesh file: " << filename);
+   string header;
+   getline(input, header);
+   MFEM_VERIFY(header == "MFEM binary mesh v1.0",
+               "not a binary MFEM mesh: " << filename);
+   bin_io::BinaryReader reader(input, header.size() + 1);
+   // Nonconforming and curved meshes must be read serially and partitioned,
+   // see ParMesh(MPI_Comm, Mesh &, int *, int).
+   MFEM_VERIFY(!reader.HasSection("vertex_parents") &&
+               !reader.HasSection("coarse_elements"),
+               "nonconforming meshes are not supported: " << filename);
+   MFEM_VERIFY(reader.HasSection("vertices"),
+               "curved meshes (with nodes) are not supported: " << filename);
+
+   int dims[5];
+   reader.SeekSection("dimensions");
+   reader.Read(dims, 5);
+   Dim = dims[0];
+   spaceDim = dims[1];
+   const long long glob_nv = dims[2], glob_ne = dims[3], glob_nbe = dims[4];
+   MFEM_VERIFY(glob_ne >= NRanks, "the mesh has fewer elements than ranks");
+
+   // read the coordinates of the vertices in the local block
+   const long long vstart = VertexBlockStart(glob_nv, NRanks, MyRank);
+   const int nhome = VertexBlockStart(glob_nv, NRanks, MyRank+1) - vstart;
+   vector<double> home_coords((size_t) nhome*spaceDim);
+   reader.SeekSection("vertices", vstart*spaceDim*sizeof(double));
+   reader.Read(home_coords.data(), home_coords.size());
+
+   // read a contiguous slice of the elements
+   vector<int> el_data, gverts, recv, recv_off;
+   vector<double> coords, recv_coords;
+   vector<vector<int> > send(NRanks);
+   vector<vector<double> > send_coords(NRanks);
+   ReadElementSlice(reader, MyComm, "elem", glob_ne, el_data);
+
+   if (sfc_partitioning && NRanks > 1)
+   {
+      // fetch the vertex coordinates of the local elements from their homes
+      GetRecordVertices(el_data, gverts);
+      SendToHomes(MyComm, glob_nv, gverts, recv, recv_off);
+      for (int r = 0; r < NRanks; r++)
+      {
+         send_coords[r].clear();
+         for (int i = recv_off[r]; i < recv_off[r+1]; i++)
+         {
+            const double *x = &home_coords[(recv[i] - vstart)*spaceDim];
+            send_coords[r].insert(send_coords[r].end(), x, x + spaceDim);
+         }
+      }
+      ExchangeBuckets(MyComm, MPI_DOUBLE, send_coords, coords, recv_off);
+
+      // order the element centers along a Morton curve
+      double loc_min[3], loc_max[3], xmin[3], xmax[3];
+      for (int d = 0; d < spaceDim; d++)
+      {
+         loc_min[d] = numeric_limits<double>::max();
+         loc_max[d] = -numeric_limits<double>::max();
+      }
+      for (int i = 0; i < nhome; i++)
+      {
+         for (int d = 0; d < spaceDim; d++)
+         {
+            loc_min[d] = std::min(loc_min[d], home_coords[i*spaceDim + d]);
+            loc_max[d] = std::max(loc_max[d], home_coords[i*spaceDim + d]);
+         }
+      }
+      MPI_Allreduce(loc_min, xmin, spaceDim, MPI_DOUBLE, MPI_MIN, MyComm);
+      MPI_Allreduce(loc_max, xmax, spaceDim, MPI_DOUBLE, MPI_MAX, MyComm);
+
+      vector<unsigned long long> keys;
+      vector<size_t> start;
+      for (size_t k = 0; k < el_data.size(); )
+      {
+         const int nv = Geometry::NumVerts[el_data[k+1]];
+         double center[3] = { 0.0, 0.0, 0.0 };
+         for (int j = 0; j < nv; j++)
+         {
+            const int i = std::lower_bound(gverts.begin(), gverts.end(),
+                                           el_data[k+2+j]) - gverts.begin();
+            for (int d = 0; d < spaceDim; d++)
+            {
+               center[d] += coords[i*spaceDim + d]/nv;
+            }
+         }
+         keys.push_back(MortonKey(center, xmin, xmax, spaceDim));
+         start.push_back(k);
+         k += 2 + nv;
+      }
+
+      // migrate the elements to their new ranks
+      vector<int> part;
+      PartitionKeys(MyComm, keys, part);
+      for (int r = 0; r < NRanks; r++) { send[r].clear(); }
+      for (size_t i = 0; i < part.size(); i++)
+      {
+         const int *rec = &el_data[start[i]];
+         send[part[i]].insert(send[part[i]].end(), rec,
+                              rec + 2 + Geometry::NumVerts[rec[1]]);
+      }
+      ExchangeBuckets(MyComm, MPI_INT, send, el_data, recv_off);
+   }
+
+   // Number the local vertices in the order of their global ids, so that the
+   // orientation of shared entities is the same on all ranks. Their homes
+   // return the coordinates and the sorted list of ranks using each vertex.
+   GetRecordVertices(el_data, gverts);
+   SendToHomes(MyComm, glob_nv, gverts, recv, recv_off);
+
+   vector<int> home_I(nhome+1, 0), home_J(recv.size());
+   for (size_t i = 0; i < recv.size(); i++) { home_I[recv[i]-vstart+1]++; }
+   for (int i = 0; i < nhome; i++) { home_I[i+1] += home_I[i]; }
+   {
+      vector<int> pos(home_I.begin(), home_I.end()-1);
+      for (int r = 0; r < NRanks; r++)
+      {
+         for (int i = recv_off[r]; i < recv_off[r+1]; i++)
+         {
+            home_J[pos[recv[i]-vstart]++] = r;
+         }
+      }
+   }
+   for (int r = 0; r < NRanks; r++)
+   {
+      send[r].clear();
+      send_coords[r].clear();
+      for (int i = recv_off[r]; i < recv_off[r+1]; i++)
+      {
+         const int hv = recv[i] - vstart;
+         send[r].push_back(home_I[hv+1] - home_I[hv]);
+         send[r].insert(send[r].end(), &home_J[home_I[hv]],
+                        &home_J[home_I[hv+1]]);
+         const double *x = &home_coords[hv*spaceDim];
+         send_coords[r].insert(send_coords[r].end(), x, x + spaceDim);
+      }
+   }
+   ExchangeBuckets(MyComm, MPI_DOUBLE, send_coords, coords, recv_off);
+   ExchangeBuckets(MyComm, MPI_INT, send, recv, recv_off);
+
+   NumOfVertices = gverts.size();
+   vertices.SetSize(NumOfVertices);
+   vector<int> vranks_I(NumOfVertices+1), vranks_J;
+   vranks_I[0] = 0;
+   for (int i = 0, p = 0; i < NumOfVertices; i++)
+   {
+      vertices[i].SetCoords(spaceDim, &coords[i*spaceDim]);
+      vranks_J.insert(vranks_J.end(), &recv[p+1], &recv[p+1] + recv[p]);
+      vranks_I[i+1] = vranks_J.size();
+      p += 1 + recv[p];
+   }
+
+   for (size_t k = 0; k < el_data.size(); )
+   {
+      int *rec = &el_data[k];
+      const int nv = Geometry::NumVerts[rec[1]];
+      for (int j = 0; j < nv; j++)
+      {
+         rec[2+j] = std::lower_bound(gverts.begin(), gverts.end(), rec[2+j])
+                    - gverts.begin();
+      }
+      Element *el = NewElement(rec[1]);
+      el->SetAttribute(rec[0]);
+      el->SetVertices(rec + 2);
+      elements.Append(el);
+      k += 2 + nv;
+   }
+   NumOfElements = elements.Size();
+
+   // Find the shared vertices, edges and faces. A shared entity is contained
+   // in more than one rank and is described by the set of these ranks, its
+   // communication group. In each group, the entities are sorted by their
+   // global vertex ids, as required by the group communication.
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+
+   vector<int> svert_group;
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      const int n = vranks_I[i+1] - vranks_I[i];
+      if (n > 1)
+      {
+         group.Recreate(n, &vranks_J[vranks_I[i]]);
+         svert_lvert.Append(i);
+         svert_group.push_back(groups.Insert(group));
+      }
+   }
+
+   vector<int> common;
+   DSTable v_to_v(NumOfVertices);
+   Array<int> ledge_owner;
+   vector<int> sedge_group;
+   if (Dim > 1)
+   {
+      GetVertexToVertexTable(v_to_v);
+      ledge_owner.SetSize(v_to_v.NumberOfEntries());
+      ledge_owner = MyRank;
+
+      vector<int> keys, lverts, ranks_I, ranks_J;
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (DSTable::RowIterator it(v_to_v, i); !it; ++it)
+         {
+            const int lv[2] = { std::min(i, it.Column()),
+                                std::max(i, it.Column())
+                              };
+            if (CommonRanks(vranks_I, vranks_J, lv, 2, common) < 2)
+            {
+               continue;
+            }
+            lverts.insert(lverts.end(), lv, lv + 2);
+            keys.push_back(gverts[lv[0]]);
+            keys.push_back(gverts[lv[1]]);
+         }
+      }
+      FindEntityRanks(MyComm, glob_nv, 2, keys, ranks_I, ranks_J);
+
+      // sort the shared edges by their vertices
+      vector<int> order;
+      for (size_t e = 0; e + 1 < ranks_I.size(); e++)
+      {
+         if (ranks_I[e+1] - ranks_I[e] > 1) { order.push_back(e); }
+      }
+      std::sort(order.begin(), order.end(), EntityKeyLess(lverts.data(), 2));
+      for (size_t k = 0; k < order.size(); k++)
+      {
+         const int e = order[k], *lv = &lverts[2*e];
+         group.Recreate(ranks_I[e+1] - ranks_I[e], &ranks_J[ranks_I[e]]);
+         shared_edges.Append(new Segment(lv[0], lv[1], 1));
+         sedge_group.push_back(groups.Insert(group));
+         ledge_owner[v_to_v(lv[0], lv[1])] = ranks_J[ranks_I[e]];
+      }
+   }
+
+   STable3D *faces_tbl = NULL;
+   Array<int> lface_owner;
+   vector<int> stria_group, squad_group;
+   if (Dim > 2)
+   {
+      faces_tbl = GetFacesTable();
+      lface_owner.SetSize(faces_tbl->NumberOfElements());
+      lface_owner = MyRank;
+
+      Array<bool> seen(faces_tbl->NumberOfElements());
+      seen = false;
+      vector<int> keys, lverts, ranks_I, ranks_J;
+      for (int e = 0; e < NumOfElements; e++)
+      {
+         const int *v = elements[e]->GetVertices();
+         for (int f = 0; f < elements[e]->GetNFaces(); f++)
+         {
+            const int nfv = elements[e]->GetNFaceVertices(f);
+            const int *fv = elements[e]->GetFaceVertices(f);
+            int lv[4] = { v[fv[0]], v[fv[1]], v[fv[2]], -1 };
+            if (nfv == 4) { lv[3] = v[fv[3]]; }
+            const int lf = FindFace(*faces_tbl, lv, nfv);
+            if (seen[lf]) { continue; }
+            seen[lf] = true;
+            if (CommonRanks(vranks_I, vranks_J, lv, nfv, common) < 2)
+            {
+               continue;
+            }
+            lverts.insert(lverts.end(), lv, lv + 4);
+            int key[4] = { gverts[lv[0]], gverts[lv[1]], gverts[lv[2]], -1 };
+            if (nfv == 4) { key[3] = gverts[lv[3]]; }
+            std::sort(key, key + nfv);
+            keys.insert(keys.end(), key, key + 4);
+         }
+      }
+      FindEntityRanks(MyComm, glob_nv, 4, keys, ranks_I, ranks_J);
+
+      // sort the shared faces by their sorted global vertex ids
+      vector<int> order;
+      for (size_t f = 0; f + 1 < ranks_I.size(); f++)
+      {
+         if (ranks_I[f+1] - ranks_I[f] > 1) { order.push_back(f); }
+      }
+      std::sort(order.begin(), order.end(), EntityKeyLess(keys.data(), 4));
+      for (size_t k = 0; k < order.size(); k++)
+      {
+         const int f = order[k], *lv = &lverts[4*f];
+         group.Recreate(ranks_I[f+1] - ranks_I[f], &ranks_J[ranks_I[f]]);
+         const int g = groups.Insert(group);
+         // use the same orientation on all ranks: since the local vertices
+         // are ordered like the global ones, start with the smallest vertex
+         // and go towards its smaller neighbor
+         if (lv[3] < 0)
+         {
+            int sv[3] = { lv[0], lv[1], lv[2] };
+            std::sort(sv, sv + 3);
+            shared_trias.Append(Vert3(sv[0], sv[1], sv[2]));
+            stria_group.push_back(g);
+         }
+         else
+         {
+            const int j = std::min_element(lv, lv + 4) - lv;
+            const int s = (lv[(j+1)%4] < lv[(j+3)%4]) ? 1 : 3;
+            shared_quads.Append(Vert4(lv[j], lv[(j+s)%4], lv[(j+2*s)%4],
+                                      lv[(j+3*s)%4]));
+            squad_group.push_back(g);
+         }
+         lface_owner[FindFace(*faces_tbl, lv, (lv[3] < 0) ? 3 : 4)] =
+            ranks_J[ranks_I[f]];
+      }
+   }
+
+   // Read a slice of the boundary elements and send each one to the ranks that
+   // contain all of its vertices. A rank keeps the boundary elements that are
+   // faces of its elements; on an interior boundary between ranks, only the
+   // smallest of them keeps the element.
+   vector<int> bdr_data, bdr_verts;
+   ReadElementSlice(reader, MyComm, "bdr", glob_nbe, bdr_data);
+   GetRecordVertices(bdr_data, bdr_verts);
+   SendToHomes(MyComm, glob_nv, bdr_verts, recv, recv_off);
+   for (int r = 0; r < NRanks; r++)
+   {
+      send[r].clear();
+      for (int i = recv_off[r]; i < recv_off[r+1]; i++)
+      {
+         const int hv = recv[i] - vstart;
+         send[r].push_back(home_I[hv+1] - home_I[hv]);
+         send[r].insert(send[r].end(), &home_J[home_I[hv]],
+                        &home_J[home_I[hv+1]]);
+      }
+   }
+   ExchangeBuckets(MyComm, MPI_INT, send, recv, recv_off);
+   {
+      vector<int> branks_I(bdr_verts.size()+1), branks_J;
+      branks_I[0] = 0;
+      for (size_t i = 0, p = 0; i < bdr_verts.size(); i++)
+      {
+         branks_J.insert(branks_J.end(), &recv[p+1], &recv[p+1] + recv[p]);
+         branks_I[i+1] = branks_J.size();
+         p += 1 + recv[p];
+      }
+      for (int r = 0; r < NRanks; r++) { send[r].clear(); }
+      int bv[8];
+      for (size_t k = 0; k < bdr_data.size(); )
+      {
+         const int *rec = &bdr_data[k];
+         const int nv = Geometry::NumVerts[rec[1]];
+         for (int j = 0; j < nv; j++)
+         {
+            bv[j] = std::lower_bound(bdr_verts.begin(), bdr_verts.end(),
+                                     rec[2+j]) - bdr_verts.begin();
+         }
+         CommonRanks(branks_I, branks_J, bv, nv, common);
+         for (size_t j = 0; j < common.size(); j++)
+         {
+            send[common[j]].insert(send[common[j]].end(), rec, rec + 2 + nv);
+         }
+         k += 2 + nv;
+      }
+   }
+   ExchangeBuckets(MyComm, MPI_INT, send, bdr_data, recv_off);
+
+   for (size_t k = 0; k < bdr_data.size(); )
+   {
+      int *rec = &bdr_data[k];
+      const int nv = Geometry::NumVerts[rec[1]];
+      k += 2 + nv;
+      int *lv = rec + 2;
+      bool local = true;
+      for (int j = 0; j < nv; j++)
+      {
+         vector<int>::iterator it =
+            std::lower_bound(gverts.begin(), gverts.end(), lv[j]);
+         local = local && (it != gverts.end() && *it == lv[j]);
+         lv[j] = it - gverts.begin();
+      }
+      if (!local) { continue; }
+      int owner;
+      if (Dim == 1)
+      {
+         owner = vranks_J[vranks_I[lv[0]]];
+      }
+      else if (Dim == 2)
+      {
+         const int le = v_to_v(lv[0], lv[1]);
+         if (le < 0) { continue; }
+         owner = ledge_owner[le];
+      }
+      else
+      {
+         const int lf = FindFace(*faces_tbl, lv, nv);
+         if (lf < 0) { continue; }
+         owner = lface_owner[lf];
+      }
+      if (owner != MyRank) { continue; }
+      Element *be = NewElement(rec[1]);
+      be->SetAttribute(rec[0]);
+      be->SetVertices(lv);
+      boundary.Append(be);
+   }
+   NumOfBdrElements = boundary.Size();
+   delete faces_tbl;
+
+   // the boundary elements on the rank interfaces must not be generated
+   FinalizeTopology(false);
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   gtopo.Create(groups, 822);
+   MakeGroupTable(GetNGroups(), svert_group, group_svert);
+   MakeGroupTable(GetNGroups(), sedge_group, group_sedge);
+   MakeGroupTable(GetNGroups(), stria_group, group_stria);
+   MakeGroupTable(GetNGroups(), squad_group, group_squad);
+
+   const bool fix_orientation = false;
+   Finalize(refine, fix_orientation);
+
+   GatherAttributes(MyComm, attributes);
+   GatherAttributes(MyComm, bdr_attributes);
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
    : Mesh(orig_mesh, ref_factor, ref_type),
      MyComm(orig_mesh->GetComm()),
@@ -5135,7 +5913,7 @@ long ParMesh::ReduceInt(int value) const
    return global;
 }
 
-void ParMesh::ParPrint(ostream &out) const
+void ParMesh::ParPrint(ostream &out, bool binary) const
 {
    if (NURBSext || pncmesh)
    {
@@ -5144,10 +5922,18 @@ void ParMesh::ParPrint(ostream &out) const
       return;
    }
 
-   // Write out serial mesh.  Tell serial mesh to deliniate the end of it's
-   // output with 'mfem_serial_mesh_end' instead of 'mfem_mesh_end', as we will
-   // be adding additional parallel mesh information.
-   Printer(out, "mfem_serial_mesh_end");
+   if (binary)
+   {
+      // The binary mesh is self-delimiting, the parallel sections follow.
+      PrintBinary(out);
+   }
+   else
+   {
+      // Write out serial mesh.  Tell serial mesh to deliniate the end of it's
+      // output with 'mfem_serial_mesh_end' instead of 'mfem_mesh_end', as we
+      // will be adding additional parallel mesh information.
+      Printer(out, "mfem_serial_mesh_end");
+   }
 
    // write out group topology info.
    gtopo.Save(out);
@@ -208,6 +208,20 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /// Read a serial binary mesh file in parallel, without a global mesh.
+   /** The file, written by Mesh::PrintBinary(), is read in slices: each rank
+       reads a contiguous range of the elements, boundary elements and vertex
+       coordinates. If @a sfc_partitioning is true, the elements are then
+       redistributed along a Morton space-filling curve through their centers;
+       otherwise each rank keeps its slice. The shared entities and the
+       communication groups are found by exchanging data with the ranks that
+       read the corresponding vertices, so no rank holds more than a few
+       slices of the global mesh. Only conforming meshes without nodes are
+       supported; MFEM_VERIFY fails for nonconforming or curved meshes. The
+       @a refine parameter is passed to Finalize(). */
+   ParMesh(MPI_Comm comm, const char *filename, bool sfc_partitioning = true,
+           bool refine = true);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
@@ -326,7 +340,11 @@ public:
    virtual void PrintInfo(std::ostream &out = mfem::out);
 
    /// Save the mesh in a parallel mesh format.
-   void ParPrint(std::ostream &out) const;
+   /** If @a binary is true, the local mesh is written with Mesh::PrintBinary()
+       and is followed by the ascii parallel sections. ParMesh(MPI_Comm,
+       std::istream &) reads both versions. Nonconforming and NURBS meshes
+       are always written with Print(). */
+   void ParPrint(std::ostream &out, bool binary = false) const;
 
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
@@ -0,0 +1,242 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "vtk.hpp"
+#include "../general/binaryio.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef MFEM_USE_GZSTREAM
+#include <zlib.h>
+#endif
+
+namespace mfem
+{
+
+const int VTKDataWriter::BlockSize;
+
+VTKDataWriter::VTKDataWriter(std::ostream &out, VTKFormat format,
+                             int compression_level)
+   : out(out), null_out(NULL), format(format),
+     compression_level(compression_level), data_pass(false),
+     ncomp(1), count(0), size(0), nbytes(0), offset(0), fill(0),
+     b64_npending(0)
+{
+   MFEM_VERIFY(0 <= compression_level && compression_level <= 9,
+               "invalid compression level: " << compression_level);
+   MFEM_VERIFY(compression_level == 0 || format == VTKFormat::BINARY,
+               "compression requires the VTKFormat::BINARY format");
+#ifndef MFEM_USE_GZSTREAM
+   MFEM_VERIFY(compression_level == 0,
+               "compression requires MFEM_USE_GZSTREAM");
+#endif
+   if (format != VTKFormat::ASCII)
+   {
+      MFEM_VERIFY(bin_io::little_endian(),
+                  "binary VTK output requires a little-endian host");
+      block.resize(BlockSize);
+   }
+}
+
+void VTKDataWriter::BeginFile(const char *type)
+{
+   file_type = type;
+   out << "<VTKFile type=\"" << type << "\" version=\"0.1\""
+       << " byte_order=\"LittleEndian\"";
+   if (compression_level > 0)
+   {
+      out << " header_type=\"UInt32\" compressor=\"vtkZLibDataCompressor\"";
+   }
+   out << ">\n<" << type << ">\n";
+}
+
+void VTKDataWriter::BeginArray(const char *type, const char *name, int ncomp,
+                               std::size_t n, std::size_t value_size)
+{
+   this->ncomp = ncomp;
+   count = 0;
+   size = n;
+   nbytes = n*value_size;
+   MFEM_VERIFY(format == VTKFormat::ASCII || nbytes <= UINT32_MAX,
+               "DataArray " << (name ? name : type) << " is too large");
+
+   if (!data_pass)
+   {
+      static const char *format_name[] = { "ascii", "binary", "appended" };
+      out << "<DataArray type=\"" << type << "\"";
+      if (name) { out << " Name=\"" << name << "\""; }
+      out << " NumberOfComponents=\"" << ncomp << "\" format=\""
+          << format_name[(int) format] << "\"";
+      if (format == VTKFormat::APPENDED)
+      {
+         out << " offset=\"" << offset << "\"/>\n";
+         offset += sizeof(uint32_t) + nbytes;
+         return;
+      }
+      out << ">\n";
+   }
+
+   // Uncompressed binary data is preceded by its size in bytes; compressed
+   // data gets its header in EndArray().
+   if (format != VTKFormat::ASCII && compression_level == 0)
+   {
+      const uint32_t header = nbytes;
+      WriteBytes(&header, sizeof(header), 1);
+      count = 0;
+   }
+}
+
+void VTKDataWriter::WriteBytes(const void *data, std::size_t value_size,
+                               std::size_t n)
+{
+   const char *bytes = (const char *) data;
+   std::size_t len = value_size*n;
+   while (len > 0)
+   {
+      // full blocks are flushed lazily so that only the last one is partial
+      if (fill == (std::size_t) BlockSize) { FlushBlock(); }
+      const std::size_t m = std::min(len, BlockSize - fill);
+      std::memcpy(&block[fill], bytes, m);
+      fill += m;
+      bytes += m;
+      len -= m;
+   }
+   count += n;
+}
+
+void VTKDataWriter::FlushBlock()
+{
+   if (fill == 0) { return; }
+   if (format == VTKFormat::APPENDED)
+   {
+      out.write(&block[0], fill);
+   }
+   else if (compression_level > 0)
+   {
+#ifdef MFEM_USE_GZSTREAM
+      const std::size_t start = zdata.size();
+      uLongf zsize = compressBound(fill);
+      zdata.resize(start + zsize);
+      const int err = compress2(&zdata[start], &zsize,
+                                (const Bytef *) &block[0], fill,
+                                compression_level);
+      MFEM_VERIFY(err == Z_OK, "zlib compression failed");
+      zdata.resize(start + zsize);
+      zsizes.push_back(zsize);
+#endif
+   }
+   else
+   {
+      EncodeBase64((const unsigned char *) &block[0], fill);
+   }
+   fill = 0;
+}
+
+void VTKDataWriter::EndArray()
+{
+   MFEM_VERIFY(!WritesData() || count == size, "DataArray with " << size
+               << " values, " << count << " were written");
+   if (format == VTKFormat::ASCII)
+   {
+      if (count % ncomp) { out << '\n'; }
+      out << "</DataArray>\n";
+      return;
+   }
+   if (!WritesData()) { return; }
+
+   FlushBlock();
+   if (format == VTKFormat::APPENDED) { return; }
+
+   if (compression_level > 0)
+   {
+      // header: number of blocks, block size, size of the last partial block
+      // (zero if the last block is full) and the compressed block sizes
+      std::vector<uint32_t> header(3 + zsizes.size());
+      header[0] = zsizes.size();
+      header[1] = BlockSize;
+      header[2] = nbytes % BlockSize;
+      std::copy(zsizes.begin(), zsizes.end(), header.begin() + 3);
+      EncodeBase64((const unsigned char *) header.data(),
+                   header.size()*sizeof(uint32_t));
+      FinishBase64();
+      EncodeBase64(zdata.data(), zdata.size());
+      zdata.clear();
+      zsizes.clear();
+   }
+   FinishBase64();
+   out << "\n</DataArray>\n";
+}
+
+bool VTKDataWriter::NextPass()
+{
+   if (format != VTKFormat::APPENDED || data_pass) { return false; }
+   out << "</" << file_type << ">\n<AppendedData encoding=\"raw\">\n_";
+   data_pass = true;
+   return true;
+}
+
+void VTKDataWriter::EndFile()
+{
+   if (format == VTKFormat::APPENDED)
+   {
+      out << "\n</AppendedData>\n";
+   }
+   else
+   {
+      out << "</" << file_type << ">\n";
+   }
+   out << "</VTKFile>\n";
+   out.flush();
+}
+
+static const char base64_chars[] =
+   "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void VTKDataWriter::EncodeBase64(const unsigned char *data, std::size_t len)
+{
+   char buf[1024];
+   int nbuf = 0;
+   for (std::size_t i = 0; i < len; i++)
+   {
+      b64_pending[b64_npending++] = data[i];
+      if (b64_npending < 3) { continue; }
+      const unsigned char *p = b64_pending;
+      buf[nbuf++] = base64_chars[p[0] >> 2];
+      buf[nbuf++] = base64_chars[((p[0] & 0x3) << 4) | (p[1] >> 4)];
+      buf[nbuf++] = base64_chars[((p[1] & 0xf) << 2) | (p[2] >> 6)];
+      buf[nbuf++] = base64_chars[p[2] & 0x3f];
+      b64_npending = 0;
+      if (nbuf == (int) sizeof(buf))
+      {
+         out.write(buf, nbuf);
+         nbuf = 0;
+      }
+   }
+   out.write(buf, nbuf);
+}
+
+void VTKDataWriter::FinishBase64()
+{
+   if (b64_npending == 0) { return; }
+   const int n = b64_npending;
+   std::fill(b64_pending + n, b64_pending + 3, 0);
+   const unsigned char *p = b64_pending;
+   char buf[4];
+   buf[0] = base64_chars[p[0] >> 2];
+   buf[1] = base64_chars[((p[0] & 0x3) << 4) | (p[1] >> 4)];
+   buf[2] = (n > 1) ? base64_chars[((p[1] & 0xf) << 2) | (p[2] >> 6)] : '=';
+   buf[3] = '=';
+   out.write(buf, 4);
+   b64_npending = 0;
+}
+
+} // namespace mfem
@@ -0,0 +1,198 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_VTK
+#define MFEM_VTK
+
+#include "../config/config.hpp"
+#include "../general/error.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+/// Data formats of the VTK XML files written by Mesh::PrintVTU() and
+/// ParaViewDataCollection.
+enum class VTKFormat
+{
+   /// Text data inside the DataArray elements.
+   ASCII,
+   /// Base64-encoded data inside the DataArray elements, optionally
+   /// zlib-compressed.
+   BINARY,
+   /// Raw binary data in the AppendedData section at the end of the file.
+   APPENDED
+};
+
+/// Names of the VTK DataArray types corresponding to C++ types.
+template <typename T> struct VTKType;
+
+template <> struct VTKType<double>
+{ static const char *Name() { return "Float64"; } };
+
+template <> struct VTKType<int>
+{ static const char *Name() { return "Int32"; } };
+
+template <> struct VTKType<unsigned char>
+{ static const char *Name() { return "UInt8"; } };
+
+/** @brief Writer of the markup and the DataArray elements of a VTK XML file
+    in one of the formats listed in VTKFormat.
+
+    The values of each array are streamed to the output with Write(), in blocks
+    of BlockSize bytes, without building the array in memory. In the
+    VTKFormat::APPENDED format the file is written in two passes over the same
+    sequence of arrays: the first pass writes the markup, with the offsets of
+    the arrays computed from their declared sizes, and the second pass writes
+    the raw data in the AppendedData section. Typical usage:
+
+    @code
+    VTKDataWriter writer(out, format);
+    writer.BeginFile("UnstructuredGrid");
+    do
+    {
+       writer.Markup() << "<Piece ...>\n";
+       writer.BeginArray<double>("x", 1, n);
+       if (writer.WritesData()) { writer.Write(x, n); }
+       writer.EndArray();
+       writer.Markup() << "</Piece>\n";
+    }
+    while (writer.NextPass());
+    writer.EndFile();
+    @endcode */
+class VTKDataWriter
+{
+public:
+   /// Size in bytes of the blocks in which binary data is written (and
+   /// compressed).
+   static const int BlockSize = 32768;
+
+   /** @brief Create a writer of the given @a format to the stream @a out,
+       which should be opened in binary mode for the binary formats.
+
+       A @a compression_level between 1 and 9 compresses the data with zlib.
+       Compression is supported only in the VTKFormat::BINARY format and
+       requires MFEM_USE_GZSTREAM. */
+   VTKDataWriter(std::ostream &out, VTKFormat format,
+                 int compression_level = 0);
+
+   VTKFormat GetFormat() const { return format; }
+
+   /// Write the opening VTKFile and @a type (e.g. "UnstructuredGrid") tags.
+   void BeginFile(const char *type);
+
+   /** @brief Stream for the XML markup around the arrays. In the data pass of
+       the VTKFormat::APPENDED format the markup is discarded. */
+   std::ostream &Markup() { return data_pass ? null_out : out; }
+
+   /** @brief Return true if the values of the arrays must be written with
+       Write(), false in the markup pass of the VTKFormat::APPENDED format. */
+   bool WritesData() const
+   { return format != VTKFormat::APPENDED || data_pass; }
+
+   /** @brief Begin a DataArray with @a n values of type T, in tuples of
+       @a ncomp components. The @a name can be NULL. */
+   template <typename T>
+   void BeginArray(const char *name, int ncomp, std::size_t n)
+   { BeginArray(VTKType<T>::Name(), name, ncomp, n, sizeof(T)); }
+
+   /// Write the next value of the current array.
+   template <typename T>
+   void Write(T value)
+   {
+      MFEM_ASSERT(WritesData(), "no data is written in this pass");
+      if (format == VTKFormat::ASCII) { WriteText(value); return; }
+      if (fill + sizeof(T) <= (std::size_t) BlockSize)
+      {
+         std::memcpy(&block[fill], &value, sizeof(T));
+         fill += sizeof(T);
+         count++;
+      }
+      else
+      {
+         WriteBytes(&value, sizeof(T), 1);
+      }
+   }
+
+   /// Write the next @a n values of the current array.
+   template <typename T>
+   void Write(const T *values, std::size_t n)
+   {
+      MFEM_ASSERT(WritesData(), "no data is written in this pass");
+      if (format == VTKFormat::ASCII)
+      {
+         for (std::size_t i = 0; i < n; i++) { WriteText(values[i]); }
+         return;
+      }
+      WriteBytes(values, sizeof(T), n);
+   }
+
+   /// Finish the current array, checking that all its values were written.
+   void EndArray();
+
+   /** @brief Finish a pass over the arrays. Return true if another pass is
+       needed, i.e. after the markup pass of the VTKFormat::APPENDED format. */
+   bool NextPass();
+
+   /// Write the closing tags of the file.
+   void EndFile();
+
+private:
+   std::ostream &out;
+   std::ostream null_out; // discards the markup in the data pass
+   const VTKFormat format;
+   const int compression_level;
+   std::string file_type;
+   bool data_pass;
+
+   // current array: components, values written and expected, size in bytes
+   int ncomp;
+   std::size_t count, size, nbytes;
+   // offset of the next array in the AppendedData section
+   std::size_t offset;
+
+   // binary data block and its number of bytes
+   std::vector<char> block;
+   std::size_t fill;
+
+   // compressed blocks of the current array
+   std::vector<unsigned char> zdata;
+   std::vector<unsigned> zsizes;
+
+   // pending bytes of the base64 encoding
+   unsigned char b64_pending[3];
+   int b64_npending;
+
+   void BeginArray(const char *type, const char *name, int ncomp,
+                   std::size_t n, std::size_t value_size);
+
+   template <typename T>
+   void WriteText(T value)
+   {
+      out << value << ((++count % ncomp) ? ' ' : '\n');
+   }
+   void WriteText(unsigned char value) { WriteText<int>(value); }
+
+   void WriteBytes(const void *data, std::size_t value_size, std::size_t n);
+   void FlushBlock();
+
+   void EncodeBase64(const unsigned char *data, std::size_t len);
+   void FinishBase64();
+};
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_ASSEMBLY_TEST_UTILS
+#define MFEM_ASSEMBLY_TEST_UTILS
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+#include <cmath>
+
+// Common setup of the tests that compare the assembly levels, the batched
+// kernels and the device assembly of forms with the legacy assembly.
+namespace assembly_test_utils
+{
+
+inline double coeffFunction(const mfem::Vector& x)
+{
+   return 1.0 + x(0)*x(0) + x(1);
+}
+
+inline void vectorFunction(const mfem::Vector& x, mfem::Vector& v)
+{
+   for (int i = 0; i < v.Size(); i++) { v(i) = coeffFunction(x) + i; }
+}
+
+/// Perturb the nodes of the mesh so that the elements are not affine.
+inline void PerturbNodes(mfem::Mesh &mesh)
+{
+   mesh.EnsureNodes();
+   mfem::GridFunction *nodes = mesh.GetNodes();
+   for (int i = 0; i < nodes->Size(); i++)
+   {
+      (*nodes)(i) += 0.01 * std::sin(7.0 * i);
+   }
+}
+
+/// Cartesian mesh of the unit square/cube with @a ne elements in each
+/// direction and perturbed nodes.
+inline mfem::Mesh *MakePerturbedMesh(int dim, mfem::Element::Type type, int ne)
+{
+   mfem::Mesh *mesh;
+   if (dim == 2) { mesh = new mfem::Mesh(ne, ne, type, 1, 1.0, 1.0); }
+   else { mesh = new mfem::Mesh(ne, ne, ne, type, 1, 1.0, 1.0, 1.0); }
+   PerturbNodes(*mesh);
+   return mesh;
+}
+
+/** @brief Assemble @a a_ref with the legacy assembly and @a a_test with its
+    assembly level, and compare their actions and, if @a diag is true, their
+    diagonals. */
+inline void CompareWithLegacyAssembly(mfem::BilinearForm &a_ref,
+                                      mfem::BilinearForm &a_test,
+                                      bool diag = true)
+{
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_test.Assemble();
+
+   mfem::Array<int> ess_tdof_list;
+   mfem::OperatorHandle A_test;
+   a_test.FormSystemMatrix(ess_tdof_list, A_test);
+
+   const int size = a_ref.FESpace()->GetTrueVSize();
+   mfem::Vector x(size), y_ref(size), y_test(size);
+   x.Randomize(1);
+   a_ref.SpMat().Mult(x, y_ref);
+   A_test->Mult(x, y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Normlinf() < 1.e-12 * y_ref.Normlinf());
+
+   if (diag)
+   {
+      mfem::Vector diag_ref, diag_test(size);
+      a_ref.SpMat().GetDiag(diag_ref);
+      a_test.AssembleDiagonal(diag_test);
+      diag_test -= diag_ref;
+      REQUIRE(diag_test.Normlinf() < 1.e-12 * diag_ref.Normlinf());
+   }
+}
+
+} // namespace assembly_test_utils
+
+#endif
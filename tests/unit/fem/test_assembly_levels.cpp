@@ -0,0 +1,142 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include "assembly_test_utils.hpp"
+
+using namespace mfem;
+using namespace assembly_test_utils;
+
+namespace assembly_levels
+{
+
+// Compare the action (and the diagonal) of the given assembly level against the
+// legacy assembly, for diffusion + mass with a variable coefficient.
+void test_assembly_level(int dim, int order, AssemblyLevel assembly)
+{
+   const Element::Type type =
+      (dim == 2) ? Element::QUADRILATERAL : Element::HEXAHEDRON;
+   Mesh *mesh = MakePerturbedMesh(dim, type, 2);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient coeff(coeffFunction);
+
+   BilinearForm a_ref(&fes), a_test(&fes);
+   a_test.SetAssemblyLevel(assembly);
+   for (BilinearForm *a : { &a_ref, &a_test })
+   {
+      a->AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      a->AddDomainIntegrator(new MassIntegrator(coeff));
+   }
+   // the matrix-free action does not provide the diagonal
+   CompareWithLegacyAssembly(a_ref, a_test, assembly != AssemblyLevel::NONE);
+
+   delete mesh;
+}
+
+TEST_CASE("Element assembly", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_assembly_level(dim, order, AssemblyLevel::ELEMENT);
+      }
+   }
+}
+
+TEST_CASE("Full assembly", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_assembly_level(dim, order, AssemblyLevel::FULL);
+      }
+   }
+
+   SECTION("Reassembly reuses the sparsity pattern")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, 1, 1.0, 1.0);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      ConstantCoefficient one(1.0);
+
+      BilinearForm a_lf(&fes);
+      a_lf.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a_lf.Assemble();
+      a_lf.Finalize();
+
+      BilinearForm a_fa(&fes);
+      a_fa.SetAssemblyLevel(AssemblyLevel::FULL);
+      a_fa.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a_fa.Assemble();
+      const int *J = a_fa.SpMat().GetJ();
+      a_fa.Assemble();
+      REQUIRE(a_fa.SpMat().GetJ() == J);
+
+      SparseMatrix *diff = Add(1.0, a_fa.SpMat(), -1.0, a_lf.SpMat());
+      REQUIRE(diff->MaxNorm() < 1e-12);
+      delete diff;
+   }
+
+   SECTION("Unsupported forms use the legacy assembly")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, 1, 1.0, 1.0);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      FiniteElementSpace vfes(&mesh, &fec, 2);
+      ConstantCoefficient one(1.0);
+      Array<int> ess_tdof_list;
+
+      // static condensation, boundary integrators, vector space
+      for (int k = 0; k < 3; k++)
+      {
+         BilinearForm a_lf(k == 2 ? &vfes : &fes);
+         BilinearForm a_fa(k == 2 ? &vfes : &fes);
+         a_fa.SetAssemblyLevel(AssemblyLevel::FULL);
+         OperatorHandle A_lf, A_fa;
+         BilinearForm *forms[2] = { &a_lf, &a_fa };
+         OperatorHandle *ops[2] = { &A_lf, &A_fa };
+         for (int f = 0; f < 2; f++)
+         {
+            BilinearForm &a = *forms[f];
+            if (k == 0) { a.EnableStaticCondensation(); }
+            if (k == 2) { a.AddDomainIntegrator(new VectorMassIntegrator); }
+            else { a.AddDomainIntegrator(new DiffusionIntegrator(one)); }
+            if (k == 1) { a.AddBoundaryIntegrator(new MassIntegrator(one)); }
+            a.Assemble();
+            a.FormSystemMatrix(ess_tdof_list, *ops[f]);
+         }
+         REQUIRE(a_fa.StaticCondensationIsEnabled() == (k == 0));
+
+         SparseMatrix *diff = Add(1.0, *A_fa.As<SparseMatrix>(), -1.0,
+                                  *A_lf.As<SparseMatrix>());
+         REQUIRE(diff->MaxNorm() < 1e-12);
+         delete diff;
+      }
+   }
+}
+
+TEST_CASE("Matrix-free action", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_assembly_level(dim, order, AssemblyLevel::NONE);
+      }
+   }
+}
+
+} // namespace assembly_levels
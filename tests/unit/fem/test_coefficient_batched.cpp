@@ -0,0 +1,113 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include "assembly_test_utils.hpp"
+
+using namespace mfem;
+using namespace assembly_test_utils;
+
+namespace coefficient_batched
+{
+
+double tdCoeffFunction(const Vector& x, double t)
+{
+   return t*x(0) + x(1)*x(1);
+}
+
+// Compare the batched evaluation with the point-wise evaluation.
+void check_batched(Coefficient &Q, Mesh &mesh, const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   Vector qcoeff;
+   Q.EvalBatched(mesh, ir, qcoeff);
+   REQUIRE(qcoeff.Size() == nq * mesh.GetNE());
+
+   const double *h_qcoeff = qcoeff.HostRead();
+   double max_err = 0.0, max_val = 0.0;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         const double val = Q.Eval(T, ip);
+         max_err = std::max(max_err, std::abs(h_qcoeff[q + nq*e] - val));
+         max_val = std::max(max_val, std::abs(val));
+      }
+   }
+   REQUIRE(max_err <= 1.e-12 * max_val);
+}
+
+void test_coefficient_batched(int dim, Element::Type type, int order)
+{
+   Mesh *mesh = MakePerturbedMesh(dim, type, 3);
+   for (int e = 0; e < mesh->GetNE(); e++)
+   {
+      mesh->SetAttribute(e, 1 + e % 3);
+   }
+   mesh->SetAttributes();
+
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+
+   ConstantCoefficient constant(2.5);
+   check_batched(constant, *mesh, ir);
+
+   Vector values(3);
+   values(0) = 1.0; values(1) = -2.0; values(2) = 4.0;
+   PWConstCoefficient pw_constant(values);
+   check_batched(pw_constant, *mesh, ir);
+
+   FunctionCoefficient function(coeffFunction);
+   check_batched(function, *mesh, ir);
+
+   FunctionCoefficient td_function(tdCoeffFunction);
+   td_function.SetTime(0.5);
+   check_batched(td_function, *mesh, ir);
+
+   H1_FECollection h1_fec(order, dim);
+   L2_FECollection l2_fec(order, dim);
+   FiniteElementSpace h1_fes(mesh, &h1_fec), l2_fes(mesh, &l2_fec);
+   FiniteElementSpace vh1_fes(mesh, &h1_fec, dim, Ordering::byVDIM);
+   GridFunction h1_gf(&h1_fes), l2_gf(&l2_fes), vh1_gf(&vh1_fes);
+   FunctionCoefficient f(coeffFunction);
+   VectorFunctionCoefficient vf(dim, vectorFunction);
+   h1_gf.ProjectCoefficient(f);
+   l2_gf.ProjectCoefficient(f);
+   vh1_gf.ProjectCoefficient(vf);
+   GridFunctionCoefficient h1_gf_coeff(&h1_gf), l2_gf_coeff(&l2_gf);
+   GridFunctionCoefficient vh1_gf_coeff(&vh1_gf, dim);
+   check_batched(h1_gf_coeff, *mesh, ir);
+   check_batched(l2_gf_coeff, *mesh, ir);
+   check_batched(vh1_gf_coeff, *mesh, ir);
+
+   // the default implementation
+   ProductCoefficient product(function, pw_constant);
+   check_batched(product, *mesh, ir);
+
+   delete mesh;
+}
+
+TEST_CASE("Batched Coefficient Evaluation", "[Coefficient]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      test_coefficient_batched(2, Element::QUADRILATERAL, order);
+      test_coefficient_batched(2, Element::TRIANGLE, order);
+      test_coefficient_batched(3, Element::HEXAHEDRON, order);
+      test_coefficient_batched(3, Element::TETRAHEDRON, order);
+   }
+}
+
+} // namespace coefficient_batched
@@ -103,6 +103,52 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
          REQUIRE(rmdir("base_00005") == 0);
       }
 
+      SECTION("Binary MFEM format")
+      {
+         VisItDataCollection dc("base", mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterField("v", v);
+         dc.SetCycle(5);
+         dc.SetTime(8.0);
+
+         //Save the DataCollection in binary format and load it back
+         dc.SetPadDigits(5);
+         dc.SetBinary(true);
+         dc.Save();
+
+         VisItDataCollection dc_new("base");
+         dc_new.SetPadDigits(5);
+         dc_new.Load(dc.GetCycle());
+         Mesh* mesh_new = dc_new.GetMesh();
+         GridFunction *u_new = dc_new.GetField("u");
+         GridFunction *v_new = dc_new.GetField("v");
+         REQUIRE(mesh_new);
+         REQUIRE(u_new);
+         REQUIRE(v_new);
+         REQUIRE(dc.GetTime() == dc_new.GetTime());
+
+         //The binary format stores the data without loss of precision
+         REQUIRE(mesh->GetNE() == mesh_new->GetNE());
+         Vector vert, vert_diff;
+         mesh->GetVertices(vert);
+         mesh_new->GetVertices(vert_diff);
+         vert_diff -= vert;
+         REQUIRE(vert_diff.Normlinf() == 0.0);
+
+         Vector u_diff(*u_new), v_diff(*v_new);
+         u_diff -= *u;
+         v_diff -= *v;
+         REQUIRE(u_diff.Normlinf() == 0.0);
+         REQUIRE(v_diff.Normlinf() == 0.0);
+
+         //Cleanup all the files
+         REQUIRE(remove("base_00005.mfem_root") == 0);
+         REQUIRE(remove("base_00005/mesh.00000") == 0);
+         REQUIRE(remove("base_00005/u.00000") == 0);
+         REQUIRE(remove("base_00005/v.00000") == 0);
+         REQUIRE(rmdir("base_00005") == 0);
+      }
+
 #ifdef MFEM_USE_GZSTREAM
       SECTION("Compressed MFEM format")
       {
@@ -0,0 +1,90 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include "assembly_test_utils.hpp"
+
+using namespace mfem;
+using namespace assembly_test_utils;
+
+namespace linearform_ext
+{
+
+// Compare the batched assembly of the linear form integrators with the
+// element-by-element assembly.
+void test_linearform_ext(int dim, Element::Type type, int order, bool dg)
+{
+   Mesh *mesh = MakePerturbedMesh(dim, type, 2);
+
+   FiniteElementCollection *fec;
+   if (dg) { fec = new L2_FECollection(order, dim); }
+   else { fec = new H1_FECollection(order, dim); }
+   FiniteElementSpace fes(mesh, fec), vfes(mesh, fec, dim);
+   FunctionCoefficient coeff(coeffFunction);
+   ConstantCoefficient one(1.0);
+   VectorFunctionCoefficient vcoeff(dim, vectorFunction);
+   Array<int> bdr_marker(mesh->bdr_attributes.Max());
+   bdr_marker = 0;
+   bdr_marker[0] = 1;
+
+   LinearForm b(&fes), b_fa(&fes), vb(&vfes), vb_fa(&vfes);
+   b_fa.UseFastAssembly(true);
+   vb_fa.UseFastAssembly(true);
+   for (LinearForm *lf : { &b, &b_fa })
+   {
+      lf->AddDomainIntegrator(new DomainLFIntegrator(coeff));
+      lf->AddDomainIntegrator(new DomainLFIntegrator(one));
+      if (!dg)
+      {
+         lf->AddBoundaryIntegrator(new BoundaryLFIntegrator(coeff));
+         lf->AddBoundaryIntegrator(new BoundaryLFIntegrator(one), bdr_marker);
+      }
+   }
+   for (LinearForm *lf : { &vb, &vb_fa })
+   {
+      lf->AddDomainIntegrator(new VectorDomainLFIntegrator(vcoeff));
+   }
+   REQUIRE(b_fa.SupportsDevice());
+   REQUIRE(vb_fa.SupportsDevice());
+
+   for (int i = 0; i < 2; i++)
+   {
+      b.Assemble();
+      b_fa.Assemble();
+      b_fa -= b;
+      REQUIRE(b_fa.Normlinf() < 1.e-12 * b.Normlinf());
+
+      vb.Assemble();
+      vb_fa.Assemble();
+      vb_fa -= vb;
+      REQUIRE(vb_fa.Normlinf() < 1.e-12 * vb.Normlinf());
+   }
+
+   delete fec;
+   delete mesh;
+}
+
+TEST_CASE("LinearForm Fast Assembly", "[LinearForm]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      for (bool dg : { false, true })
+      {
+         test_linearform_ext(2, Element::QUADRILATERAL, order, dg);
+         test_linearform_ext(2, Element::TRIANGLE, order, dg);
+         test_linearform_ext(3, Element::HEXAHEDRON, order, dg);
+         test_linearform_ext(3, Element::TETRAHEDRON, order, dg);
+      }
+   }
+}
+
+} // namespace linearform_ext
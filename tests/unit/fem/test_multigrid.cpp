@@ -0,0 +1,148 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace multigrid
+{
+
+class DiffusionMultigrid : public GeometricMultigrid
+{
+protected:
+   ConstantCoefficient one;
+
+   virtual void AddIntegrators(BilinearForm &form)
+   {
+      form.AddDomainIntegrator(new DiffusionIntegrator(one));
+   }
+
+public:
+   DiffusionMultigrid(const FiniteElementSpaceHierarchy &fespaces)
+      : GeometricMultigrid(fespaces), one(1.0) { }
+};
+
+// Check that the transpose of the prolongations is their adjoint.
+void check_prolongations(const FiniteElementSpaceHierarchy &fespaces)
+{
+   for (int l = 1; l < fespaces.GetNumLevels(); l++)
+   {
+      const Operator &P = fespaces.GetProlongationAtLevel(l);
+      Vector x(P.Width()), y(P.Height()), Px(P.Height()), Pty(P.Width());
+      x.Randomize(1);
+      y.Randomize(2);
+      P.Mult(x, Px);
+      P.MultTranspose(y, Pty);
+      const double lhs = Px * y, rhs = x * Pty;
+      REQUIRE(std::abs(lhs - rhs) <= 1e-12 * std::abs(lhs));
+   }
+}
+
+// Solve a Poisson problem with multigrid preconditioned CG and compare with
+// the solution of the assembled system.
+void test_multigrid(int dim, int h_levels, const Array<int> &orders,
+                    Multigrid::CycleType cycle)
+{
+   Mesh *mesh;
+   if (dim == 2)
+   {
+      mesh = new Mesh(2, 2, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   }
+   else
+   {
+      mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+   }
+
+   H1_FECollection fec(orders[0], dim);
+   FiniteElementSpace *fes = new FiniteElementSpace(mesh, &fec);
+   FiniteElementSpaceHierarchy fespaces(mesh, fes, true, true);
+   for (int l = 0; l < h_levels; l++)
+   {
+      fespaces.AddUniformlyRefinedLevel();
+   }
+   for (int i = 1; i < orders.Size(); i++)
+   {
+      fespaces.AddOrderRefinedLevel(new H1_FECollection(orders[i], dim));
+   }
+   check_prolongations(fespaces);
+
+   FiniteElementSpace &fine_fes = fespaces.GetFinestFESpace();
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 1;
+
+   DiffusionMultigrid mg(fespaces);
+   mg.SetCycle(cycle, 1, 1);
+   mg.Setup(ess_bdr);
+   REQUIRE(mg.NumLevels() == fespaces.GetNumLevels());
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fine_fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fine_fes);
+   x = 0.0;
+
+   OperatorHandle A;
+   Vector X, B;
+   mg.FormFineLinearSystem(x, b, A, X, B);
+   CGSolver cg;
+   cg.SetRelTol(1e-12);
+   cg.SetMaxIter(100);
+   cg.SetOperator(*A);
+   cg.SetPreconditioner(mg);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(cg.GetNumIterations() < 20);
+   mg.RecoverFineFEMSolution(X, b, x);
+
+   // Reference solution with the assembled matrix
+   BilinearForm a(&fine_fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   Array<int> ess_tdof_list;
+   fine_fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   GridFunction x_ref(&fine_fes);
+   x_ref = 0.0;
+   SparseMatrix A_ref;
+   Vector X_ref, B_ref;
+   a.FormLinearSystem(ess_tdof_list, x_ref, b, A_ref, X_ref, B_ref);
+   DSmoother jacobi(A_ref);
+   PCG(A_ref, jacobi, B_ref, X_ref, -1, 2000, 1e-24, 0.0);
+   a.RecoverFEMSolution(X_ref, b, x_ref);
+
+   x -= x_ref;
+   REQUIRE(x.Normlinf() <= 1e-8 * x_ref.Normlinf());
+}
+
+TEST_CASE("Geometric Multigrid", "[Multigrid]")
+{
+   Array<int> h_orders(1), p_orders(3), hp_orders(2);
+   h_orders[0] = 2;
+   p_orders[0] = 1; p_orders[1] = 2; p_orders[2] = 4;
+   hp_orders[0] = 1; hp_orders[1] = 3;
+
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int c = 0; c < 2; c++)
+      {
+         Multigrid::CycleType cycle = (c == 0) ?
+                                      Multigrid::CycleType::VCYCLE :
+                                      Multigrid::CycleType::WCYCLE;
+         test_multigrid(dim, 2, h_orders, cycle);
+         test_multigrid(dim, 0, p_orders, cycle);
+         test_multigrid(dim, 1, hp_orders, cycle);
+      }
+   }
+}
+
+} // namespace multigrid
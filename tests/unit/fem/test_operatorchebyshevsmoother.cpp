@@ -0,0 +1,116 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace operatorchebyshevsmoother
+{
+
+// Compare the Chebyshev smoother applied to the partially assembled and to
+// the fully assembled diffusion operators, check the eigenvalue estimate and
+// the use of the smoother as a preconditioner in CG.
+void test_chebyshev(int dim, int order)
+{
+   const int ne = (dim == 2) ? 8 : 6;
+   Mesh *mesh;
+   if (dim == 2)
+   {
+      mesh = new Mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   }
+   else
+   {
+      mesh = new Mesh(ne, ne, ne, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+   }
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(mesh, &fec);
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 1;
+   fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   GridFunction x(&fespace), b(&fespace);
+   x = 0.0;
+   b = 1.0;
+
+   BilinearForm paform(&fespace);
+   paform.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   paform.AddDomainIntegrator(new DiffusionIntegrator(one));
+   paform.Assemble();
+   OperatorPtr A_pa;
+   Vector B, X;
+   paform.FormLinearSystem(ess_tdof_list, x, b, A_pa, X, B);
+   Vector diag(fespace.GetTrueVSize());
+   paform.AssembleDiagonal(diag);
+
+   BilinearForm faform(&fespace);
+   faform.AddDomainIntegrator(new DiffusionIntegrator(one));
+   faform.SetDiagonalPolicy(Matrix::DIAG_ONE);
+   faform.Assemble();
+   faform.Finalize();
+   OperatorPtr A_fa;
+   faform.FormLinearSystem(ess_tdof_list, x, b, A_fa, X, B);
+
+   // The estimate increases monotonically to the largest eigenvalue.
+   OperatorChebyshevSmoother pa_smoother(*A_pa, diag, ess_tdof_list, 3);
+   OperatorChebyshevSmoother ref_smoother(*A_pa, diag, ess_tdof_list, 3,
+                                          500, 0.0);
+   const double eig = pa_smoother.GetMaxEigenvalueEstimate();
+   const double ref_eig = ref_smoother.GetMaxEigenvalueEstimate();
+   REQUIRE(eig > 0.8 * ref_eig);
+   REQUIRE(eig <= ref_eig * (1.0 + 1e-12));
+
+   OperatorChebyshevSmoother fa_smoother(*A_fa, diag, ess_tdof_list, 3, 0);
+   fa_smoother.SetMaxEigenvalueEstimate(eig);
+   Vector xin(fespace.GetTrueVSize());
+   xin.Randomize();
+   Vector y_pa(xin.Size()), y_fa(xin.Size());
+   pa_smoother.Mult(xin, y_pa);
+   fa_smoother.Mult(xin, y_fa);
+   y_fa -= y_pa;
+   REQUIRE(y_fa.Normlinf() <= 1e-12 * y_pa.Normlinf());
+
+   // Chebyshev preconditioned CG takes fewer iterations than Jacobi.
+   OperatorJacobiSmoother jacobi(diag, ess_tdof_list);
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(500);
+   cg.SetOperator(*A_pa);
+   B.Randomize(1);
+   X = 0.0;
+   cg.SetPreconditioner(jacobi);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   const int jacobi_iter = cg.GetNumIterations();
+   X = 0.0;
+   cg.SetPreconditioner(pa_smoother);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(cg.GetNumIterations() < jacobi_iter);
+
+   delete mesh;
+}
+
+TEST_CASE("operatorchebyshevsmoother")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_chebyshev(dim, order);
+      }
+   }
+}
+
+} // namespace operatorchebyshevsmoother
@@ -0,0 +1,165 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include "assembly_test_utils.hpp"
+
+using namespace mfem;
+using namespace assembly_test_utils;
+
+namespace pa_dg_integrators
+{
+
+void velocityFunction(const Vector& x, Vector& v)
+{
+   v(0) = 1.0 + x(1);
+   v(1) = 0.5 - x(0)*x(0);
+   if (v.Size() == 3) { v(2) = x(0) - x(2); }
+}
+
+// Cartesian mesh of the unit square/cube in which the vertices of the elements
+// are ordered differently, so that the faces are seen with all kinds of
+// orientations from their two sides. The nodes are perturbed so that the
+// elements are not affine.
+Mesh *make_mesh(int dim)
+{
+   const int n = 3;
+   const int nv1 = n + 1;
+   const int nv = (dim == 2) ? nv1*nv1 : nv1*nv1*nv1;
+   const int ne = (dim == 2) ? n*n : n*n*n;
+   Mesh *mesh = new Mesh(dim, nv, ne);
+   for (int i = 0; i < nv; i++)
+   {
+      const double x[3] = { double(i % nv1)/n, double((i / nv1) % nv1)/n,
+                            double(i / (nv1*nv1))/n
+                          };
+      mesh->AddVertex(x);
+   }
+   const int rx[8] = { 3, 2, 6, 7, 0, 1, 5, 4 };
+   const int rz[8] = { 1, 2, 3, 0, 5, 6, 7, 4 };
+   for (int e = 0; e < ne; e++)
+   {
+      const int ex = e % n, ey = (e / n) % n, ez = e / (n*n);
+      const int v0 = ex + nv1*(ey + nv1*ez);
+      int v[8] = { v0, v0 + 1, v0 + nv1 + 1, v0 + nv1 };
+      for (int i = 0; i < 4; i++) { v[i + 4] = v[i] + nv1*nv1; }
+      int w[8];
+      for (int r = 0; r < e % 4; r++)
+      {
+         // rz restricted to the bottom face is the rotation of a quadrilateral
+         for (int i = 0; i < 8; i++) { w[i] = v[rz[i]]; }
+         std::copy(w, w + 8, v);
+      }
+      if (dim == 3 && e % 3 == 1)
+      {
+         for (int i = 0; i < 8; i++) { w[i] = v[rx[i]]; }
+         std::copy(w, w + 8, v);
+      }
+      if (dim == 2) { mesh->AddQuad(v); }
+      else { mesh->AddHex(v); }
+   }
+   mesh->FinalizeMesh();
+   PerturbNodes(*mesh);
+   return mesh;
+}
+
+enum class Integrator { DGTrace, DGDiffusion, DGDiffusionSymmetric };
+
+BilinearFormIntegrator *new_integrator(Integrator integ, int dim,
+                                       Coefficient &coeff,
+                                       VectorCoefficient &velocity)
+{
+   switch (integ)
+   {
+      case Integrator::DGTrace:
+         return new DGTraceIntegrator(coeff, velocity, 1.0, -0.5);
+      case Integrator::DGDiffusion:
+         return new DGDiffusionIntegrator(coeff, -1.0, (dim + 1.0)*(dim + 1.0));
+      case Integrator::DGDiffusionSymmetric:
+         return new DGDiffusionIntegrator(coeff, 1.0, 2.0);
+   }
+   return NULL;
+}
+
+// Compare the partially assembled action of a DG face integrator, and of its
+// transpose, with the ones of the legacy assembly.
+void test_pa_dg_integrator(int dim, int order, int btype, Integrator integ)
+{
+   Mesh *mesh = make_mesh(dim);
+   L2_FECollection fec(order, dim, btype);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient coeff(coeffFunction);
+   VectorFunctionCoefficient velocity(dim, velocityFunction);
+
+   BilinearForm a_ref(&fes), a_pa(&fes), at_pa(&fes);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   at_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   for (BilinearForm *a : { &a_ref, &a_pa, &at_pa })
+   {
+      BilinearFormIntegrator *fi = new_integrator(integ, dim, coeff, velocity);
+      BilinearFormIntegrator *bfi = new_integrator(integ, dim, coeff, velocity);
+      if (a == &at_pa)
+      {
+         fi = new TransposeIntegrator(fi);
+         bfi = new TransposeIntegrator(bfi);
+      }
+      a->AddInteriorFaceIntegrator(fi);
+      a->AddBdrFaceIntegrator(bfi);
+   }
+   CompareWithLegacyAssembly(a_ref, a_pa, false);
+
+   // the transposed integrators give the transpose of the legacy matrix
+   Array<int> ess_tdof_list;
+   OperatorHandle At_pa;
+   at_pa.Assemble();
+   at_pa.FormSystemMatrix(ess_tdof_list, At_pa);
+
+   Vector x(fes.GetTrueVSize()), y_ref(x.Size()), y_pa(x.Size());
+   x.Randomize(1);
+   a_ref.SpMat().MultTranspose(x, y_ref);
+   At_pa->Mult(x, y_pa);
+   y_pa -= y_ref;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y_ref.Normlinf());
+
+   delete mesh;
+}
+
+TEST_CASE("PA DG Trace", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_pa_dg_integrator(dim, order, BasisType::GaussLegendre,
+                               Integrator::DGTrace);
+      }
+   }
+   test_pa_dg_integrator(2, 2, BasisType::GaussLobatto, Integrator::DGTrace);
+}
+
+TEST_CASE("PA DG Diffusion", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_pa_dg_integrator(dim, order, BasisType::GaussLegendre,
+                               Integrator::DGDiffusion);
+         test_pa_dg_integrator(dim, order, BasisType::GaussLegendre,
+                               Integrator::DGDiffusionSymmetric);
+      }
+   }
+   test_pa_dg_integrator(3, 2, BasisType::GaussLobatto,
+                         Integrator::DGDiffusion);
+}
+
+} // namespace pa_dg_integrators
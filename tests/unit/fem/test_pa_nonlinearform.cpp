@@ -0,0 +1,113 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include "assembly_test_utils.hpp"
+
+using namespace mfem;
+using namespace assembly_test_utils;
+
+namespace pa_nonlinearform
+{
+
+// Deformed configuration
+void deformation(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(3.0*x(1)) + 0.02*x(0)*x(0);
+   y(1) += 0.04*cos(2.0*x(0)) - 0.03*x(1);
+   if (x.Size() == 3) { y(2) += 0.05*x(0)*x(1); }
+}
+
+double muFunction(const Vector &x)
+{
+   return 0.25 + 0.1*x(0);
+}
+
+// Compare the partially assembled action and gradient of a hyperelastic
+// NonlinearForm with the element-by-element assembly.
+void test_pa_hyperelastic(int dim, Element::Type type, int order, int model_id)
+{
+   Mesh *mesh = MakePerturbedMesh(dim, type, 2);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+
+   ConstantCoefficient K(1.5);
+   FunctionCoefficient mu(muFunction);
+   HyperelasticModel *model, *model_pa;
+   switch (model_id)
+   {
+      case 0:
+         model = new NeoHookeanModel(0.25, 1.5);
+         model_pa = new NeoHookeanModel(0.25, 1.5);
+         break;
+      case 1:
+         model = new NeoHookeanModel(mu, K);
+         model_pa = new NeoHookeanModel(mu, K);
+         break;
+      default:
+         model = new InverseHarmonicModel;
+         model_pa = new InverseHarmonicModel;
+   }
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+
+   NonlinearForm nlf(&fes), nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+   nlf_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model_pa));
+   nlf.SetEssentialBC(ess_bdr);
+   nlf_pa.SetEssentialBC(ess_bdr);
+   nlf_pa.Setup();
+
+   VectorFunctionCoefficient deform(dim, deformation);
+   GridFunction x(&fes), dx(&fes);
+   x.ProjectCoefficient(deform);
+   for (int i = 0; i < dx.Size(); i++) { dx(i) = std::cos(3.0 * i); }
+
+   Vector y(fes.GetTrueVSize()), y_pa(fes.GetTrueVSize());
+   nlf.Mult(x, y);
+   nlf_pa.Mult(x, y_pa);
+   y_pa -= y;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y.Normlinf());
+
+   Operator &grad = nlf.GetGradient(x);
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   REQUIRE(dynamic_cast<SparseMatrix*>(&grad_pa) == NULL);
+   grad.Mult(dx, y);
+   grad_pa.Mult(dx, y_pa);
+   y_pa -= y;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y.Normlinf());
+
+   delete model_pa;
+   delete model;
+   delete mesh;
+}
+
+TEST_CASE("PA Hyperelastic NonlinearForm", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 2; order++)
+   {
+      for (int model = 0; model < 3; model++)
+      {
+         test_pa_hyperelastic(2, Element::QUADRILATERAL, order, model);
+         test_pa_hyperelastic(2, Element::TRIANGLE, order, model);
+         test_pa_hyperelastic(3, Element::HEXAHEDRON, order, model);
+         test_pa_hyperelastic(3, Element::TETRAHEDRON, order, model);
+      }
+   }
+}
+
+} // namespace pa_nonlinearform
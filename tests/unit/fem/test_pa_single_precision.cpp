@@ -0,0 +1,157 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_single_precision
+{
+
+static Mesh *make_mesh(int dim)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 3, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+   // Curve the mesh so that the PA data is not constant
+   mesh->SetCurvature(2);
+   GridFunction &nodes = *mesh->GetNodes();
+   for (int i = 0; i < nodes.Size(); i++)
+   {
+      nodes(i) += 0.03 * sin(7.0 * nodes(i));
+   }
+   return mesh;
+}
+
+static void add_integrators(BilinearForm &a, Coefficient &q, bool sp)
+{
+   MassIntegrator *mass = new MassIntegrator(q);
+   DiffusionIntegrator *diff = new DiffusionIntegrator(q);
+   mass->SetSinglePrecisionPA(sp);
+   diff->SetSinglePrecisionPA(sp);
+   a.AddDomainIntegrator(mass);
+   a.AddDomainIntegrator(diff);
+}
+
+static double coeff_function(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+TEST_CASE("Single precision PA", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      for (int order = 1; order <= 4; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         FunctionCoefficient q(coeff_function);
+         BilinearForm a_dp(&fes), a_sp(&fes);
+         a_dp.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         a_sp.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         add_integrators(a_dp, q, false);
+         add_integrators(a_sp, q, true);
+         a_dp.Assemble();
+         a_sp.Assemble();
+
+         Array<int> empty;
+         OperatorPtr A_dp, A_sp;
+         a_dp.FormSystemMatrix(empty, A_dp);
+         a_sp.FormSystemMatrix(empty, A_sp);
+
+         const int n = A_dp->Height();
+         Vector x(n), y_dp(n), y_sp(n);
+         x.Randomize(1);
+         A_dp->Mult(x, y_dp);
+         A_sp->Mult(x, y_sp);
+         y_sp -= y_dp;
+         REQUIRE(y_sp.Normlinf() <= 1e-5 * y_dp.Normlinf());
+
+         MultiVector X(n, 3), Y_sp(n, 3);
+         X.Randomize(2);
+         A_sp->MultMulti(X, Y_sp);
+         Vector xj, yj;
+         for (int j = 0; j < 3; j++)
+         {
+            X.GetVector(j, xj);
+            Y_sp.GetVector(j, yj);
+            A_dp->Mult(xj, y_dp);
+            y_dp -= yj;
+            REQUIRE(y_dp.Normlinf() <= 1e-5 * yj.Normlinf());
+         }
+
+         Vector diag_dp(n), diag_sp(n);
+         a_dp.AssembleDiagonal(diag_dp);
+         a_sp.AssembleDiagonal(diag_sp);
+         diag_sp -= diag_dp;
+         REQUIRE(diag_sp.Normlinf() <= 1e-5 * diag_dp.Normlinf());
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("Iterative refinement", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      H1_FECollection fec(3, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+      FunctionCoefficient q(coeff_function);
+      BilinearForm a_dp(&fes), a_sp(&fes);
+      a_dp.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_sp.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      add_integrators(a_dp, q, false);
+      add_integrators(a_sp, q, true);
+      a_dp.Assemble();
+      a_sp.Assemble();
+      OperatorPtr A_dp, A_sp;
+      a_dp.FormSystemMatrix(ess_tdof_list, A_dp);
+      a_sp.FormSystemMatrix(ess_tdof_list, A_sp);
+
+      const int n = A_dp->Height();
+      Vector b(n), x(n), r(n);
+      b.Randomize(1);
+
+      // Inner CG in single precision with a loose tolerance
+      CGSolver inner;
+      inner.SetOperator(*A_sp);
+      inner.SetRelTol(1e-3);
+      inner.SetMaxIter(200);
+      inner.SetPrintLevel(-1);
+      inner.iterative_mode = false;
+
+      IterativeRefinementSolver ir;
+      ir.SetPreconditioner(inner);
+      ir.SetOperator(*A_dp);
+      ir.SetRelTol(1e-12);
+      ir.SetMaxIter(30);
+      ir.SetPrintLevel(-1);
+      ir.iterative_mode = false;
+      ir.Mult(b, x);
+      REQUIRE(ir.GetConverged());
+      REQUIRE(ir.GetNumIterations() > 1);
+
+      // The residual is far below the single precision accuracy
+      A_dp->Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-12 * b.Norml2());
+      delete mesh;
+   }
+}
+
+} // namespace pa_single_precision
@@ -0,0 +1,144 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+#include "assembly_test_utils.hpp"
+
+using namespace mfem;
+using namespace assembly_test_utils;
+
+namespace pa_vector_integrators
+{
+
+enum class Integrator { VectorDiffusion, Elasticity, ElasticityRatio };
+
+// Compare the partially assembled action and diagonal of a vector integrator
+// with the ones of the legacy assembly.
+void test_pa_vector_integrator(int dim, int order, Integrator integ)
+{
+   const Element::Type type =
+      (dim == 2) ? Element::QUADRILATERAL : Element::HEXAHEDRON;
+   Mesh *mesh = MakePerturbedMesh(dim, type, 2);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+   FunctionCoefficient coeff(coeffFunction);
+   ConstantCoefficient lambda(2.0);
+
+   BilinearForm a_ref(&fes), a_pa(&fes);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   for (BilinearForm *a : { &a_ref, &a_pa })
+   {
+      switch (integ)
+      {
+         case Integrator::VectorDiffusion:
+            a->AddDomainIntegrator(new VectorDiffusionIntegrator(coeff));
+            break;
+         case Integrator::Elasticity:
+            a->AddDomainIntegrator(new ElasticityIntegrator(lambda, coeff));
+            break;
+         case Integrator::ElasticityRatio:
+            a->AddDomainIntegrator(new ElasticityIntegrator(coeff, 1.5, 0.5));
+            break;
+      }
+   }
+   CompareWithLegacyAssembly(a_ref, a_pa);
+
+   delete mesh;
+}
+
+TEST_CASE("PA Vector Diffusion", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_pa_vector_integrator(dim, order, Integrator::VectorDiffusion);
+      }
+   }
+}
+
+TEST_CASE("PA Elasticity", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         test_pa_vector_integrator(dim, order, Integrator::Elasticity);
+         test_pa_vector_integrator(dim, order, Integrator::ElasticityRatio);
+      }
+   }
+}
+
+enum class VectorFEIntegrator { Mass, CurlCurl, DivDiv };
+
+// Same comparison for the integrators of Nedelec and Raviart-Thomas spaces on
+// hexahedral meshes.
+void test_pa_vectorfe_integrator(int order, bool hdiv, VectorFEIntegrator integ)
+{
+   const int dim = 3;
+   Mesh *mesh = MakePerturbedMesh(dim, Element::HEXAHEDRON, 2);
+   FiniteElementCollection *fec;
+   if (hdiv) { fec = new RT_FECollection(order - 1, dim); }
+   else { fec = new ND_FECollection(order, dim); }
+   FiniteElementSpace fes(mesh, fec);
+   FunctionCoefficient coeff(coeffFunction);
+
+   BilinearForm a_ref(&fes), a_pa(&fes);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   for (BilinearForm *a : { &a_ref, &a_pa })
+   {
+      switch (integ)
+      {
+         case VectorFEIntegrator::Mass:
+            a->AddDomainIntegrator(new VectorFEMassIntegrator(coeff));
+            break;
+         case VectorFEIntegrator::CurlCurl:
+            a->AddDomainIntegrator(new CurlCurlIntegrator(coeff));
+            break;
+         case VectorFEIntegrator::DivDiv:
+            a->AddDomainIntegrator(new DivDivIntegrator(coeff));
+            break;
+      }
+   }
+   CompareWithLegacyAssembly(a_ref, a_pa);
+
+   delete fec;
+   delete mesh;
+}
+
+TEST_CASE("PA Vector FE Mass", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      test_pa_vectorfe_integrator(order, false, VectorFEIntegrator::Mass);
+      test_pa_vectorfe_integrator(order, true, VectorFEIntegrator::Mass);
+   }
+}
+
+TEST_CASE("PA Curl Curl", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      test_pa_vectorfe_integrator(order, false, VectorFEIntegrator::CurlCurl);
+   }
+}
+
+TEST_CASE("PA Div Div", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      test_pa_vectorfe_integrator(order, true, VectorFEIntegrator::DivDiv);
+   }
+}
+
+} // namespace pa_vector_integrators
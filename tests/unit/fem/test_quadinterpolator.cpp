@@ -0,0 +1,95 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace quadinterpolator
+{
+
+// Check that MultTranspose() is the adjoint of Mult(), i.e. that
+// (Mult(x), w) = (x, MultTranspose(w)), and that the tensor and the non-tensor
+// evaluations of MultTranspose() agree.
+void test_quadinterp_transpose(int dim, Element::Type type, int order,
+                               int vdim, bool l2)
+{
+   const int ne = 2;
+   Mesh *mesh;
+   if (dim == 2) { mesh = new Mesh(ne, ne, type, 1, 1.0, 1.0); }
+   else { mesh = new Mesh(ne, ne, ne, type, 1, 1.0, 1.0, 1.0); }
+
+   FiniteElementCollection *fec;
+   if (l2) { fec = new L2_FECollection(order, dim, BasisType::GaussLobatto); }
+   else { fec = new H1_FECollection(order, dim); }
+   FiniteElementSpace fes(mesh, fec, vdim);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+   const Operator *R = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+
+   const int nq = ir.GetNPoints() * mesh->GetNE();
+   Vector x(R->Height()), x_t(R->Height()), x_f(R->Height());
+   Vector val(nq*vdim), der(nq*vdim*dim), det;
+   Vector w_val(nq*vdim), w_der(nq*vdim*dim);
+   x.Randomize(1);
+   w_val.Randomize(2);
+   w_der.Randomize(3);
+
+   const unsigned flags[3] =
+   {
+      QuadratureInterpolator::VALUES,
+      QuadratureInterpolator::DERIVATIVES,
+      QuadratureInterpolator::VALUES | QuadratureInterpolator::DERIVATIVES
+   };
+   for (int i = 0; i < 3; i++)
+   {
+      val = 0.0;
+      der = 0.0;
+      qi->Mult(x, flags[i], val, der, det);
+      const double lhs = (val * w_val) + (der * w_der);
+
+      qi->DisableTensorProducts(false);
+      qi->MultTranspose(flags[i], w_val, w_der, x_t);
+      const double rhs = x * x_t;
+      REQUIRE(std::abs(lhs - rhs) <= 1.e-12 * std::abs(lhs));
+
+      qi->DisableTensorProducts(true);
+      qi->MultTranspose(flags[i], w_val, w_der, x_f);
+      x_f -= x_t;
+      REQUIRE(x_f.Normlinf() <= 1.e-12 * x_t.Normlinf());
+   }
+   qi->DisableTensorProducts(false);
+
+   delete fec;
+   delete mesh;
+}
+
+TEST_CASE("QuadratureInterpolator MultTranspose", "[QuadratureInterpolator]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      for (int l2 = 0; l2 <= 1; l2++)
+      {
+         test_quadinterp_transpose(2, Element::QUADRILATERAL, order, 1, l2);
+         test_quadinterp_transpose(2, Element::QUADRILATERAL, order, 2, l2);
+         test_quadinterp_transpose(2, Element::TRIANGLE, order, 1, l2);
+         test_quadinterp_transpose(2, Element::TRIANGLE, order, 2, l2);
+         test_quadinterp_transpose(3, Element::HEXAHEDRON, order, 1, l2);
+         test_quadinterp_transpose(3, Element::HEXAHEDRON, order, 3, l2);
+         test_quadinterp_transpose(3, Element::TETRAHEDRON, order, 1, l2);
+         test_quadinterp_transpose(3, Element::TETRAHEDRON, order, 3, l2);
+      }
+   }
+}
+
+} // namespace quadinterpolator
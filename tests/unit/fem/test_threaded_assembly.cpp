@@ -0,0 +1,156 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace threaded_assembly
+{
+
+static double coeff(const Vector &x) { return 1.0 + x(0)*x(1); }
+
+// Element matrices and vectors computed with caller-owned transformations,
+// by multiple threads if OpenMP and MFEM_THREAD_SAFE are enabled, must match
+// the ones computed with the transformation owned by the mesh.
+TEST_CASE("Caller-owned element transformations", "[ElementTransformation]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   mesh.SetCurvature(2);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   const int NE = fes.GetNE();
+   const int nd = fes.GetFE(0)->GetDof();
+
+   FunctionCoefficient f(coeff);
+   DiffusionIntegrator diff(f);
+   VectorMassIntegrator vmass(f);
+   DomainLFIntegrator lf(f);
+   REQUIRE(diff.IsThreadSafe());
+   REQUIRE(vmass.IsThreadSafe());
+   REQUIRE(lf.IsThreadSafe());
+   // integrators that were not audited use the serial assembly
+   Vector one(2);
+   one = 1.0;
+   VectorConstantCoefficient v_one(one);
+   REQUIRE(!ConvectionIntegrator(v_one).IsThreadSafe());
+   // coefficients with work data use the serial assembly
+   GridFunction gf(&fes);
+   GridFunctionCoefficient gf_coeff(&gf);
+   ProductCoefficient prod(f, f);
+   REQUIRE(!DiffusionIntegrator(gf_coeff).IsThreadSafe());
+   REQUIRE(!MassIntegrator(prod).IsThreadSafe());
+   REQUIRE(!DomainLFIntegrator(prod).IsThreadSafe());
+
+   DenseTensor mats_ref(nd, nd, NE), mats(nd, nd, NE);
+   DenseTensor vmats_ref(2*nd, 2*nd, NE), vmats(2*nd, 2*nd, NE);
+   DenseMatrix vecs_ref(nd, NE), vecs(nd, NE);
+   for (int i = 0; i < NE; i++)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(i);
+      diff.AssembleElementMatrix(*fes.GetFE(i), T, mats_ref(i));
+      vmass.AssembleElementMatrix(*fes.GetFE(i), T, vmats_ref(i));
+      Vector v;
+      lf.AssembleRHSElementVect(*fes.GetFE(i), T, v);
+      vecs_ref.SetCol(i, v);
+   }
+
+   mesh.GetNodes()->HostRead();
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      IsoparametricTransformation T;
+      fes.GetElementTransformation(i, &T);
+      DenseMatrix elmat(mats.GetData(i), nd, nd);
+      diff.AssembleElementMatrix(*fes.GetFE(i), T, elmat);
+      DenseMatrix velmat(vmats.GetData(i), 2*nd, 2*nd);
+      vmass.AssembleElementMatrix(*fes.GetFE(i), T, velmat);
+      Vector v(vecs.GetColumn(i), nd);
+      lf.AssembleRHSElementVect(*fes.GetFE(i), T, v);
+   }
+
+   for (int i = 0; i < NE; i++)
+   {
+      DenseMatrix diff_mat(mats(i));
+      diff_mat -= mats_ref(i);
+      REQUIRE(diff_mat.MaxMaxNorm() == 0.0);
+      DenseMatrix vdiff_mat(vmats(i));
+      vdiff_mat -= vmats_ref(i);
+      REQUIRE(vdiff_mat.MaxMaxNorm() == 0.0);
+   }
+   vecs -= vecs_ref;
+   REQUIRE(vecs.MaxMaxNorm() == 0.0);
+}
+
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+
+// The threaded assembly of the domain integrators must give the same matrix
+// and vector as the serial assembly.
+TEST_CASE("Threaded assembly", "[BilinearForm][LinearForm]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(9, 9, Element::TRIANGLE, 1, 1.0, 1.0) :
+                   new Mesh(5, 5, 5, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+      mesh->SetCurvature(2);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec);
+
+      FunctionCoefficient f(coeff);
+      ConstantCoefficient two(2.0);
+      BilinearForm a_serial(&fes), a_threaded(&fes);
+      LinearForm b_serial(&fes), b_threaded(&fes);
+      BilinearForm *a[] = { &a_serial, &a_threaded };
+      LinearForm *b[] = { &b_serial, &b_threaded };
+      for (int k = 0; k < 2; k++)
+      {
+         a[k]->AddDomainIntegrator(new DiffusionIntegrator(f));
+         a[k]->AddDomainIntegrator(new MassIntegrator(two));
+         b[k]->AddDomainIntegrator(new DomainLFIntegrator(f));
+         b[k]->AddDomainIntegrator(new DomainLFIntegrator(two));
+      }
+      REQUIRE(!Device::Allows(Backend::OMP_MASK));
+      a_serial.Assemble();
+      a_serial.Finalize();
+      a_threaded.AssembleDomainThreaded();
+      a_threaded.Finalize();
+      b_serial.Assemble();
+      b_threaded = 0.0;
+      b_threaded.AssembleDomainThreaded();
+
+      const SparseMatrix &A_serial = a_serial.SpMat();
+      const SparseMatrix &A_threaded = a_threaded.SpMat();
+      const int n = A_serial.Height();
+      const int nnz = A_serial.NumNonZeroElems();
+      REQUIRE(A_threaded.NumNonZeroElems() == nnz);
+      for (int i = 0; i <= n; i++)
+      {
+         REQUIRE(A_threaded.GetI()[i] == A_serial.GetI()[i]);
+      }
+      for (int k = 0; k < nnz; k++)
+      {
+         REQUIRE(A_threaded.GetJ()[k] == A_serial.GetJ()[k]);
+         REQUIRE(A_threaded.GetData()[k] == A_serial.GetData()[k]);
+      }
+      b_threaded -= b_serial;
+      REQUIRE(b_threaded.Normlinf() == 0.0);
+
+      delete mesh;
+   }
+}
+
+#endif // MFEM_USE_OPENMP && MFEM_THREAD_SAFE
+
+} // namespace threaded_assembly
@@ -0,0 +1,99 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace cg_variants
+{
+
+static void solve(IterativeSolver &solver, const Operator &A, Solver *prec,
+                  const Vector &b, Vector &x)
+{
+   if (prec) { solver.SetPreconditioner(*prec); }
+   solver.SetOperator(A);
+   solver.SetRelTol(1e-10);
+   solver.SetAbsTol(0.0);
+   solver.SetMaxIter(1000);
+   solver.SetPrintLevel(-1);
+   x = 0.0;
+   solver.Mult(b, x);
+   REQUIRE(solver.GetConverged());
+}
+
+TEST_CASE("CG variants", "[CGSolver]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(4, 4, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+                   new Mesh(3, 3, 3, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+      H1_FECollection fec(3, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+      ConstantCoefficient one(1.0);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      OperatorPtr A;
+      a.FormSystemMatrix(ess_tdof_list, A);
+      Vector diag(fes.GetTrueVSize());
+      a.AssembleDiagonal(diag);
+      OperatorJacobiSmoother jacobi(diag, ess_tdof_list);
+
+      const int n = A->Height();
+      Vector b(n), x_ref(n), x(n), r(n);
+      b.Randomize(1);
+      for (int i = 0; i < ess_tdof_list.Size(); i++)
+      {
+         b(ess_tdof_list[i]) = 0.0;
+      }
+
+      for (int p = 0; p < 2; p++)
+      {
+         Solver *prec = p ? &jacobi : NULL;
+         CGSolver cg;
+         solve(cg, *A, prec, b, x_ref);
+
+         PipelinedCGSolver pcg;
+         ChronopoulosGearCGSolver cgcg;
+         IterativeSolver *solvers[2] = { &pcg, &cgcg };
+         for (int s = 0; s < 2; s++)
+         {
+            solve(*solvers[s], *A, prec, b, x);
+            // The same Krylov space as CG up to rounding
+            REQUIRE(std::abs(solvers[s]->GetNumIterations() -
+                             cg.GetNumIterations()) <= 1);
+            A->Mult(x, r);
+            r -= b;
+            REQUIRE(r.Norml2() <= 1e-8 * b.Norml2());
+            x -= x_ref;
+            REQUIRE(x.Normlinf() <= 1e-8 * x_ref.Normlinf());
+         }
+      }
+
+      // A zero right-hand side converges immediately
+      Vector zero(n);
+      zero = 0.0;
+      PipelinedCGSolver pcg;
+      solve(pcg, *A, &jacobi, zero, x);
+      REQUIRE(pcg.GetNumIterations() == 0);
+      REQUIRE(x.Normlinf() == 0.0);
+      delete mesh;
+   }
+}
+
+} // namespace cg_variants
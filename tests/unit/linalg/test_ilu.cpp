@@ -0,0 +1,172 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace ilu
+{
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v(0) = 1.0 + x(1);
+   v(1) = 0.5 - x(0);
+}
+
+// The matrix M - dt K of an implicit time step of the upwind DG
+// discretization of the advection equation, as in Example 9
+static SparseMatrix *advection_matrix(Mesh &mesh, int order)
+{
+   DG_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   const double dt = 1.0;
+   ConstantCoefficient one(1.0);
+   VectorFunctionCoefficient v(2, velocity);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.AddDomainIntegrator(new ConvectionIntegrator(v, dt));
+   a.AddInteriorFaceIntegrator(new DGTraceIntegrator(v, -dt, 0.5*dt));
+   a.AddBdrFaceIntegrator(new DGTraceIntegrator(v, -dt, 0.5*dt));
+   a.Assemble();
+   a.Finalize();
+   return a.LoseMat();
+}
+
+// Residual of the solution with ILU as a direct solver
+static double ilu_residual(const SparseMatrix &A, const ILUSmoother &ilu)
+{
+   Vector b(A.Height()), x(A.Height()), r(A.Height());
+   b.Randomize(1);
+   ilu.Mult(b, x);
+   A.Mult(x, r);
+   r -= b;
+   return r.Normlinf() / b.Normlinf();
+}
+
+static int gmres_iterations(const SparseMatrix &A, Solver &prec)
+{
+   Vector b(A.Height()), x(A.Height());
+   b.Randomize(2);
+   x = 0.0;
+   GMRESSolver gmres;
+   gmres.SetOperator(A);
+   gmres.SetPreconditioner(prec);
+   gmres.SetRelTol(1e-10);
+   gmres.SetMaxIter(500);
+   gmres.SetKDim(50);
+   gmres.SetPrintLevel(-1);
+   gmres.Mult(b, x);
+   REQUIRE(gmres.GetConverged());
+   return gmres.GetNumIterations();
+}
+
+TEST_CASE("ILUSmoother", "[ILUSmoother]")
+{
+   Mesh mesh(6, 6, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   SparseMatrix *A = advection_matrix(mesh, 2);
+   const int n = A->Height();
+
+   SECTION("Exact for tridiagonal matrices")
+   {
+      SparseMatrix T(n, n);
+      for (int i = 0; i < n; i++)
+      {
+         T.Add(i, i, 4.0 + i % 3);
+         if (i > 0) { T.Add(i, i-1, -1.0 - 0.1*(i % 5)); }
+         if (i < n-1) { T.Add(i, i+1, -2.0); }
+      }
+      T.Finalize();
+      ILUSmoother ilu(T);
+      REQUIRE(ilu.NumNonZeroElems() == T.NumNonZeroElems());
+      REQUIRE(ilu_residual(T, ilu) <= 1e-13);
+      // The wavefronts of a tridiagonal matrix are single rows
+      REQUIRE(ilu.NumLowerLevels() == n);
+      REQUIRE(ilu.NumUpperLevels() == n);
+   }
+
+   SECTION("Exact with full fill-in")
+   {
+      ILUSmoother ilu(*A, n);
+      REQUIRE(ilu.NumNonZeroElems() > A->NumNonZeroElems());
+      REQUIRE(ilu_residual(*A, ilu) <= 1e-12);
+   }
+
+   SECTION("Fill-in and wavefronts")
+   {
+      ILUSmoother ilu0(*A, 0), ilu1(*A, 1), ilu2(*A, 2);
+      REQUIRE(ilu0.NumNonZeroElems() == A->NumNonZeroElems());
+      REQUIRE(ilu1.NumNonZeroElems() > ilu0.NumNonZeroElems());
+      REQUIRE(ilu2.NumNonZeroElems() > ilu1.NumNonZeroElems());
+      REQUIRE(ilu0.NumLowerLevels() < n);
+      REQUIRE(ilu0.NumUpperLevels() < n);
+   }
+
+   SECTION("GMRES preconditioning")
+   {
+      DSmoother jacobi(*A);
+      ILUSmoother ilu0(*A, 0), ilu2(*A, 2);
+      const int it_jacobi = gmres_iterations(*A, jacobi);
+      const int it_ilu0 = gmres_iterations(*A, ilu0);
+      const int it_ilu2 = gmres_iterations(*A, ilu2);
+      REQUIRE(it_ilu0 < it_jacobi);
+      REQUIRE(it_ilu2 <= it_ilu0);
+   }
+
+   SECTION("Iterative mode")
+   {
+      ILUSmoother ilu(*A, 1);
+      Vector b(n), x(n), x_ref(n);
+      b.Randomize(3);
+      x.Randomize(4);
+      x_ref = x;
+      ilu.iterative_mode = true;
+      ilu.Mult(b, x);
+      // x_ref + (LU)^{-1} (b - A x_ref)
+      Vector r(n), c(n);
+      A->Mult(x_ref, r);
+      subtract(b, r, r);
+      ilu.iterative_mode = false;
+      ilu.Mult(r, c);
+      x_ref += c;
+      x -= x_ref;
+      REQUIRE(x.Normlinf() <= 1e-12 * x_ref.Normlinf());
+   }
+
+   SECTION("Reuse of the symbolic factorization")
+   {
+      ILUSmoother ilu(*A, 1);
+      Vector b(n), x(n), x2(n);
+      b.Randomize(5);
+      ilu.Mult(b, x);
+
+      // Change the values in place: the factors of 2 A are L and 2 U
+      *A *= 2.0;
+      ilu.SetOperator(*A);
+      ilu.Mult(b, x2);
+      x2 *= 2.0;
+      x2 -= x;
+      REQUIRE(x2.Normlinf() <= 1e-12 * x.Normlinf());
+
+      // A different pattern is factorized from scratch
+      SparseMatrix *B = advection_matrix(mesh, 1);
+      ilu.SetOperator(*B);
+      ILUSmoother ilu_ref(*B, 1);
+      REQUIRE(ilu.NumNonZeroElems() == ilu_ref.NumNonZeroElems());
+      REQUIRE(ilu_residual(*B, ilu) == ilu_residual(*B, ilu_ref));
+      delete B;
+   }
+
+   delete A;
+}
+
+} // namespace ilu
@@ -0,0 +1,229 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace multivector
+{
+
+// Compare MultMulti() with Mult() applied to every vector
+static void compare_multmulti(const Operator &op, int k)
+{
+   MultiVector X(op.Width(), k), Y(op.Height(), k);
+   X.Randomize(1);
+   Y = 0.0;
+   op.MultMulti(X, Y);
+   Vector x, y, y_ref(op.Height());
+   for (int j = 0; j < k; j++)
+   {
+      X.GetVector(j, x);
+      Y.GetVector(j, y);
+      op.Mult(x, y_ref);
+      y_ref -= y;
+      REQUIRE(y_ref.Normlinf() <= 1e-12 * y.Normlinf());
+   }
+}
+
+static Mesh *make_mesh(int dim)
+{
+   return (dim == 2) ?
+          new Mesh(3, 3, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+          new Mesh(2, 2, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+}
+
+TEST_CASE("MultiVector", "[MultiVector]")
+{
+   MultiVector X(5, 3), Y(5, 3);
+   REQUIRE(X.Size() == 15);
+   REQUIRE(X.VectorSize() == 5);
+   REQUIRE(X.NumVectors() == 3);
+   X.Randomize(1);
+   Y.Randomize(2);
+   MultiVector Y_ref(Y);
+   Vector a(3);
+   a(0) = 1.0; a(1) = -2.0; a(2) = 0.5;
+   Y.AddScaled(a, X);
+   Vector x, y, y_ref;
+   for (int j = 0; j < 3; j++)
+   {
+      X.GetVector(j, x);
+      Y.GetVector(j, y);
+      Y_ref.GetVector(j, y_ref);
+      y_ref.Add(a(j), x);
+      y_ref -= y;
+      REQUIRE(y_ref.Normlinf() == 0.0);
+   }
+   Y_ref = Y;
+   Y.ScaleAndAdd(a, X);
+   for (int j = 0; j < 3; j++)
+   {
+      X.GetVector(j, x);
+      Y.GetVector(j, y);
+      Y_ref.GetVector(j, y_ref);
+      y_ref *= a(j);
+      y_ref += x;
+      y_ref -= y;
+      REQUIRE(y_ref.Normlinf() == 0.0);
+   }
+}
+
+TEST_CASE("MultMulti", "[MultiVector]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      for (int order = 1; order <= (dim == 2 ? 6 : 3); order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+         Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+         ess_bdr = 1;
+         fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+         ConstantCoefficient one(1.0);
+
+         BilinearForm fa(&fes);
+         fa.AddDomainIntegrator(new DiffusionIntegrator(one));
+         fa.AddDomainIntegrator(new MassIntegrator(one));
+         fa.Assemble();
+         fa.Finalize();
+         // Numbers of vectors smaller and larger than the SparseMatrix chunk
+         compare_multmulti(fa.SpMat(), 3);
+         compare_multmulti(fa.SpMat(), 11);
+
+         BilinearForm pa(&fes);
+         pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         pa.AddDomainIntegrator(new DiffusionIntegrator(one));
+         pa.AddDomainIntegrator(new MassIntegrator(one));
+         pa.Assemble();
+         OperatorPtr A;
+         pa.FormSystemMatrix(ess_tdof_list, A);
+         compare_multmulti(*A, 4);
+      }
+
+      // Face integrators on a discontinuous space
+      DG_FECollection dg_fec(2, dim);
+      FiniteElementSpace dg_fes(mesh, &dg_fec);
+      ConstantCoefficient one(1.0);
+      Vector v(dim);
+      v = 1.0;
+      VectorConstantCoefficient velocity(v);
+      BilinearForm dg(&dg_fes);
+      dg.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      dg.AddDomainIntegrator(new MassIntegrator(one));
+      dg.AddInteriorFaceIntegrator(new DGTraceIntegrator(velocity, 1.0, -0.5));
+      dg.Assemble();
+      OperatorPtr A;
+      Array<int> empty;
+      dg.FormSystemMatrix(empty, A);
+      compare_multmulti(*A, 3);
+
+      // An integrator without a native MultMulti()
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace vfes(mesh, &fec, dim);
+      BilinearForm vd(&vfes);
+      vd.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      vd.AddDomainIntegrator(new VectorDiffusionIntegrator(one));
+      vd.Assemble();
+      vd.FormSystemMatrix(empty, A);
+      compare_multmulti(*A, 3);
+      delete mesh;
+   }
+}
+
+TEST_CASE("Batched Krylov solvers", "[MultiVector]")
+{
+   const int k = 5;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+      ConstantCoefficient one(1.0);
+      BilinearForm pa(&fes);
+      pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      pa.AddDomainIntegrator(new DiffusionIntegrator(one));
+      pa.Assemble();
+      OperatorPtr A;
+      pa.FormSystemMatrix(ess_tdof_list, A);
+      Vector diag(fes.GetTrueVSize());
+      pa.AssembleDiagonal(diag);
+      OperatorJacobiSmoother jacobi(diag, ess_tdof_list);
+
+      const int n = A->Height();
+      MultiVector B(n, k), X(n, k);
+      B.Randomize(1);
+      // The right-hand sides are scaled differently and the last one is zero
+      Vector b, x;
+      for (int j = 0; j < k; j++)
+      {
+         B.GetVector(j, b);
+         b *= pow(10.0, j);
+         for (int i = 0; i < ess_tdof_list.Size(); i++)
+         {
+            b(ess_tdof_list[i]) = 0.0;
+         }
+      }
+      B.GetVector(k-1, b);
+      b = 0.0;
+
+      BatchedCGSolver bcg;
+      CGSolver cg;
+      BatchedGMRESSolver bgmres;
+      GMRESSolver gmres;
+      IterativeSolver *solvers[4] = { &bcg, &cg, &bgmres, &gmres };
+      for (int s = 0; s < 4; s++)
+      {
+         solvers[s]->SetOperator(*A);
+         solvers[s]->SetPreconditioner(jacobi);
+         solvers[s]->SetRelTol(1e-12);
+         solvers[s]->SetAbsTol(0.0);
+         solvers[s]->SetMaxIter(500);
+         solvers[s]->SetPrintLevel(-1);
+         solvers[s]->iterative_mode = false;
+      }
+      bgmres.SetKDim(10);
+      gmres.SetKDim(10);
+
+      for (int s = 0; s < 4; s += 2)
+      {
+         X = 0.0;
+         solvers[s]->MultMulti(B, X);
+         REQUIRE(solvers[s]->GetConverged());
+         int max_iter = 0;
+         Vector r(n), x_ref(n);
+         for (int j = 0; j < k; j++)
+         {
+            B.GetVector(j, b);
+            X.GetVector(j, x);
+            A->Mult(x, r);
+            r -= b;
+            REQUIRE(r.Norml2() <= 1e-8 * std::max(b.Norml2(), 1e-300));
+
+            // The iterations of every vector are those of the single solve
+            solvers[s+1]->Mult(b, x_ref);
+            REQUIRE(solvers[s+1]->GetConverged());
+            max_iter = std::max(max_iter, solvers[s+1]->GetNumIterations());
+            x_ref -= x;
+            REQUIRE(x_ref.Normlinf() <= 1e-8 * std::max(x.Normlinf(), 1e-300));
+         }
+         REQUIRE(solvers[s]->GetNumIterations() == max_iter);
+      }
+      delete mesh;
+   }
+}
+
+} // namespace multivector
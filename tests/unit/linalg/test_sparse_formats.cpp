@@ -0,0 +1,133 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sparse_formats
+{
+
+// Assemble the elasticity matrix of a vector H1 space ordered byVDIM, whose
+// rows have different lengths at the boundary and inside the domain. The zero
+// entries are kept, so that the dim x dim blocks of the nodes are full.
+static SparseMatrix *elasticity_matrix(int dim, int order)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 4, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+                new Mesh(2, 3, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim, Ordering::byVDIM);
+   ConstantCoefficient lambda(1.0), mu(2.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.Assemble(0);
+   a.Finalize(0);
+   SparseMatrix *A = a.LoseMat();
+   delete mesh;
+   return A;
+}
+
+// Compare the products of op with those of the SparseMatrix A.
+static void compare_products(const SparseMatrix &A, const Operator &op)
+{
+   REQUIRE(op.Height() == A.Height());
+   REQUIRE(op.Width() == A.Width());
+   Vector x(A.Width()), y(A.Height()), y_ref(A.Height());
+   x.Randomize(1);
+   A.Mult(x, y_ref);
+   op.Mult(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+
+   Vector xt(A.Height()), yt(A.Width()), yt_ref(A.Width());
+   xt.Randomize(2);
+   A.MultTranspose(xt, yt_ref);
+   op.MultTranspose(xt, yt);
+   yt -= yt_ref;
+   REQUIRE(yt.Normlinf() <= 1e-12 * yt_ref.Normlinf());
+}
+
+TEST_CASE("BSRMatrix", "[BSRMatrix]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      SparseMatrix *A = elasticity_matrix(dim, 2);
+
+      // Block sizes smaller than, equal to and larger than the vector dim
+      const int block_sizes[3] = { 1, dim, 2*dim };
+      for (int i = 0; i < 3; i++)
+      {
+         const int bs = block_sizes[i];
+         if (A->Height() % bs) { continue; }
+         BSRMatrix B(*A, bs);
+         REQUIRE(B.GetBlockSize() == bs);
+         REQUIRE(B.NumStoredEntries() >= A->GetI()[A->Height()]);
+         compare_products(*A, B);
+
+         Vector x(A->Width()), y(A->Height()), y_ref(A->Height());
+         x.Randomize(3);
+         y.Randomize(4);
+         y_ref = y;
+         A->AddMult(x, y_ref, -0.5);
+         B.AddMult(x, y, -0.5);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+
+         SparseMatrix *C = B.ToSparseMatrix();
+         SparseMatrix *D = Add(1.0, *A, -1.0, *C);
+         REQUIRE(D->MaxNorm() == 0.0);
+         delete D;
+         delete C;
+      }
+      // With block size dim there is no fill in
+      BSRMatrix B(*A, dim);
+      REQUIRE(B.NumStoredEntries() == A->GetI()[A->Height()]);
+      delete A;
+   }
+}
+
+TEST_CASE("SELLMatrix", "[SELLMatrix]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      SparseMatrix *A = elasticity_matrix(dim, 2);
+      const int chunk_sizes[3] = { 4, 8, 5 };
+      for (int i = 0; i < 3; i++)
+      {
+         const int C = chunk_sizes[i];
+         for (int sigma = 1; sigma <= 16*C; sigma *= 16*C)
+         {
+            SELLMatrix S(*A, C, sigma);
+            REQUIRE(S.NumNonZeroElems() == A->GetI()[A->Height()]);
+            REQUIRE(S.NumStoredEntries() >= A->GetI()[A->Height()]);
+            compare_products(*A, S);
+
+            Vector x(A->Width()), y(A->Height()), y_ref(A->Height());
+            x.Randomize(3);
+            y.Randomize(4);
+            y_ref = y;
+            A->AddMult(x, y_ref, 2.0);
+            S.AddMult(x, y, 2.0);
+            y -= y_ref;
+            REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+         }
+      }
+
+      // Sorting the rows does not increase the padding
+      SELLMatrix S1(*A, 8, 1), S2(*A, 8, A->Height() + 8 - A->Height() % 8);
+      REQUIRE(S2.NumStoredEntries() <= S1.NumStoredEntries());
+      delete A;
+   }
+}
+
+} // namespace sparse_formats
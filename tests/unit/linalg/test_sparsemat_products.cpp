@@ -0,0 +1,158 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <cstdlib>
+
+using namespace mfem;
+
+namespace sparsemat_products
+{
+
+// Random m x n sparse matrix with about nnz_row entries per row
+static SparseMatrix *random_matrix(int m, int n, int nnz_row)
+{
+   SparseMatrix *A = new SparseMatrix(m, n);
+   for (int i = 0; i < m; i++)
+   {
+      for (int k = 0; k < nnz_row; k++)
+      {
+         A->Add(i, rand() % n, rand() / (double) RAND_MAX - 0.5);
+      }
+   }
+   A->Finalize();
+   return A;
+}
+
+static double dense_diff(const SparseMatrix &A, const DenseMatrix &B)
+{
+   REQUIRE(A.Height() == B.Height());
+   REQUIRE(A.Width() == B.Width());
+   DenseMatrix Ad;
+   A.ToDenseMatrix(Ad);
+   Ad -= B;
+   return Ad.MaxMaxNorm();
+}
+
+TEST_CASE("SparseMatrix products", "[SparseMatrix]")
+{
+   srand(1);
+   SparseMatrix *A = random_matrix(40, 30, 4);
+   SparseMatrix *B = random_matrix(30, 50, 3);
+   SparseMatrix *R = random_matrix(20, 40, 3);
+   SparseMatrix *S = random_matrix(40, 40, 5);
+   DenseMatrix Ad, Bd, Rd, Sd;
+   A->ToDenseMatrix(Ad);
+   B->ToDenseMatrix(Bd);
+   R->ToDenseMatrix(Rd);
+   S->ToDenseMatrix(Sd);
+
+   SECTION("Transpose")
+   {
+      SparseMatrix *At = Transpose(*A);
+      DenseMatrix Atd(Ad, 't');
+      REQUIRE(dense_diff(*At, Atd) == 0.0);
+      // The rows of At are sorted
+      const int *I = At->GetI(), *J = At->GetJ();
+      for (int i = 0; i < At->Height(); i++)
+      {
+         for (int j = I[i] + 1; j < I[i+1]; j++) { REQUIRE(J[j-1] < J[j]); }
+      }
+      delete At;
+
+      // Banded matrix with rows of very different lengths
+      SparseMatrix Band(200, 150);
+      for (int i = 0; i < Band.Height(); i++)
+      {
+         const int len = (i % 10 == 0) ? 20 : 2;
+         for (int k = 0; k < len; k++)
+         {
+            Band.Add(i, (3*i/4 + k) % Band.Width(), i + 0.5*k);
+         }
+      }
+      Band.Finalize();
+      DenseMatrix Bandd, Bandtd;
+      Band.ToDenseMatrix(Bandd);
+      Bandtd.Transpose(Bandd);
+      SparseMatrix *Bandt = Transpose(Band);
+      REQUIRE(dense_diff(*Bandt, Bandtd) == 0.0);
+      delete Bandt;
+   }
+
+   SECTION("Mult")
+   {
+      SparseMatrix *AB = Mult(*A, *B);
+      DenseMatrix ABd(A->Height(), B->Width());
+      Mult(Ad, Bd, ABd);
+      REQUIRE(dense_diff(*AB, ABd) <= 1e-14);
+
+      // Reuse the structure
+      *B *= 2.0;
+      Mult(*A, *B, AB);
+      ABd *= 2.0;
+      REQUIRE(dense_diff(*AB, ABd) <= 1e-14);
+      delete AB;
+   }
+
+   SECTION("RAP")
+   {
+      // R S R^T
+      SparseMatrix *RSRt = RAP(*S, *R);
+      DenseMatrix RS(R->Height(), S->Width()), RSRtd(R->Height());
+      Mult(Rd, Sd, RS);
+      MultABt(RS, Rd, RSRtd);
+      REQUIRE(dense_diff(*RSRt, RSRtd) <= 1e-14);
+
+      // Reuse the structure
+      *S *= -3.0;
+      RAP(*S, *R, RSRt);
+      RSRtd *= -3.0;
+      REQUIRE(dense_diff(*RSRt, RSRtd) <= 1e-14);
+      delete RSRt;
+
+      // A^T S A, the same as Mult(*Mult(At, S), A)
+      SparseMatrix *AtSA = RAP(*A, *S, *A);
+      SparseMatrix *At = Transpose(*A);
+      SparseMatrix *AtS = Mult(*At, *S);
+      SparseMatrix *AtSA_ref = Mult(*AtS, *A);
+      REQUIRE(AtSA->NumNonZeroElems() == AtSA_ref->NumNonZeroElems());
+      for (int k = 0; k < AtSA->NumNonZeroElems(); k++)
+      {
+         REQUIRE(AtSA->GetJ()[k] == AtSA_ref->GetJ()[k]);
+         REQUIRE(AtSA->GetData()[k] == AtSA_ref->GetData()[k]);
+      }
+      delete AtSA_ref;
+      delete AtS;
+      delete At;
+      delete AtSA;
+   }
+
+   SECTION("Mult_AtDA")
+   {
+      Vector D(A->Height());
+      D.Randomize(1);
+      SparseMatrix *AtDA = Mult_AtDA(*A, D);
+      DenseMatrix DA(Ad), AtDAd(A->Width());
+      DA.LeftScaling(D);
+      MultAtB(Ad, DA, AtDAd);
+      REQUIRE(dense_diff(*AtDA, AtDAd) <= 1e-14);
+      delete AtDA;
+   }
+
+   delete S;
+   delete R;
+   delete B;
+   delete A;
+}
+
+} // namespace sparsemat_products
@@ -0,0 +1,252 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sparsemat_symmetric
+{
+
+// Assemble the mass plus diffusion matrix of an H1 space into A, element by
+// element with AddSubMatrix()
+static void assemble(FiniteElementSpace &fes, SparseMatrix &A)
+{
+   ConstantCoefficient one(1.0);
+   MassIntegrator mass(one);
+   DiffusionIntegrator diff(one);
+   DenseMatrix elmat, elmat2;
+   Array<int> vdofs;
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      const FiniteElement &fe = *fes.GetFE(e);
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      mass.AssembleElementMatrix(fe, T, elmat);
+      diff.AssembleElementMatrix(fe, T, elmat2);
+      elmat += elmat2;
+      fes.GetElementVDofs(e, vdofs);
+      A.AddSubMatrix(vdofs, vdofs, elmat);
+   }
+   A.Finalize();
+}
+
+TEST_CASE("SparseMatrix symmetric storage", "[SparseMatrix]")
+{
+   Mesh mesh(3, 3, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   const int n = fes.GetVSize();
+
+   SparseMatrix A(n);
+   assemble(fes, A);
+   SparseMatrix S(A);
+   S.SetSymmetricStorage();
+   SparseMatrix Sa(n);
+   Sa.SetSymmetricStorage();
+   assemble(fes, Sa);
+
+   REQUIRE(S.HasSymmetricStorage());
+   REQUIRE(Sa.HasSymmetricStorage());
+   REQUIRE(S.NumNonZeroElems() == (A.NumNonZeroElems() + n) / 2);
+   REQUIRE(Sa.NumNonZeroElems() == S.NumNonZeroElems());
+
+   Vector x(n), b(n), y(n), y_ref(n);
+   x.Randomize(1);
+   b.Randomize(2);
+   SparseMatrix *mats[2] = { &S, &Sa };
+
+   SECTION("Mult")
+   {
+      for (int k = 0; k < 2; k++)
+      {
+         const SparseMatrix &M = *mats[k];
+         A.Mult(x, y_ref);
+         M.Mult(x, y);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+
+         A.MultTranspose(x, y_ref);
+         M.MultTranspose(x, y);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+
+         y_ref = 1.0;
+         A.AddMult(x, y_ref, 0.5);
+         y = 1.0;
+         M.AddMult(x, y, 0.5);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+      }
+   }
+
+   SECTION("Entries")
+   {
+      const int i = 0, j = A.GetRowColumns(0)[A.RowSize(0)-1];
+      Vector d, d_ref;
+      A.GetDiag(d_ref);
+      for (int k = 0; k < 2; k++)
+      {
+         const SparseMatrix &M = *mats[k];
+         M.GetDiag(d);
+         d -= d_ref;
+         REQUIRE(d.Normlinf() == 0.0);
+         REQUIRE(M(i, j) == A(i, j));
+         REQUIRE(M(j, i) == A(j, i));
+         REQUIRE(std::abs(M.InnerProduct(x, b) - A.InnerProduct(x, b)) <=
+                 1e-12 * std::abs(A.InnerProduct(x, b)));
+      }
+      Vector s(n), s_ref(n);
+      A.GetRowSums(s_ref);
+      S.GetRowSums(s);
+      s -= s_ref;
+      REQUIRE(s.Normlinf() <= 1e-12 * s_ref.Normlinf());
+      DenseMatrix D, D_ref;
+      A.ToDenseMatrix(D_ref);
+      S.ToDenseMatrix(D);
+      D -= D_ref;
+      REQUIRE(D.MaxMaxNorm() == 0.0);
+   }
+
+   SECTION("Smoothers")
+   {
+      for (int k = 0; k < 2; k++)
+      {
+         const SparseMatrix &M = *mats[k];
+         y_ref = x;
+         A.Gauss_Seidel_forw(b, y_ref);
+         y = x;
+         M.Gauss_Seidel_forw(b, y);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+
+         y_ref = x;
+         A.Gauss_Seidel_back(b, y_ref);
+         y = x;
+         M.Gauss_Seidel_back(b, y);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+
+         A.Jacobi(b, x, y_ref, 0.7);
+         M.Jacobi(b, x, y, 0.7);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+      }
+   }
+
+   SECTION("Elimination")
+   {
+      const int rc[2] = { 0, n/2 };
+      for (int k = 0; k < 2; k++)
+      {
+         SparseMatrix A2(A), M(*mats[k]);
+         Vector rhs(b), rhs_ref(b);
+         for (int r : rc)
+         {
+            A2.EliminateRowCol(r, x(r), rhs_ref, Matrix::DIAG_KEEP);
+            M.EliminateRowCol(r, x(r), rhs, Matrix::DIAG_KEEP);
+         }
+         rhs -= rhs_ref;
+         REQUIRE(rhs.Normlinf() <= 1e-12 * rhs_ref.Normlinf());
+         DenseMatrix D, D_ref;
+         A2.ToDenseMatrix(D_ref);
+         M.ToDenseMatrix(D);
+         D -= D_ref;
+         REQUIRE(D.MaxMaxNorm() == 0.0);
+
+         Array<int> rows(2);
+         rows[0] = rc[0];
+         rows[1] = rc[1];
+         SparseMatrix A3(A), M3(*mats[k]), Ae_ref(n), Ae(n);
+         for (int r : rc) { A3.EliminateRowCol(r, Ae_ref); }
+         M3.EliminateRowCols(rows, Ae);
+         Ae_ref.Finalize();
+         Ae.Finalize();
+         Ae_ref.Mult(x, y_ref);
+         Ae.Mult(x, y);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() <= 1e-12 * y_ref.Normlinf());
+         A3.PartMult(rows, x, y_ref);
+         M3.PartMult(rows, x, y);
+         REQUIRE(y(rc[0]) == y_ref(rc[0]));
+         REQUIRE(y(rc[1]) == y_ref(rc[1]));
+      }
+   }
+
+   SECTION("Solve")
+   {
+      GSSmoother gs(S);
+      CGSolver cg;
+      cg.SetOperator(S);
+      cg.SetPreconditioner(gs);
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(500);
+      cg.SetPrintLevel(-1);
+      y = 0.0;
+      cg.Mult(b, y);
+      REQUIRE(cg.GetConverged());
+      A.Mult(y, y_ref);
+      y_ref -= b;
+      REQUIRE(y_ref.Norml2() <= 1e-10 * b.Norml2());
+   }
+}
+
+// Eliminate essential boundary conditions with FormLinearSystem() and solve
+// with CG, with full and symmetric storage of the matrix.
+TEST_CASE("SparseMatrix symmetric storage FormLinearSystem", "[SparseMatrix]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   Vector sol[2];
+   for (int k = 0; k < 2; k++)
+   {
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+      GridFunction x(&fes);
+      x = 0.5;
+
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.AddDomainIntegrator(new MassIntegrator(one));
+      a.Assemble();
+      if (k == 1) { a.SpMat().SetSymmetricStorage(); }
+
+      OperatorHandle A;
+      Vector B, X;
+      a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+      SparseMatrix &Amat = *A.As<SparseMatrix>();
+      REQUIRE(Amat.HasSymmetricStorage() == (k == 1));
+
+      GSSmoother gs(Amat);
+      CGSolver cg;
+      cg.SetOperator(Amat);
+      cg.SetPreconditioner(gs);
+      cg.SetRelTol(1e-14);
+      cg.SetMaxIter(500);
+      cg.SetPrintLevel(-1);
+      cg.Mult(B, X);
+      REQUIRE(cg.GetConverged());
+      a.RecoverFEMSolution(X, b, x);
+      sol[k] = x;
+   }
+   REQUIRE(sol[0](0) == Approx(0.5));
+   sol[1] -= sol[0];
+   REQUIRE(sol[1].Normlinf() <= 1e-10 * sol[0].Normlinf());
+}
+
+} // namespace sparsemat_symmetric
@@ -0,0 +1,108 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace vector_fused
+{
+
+TEST_CASE("Fused vector kernels", "[Vector]")
+{
+   const int n = 1000;
+   const double a = 0.7, b = -1.3;
+   Vector x(n), y(n), w(n), p(n), r(n);
+   x.Randomize(1);
+   y.Randomize(2);
+   w.Randomize(3);
+   p.Randomize(4);
+   r.Randomize(5);
+
+   SECTION("AddAndDot")
+   {
+      Vector z(n), z_ref(n);
+      double dot = AddAndDot(x, a, y, z, w);
+      add(x, a, y, z_ref);
+      REQUIRE(std::abs(dot - z_ref * w) <= 1e-12 * std::abs(dot));
+      z_ref -= z;
+      REQUIRE(z_ref.Normlinf() == 0.0);
+
+      // In-place update and squared norm of the result
+      Vector x_ref(x);
+      x_ref.Add(a, y);
+      dot = AddAndDot(x, a, y, x, x);
+      REQUIRE(std::abs(dot - x_ref * x_ref) <= 1e-12 * dot);
+      x_ref -= x;
+      REQUIRE(x_ref.Normlinf() == 0.0);
+   }
+
+   SECTION("AddTwoAndDot")
+   {
+      Vector x_ref(x), r_ref(r);
+      x_ref.Add(a, p);
+      r_ref.Add(b, y);
+      const double dot = AddTwoAndDot(a, p, x, b, y, r, r);
+      REQUIRE(std::abs(dot - r_ref * r_ref) <= 1e-12 * dot);
+      x_ref -= x;
+      r_ref -= r;
+      REQUIRE(x_ref.Normlinf() == 0.0);
+      REQUIRE(r_ref.Normlinf() == 0.0);
+   }
+}
+
+TEST_CASE("Krylov solvers with fused kernels", "[Vector]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   SparseMatrix A;
+   Vector b(fes.GetVSize()), x(fes.GetVSize()), r(fes.GetVSize());
+   b.Randomize(1);
+   x = 0.0;
+   Vector X, B;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   DSmoother jacobi(A);
+
+   CGSolver cg;
+   MINRESSolver minres;
+   BiCGSTABSolver bicgstab;
+   IterativeSolver *solvers[3] = { &cg, &minres, &bicgstab };
+   for (int s = 0; s < 3; s++)
+   {
+      for (int p = 0; p < 2; p++)
+      {
+         if (p) { solvers[s]->SetPreconditioner(jacobi); }
+         solvers[s]->SetOperator(A);
+         solvers[s]->SetRelTol(1e-10);
+         solvers[s]->SetAbsTol(0.0);
+         solvers[s]->SetMaxIter(1000);
+         solvers[s]->SetPrintLevel(-1);
+         X = 0.0;
+         solvers[s]->Mult(B, X);
+         REQUIRE(solvers[s]->GetConverged());
+         r.SetSize(X.Size());
+         A.Mult(X, r);
+         r -= B;
+         REQUIRE(r.Norml2() <= 1e-8 * B.Norml2());
+      }
+   }
+}
+
+} // namespace vector_fused
@@ -0,0 +1,145 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "general/binaryio.hpp"
+#include "catch.hpp"
+
+#include <sstream>
+
+using namespace mfem;
+
+namespace mesh_binary
+{
+
+static std::string ascii(const Mesh &mesh)
+{
+   std::ostringstream out;
+   out.precision(16);
+   mesh.Print(out);
+   return out.str();
+}
+
+// Write the mesh in binary and ascii formats, load both back and compare the
+// ascii output of the loaded meshes.
+static void check_round_trip(const Mesh &mesh)
+{
+   std::stringstream stream, ascii_stream(ascii(mesh));
+   mesh.PrintBinary(stream);
+   stream << "trailing data";
+
+   Mesh loaded(stream, 1, 0, false);
+   Mesh loaded_ascii(ascii_stream, 1, 0, false);
+   REQUIRE(ascii(loaded) == ascii(loaded_ascii));
+
+   // the stream is left right after the mesh
+   std::string rest;
+   std::getline(stream, rest);
+   REQUIRE(rest == "trailing data");
+}
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   SECTION("Conforming meshes")
+   {
+      const Element::Type types[] = { Element::TRIANGLE,
+                                      Element::QUADRILATERAL,
+                                      Element::TETRAHEDRON,
+                                      Element::HEXAHEDRON
+                                    };
+      for (Element::Type type : types)
+      {
+         const bool dim3 = type >= Element::TETRAHEDRON;
+         Mesh *mesh = dim3 ? new Mesh(2, 2, 2, type, true, 1.0, 2.0, 3.0) :
+                      new Mesh(3, 2, type, true, 1.0, 2.0);
+         for (int i = 0; i < mesh->GetNE(); i++)
+         {
+            mesh->SetAttribute(i, 1 + i % 3);
+         }
+         mesh->SetAttributes();
+         check_round_trip(*mesh);
+
+         mesh->SetCurvature(3);
+         check_round_trip(*mesh);
+         delete mesh;
+      }
+   }
+
+   SECTION("Nonconforming mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      mesh.EnsureNCMesh();
+      Array<Refinement> refs;
+      refs.Append(Refinement(0, 7));
+      refs.Append(Refinement(3, 1));
+      mesh.GeneralRefinement(refs);
+      refs.SetSize(0);
+      refs.Append(Refinement(1, 6));
+      mesh.GeneralRefinement(refs);
+      check_round_trip(mesh);
+   }
+}
+
+// Parallel loading reads slices of the sections of a mesh file, in any order.
+TEST_CASE("Binary file random access", "[Mesh]")
+{
+   Mesh mesh(3, 2, Element::QUADRILATERAL, true, 1.0, 2.0);
+   std::stringstream stream;
+   stream << "leading data\n";
+   mesh.PrintBinary(stream);
+
+   std::string header;
+   std::getline(stream, header); // leading data
+   std::getline(stream, header);
+   REQUIRE(header == "MFEM binary mesh v1.0");
+   bin_io::BinaryReader reader(stream, header.size() + 1);
+
+   double x[2];
+   reader.SeekSection("vertices", 5*sizeof(x));
+   reader.Read(x, 2);
+   REQUIRE(x[0] == mesh.GetVertex(5)[0]);
+   REQUIRE(x[1] == mesh.GetVertex(5)[1]);
+
+   int v[4];
+   reader.SeekSection("elem_vert", 4*sizeof(v));
+   reader.Read(v, 4);
+   for (int j = 0; j < 4; j++)
+   {
+      REQUIRE(v[j] == mesh.GetElement(4)->GetVertices()[j]);
+   }
+
+   int dims[5];
+   reader.SeekSection("dimensions");
+   reader.Read(dims, 5);
+   REQUIRE(dims[2] == mesh.GetNV());
+   REQUIRE(dims[3] == mesh.GetNE());
+}
+
+TEST_CASE("Binary grid function format", "[GridFunction]")
+{
+   Mesh mesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+   GridFunction x(&fes);
+   x.Randomize(1);
+
+   std::stringstream stream;
+   x.SaveBinary(stream);
+   GridFunction y(&mesh, stream);
+
+   REQUIRE(std::string(y.FESpace()->FEColl()->Name()) == fec.Name());
+   REQUIRE(y.FESpace()->GetVDim() == 2);
+   REQUIRE(y.FESpace()->GetOrdering() == Ordering::byVDIM);
+   y -= x;
+   REQUIRE(y.Normlinf() == 0.0);
+}
+
+} // namespace mesh_binary
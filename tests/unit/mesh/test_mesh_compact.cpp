@@ -0,0 +1,174 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <sstream>
+
+using namespace mfem;
+
+namespace mesh_compact
+{
+
+// Compare the connectivity of a mesh with compact element storage to the one
+// of the same mesh with the default storage.
+static void compare(Mesh &ref, Mesh &mesh)
+{
+   REQUIRE(mesh.HasCompactElementStorage());
+   REQUIRE(mesh.GetNE() == ref.GetNE());
+   REQUIRE(mesh.GetNEdges() == ref.GetNEdges());
+   REQUIRE(mesh.GetNumFaces() == ref.GetNumFaces());
+
+   Array<int> v, v_ref, f, f_ref, o, o_ref;
+   DenseMatrix pm, pm_ref;
+   for (int i = 0; i < ref.GetNE(); i++)
+   {
+      mesh.GetElementVertices(i, v);
+      ref.GetElementVertices(i, v_ref);
+      REQUIRE(v == v_ref);
+      REQUIRE(mesh.GetAttribute(i) == ref.GetAttribute(i));
+      REQUIRE(mesh.GetElementBaseGeometry(i) == ref.GetElementBaseGeometry(i));
+      REQUIRE(mesh.GetElementType(i) == ref.GetElementType(i));
+      mesh.GetPointMatrix(i, pm);
+      ref.GetPointMatrix(i, pm_ref);
+      pm -= pm_ref;
+      REQUIRE(pm.MaxMaxNorm() == 0.0);
+      mesh.GetElementEdges(i, f, o);
+      ref.GetElementEdges(i, f_ref, o_ref);
+      REQUIRE(f == f_ref);
+      REQUIRE(o == o_ref);
+      if (ref.Dimension() == 3)
+      {
+         mesh.GetElementFaces(i, f, o);
+         ref.GetElementFaces(i, f_ref, o_ref);
+         REQUIRE(f == f_ref);
+         REQUIRE(o == o_ref);
+      }
+   }
+   for (int i = 0; i < ref.GetNumFaces(); i++)
+   {
+      int e1, e2, e1_ref, e2_ref, i1, i2, i1_ref, i2_ref;
+      mesh.GetFaceElements(i, &e1, &e2);
+      ref.GetFaceElements(i, &e1_ref, &e2_ref);
+      mesh.GetFaceInfos(i, &i1, &i2);
+      ref.GetFaceInfos(i, &i1_ref, &i2_ref);
+      REQUIRE(e1 == e1_ref);
+      REQUIRE(e2 == e2_ref);
+      REQUIRE(i1 == i1_ref);
+      REQUIRE(i2 == i2_ref);
+   }
+
+   std::ostringstream out, out_ref;
+   mesh.Print(out);
+   ref.Print(out_ref);
+   REQUIRE(out.str() == out_ref.str());
+   out.str("");
+   out_ref.str("");
+   mesh.PrintBinary(out);
+   ref.PrintBinary(out_ref);
+   REQUIRE(out.str() == out_ref.str());
+   REQUIRE(mesh.HasCompactElementStorage());
+}
+
+// Assemble a mass matrix on both meshes and compare the results.
+static void compare_assembly(Mesh &ref, Mesh &mesh)
+{
+   H1_FECollection fec(2, ref.Dimension());
+   FiniteElementSpace fes(&mesh, &fec), fes_ref(&ref, &fec);
+   REQUIRE(fes.GetVSize() == fes_ref.GetVSize());
+   BilinearForm m(&fes), m_ref(&fes_ref);
+   m.AddDomainIntegrator(new MassIntegrator);
+   m_ref.AddDomainIntegrator(new MassIntegrator);
+   m.Assemble();
+   m_ref.Assemble();
+   m.Finalize();
+   m_ref.Finalize();
+   SparseMatrix diff(m.SpMat());
+   diff.Add(-1.0, m_ref.SpMat());
+   REQUIRE(diff.MaxNorm() < 1e-14);
+   REQUIRE(mesh.HasCompactElementStorage());
+}
+
+TEST_CASE("Compact element storage", "[Mesh]")
+{
+   const Element::Type types[] = { Element::TRIANGLE, Element::QUADRILATERAL,
+                                   Element::TETRAHEDRON, Element::WEDGE,
+                                   Element::HEXAHEDRON
+                                 };
+   for (Element::Type type : types)
+   {
+      const bool dim3 = type >= Element::TETRAHEDRON;
+      Mesh *ref_ptr = dim3 ? new Mesh(2, 2, 2, type, true) :
+                      new Mesh(3, 3, type, true);
+      Mesh &ref = *ref_ptr;
+      for (int i = 0; i < ref.GetNE(); i++)
+      {
+         ref.SetAttribute(i, 1 + i % 3);
+      }
+      ref.SetAttributes();
+
+      Mesh mesh(ref);
+      if (type == Element::TETRAHEDRON)
+      {
+         // mark the tetrahedra for bisection, the copy does not keep the marks
+         ref.Finalize(true);
+         mesh.Finalize(true);
+      }
+      mesh.UseCompactElementStorage();
+      compare(ref, mesh);
+      compare_assembly(ref, mesh);
+
+      // elements are created on demand by the const GetElement()
+      const Mesh &cmesh = mesh;
+      const Element *el = cmesh.GetElement(1);
+      REQUIRE(el->GetGeometryType() == ref.GetElementBaseGeometry(1));
+      REQUIRE(el->GetAttribute() == ref.GetAttribute(1));
+      ref.SetAttribute(1, 5);
+      mesh.SetAttribute(1, 5);
+      REQUIRE(mesh.GetAttribute(1) == 5);
+      REQUIRE(el->GetAttribute() == 5);
+      REQUIRE(mesh.HasCompactElementStorage());
+
+      Mesh copy(mesh);
+      compare(ref, copy);
+
+      // refinement recreates the Element objects
+      if (type == Element::TRIANGLE || type == Element::TETRAHEDRON)
+      {
+         // the bisection uses the refinement marks of the tetrahedra
+         Array<int> refs(1);
+         refs[0] = 0;
+         ref.GeneralRefinement(refs, 0);
+         mesh.GeneralRefinement(refs, 0);
+         REQUIRE(!mesh.HasCompactElementStorage());
+         mesh.UseCompactElementStorage();
+         compare(ref, mesh);
+      }
+
+      ref.UniformRefinement();
+      mesh.UniformRefinement();
+      REQUIRE(!mesh.HasCompactElementStorage());
+      mesh.UseCompactElementStorage();
+      compare(ref, mesh);
+
+      mesh.UseCompactElementStorage(false);
+      REQUIRE(!mesh.HasCompactElementStorage());
+      REQUIRE(mesh.GetNE() == ref.GetNE());
+      for (int i = 0; i < ref.GetNE(); i++)
+      {
+         REQUIRE(mesh.GetElement(i)->GetAttribute() == ref.GetAttribute(i));
+      }
+      delete ref_ptr;
+   }
+}
+
+} // namespace mesh_compact
@@ -0,0 +1,254 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#ifdef MFEM_USE_GZSTREAM
+#include <zlib.h>
+#endif
+
+using namespace mfem;
+
+namespace mesh_vtu
+{
+
+static std::string decode_base64(const std::string &s)
+{
+   static const std::string chars =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+   std::string bytes;
+   unsigned bits = 0;
+   int nbits = 0;
+   for (std::size_t i = 0; i < s.size() && s[i] != '='; i++)
+   {
+      bits = (bits << 6) | (unsigned) chars.find(s[i]);
+      nbits += 6;
+      if (nbits >= 8)
+      {
+         nbits -= 8;
+         bytes += (char) ((bits >> nbits) & 0xff);
+      }
+   }
+   return bytes;
+}
+
+// Return the text of the DataArray starting after position pos.
+static std::string array_text(const std::string &file, std::size_t &pos)
+{
+   pos = file.find("<DataArray", pos);
+   const std::size_t begin = file.find(">\n", pos) + 2;
+   pos = file.find("</DataArray>", begin);
+   std::string text = file.substr(begin, pos - begin);
+   return text.substr(0, text.find_last_not_of('\n') + 1);
+}
+
+// Return the contents of the AppendedData section.
+static std::string appended_data(const std::string &file)
+{
+   const std::string tag = "<AppendedData encoding=\"raw\">\n_";
+   const std::size_t begin = file.find(tag) + tag.size();
+   const std::size_t end = file.find("\n</AppendedData>");
+   return file.substr(begin, end - begin);
+}
+
+static uint32_t get_uint32(const std::string &bytes, std::size_t offset)
+{
+   uint32_t value;
+   std::memcpy(&value, bytes.data() + offset, sizeof(value));
+   return value;
+}
+
+// Write an array larger than a block and a small one, and check that they
+// can be read back from each format.
+TEST_CASE("VTK data formats", "[VTK]")
+{
+   const int n = 5000, m = 7;
+   std::vector<double> x(n);
+   std::vector<int> ids(m);
+   for (int i = 0; i < n; i++) { x[i] = 0.5*i - 1e3; }
+   for (int i = 0; i < m; i++) { ids[i] = 100 - 3*i; }
+   const std::string x_bytes((const char *) x.data(), n*sizeof(double));
+   const std::string ids_bytes((const char *) ids.data(), m*sizeof(int));
+
+   std::vector<int> levels(1, 0);
+#ifdef MFEM_USE_GZSTREAM
+   levels.push_back(6);
+#endif
+
+   for (int k = 0; k < 3; k++)
+   {
+      const VTKFormat format = (VTKFormat) k;
+      for (std::size_t l = 0; l < levels.size(); l++)
+      {
+         const int level = levels[l];
+         if (level > 0 && format != VTKFormat::BINARY) { continue; }
+
+         std::ostringstream out;
+         VTKDataWriter writer(out, format, level);
+         writer.BeginFile("UnstructuredGrid");
+         do
+         {
+            writer.Markup() << "<Piece>\n";
+            writer.BeginArray<double>("x", 2, n);
+            if (writer.WritesData()) { writer.Write(x.data(), n); }
+            writer.EndArray();
+            writer.BeginArray<int>("ids", 1, m);
+            for (int i = 0; writer.WritesData() && i < m; i++)
+            {
+               writer.Write(ids[i]);
+            }
+            writer.EndArray();
+            writer.Markup() << "</Piece>\n";
+         }
+         while (writer.NextPass());
+         writer.EndFile();
+         const std::string file = out.str();
+
+         REQUIRE(file.find("</VTKFile>") != std::string::npos);
+         std::size_t pos = 0;
+         if (format == VTKFormat::ASCII)
+         {
+            std::istringstream x_text(array_text(file, pos));
+            std::istringstream ids_text(array_text(file, pos));
+            double xi;
+            int i = 0;
+            while (x_text >> xi) { REQUIRE(xi == x[i++]); }
+            REQUIRE(i == n);
+            i = 0;
+            int id;
+            while (ids_text >> id) { REQUIRE(id == ids[i++]); }
+            REQUIRE(i == m);
+         }
+         else if (format == VTKFormat::APPENDED)
+         {
+            REQUIRE(file.find("offset=\"0\"") != std::string::npos);
+            const std::string off = "offset=\"" +
+                                    std::to_string(4 + x_bytes.size()) + "\"";
+            REQUIRE(file.find(off) != std::string::npos);
+            const std::string data = appended_data(file);
+            REQUIRE(data.size() == 8 + x_bytes.size() + ids_bytes.size());
+            REQUIRE(get_uint32(data, 0) == x_bytes.size());
+            REQUIRE(data.substr(4, x_bytes.size()) == x_bytes);
+            REQUIRE(get_uint32(data, 4 + x_bytes.size()) == ids_bytes.size());
+            REQUIRE(data.substr(8 + x_bytes.size()) == ids_bytes);
+         }
+         else if (level == 0)
+         {
+            std::string data = decode_base64(array_text(file, pos));
+            REQUIRE(get_uint32(data, 0) == x_bytes.size());
+            REQUIRE(data.substr(4) == x_bytes);
+            data = decode_base64(array_text(file, pos));
+            REQUIRE(get_uint32(data, 0) == ids_bytes.size());
+            REQUIRE(data.substr(4) == ids_bytes);
+         }
+#ifdef MFEM_USE_GZSTREAM
+         else
+         {
+            REQUIRE(file.find("vtkZLibDataCompressor") != std::string::npos);
+            for (int a = 0; a < 2; a++)
+            {
+               const std::string &bytes = a ? ids_bytes : x_bytes;
+               const std::string text = array_text(file, pos);
+               // the header is encoded separately from the compressed data
+               const uint32_t nblocks =
+                  get_uint32(decode_base64(text.substr(0, 8)), 0);
+               const std::size_t hlen = 4*((12 + 4*nblocks + 2)/3);
+               const std::string header = decode_base64(text.substr(0, hlen));
+               const std::string zdata = decode_base64(text.substr(hlen));
+               REQUIRE(nblocks == (bytes.size() + VTKDataWriter::BlockSize - 1)
+                       / VTKDataWriter::BlockSize);
+               REQUIRE(get_uint32(header, 8) ==
+                       bytes.size() % VTKDataWriter::BlockSize);
+               std::string data;
+               std::size_t zpos = 0;
+               for (uint32_t b = 0; b < nblocks; b++)
+               {
+                  const uint32_t zsize = get_uint32(header, 12 + 4*b);
+                  std::vector<Bytef> block(VTKDataWriter::BlockSize);
+                  uLongf size = block.size();
+                  REQUIRE(uncompress(block.data(), &size,
+                                     (const Bytef *) zdata.data() + zpos,
+                                     zsize) == Z_OK);
+                  data.append((const char *) block.data(), size);
+                  zpos += zsize;
+               }
+               REQUIRE(zpos == zdata.size());
+               REQUIRE(data == bytes);
+            }
+         }
+#endif
+      }
+   }
+}
+
+// The appended format must declare the same arrays as the ascii one, with the
+// data of all of them in the AppendedData section.
+TEST_CASE("Mesh VTU output", "[Mesh][VTK]")
+{
+   Mesh mesh(2, 2, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   const int ref = 2;
+
+   std::ostringstream ascii, appended;
+   for (int k = 0; k < 2; k++)
+   {
+      const VTKFormat format = k ? VTKFormat::APPENDED : VTKFormat::ASCII;
+      std::ostringstream &out = k ? appended : ascii;
+      VTKDataWriter writer(out, format);
+      writer.BeginFile("UnstructuredGrid");
+      do
+      {
+         mesh.PrintVTU(writer, ref);
+         writer.Markup() << "</Piece>\n";
+      }
+      while (writer.NextPass());
+      writer.EndFile();
+   }
+
+   // 4 elements with 4 cells and 9 points each
+   const int np = 36, nc = 16;
+   const std::string piece =
+      "<Piece NumberOfPoints=\"36\" NumberOfCells=\"16\">";
+   REQUIRE(ascii.str().find(piece) != std::string::npos);
+   REQUIRE(appended.str().find(piece) != std::string::npos);
+
+   std::size_t pos = 0;
+   std::istringstream points(array_text(ascii.str(), pos));
+   double coord;
+   int ncoords = 0;
+   while (points >> coord)
+   {
+      REQUIRE((0.0 <= coord && coord <= 1.0));
+      ncoords++;
+   }
+   REQUIRE(ncoords == 3*np);
+
+   const std::string data = appended_data(appended.str());
+   // points, connectivity, offsets, types and materials with their headers
+   const std::size_t size = 3*np*sizeof(double) + 4*nc*sizeof(int) +
+                            nc*sizeof(int) + nc + nc*sizeof(int) + 5*4;
+   REQUIRE(data.size() == size);
+   std::vector<double> xyz(3*np);
+   std::memcpy(xyz.data(), data.data() + 4, xyz.size()*sizeof(double));
+   pos = 0;
+   points.clear();
+   points.str(array_text(ascii.str(), pos));
+   for (int i = 0; i < 3*np; i++)
+   {
+      points >> coord;
+      REQUIRE(std::abs(coord - xyz[i]) <= 1e-6);
+   }
+}
+
+} // namespace mesh_vtu
@@ -0,0 +1,194 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <vector>
+
+using namespace mfem;
+
+namespace pmesh_binary
+{
+
+#ifdef MFEM_USE_MPI
+
+static double volume(const Mesh &mesh)
+{
+   double vol = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      vol += const_cast<Mesh &>(mesh).GetElementVolume(i);
+   }
+   return vol;
+}
+
+// The center of the vertices of element i, rounded to integers
+static std::vector<long long> center_key(Mesh &mesh, int i)
+{
+   const int sdim = mesh.SpaceDimension();
+   Array<int> v;
+   mesh.GetElementVertices(i, v);
+   std::vector<long long> key(sdim);
+   for (int d = 0; d < sdim; d++)
+   {
+      double x = 0.0;
+      for (int j = 0; j < v.Size(); j++) { x += mesh.GetVertex(v[j])[d]; }
+      key[d] = std::llround(1e6*x/v.Size());
+   }
+   return key;
+}
+
+// Partitioning of the serial mesh that gives every element to the rank that
+// owns it in pmesh, found by matching the element centers.
+static int *get_partitioning(Mesh &mesh, ParMesh &pmesh)
+{
+   int nranks;
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+   const int sdim = mesh.SpaceDimension();
+   std::vector<long long> keys;
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      const std::vector<long long> key = center_key(pmesh, i);
+      keys.insert(keys.end(), key.begin(), key.end());
+   }
+   int nkeys = keys.size();
+   std::vector<int> counts(nranks), displs(nranks+1, 0);
+   MPI_Allgather(&nkeys, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                 MPI_COMM_WORLD);
+   for (int r = 0; r < nranks; r++) { displs[r+1] = displs[r] + counts[r]; }
+   std::vector<long long> all_keys(displs[nranks]);
+   MPI_Allgatherv(keys.data(), nkeys, MPI_LONG_LONG, all_keys.data(),
+                  counts.data(), displs.data(), MPI_LONG_LONG, MPI_COMM_WORLD);
+
+   std::map<std::vector<long long>, int> key_rank;
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int k = displs[r]; k < displs[r+1]; k += sdim)
+      {
+         std::vector<long long> key(&all_keys[k], &all_keys[k] + sdim);
+         key_rank[key] = r;
+      }
+   }
+   REQUIRE(key_rank.size() == (size_t) mesh.GetNE());
+   int *partitioning = new int[mesh.GetNE()];
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      auto it = key_rank.find(center_key(mesh, i));
+      REQUIRE(it != key_rank.end());
+      partitioning[i] = it->second;
+   }
+   return partitioning;
+}
+
+// The shared groups of pmesh in sorted order: the numbers of shared vertices,
+// edges, triangles and quadrilaterals of every group followed by its ranks.
+static std::vector<std::vector<int> > shared_groups(ParMesh &pmesh)
+{
+   std::vector<std::vector<int> > groups;
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      std::vector<int> group =
+      {
+         pmesh.GroupNVertices(g), pmesh.GroupNEdges(g),
+         pmesh.GroupNTriangles(g), pmesh.GroupNQuadrilaterals(g)
+      };
+      const int *lprocs = pmesh.gtopo.GetGroup(g);
+      for (int j = 0; j < pmesh.gtopo.GetGroupSize(g); j++)
+      {
+         group.push_back(pmesh.gtopo.GetNeighborRank(lprocs[j]));
+      }
+      std::sort(group.begin() + 4, group.end());
+      groups.push_back(group);
+   }
+   std::sort(groups.begin(), groups.end());
+   return groups;
+}
+
+// Read the binary file of the serial mesh in parallel and compare the result
+// with the ParMesh built from the serial mesh with the same partitioning: the
+// local entities and the shared vertices, edges and faces of every group must
+// match. Also compare the global numbers of elements, the volume and the
+// number of true dofs, which counts every shared entity once.
+static void check_parallel_read(const Mesh &mesh, bool sfc_partitioning)
+{
+   const char *filename = "pmesh_binary_test.mesh";
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   if (rank == 0)
+   {
+      std::ofstream out(filename, std::ios::binary);
+      mesh.PrintBinary(out);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParMesh pmesh(MPI_COMM_WORLD, filename, sfc_partitioning);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0) { std::remove(filename); }
+
+   long nbe = pmesh.GetNBE(), glob_nbe;
+   MPI_Allreduce(&nbe, &glob_nbe, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   double vol = volume(pmesh), glob_vol;
+   MPI_Allreduce(&vol, &glob_vol, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   REQUIRE(glob_nbe == mesh.GetNBE());
+   REQUIRE(glob_vol == Approx(volume(mesh)));
+
+   const int order = 3;
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(const_cast<Mesh *>(&mesh), &fec);
+   ParFiniteElementSpace pfes(&pmesh, &fec);
+   REQUIRE(pfes.GlobalTrueVSize() == fes.GetVSize());
+
+   Mesh &smesh = const_cast<Mesh &>(mesh);
+   int *partitioning = get_partitioning(smesh, pmesh);
+   ParMesh pmesh_ref(MPI_COMM_WORLD, smesh, partitioning);
+   delete [] partitioning;
+   REQUIRE(pmesh.GetNE() == pmesh_ref.GetNE());
+   REQUIRE(pmesh.GetNBE() == pmesh_ref.GetNBE());
+   REQUIRE(pmesh.GetNV() == pmesh_ref.GetNV());
+   REQUIRE(pmesh.GetNEdges() == pmesh_ref.GetNEdges());
+   REQUIRE(pmesh.GetNFaces() == pmesh_ref.GetNFaces());
+   REQUIRE(pmesh.GetNSharedFaces() == pmesh_ref.GetNSharedFaces());
+   REQUIRE(shared_groups(pmesh) == shared_groups(pmesh_ref));
+}
+
+TEST_CASE("Parallel binary mesh reader", "[Mesh][Parallel]")
+{
+   Mesh *meshes[] =
+   {
+      new Mesh(64, 1.0),
+      new Mesh(8, 8, Element::TRIANGLE, true, 1.0, 2.0),
+      new Mesh(4, 4, 4, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0),
+      new Mesh(4, 4, 4, Element::WEDGE, true, 1.0, 1.0, 1.0)
+   };
+   for (Mesh *mesh : meshes)
+   {
+      for (int i = 0; i < mesh->GetNE(); i++)
+      {
+         mesh->SetAttribute(i, 1 + i % 2);
+      }
+      mesh->SetAttributes();
+      check_parallel_read(*mesh, false);
+      check_parallel_read(*mesh, true);
+      delete mesh;
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace pmesh_binary